@@ -94,35 +94,6 @@ FILE(
   ${MMG3D_SOURCE_DIR}/lib${PROJECT_NAME}3df.c
   )
 
-############################################################################
-#####
-#####         Elastic
-#####
-############################################################################
-
-IF( USE_SUSCELAS )
-  # Set flags for building test program
-  INCLUDE_DIRECTORIES(${SUSCELAS_INCLUDE_DIR})
-
-  SET(CMAKE_REQUIRED_INCLUDES ${SUSCELAS_INCLUDE_DIR})
-  SET(CMAKE_REQUIRED_LIBRARIES ${SUSCELAS_LIBRARY})
-
-  SET(CMAKE_C_FLAGS "-DUSE_SUSCELAS ${CMAKE_C_FLAGS}")
-  MESSAGE(STATUS
-    "Compilation with the Elas library: ${SUSCELAS_LIBRARY} ")
-  SET( LIBRARIES ${SUSCELAS_LINK_FLAGS} ${LIBRARIES})
-  SET( LIBRARIES ${SUSCELAS_LIBRARY} ${LIBRARIES})
-ENDIF()
-
-IF (SUSCELAS_NOTFOUND)
-  MESSAGE ( WARNING "SUscElas is a library to solve the linear elasticity "
-    "problem (see https://github.com/SUscTools/SUscElas to download it). "
-    "This library is needed to use the lagrangian motion option. "
-    "If you have already installed SUscElas and want to use it, "
-    "please set the CMake variable or environment variable SUSCELAS_DIR "
-    "to your SUscElas directory.")
-ENDIF ( )
-
 ############################################################################
 #####
 #####         Compile mmg3d libraries
@@ -278,15 +249,17 @@ IF ( BUILD_TESTING )
       SET(LIBMMG3D_EXEC2   ${EXECUTABLE_OUTPUT_PATH}/libmmg3d_example2)
       SET(LIBMMG3D_EXEC4   ${EXECUTABLE_OUTPUT_PATH}/libmmg3d_example4)
       SET(LIBMMG3D_EXEC5   ${EXECUTABLE_OUTPUT_PATH}/libmmg3d_example5)
+      SET(LIBMMG3D_EXEC6   ${EXECUTABLE_OUTPUT_PATH}/libmmg3d_example6)
+      SET(LIBMMG3D_EXEC7   ${EXECUTABLE_OUTPUT_PATH}/libmmg3d_example7)
 
       ADD_TEST(NAME libmmg3d_example0_a COMMAND ${LIBMMG3D_EXEC0_a})
       ADD_TEST(NAME libmmg3d_example0_b COMMAND ${LIBMMG3D_EXEC0_b})
       ADD_TEST(NAME libmmg3d_example1   COMMAND ${LIBMMG3D_EXEC1})
       ADD_TEST(NAME libmmg3d_example2   COMMAND ${LIBMMG3D_EXEC2})
-      IF ( USE_SUSCELAS )
-        ADD_TEST(NAME libmmg3d_example4   COMMAND ${LIBMMG3D_EXEC4})
-      ENDIF ()
+      ADD_TEST(NAME libmmg3d_example4   COMMAND ${LIBMMG3D_EXEC4})
       ADD_TEST(NAME libmmg3d_example5   COMMAND ${LIBMMG3D_EXEC5})
+      ADD_TEST(NAME libmmg3d_example6   COMMAND ${LIBMMG3D_EXEC6})
+      ADD_TEST(NAME libmmg3d_example7   COMMAND ${LIBMMG3D_EXEC7})
 
       SET( LISTEXEC_MMG3D ${LISTEXEC_MMG3D} )
 
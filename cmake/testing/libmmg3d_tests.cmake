@@ -24,6 +24,12 @@ ADD_EXECUTABLE(libmmg3d_example4
 ADD_EXECUTABLE(libmmg3d_example5
   ${CMAKE_SOURCE_DIR}/libexamples/mmg3d/IsosurfDiscretization_example0/main.c ${mmg3d_includes})
 
+ADD_EXECUTABLE(libmmg3d_example6
+  ${CMAKE_SOURCE_DIR}/libexamples/mmg3d/FieldTransfer_example0/main.c ${mmg3d_includes})
+
+ADD_EXECUTABLE(libmmg3d_example7
+  ${CMAKE_SOURCE_DIR}/libexamples/mmg3d/Locator_example0/main.c ${mmg3d_includes})
+
  IF ( WIN32 AND ((NOT MINGW) AND USE_SCOTCH) )
     my_add_link_flags(libmmg3d_example0_a "/SAFESEH:NO")
     my_add_link_flags(libmmg3d_example0_b "/SAFESEH:NO")
@@ -31,6 +37,8 @@ ADD_EXECUTABLE(libmmg3d_example5
     my_add_link_flags(libmmg3d_example2 "/SAFESEH:NO")
     my_add_link_flags(libmmg3d_example4 "/SAFESEH:NO")
     my_add_link_flags(libmmg3d_example5 "/SAFESEH:NO")
+    my_add_link_flags(libmmg3d_example6 "/SAFESEH:NO")
+    my_add_link_flags(libmmg3d_example7 "/SAFESEH:NO")
  ENDIF ( )
 
 IF ( LIBMMG3D_STATIC )
@@ -41,6 +49,8 @@ IF ( LIBMMG3D_STATIC )
   TARGET_LINK_LIBRARIES(libmmg3d_example2   ${PROJECT_NAME}3d_a)
   TARGET_LINK_LIBRARIES(libmmg3d_example4   ${PROJECT_NAME}3d_a)
   TARGET_LINK_LIBRARIES(libmmg3d_example5   ${PROJECT_NAME}3d_a)
+  TARGET_LINK_LIBRARIES(libmmg3d_example6   ${PROJECT_NAME}3d_a)
+  TARGET_LINK_LIBRARIES(libmmg3d_example7   ${PROJECT_NAME}3d_a)
 
 ELSEIF ( LIBMMG3D_SHARED )
 
@@ -50,6 +60,8 @@ ELSEIF ( LIBMMG3D_SHARED )
   TARGET_LINK_LIBRARIES(libmmg3d_example2   ${PROJECT_NAME}3d_so)
   TARGET_LINK_LIBRARIES(libmmg3d_example4   ${PROJECT_NAME}3d_so)
   TARGET_LINK_LIBRARIES(libmmg3d_example5   ${PROJECT_NAME}3d_so)
+  TARGET_LINK_LIBRARIES(libmmg3d_example6   ${PROJECT_NAME}3d_so)
+  TARGET_LINK_LIBRARIES(libmmg3d_example7   ${PROJECT_NAME}3d_so)
 
 ELSE ()
   MESSAGE(WARNING "You must activate the compilation of the static or"
@@ -62,6 +74,8 @@ INSTALL(TARGETS libmmg3d_example1   RUNTIME DESTINATION bin )
 INSTALL(TARGETS libmmg3d_example2   RUNTIME DESTINATION bin )
 INSTALL(TARGETS libmmg3d_example4   RUNTIME DESTINATION bin )
 INSTALL(TARGETS libmmg3d_example5   RUNTIME DESTINATION bin )
+INSTALL(TARGETS libmmg3d_example6   RUNTIME DESTINATION bin )
+INSTALL(TARGETS libmmg3d_example7   RUNTIME DESTINATION bin )
 
 ###############################################################################
 #####
@@ -103,14 +103,12 @@ FOREACH(EXEC ${LISTEXEC_MMG3D})
   #####
   ###############################################################################
   #####
-  IF ( USE_SUSCELAS )
-    ADD_TEST(NAME LagMotion1_tinyBoxt_${EXEC}
-      COMMAND ${EXEC} -v 5  -lag 1
-      -in ${MMG3D_CI_TESTS}/LagMotion1_tinyBoxt/tinyBoxt
-      -sol ${MMG3D_CI_TESTS}/LagMotion1_tinyBoxt/tinyBoxt.sol
-      -out ${MMG3D_CI_TESTS}/LagMotion1_tinyBoxt/tinyBoxt.o.meshb
-      )
-  ENDIF()
+  ADD_TEST(NAME LagMotion1_tinyBoxt_${EXEC}
+    COMMAND ${EXEC} -v 5  -lag 1
+    -in ${MMG3D_CI_TESTS}/LagMotion1_tinyBoxt/tinyBoxt
+    -sol ${MMG3D_CI_TESTS}/LagMotion1_tinyBoxt/tinyBoxt.sol
+    -out ${MMG3D_CI_TESTS}/LagMotion1_tinyBoxt/tinyBoxt.o.meshb
+    )
 
 ENDFOREACH(EXEC)
 
@@ -369,14 +367,12 @@ IF ( LONG_TESTS )
   #####
   ###############################################################################
   #####
-  IF ( USE_SUSCELAS )
-    ADD_TEST(NAME LagMotion1_boxt_${EXEC}
-      COMMAND ${EXEC} -v 5  -lag 1
-      -in ${MMG3D_CI_TESTS}/LagMotion1_boxt/boxt
-      -sol ${MMG3D_CI_TESTS}/LagMotion1_boxt/boxt.sol
-      -out ${MMG3D_CI_TESTS}/LagMotion1_boxt/boxt.o.meshb
-      )
-  ENDIF()
+  ADD_TEST(NAME LagMotion1_boxt_${EXEC}
+    COMMAND ${EXEC} -v 5  -lag 1
+    -in ${MMG3D_CI_TESTS}/LagMotion1_boxt/boxt
+    -sol ${MMG3D_CI_TESTS}/LagMotion1_boxt/boxt.sol
+    -out ${MMG3D_CI_TESTS}/LagMotion1_boxt/boxt.o.meshb
+    )
 
 ENDIF()
 
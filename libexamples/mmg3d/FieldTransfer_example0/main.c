@@ -0,0 +1,145 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Bx INP/Inria/UBordeaux/UPMC, 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * Example of use of the mmg3d library: transfer of a user field through the
+ * remeshing (MMG3D_Add_field).
+ *
+ * \author Charles Dapogny (LJLL, UPMC)
+ * \author Cécile Dobrzynski (Inria / IMB, Université de Bordeaux)
+ * \author Pascal Frey (LJLL, UPMC)
+ * \author Algiane Froehly (Inria / IMB, Université de Bordeaux)
+ * \version 5
+ * \copyright GNU Lesser General Public License.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <float.h>
+
+/** Include the mmg3d library hader file */
+// if the header file is in the "include" directory
+// #include "libmmg3d.h"
+// if the header file is in "include/mmg/mmg3d"
+#include "mmg/mmg3d/libmmg3d.h"
+
+int main(int argc,char *argv[]) {
+  MMG5_pMesh      mmgMesh;
+  MMG5_pSol       mmgSol,mmgField;
+  double          err;
+  int             ier,k;
+  char            *pwd,*filename;
+
+  fprintf(stdout,"  -- TEST MMG3DLIB: USER FIELD\n");
+
+  /* Name and path of the mesh file */
+  pwd = getenv("PWD");
+  filename = (char *) calloc(strlen(pwd) + 58, sizeof(char));
+  if ( filename == NULL ) {
+    perror("  ## Memory problem: calloc");
+    exit(EXIT_FAILURE);
+  }
+  sprintf(filename, "%s%s%s", pwd, "/../libexamples/mmg3d/adaptation_example0/example0_a/", "cube");
+
+  /** ------------------------------ STEP   I -------------------------- */
+  /** 1) Initialisation of mesh and sol structures */
+  mmgMesh = NULL;
+  mmgSol  = NULL;
+
+  MMG3D_Init_mesh(MMG5_ARG_start,
+                  MMG5_ARG_ppMesh,&mmgMesh,MMG5_ARG_ppMet,&mmgSol,
+                  MMG5_ARG_end);
+
+  /** 2) Read the mesh and the metric */
+  if ( MMG3D_loadMesh(mmgMesh,filename) != 1 )  exit(EXIT_FAILURE);
+  if ( MMG3D_loadSol(mmgMesh,mmgSol,filename) != 1 )  exit(EXIT_FAILURE);
+
+  /** 3) Attach a user field with 2 values per vertex: a constant and the x
+      coordinate of the vertex. The field structure belongs to the user but its
+      values are allocated by MMG3D_Add_field and freed with the mesh. */
+  mmgField = (MMG5_pSol) calloc(1,sizeof(MMG5_Sol));
+  if ( mmgField == NULL ) {
+    perror("  ## Memory problem: calloc");
+    exit(EXIT_FAILURE);
+  }
+  if ( MMG3D_Add_field(mmgMesh,mmgField,2) != 1 )  exit(EXIT_FAILURE);
+
+  for (k=1; k<=mmgMesh->np; k++) {
+    mmgField->m[2*k]   = 1.;
+    mmgField->m[2*k+1] = mmgMesh->point[k].c[0];
+  }
+
+  /** 4) The field is linearly interpolated at the new and the moved points,
+      so the transfered field can be compared to the coordinates */
+  if ( MMG3D_Chk_meshData(mmgMesh,mmgSol) != 1 ) exit(EXIT_FAILURE);
+
+  /** ------------------------------ STEP  II -------------------------- */
+  /** library call */
+  ier = MMG3D_mmg3dlib(mmgMesh,mmgSol);
+
+  if ( ier == MMG5_STRONGFAILURE ) {
+    fprintf(stdout,"BAD ENDING OF MMG3DLIB: UNABLE TO SAVE MESH\n");
+    return(ier);
+  } else if ( ier == MMG5_LOWFAILURE )
+    fprintf(stdout,"BAD ENDING OF MMG3DLIB\n");
+
+  /** ------------------------------ STEP III -------------------------- */
+  /** The field is now defined on the output mesh */
+  if ( mmgField->np != mmgMesh->np ) {
+    fprintf(stdout,"WRONG NUMBER OF FIELD VALUES: %d (%d VERTICES)\n",
+            mmgField->np,mmgMesh->np);
+    return(MMG5_LOWFAILURE);
+  }
+  err = 0.;
+  for (k=1; k<=mmgMesh->np; k++) {
+    err = fmax(err,fabs(mmgField->m[2*k] - 1.));
+    err = fmax(err,fabs(mmgField->m[2*k+1] - mmgMesh->point[k].c[0]));
+  }
+  fprintf(stdout,"  -- %d VERTICES, MAXIMAL FIELD ERROR %e\n",mmgMesh->np,err);
+  if ( err > 1.e-6 ) {
+    fprintf(stdout,"WRONG TRANSFER OF THE USER FIELD\n");
+    ier = MMG5_LOWFAILURE;
+  }
+
+  if ( MMG3D_saveMesh(mmgMesh,"cube_field.o.mesh") != 1 ) {
+    fprintf(stdout,"UNABLE TO SAVE MESH\n");
+    return(MMG5_STRONGFAILURE);
+  }
+
+  /** Free the MMG3D5 structures (and the field values), then the field */
+  MMG3D_Free_all(MMG5_ARG_start,
+                 MMG5_ARG_ppMesh,&mmgMesh,MMG5_ARG_ppMet,&mmgSol,
+                 MMG5_ARG_end);
+  free(mmgField);
+  mmgField = NULL;
+
+  free(filename);
+  filename = NULL;
+
+  return(ier);
+}
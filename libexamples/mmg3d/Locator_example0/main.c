@@ -0,0 +1,172 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Bx INP/Inria/UBordeaux/UPMC, 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+
+/**
+ * Example of use of the mmg3d library: transfer of a field from the input
+ * mesh to the output mesh with a point locator (MMG3D_Init_locator).
+ *
+ * \author Charles Dapogny (LJLL, UPMC)
+ * \author Cécile Dobrzynski (Inria / IMB, Université de Bordeaux)
+ * \author Pascal Frey (LJLL, UPMC)
+ * \author Algiane Froehly (Inria / IMB, Université de Bordeaux)
+ * \version 5
+ * \copyright GNU Lesser General Public License.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <float.h>
+
+/** Include the mmg3d library hader file */
+// if the header file is in the "include" directory
+// #include "libmmg3d.h"
+// if the header file is in "include/mmg/mmg3d"
+#include "mmg/mmg3d/libmmg3d.h"
+
+/** Linear field to transfer (exactly interpolated by P1 functions) */
+static double field(double *c) {
+  return(c[0] + 2.*c[1] + 3.*c[2]);
+}
+
+int main(int argc,char *argv[]) {
+  MMG5_pMesh      mmgMesh;
+  MMG5_pSol       mmgSol;
+  MMG3D_pLocator  loc;
+  double          *fold,*fnew,*c,*bary,err;
+  int             ier,k,np,*iel;
+  char            *pwd,*filename;
+  /* Points outside the unit cube and their projection on its boundary */
+  double          out[6]  = { 2., 0.5, 0.5,  -1., -1., -1. };
+  double          proj[6] = { 1., 0.5, 0.5,   0.,  0.,  0. };
+
+  fprintf(stdout,"  -- TEST MMG3DLIB: POINT LOCATOR\n");
+
+  /* Name and path of the mesh file */
+  pwd = getenv("PWD");
+  filename = (char *) calloc(strlen(pwd) + 58, sizeof(char));
+  if ( filename == NULL ) {
+    perror("  ## Memory problem: calloc");
+    exit(EXIT_FAILURE);
+  }
+  sprintf(filename, "%s%s%s", pwd, "/../libexamples/mmg3d/adaptation_example0/example0_a/", "cube");
+
+  /** ------------------------------ STEP   I -------------------------- */
+  /** 1) Initialisation of mesh and sol structures */
+  mmgMesh = NULL;
+  mmgSol  = NULL;
+
+  MMG3D_Init_mesh(MMG5_ARG_start,
+                  MMG5_ARG_ppMesh,&mmgMesh,MMG5_ARG_ppMet,&mmgSol,
+                  MMG5_ARG_end);
+
+  /** 2) Read the mesh and the metric */
+  if ( MMG3D_loadMesh(mmgMesh,filename) != 1 )  exit(EXIT_FAILURE);
+  if ( MMG3D_loadSol(mmgMesh,mmgSol,filename) != 1 )  exit(EXIT_FAILURE);
+
+  /** 3) Build the locator on the input mesh (it stores a copy of the mesh, so
+      it remains valid after the remeshing) and compute the field to transfer
+      at the input vertices (0-based array) */
+  if ( MMG3D_Init_locator(mmgMesh,&loc) != 1 )  exit(EXIT_FAILURE);
+
+  fold = (double *) calloc(mmgMesh->np, sizeof(double));
+  if ( fold == NULL ) {
+    perror("  ## Memory problem: calloc");
+    exit(EXIT_FAILURE);
+  }
+  for (k=1; k<=mmgMesh->np; k++)
+    fold[k-1] = field(mmgMesh->point[k].c);
+
+  if ( MMG3D_Chk_meshData(mmgMesh,mmgSol) != 1 ) exit(EXIT_FAILURE);
+
+  /** ------------------------------ STEP  II -------------------------- */
+  /** library call */
+  ier = MMG3D_mmg3dlib(mmgMesh,mmgSol);
+
+  if ( ier == MMG5_STRONGFAILURE ) {
+    fprintf(stdout,"BAD ENDING OF MMG3DLIB: UNABLE TO SAVE MESH\n");
+    return(ier);
+  } else if ( ier == MMG5_LOWFAILURE )
+    fprintf(stdout,"BAD ENDING OF MMG3DLIB\n");
+
+  /** ------------------------------ STEP III -------------------------- */
+  /** 1) Points to locate: the output vertices followed by 2 points lying
+      outside the mesh */
+  np   = mmgMesh->np + 2;
+  c    = (double *) calloc(3*np, sizeof(double));
+  bary = (double *) calloc(4*np, sizeof(double));
+  fnew = (double *) calloc(np, sizeof(double));
+  iel  = (int *)    calloc(np, sizeof(int));
+  if ( !c || !bary || !fnew || !iel ) {
+    perror("  ## Memory problem: calloc");
+    exit(EXIT_FAILURE);
+  }
+  for (k=0; k<mmgMesh->np; k++)
+    memcpy(&c[3*k],mmgMesh->point[k+1].c,3*sizeof(double));
+  memcpy(&c[3*mmgMesh->np],out,6*sizeof(double));
+
+  /** 2) Locate the points in the input mesh and interpolate the field */
+  if ( MMG3D_locate(loc,np,c,iel,bary) != 1 )  exit(EXIT_FAILURE);
+  if ( MMG3D_Interp_locator(loc,np,iel,bary,1,fold,fnew) != 1 )
+    exit(EXIT_FAILURE);
+
+  /** 3) The field is linear so it is exactly transfered at the vertices; an
+      outside point gets the value at its projection on the boundary */
+  err = 0.;
+  for (k=0; k<mmgMesh->np; k++)
+    err = fmax(err,fabs(fnew[k] - field(&c[3*k])));
+  for (k=0; k<2; k++) {
+    if ( iel[mmgMesh->np+k] >= 0 ) {
+      fprintf(stdout,"OUTSIDE POINT %d LOCATED IN THE MESH\n",k);
+      ier = MMG5_LOWFAILURE;
+    }
+    err = fmax(err,fabs(fnew[mmgMesh->np+k] - field(&proj[3*k])));
+  }
+  fprintf(stdout,"  -- %d POINTS, MAXIMAL INTERPOLATION ERROR %e\n",np,err);
+  if ( err > 1.e-6 ) {
+    fprintf(stdout,"WRONG INTERPOLATION OF THE FIELD\n");
+    ier = MMG5_LOWFAILURE;
+  }
+
+  /** 4) Free the locator, the arrays and the MMG3D5 structures */
+  MMG3D_Free_locator(&loc);
+  free(fold);
+  free(fnew);
+  free(c);
+  free(bary);
+  free(iel);
+
+  MMG3D_Free_all(MMG5_ARG_start,
+                 MMG5_ARG_ppMesh,&mmgMesh,MMG5_ARG_ppMet,&mmgSol,
+                 MMG5_ARG_end);
+
+  free(filename);
+  filename = NULL;
+
+  return(ier);
+}
@@ -152,3 +152,176 @@ inline void _MMG5_bezierEdge(MMG5_pMesh mesh,int i0,int i1,
     }
   }
 }
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param nbdy approximative number of boundary triangles.
+ * \return 1 if success, 0 if the cache is not allocated.
+ *
+ * Allocate the cache of Bezier patches (nothing is done if it already
+ * exists). The cache is optional: if there is not enough memory, the patches
+ * are simply recomputed at each call.
+ *
+ */
+int _MMG5_bezierCacheNew(MMG5_pMesh mesh,int nbdy) {
+  _MMG5_BezCache *cache;
+  long long      size;
+  int            siz;
+
+  if ( mesh->bezcache )  return(1);
+
+  siz = 64;
+  while ( siz < nbdy && siz < _MMG5_BEZCACHE )  siz <<= 1;
+
+  size = sizeof(_MMG5_BezCache) + (long long)siz*sizeof(_MMG5_BezCell);
+  if ( mesh->memCur + size > mesh->memMax )  return(0);
+  mesh->memCur += size;
+
+  _MMG5_SAFE_CALLOC(cache,1,_MMG5_BezCache);
+  _MMG5_SAFE_CALLOC(cache->cell,siz,_MMG5_BezCell);
+  cache->siz = siz;
+
+  mesh->bezcache = cache;
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ *
+ * Free the cache of Bezier patches.
+ *
+ */
+void _MMG5_bezierCacheFree(MMG5_pMesh mesh) {
+  _MMG5_BezCache *cache;
+
+  cache = mesh->bezcache;
+  if ( !cache )  return;
+
+  _MMG5_DEL_MEM(mesh,cache->cell,cache->siz*sizeof(_MMG5_BezCell));
+  _MMG5_DEL_MEM(mesh,cache,sizeof(_MMG5_BezCache));
+  mesh->bezcache = NULL;
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param pt pointer toward the triangle.
+ * \return the signature of the data of the vertices of \a pt used by the
+ * computation of its Bezier patch.
+ *
+ * Mix the coordinates, tags, normals and tangents of the vertices of \a pt.
+ *
+ */
+static inline
+unsigned long long _MMG5_bezierSig(MMG5_pMesh mesh,MMG5_pTria pt) {
+  MMG5_pPoint        ppt;
+  MMG5_pxPoint       pxp;
+  unsigned long long h,w;
+  int                i,j;
+
+  h = 0;
+  for (i=0; i<3; i++) {
+    ppt = &mesh->point[pt->v[i]];
+    h   = (h ^ (((unsigned long long)(unsigned char)ppt->tag << 32) | (unsigned int)ppt->xp))
+      * 0x9e3779b97f4a7c15ULL;
+    for (j=0; j<3; j++) {
+      memcpy(&w,&ppt->c[j],sizeof(double));
+      h = (h ^ w) * 0x9e3779b97f4a7c15ULL;
+      h ^= h >> 29;
+      memcpy(&w,&ppt->n[j],sizeof(double));
+      h = (h ^ w) * 0x9e3779b97f4a7c15ULL;
+      h ^= h >> 29;
+    }
+    if ( !ppt->xp )  continue;
+    pxp = &mesh->xpoint[ppt->xp];
+    for (j=0; j<3; j++) {
+      memcpy(&w,&pxp->n1[j],sizeof(double));
+      h = (h ^ w) * 0x9e3779b97f4a7c15ULL;
+      h ^= h >> 29;
+      memcpy(&w,&pxp->n2[j],sizeof(double));
+      h = (h ^ w) * 0x9e3779b97f4a7c15ULL;
+      h ^= h >> 29;
+    }
+  }
+  return(h);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param pt pointer toward the triangle.
+ * \return the cell of the cache associated to \a pt, NULL if the cache can't
+ * be used.
+ *
+ */
+static inline
+_MMG5_BezCell* _MMG5_bezierCell(MMG5_pMesh mesh,MMG5_pTria pt) {
+  _MMG5_BezCache *cache;
+
+  cache = mesh->bezcache;
+  if ( !cache )  return(NULL);
+
+#ifdef _OPENMP
+  /* the cache is not shared between threads */
+  if ( omp_in_parallel() )  return(NULL);
+#endif
+
+  return(&cache->cell[_MMG5_hashSlot(pt->v[0],
+                                     pt->v[1]^(int)((unsigned)pt->v[2]<<16),
+                                     cache->siz-1)]);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param pt pointer toward the triangle.
+ * \param pb pointer toward the Bezier patch to fill.
+ * \param ori triangle orientation.
+ * \return 1 if the patch of \a pt is in the cache and still valid, 0
+ * otherwise.
+ *
+ * Seek the Bezier patch of the triangle \a pt in the cache.
+ *
+ */
+int _MMG5_bezierCacheGet(MMG5_pMesh mesh,MMG5_pTria pt,_MMG5_pBezier pb,char ori) {
+  _MMG5_BezCell *cell;
+  char          i;
+
+  cell = _MMG5_bezierCell(mesh,pt);
+  if ( !cell )  return(0);
+
+  for (i=0; i<3; i++) {
+    if ( cell->v[i] != pt->v[i] || cell->tag[i] != pt->tag[i] )  return(0);
+  }
+  if ( cell->ori != ori )  return(0);
+  if ( cell->sig != _MMG5_bezierSig(mesh,pt) )  return(0);
+
+  memcpy(pb,&cell->pb,sizeof(_MMG5_Bezier));
+  /* the point array may have been reallocated */
+  for (i=0; i<3; i++)
+    pb->p[i] = &mesh->point[pt->v[i]];
+
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param pt pointer toward the triangle.
+ * \param pb pointer toward the Bezier patch of \a pt.
+ * \param ori triangle orientation.
+ *
+ * Store the Bezier patch of the triangle \a pt in the cache.
+ *
+ */
+void _MMG5_bezierCachePut(MMG5_pMesh mesh,MMG5_pTria pt,_MMG5_pBezier pb,char ori) {
+  _MMG5_BezCell *cell;
+  char          i;
+
+  cell = _MMG5_bezierCell(mesh,pt);
+  if ( !cell )  return;
+
+  for (i=0; i<3; i++) {
+    cell->v[i]   = pt->v[i];
+    cell->tag[i] = pt->tag[i];
+  }
+  cell->ori = ori;
+  cell->sig = _MMG5_bezierSig(mesh,pt);
+  memcpy(&cell->pb,pb,sizeof(_MMG5_Bezier));
+}
@@ -0,0 +1,211 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Bx INP/Inria/UBordeaux/UPMC, 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file common/coincid.c
+ * \brief Detection of coincident (and periodic) points by spatial hashing.
+ * \author Charles Dapogny (UPMC)
+ * \author Cécile Dobrzynski (Bx INP/Inria/UBordeaux)
+ * \author Pascal Frey (UPMC)
+ * \author Algiane Froehly (Inria/UBordeaux)
+ * \version 5
+ * \copyright GNU Lesser General Public License.
+ */
+
+#include "mmgcommon.h"
+
+/** Number of bits per direction of the cell keys */
+#define _MMG5_COINBIT  21
+
+/** Cell of the spatial hash: key of the cell and first point of the cell */
+typedef struct {
+  unsigned long long key;
+  int                head;
+} _MMG5_CoinCell;
+
+/**
+ * \param c coordinates of the point.
+ * \param t translation to apply (may be NULL).
+ * \param dim space dimension.
+ * \param min origin of the grid.
+ * \param dd inverse of the cell size.
+ * \param X integer coordinates of the cell (computed).
+ *
+ * Integer coordinates of the cell containing \f$c-t\f$.
+ *
+ */
+static inline
+void _MMG5_coinCell(double *c,double *t,int dim,double *min,double dd,
+                    long long *X) {
+  double  x;
+  int     i;
+
+  for (i=0; i<dim; i++) {
+    x    = t ? c[i]-t[i] : c[i];
+    X[i] = (long long)floor((x-min[i])*dd);
+  }
+  for ( ; i<3; i++)  X[i] = 0;
+}
+
+/**
+ * \param X integer coordinates of the cell.
+ * \return the key of the cell.
+ *
+ * Cells that are far outside the grid may share their key with a cell of
+ * the grid: it only costs some useless distance computations.
+ *
+ */
+static inline
+unsigned long long _MMG5_coinKey(long long *X) {
+  unsigned long long mask;
+
+  mask = (1ULL << _MMG5_COINBIT) - 1;
+  return( ((unsigned long long)X[0] & mask)
+          | (((unsigned long long)X[1] & mask) << _MMG5_COINBIT)
+          | (((unsigned long long)X[2] & mask) << (2*_MMG5_COINBIT)) );
+}
+
+/**
+ * \param tab hash table of the cells.
+ * \param mask slot mask of the table.
+ * \param key key of the cell.
+ * \return slot of the cell or first empty slot of its probe sequence.
+ *
+ */
+static inline
+int _MMG5_coinSlot(_MMG5_CoinCell *tab,int mask,unsigned long long key) {
+  int  s;
+
+  s = _MMG5_hashSlot((int)(key >> 32),(int)(key & 0xffffffffULL),mask);
+  while ( tab[s].head && tab[s].key != key )  s = (s+1) & mask;
+  return(s);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param dim space dimension (2 or 3).
+ * \param tol distance under which two points are merged.
+ * \param ntrans number of periodicity translations.
+ * \param trans translations (\a dim values per translation, may be NULL if
+ * \a ntrans is 0).
+ * \param img array of size np+1 filled with, for each point \a k, the
+ * smallest index \a j < \a k of a point that coincides with \a k or whose
+ * image by one of the translations coincides with \a k (0 if none).
+ * \return 1 if success, 0 if fail.
+ *
+ * Find the coincident and periodic points of the mesh in expected linear
+ * time: the points are stored in the cells of a uniform grid of size
+ * greater than \a tol (hashed with open addressing), and each point (and
+ * each of its preimage by the translations) is only compared with the
+ * points of the \f$3^{dim}\f$ neighbouring cells.
+ *
+ */
+int _MMG5_coincidentPoints(MMG5_pMesh mesh,int dim,double tol,int ntrans,
+                           double *trans,int *img) {
+  _MMG5_CoinCell     *tab;
+  MMG5_pPoint        ppt,p1;
+  double             min[3],max[3],dd,d,tol2,*t,c[3];
+  long long          X[3],Y[3];
+  int                *next,siz,mask,k,j,i,l,s,nc,i0,i1,i2;
+
+  assert ( dim == 2 || dim == 3 );
+  assert ( tol > 0. );
+
+  if ( mesh->np < 1 )  return(1);
+
+  for (i=0; i<dim; i++) {
+    min[i] =  DBL_MAX;
+    max[i] = -DBL_MAX;
+  }
+  for (k=1; k<=mesh->np; k++) {
+    ppt = &mesh->point[k];
+    for (i=0; i<dim; i++) {
+      min[i] = MG_MIN(min[i],ppt->c[i]);
+      max[i] = MG_MAX(max[i],ppt->c[i]);
+    }
+  }
+
+  /* cell size: at least tol, and the grid fits in the key bits */
+  d = 0.;
+  for (i=0; i<dim; i++)  d = MG_MAX(d,max[i]-min[i]);
+  d  = MG_MAX(tol,d/(double)((1 << (_MMG5_COINBIT-1))-1));
+  dd = 1./d;
+
+  siz  = _MMG5_hashSiz(mesh->np);
+  mask = siz-1;
+  _MMG5_ADD_MEM(mesh,siz*sizeof(_MMG5_CoinCell)+(mesh->np+1)*sizeof(int),
+                "coincident points",return(0));
+  _MMG5_SAFE_CALLOC(tab,siz,_MMG5_CoinCell);
+  _MMG5_SAFE_CALLOC(next,mesh->np+1,int);
+
+  /* store the points in the cells (in decreasing order so that each cell
+   * list is sorted by increasing index) */
+  for (k=mesh->np; k>0; k--) {
+    _MMG5_coinCell(mesh->point[k].c,NULL,dim,min,dd,X);
+    s = _MMG5_coinSlot(tab,mask,_MMG5_coinKey(X));
+    tab[s].key  = _MMG5_coinKey(X);
+    next[k]     = tab[s].head;
+    tab[s].head = k;
+  }
+
+  tol2 = tol*tol;
+  nc   = (dim == 3) ? 1 : 0;
+
+#pragma omp parallel for private(ppt,p1,t,c,X,Y,l,i,i0,i1,i2,s,j,d)
+  for (k=1; k<=mesh->np; k++) {
+    ppt    = &mesh->point[k];
+    img[k] = 0;
+
+    for (l=-1; l<ntrans; l++) {
+      t = ( l < 0 ) ? NULL : &trans[dim*l];
+      for (i=0; i<dim; i++)  c[i] = t ? ppt->c[i]-t[i] : ppt->c[i];
+      _MMG5_coinCell(ppt->c,t,dim,min,dd,X);
+
+      for (i0=-1; i0<=1; i0++) {
+        for (i1=-1; i1<=1; i1++) {
+          for (i2=-nc; i2<=nc; i2++) {
+            Y[0] = X[0]+i0;
+            Y[1] = X[1]+i1;
+            Y[2] = X[2]+i2;
+            s = _MMG5_coinSlot(tab,mask,_MMG5_coinKey(Y));
+            for (j=tab[s].head; j && j<k; j=next[j]) {
+              if ( img[k] && j >= img[k] )  break;
+              p1 = &mesh->point[j];
+              d  = 0.;
+              for (i=0; i<dim; i++)  d += (p1->c[i]-c[i])*(p1->c[i]-c[i]);
+              if ( d < tol2 ) {
+                img[k] = j;
+                break;
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  _MMG5_DEL_MEM(mesh,next,(mesh->np+1)*sizeof(int));
+  _MMG5_DEL_MEM(mesh,tab,siz*sizeof(_MMG5_CoinCell));
+
+  return(1);
+}
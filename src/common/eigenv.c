@@ -48,6 +48,12 @@
 #define  _MG_EPSX2          2.e-06
 #define  MAXTOU         50
 
+/* closed-form symmetric solver */
+#define  _MG_SQRT3          1.73205080756887729
+#define  _MG_EPSJ           1.e-30
+#define  _MG_EIGGAP         1.e-04
+#define  _MG_EIGBLOC        32
+
 /**
  * \def egal(x,y)
  * Check if numbers \a x and \a y are equal.
@@ -247,6 +253,274 @@ static int newton3(double p[4],double x[3]) {
   return(n);
 }
 
+/**
+ * \brief Closed-form eigenvalues of a normalized symmetric 3x3 matrix.
+ * \param a11 coefficient (1,1) of the matrix.
+ * \param a12 coefficient (1,2) of the matrix.
+ * \param a13 coefficient (1,3) of the matrix.
+ * \param a22 coefficient (2,2) of the matrix.
+ * \param a23 coefficient (2,3) of the matrix.
+ * \param a33 coefficient (3,3) of the matrix.
+ * \param lambda eigenvalues, by decreasing order.
+ *
+ * Trigonometric solution of the characteristic polynomial. Without branch so
+ * that it can be vectorized over a set of matrices.
+ *
+ */
+static inline
+void _MMG5_eigvalsym3(double a11,double a12,double a13,double a22,double a23,
+                      double a33,double lambda[3]) {
+  double q,b11,b22,b33,p,ip,r,c,s;
+
+  q   = (a11 + a22 + a33) / 3.0;
+  b11 = a11 - q;
+  b22 = a22 - q;
+  b33 = a33 - q;
+  p   = sqrt((b11*b11 + b22*b22 + b33*b33
+              + 2.0*(a12*a12 + a13*a13 + a23*a23)) / 6.0);
+  ip  = p > 0.0 ? 1.0 / p : 0.0;
+
+  /* r = det((A - q Id)/p) / 2 lies in [-1,1] up to round-off */
+  r   = b11*(b22*b33 - a23*a23) - a12*(a12*b33 - a23*a13)
+    + a13*(a12*a23 - b22*a13);
+  r  *= 0.5*ip*ip*ip;
+  r   = r < -1.0 ? -1.0 : ( r > 1.0 ? 1.0 : r );
+
+  /* phi in [0,pi/3]: cos(phi+2pi/3) = -cos(phi)/2 - sqrt(3)/2 sin(phi) */
+  c   = cos(acos(r) / 3.0);
+  s   = sqrt(1.0 - c*c);
+
+  lambda[0] = q + 2.0*p*c;
+  lambda[2] = q - p*(c + _MG_SQRT3*s);
+  lambda[1] = 3.0*q - lambda[0] - lambda[2];
+}
+
+/**
+ * \brief Eigenvalues and vectors of a symmetric 3x3 matrix by Jacobi method.
+ * \param a normalized symmetric matrix.
+ * \param lambda eigenvalues.
+ * \param v eigenvectors.
+ *
+ * Cyclic Jacobi rotations, used when two eigenvalues are too close for the
+ * eigenvectors to be accurately computed by cross products.
+ *
+ */
+static void _MMG5_jacobi3(double a[6],double lambda[3],double v[3][3]) {
+  double     m[3][3],theta,t,c,s,x,y;
+  int        it,l,i,p,q;
+  static int ip[3] = {0,0,1};
+  static int iq[3] = {1,2,2};
+
+  m[0][0] = a[0];  m[0][1] = a[1];  m[0][2] = a[2];
+  m[1][0] = a[1];  m[1][1] = a[3];  m[1][2] = a[4];
+  m[2][0] = a[2];  m[2][1] = a[4];  m[2][2] = a[5];
+  memcpy(v,Id,9*sizeof(double));
+
+  for (it=0; it<MAXTOU; it++) {
+    if ( m[0][1]*m[0][1]+m[0][2]*m[0][2]+m[1][2]*m[1][2] < _MG_EPSJ )  break;
+
+    for (l=0; l<3; l++) {
+      p = ip[l];
+      q = iq[l];
+      if ( fabs(m[p][q]) < _MG_EPSD )  continue;
+
+      theta = 0.5*(m[q][q] - m[p][p]) / m[p][q];
+      t     = 1.0 / (fabs(theta) + sqrt(theta*theta + 1.0));
+      if ( theta < 0.0 )  t = -t;
+      c     = 1.0 / sqrt(t*t + 1.0);
+      s     = t*c;
+
+      /* m <- J^t m J and v <- J^t v (eigenvectors are stored by rows) */
+      for (i=0; i<3; i++) {
+        x = m[i][p];
+        y = m[i][q];
+        m[i][p] = c*x - s*y;
+        m[i][q] = s*x + c*y;
+      }
+      for (i=0; i<3; i++) {
+        x = m[p][i];
+        y = m[q][i];
+        m[p][i] = c*x - s*y;
+        m[q][i] = s*x + c*y;
+        x = v[p][i];
+        y = v[q][i];
+        v[p][i] = c*x - s*y;
+        v[q][i] = s*x + c*y;
+      }
+    }
+  }
+  lambda[0] = m[0][0];
+  lambda[1] = m[1][1];
+  lambda[2] = m[2][2];
+}
+
+/**
+ * \brief Eigenvectors of a symmetric 3x3 matrix from its eigenvalues.
+ * \param a normalized symmetric matrix.
+ * \param lambda eigenvalues by decreasing order (computed by \ref
+ * _MMG5_eigvalsym3), refined here.
+ * \param v eigenvectors.
+ * \return 0 if the matrix is not finite, 1 otherwise.
+ *
+ * The eigenvector of the most isolated eigenvalue is the cross product of
+ * maximal norm of the rows of \f$A-\lambda Id\f$, the two others are the
+ * eigenvectors of the restriction of \a A to its orthogonal plane (2x2
+ * problem). Nearly triple eigenvalues are solved by the Jacobi method.
+ *
+ */
+static int _MMG5_eigvecsym3(double a[6],double lambda[3],double v[3][3]) {
+  double  r0[3],r1[3],r2[3],c[3][3],dd[3],u[3],w[3],au[3],aw[3];
+  double  b00,b01,b11,dd1,sqd,x,y;
+  int     j,l,k,k1,k2;
+
+  if ( !(isfinite(lambda[0]) && isfinite(lambda[2])) )  return(0);
+
+  if ( lambda[0]-lambda[2] < _MG_EIGGAP ) {
+    _MMG5_jacobi3(a,lambda,v);
+    return(1);
+  }
+
+  /* isolated eigenvalue */
+  if ( lambda[0]-lambda[1] > lambda[1]-lambda[2] ) {
+    k = 0;  k1 = 1;  k2 = 2;
+  }
+  else {
+    k = 2;  k1 = 0;  k2 = 1;
+  }
+
+  r0[0] = a[0] - lambda[k];  r0[1] = a[1];              r0[2] = a[2];
+  r1[0] = a[1];              r1[1] = a[3] - lambda[k];  r1[2] = a[4];
+  r2[0] = a[2];              r2[1] = a[4];              r2[2] = a[5] - lambda[k];
+
+  c[0][0] = r0[1]*r1[2] - r0[2]*r1[1];
+  c[0][1] = r0[2]*r1[0] - r0[0]*r1[2];
+  c[0][2] = r0[0]*r1[1] - r0[1]*r1[0];
+  c[1][0] = r0[1]*r2[2] - r0[2]*r2[1];
+  c[1][1] = r0[2]*r2[0] - r0[0]*r2[2];
+  c[1][2] = r0[0]*r2[1] - r0[1]*r2[0];
+  c[2][0] = r1[1]*r2[2] - r1[2]*r2[1];
+  c[2][1] = r1[2]*r2[0] - r1[0]*r2[2];
+  c[2][2] = r1[0]*r2[1] - r1[1]*r2[0];
+
+  /* find vector of max norm */
+  l = 0;
+  for (j=0; j<3; j++) {
+    dd[j] = c[j][0]*c[j][0] + c[j][1]*c[j][1] + c[j][2]*c[j][2];
+    if ( dd[j] > dd[l] )  l = j;
+  }
+  dd1 = 1.0 / sqrt(dd[l]);
+  v[k][0] = c[l][0] * dd1;
+  v[k][1] = c[l][1] * dd1;
+  v[k][2] = c[l][2] * dd1;
+
+  /* orthonormal basis (u,w) of the orthogonal plane */
+  if ( fabs(v[k][0]) < fabs(v[k][1]) ) {
+    dd1  = 1.0 / sqrt(v[k][1]*v[k][1] + v[k][2]*v[k][2]);
+    u[0] = 0.0;
+    u[1] = -v[k][2]*dd1;
+    u[2] =  v[k][1]*dd1;
+  }
+  else {
+    dd1  = 1.0 / sqrt(v[k][0]*v[k][0] + v[k][2]*v[k][2]);
+    u[0] =  v[k][2]*dd1;
+    u[1] = 0.0;
+    u[2] = -v[k][0]*dd1;
+  }
+  w[0] = v[k][1]*u[2] - v[k][2]*u[1];
+  w[1] = v[k][2]*u[0] - v[k][0]*u[2];
+  w[2] = v[k][0]*u[1] - v[k][1]*u[0];
+
+  /* restriction of a to the plane and its eigenvalues */
+  au[0] = a[0]*u[0] + a[1]*u[1] + a[2]*u[2];
+  au[1] = a[1]*u[0] + a[3]*u[1] + a[4]*u[2];
+  au[2] = a[2]*u[0] + a[4]*u[1] + a[5]*u[2];
+  aw[0] = a[0]*w[0] + a[1]*w[1] + a[2]*w[2];
+  aw[1] = a[1]*w[0] + a[3]*w[1] + a[4]*w[2];
+  aw[2] = a[2]*w[0] + a[4]*w[1] + a[5]*w[2];
+  b00 = u[0]*au[0] + u[1]*au[1] + u[2]*au[2];
+  b01 = u[0]*aw[0] + u[1]*aw[1] + u[2]*aw[2];
+  b11 = w[0]*aw[0] + w[1]*aw[1] + w[2]*aw[2];
+
+  sqd = sqrt((b00-b11)*(b00-b11) + 4.0*b01*b01);
+  lambda[k1] = 0.5*(b00 + b11 + sqd);
+  lambda[k2] = 0.5*(b00 + b11 - sqd);
+
+  /* eigenvector of the largest one in the (u,w) basis */
+  if ( sqd < _MG_EPSD ) {
+    x = 1.0;
+    y = 0.0;
+  }
+  else if ( b00 >= b11 ) {
+    x   = lambda[k1] - b11;
+    y   = b01;
+  }
+  else {
+    x   = b01;
+    y   = lambda[k1] - b00;
+  }
+  dd1 = 1.0 / sqrt(x*x + y*y);
+  x  *= dd1;
+  y  *= dd1;
+
+  v[k1][0] = x*u[0] + y*w[0];
+  v[k1][1] = x*u[1] + y*w[1];
+  v[k1][2] = x*u[2] + y*w[2];
+  v[k2][0] = x*w[0] - y*u[0];
+  v[k2][1] = x*w[1] - y*u[1];
+  v[k2][2] = x*w[2] - y*u[2];
+
+  return(1);
+}
+
+/**
+ * \brief Find eigenvalues and vectors of a symmetric 3x3 matrix.
+ * \param mat pointer toward the matrix (6 coefficients).
+ * \param lambda eigenvalues.
+ * \param v eigenvectors.
+ * \return 1 if success, 0 if fail.
+ *
+ */
+static int _MMG5_eigenvsym(double *mat,double lambda[3],double v[3][3]) {
+  double    a[6],maxm,maxd,valm,dd;
+  int       k;
+
+  /* default */
+  memcpy(v,Id,9*sizeof(double));
+  lambda[0] = mat[0];
+  lambda[1] = mat[3];
+  lambda[2] = mat[5];
+
+  maxm = fabs(mat[0]);
+  for (k=1; k<6; k++) {
+    valm = fabs(mat[k]);
+    if ( valm > maxm )  maxm = valm;
+  }
+  /* single float accuracy */
+  if ( maxm < _MG_EPS6 )  return(1);
+
+  /* diagonal matrix */
+  maxd = fabs(mat[1]);
+  valm = fabs(mat[2]);
+  if ( valm > maxd )  maxd = valm;
+  valm = fabs(mat[4]);
+  if ( valm > maxd )  maxd = valm;
+  if ( maxd < _MG_EPSD*maxm )  return(1);
+
+  /* normalize matrix */
+  dd = 1.0 / maxm;
+  for (k=0; k<6; k++)
+    a[k] = mat[k]*dd;
+
+  _MMG5_eigvalsym3(a[0],a[1],a[2],a[3],a[4],a[5],lambda);
+  if ( !_MMG5_eigvecsym3(a,lambda,v) )  return(0);
+
+  lambda[0] *= maxm;
+  lambda[1] *= maxm;
+  lambda[2] *= maxm;
+
+  return(1);
+}
+
 /**
  * \brief Find eigenvalues and vectors of a 3x3 matrix.
  * \param symmat 0 if matrix is not symetric, 1 otherwise.
@@ -254,6 +528,9 @@ static int newton3(double p[4],double x[3]) {
  * \param lambda eigenvalues.
  * \param v eigenvectors.
  * \return order of eigenvalues (1,2,3) or 0 if failed.
+ *
+ * Symmetric matrices are solved in closed form (see \ref _MMG5_eigenvsym) and
+ * the function then returns 1 if success.
  */
 int _MMG5_eigenv(int symmat,double *mat,double lambda[3],double v[3][3]) {
   double    a11,a12,a13,a21,a22,a23,a31,a32,a33;
@@ -261,104 +538,59 @@ int _MMG5_eigenv(int symmat,double *mat,double lambda[3],double v[3][3]) {
   double    maxd,maxm,valm,p[4],w1[3],w2[3],w3[3];
   int       k,n;
 
+  if ( symmat )  return(_MMG5_eigenvsym(mat,lambda,v));
+
   /* default */
   memcpy(v,Id,9*sizeof(double));
-  if ( symmat ) {
-    lambda[0] = (double)mat[0];
-    lambda[1] = (double)mat[3];
-    lambda[2] = (double)mat[5];
-
-    maxm = fabs(mat[0]);
-    for (k=1; k<6; k++) {
-      valm = fabs(mat[k]);
-      if ( valm > maxm )  maxm = valm;
-    }
-    /* single float accuracy */
-    if ( maxm < _MG_EPS6 )  return(1);
-
-    /* normalize matrix */
-    dd  = 1.0 / maxm;
-    a11 = mat[0] * dd;
-    a12 = mat[1] * dd;
-    a13 = mat[2] * dd;
-    a22 = mat[3] * dd;
-    a23 = mat[4] * dd;
-    a33 = mat[5] * dd;
-
-    /* diagonal matrix */
-    maxd = fabs(a12);
-    valm = fabs(a13);
-    if ( valm > maxd )  maxd = valm;
-    valm = fabs(a23);
-    if ( valm > maxd )  maxd = valm;
-    if ( maxd < _MG_EPSD )  return(1);
-
-    a21  = a12;
-    a31  = a13;
-    a32  = a23;
-
-    /* build characteristic polynomial
-       P(X) = X^3 - trace X^2 + (somme des mineurs)X - det = 0 */
-    aa = a11*a22;
-    bb = a23*a32;
-    cc = a12*a21;
-    dd = a13*a31;
-    p[0] =  a11*bb + a33*(cc-aa) + a22*dd -2.0*a12*a13*a23;
-    p[1] =  a11*(a22 + a33) + a22*a33 - bb - cc - dd;
-    p[2] = -a11 - a22 - a33;
-    p[3] =  1.0;
-  }
-  else {
-    lambda[0] = (double)mat[0];
-    lambda[1] = (double)mat[4];
-    lambda[2] = (double)mat[8];
-
-    maxm = fabs(mat[0]);
-    for (k=1; k<9; k++) {
-      valm = fabs(mat[k]);
-      if ( valm > maxm )  maxm = valm;
-    }
-    if ( maxm < _MG_EPS6 )  return(1);
-
-    /* normalize matrix */
-    dd  = 1.0 / maxm;
-    a11 = mat[0] * dd;
-    a12 = mat[1] * dd;
-    a13 = mat[2] * dd;
-    a21 = mat[3] * dd;
-    a22 = mat[4] * dd;
-    a23 = mat[5] * dd;
-    a31 = mat[6] * dd;
-    a32 = mat[7] * dd;
-    a33 = mat[8] * dd;
-
-    /* diagonal matrix */
-    maxd = fabs(a12);
-    valm = fabs(a13);
-    if ( valm > maxd )  maxd = valm;
-    valm = fabs(a23);
-    if ( valm > maxd )  maxd = valm;
-    valm = fabs(a21);
-    if ( valm > maxd )  maxd = valm;
-    valm = fabs(a31);
-    if ( valm > maxd )  maxd = valm;
-    valm = fabs(a32);
-    if ( valm > maxd )  maxd = valm;
-    if ( maxd < _MG_EPSD )  return(1);
-
-    /* build characteristic polynomial
-       P(X) = X^3 - trace X^2 + (somme des mineurs)X - det = 0 */
-    aa = a22*a33 - a23*a32;
-    bb = a23*a31 - a21*a33;
-    cc = a21*a32 - a31*a22;
-    ee = a11*a33 - a13*a31;
-    ii = a11*a22 - a12*a21;
-
-    p[0] =  -a11*aa - a12*bb - a13*cc;
-    p[1] =  aa + ee + ii;
-    p[2] = -a11 - a22 - a33;
-    p[3] =  1.0;
+  lambda[0] = (double)mat[0];
+  lambda[1] = (double)mat[4];
+  lambda[2] = (double)mat[8];
+
+  maxm = fabs(mat[0]);
+  for (k=1; k<9; k++) {
+    valm = fabs(mat[k]);
+    if ( valm > maxm )  maxm = valm;
   }
+  if ( maxm < _MG_EPS6 )  return(1);
+
+  /* normalize matrix */
+  dd  = 1.0 / maxm;
+  a11 = mat[0] * dd;
+  a12 = mat[1] * dd;
+  a13 = mat[2] * dd;
+  a21 = mat[3] * dd;
+  a22 = mat[4] * dd;
+  a23 = mat[5] * dd;
+  a31 = mat[6] * dd;
+  a32 = mat[7] * dd;
+  a33 = mat[8] * dd;
+
+  /* diagonal matrix */
+  maxd = fabs(a12);
+  valm = fabs(a13);
+  if ( valm > maxd )  maxd = valm;
+  valm = fabs(a23);
+  if ( valm > maxd )  maxd = valm;
+  valm = fabs(a21);
+  if ( valm > maxd )  maxd = valm;
+  valm = fabs(a31);
+  if ( valm > maxd )  maxd = valm;
+  valm = fabs(a32);
+  if ( valm > maxd )  maxd = valm;
+  if ( maxd < _MG_EPSD )  return(1);
+
+  /* build characteristic polynomial
+     P(X) = X^3 - trace X^2 + (somme des mineurs)X - det = 0 */
+  aa = a22*a33 - a23*a32;
+  bb = a23*a31 - a21*a33;
+  cc = a21*a32 - a31*a22;
+  ee = a11*a33 - a13*a31;
+  ii = a11*a22 - a12*a21;
+
+  p[0] =  -a11*aa - a12*bb - a13*cc;
+  p[1] =  aa + ee + ii;
+  p[2] = -a11 - a22 - a33;
+  p[3] =  1.0;
 
   /* solve polynomial (find roots using newton) */
   n = newton3(p,lambda);
@@ -572,6 +804,81 @@ int _MMG5_eigenv(int symmat,double *mat,double lambda[3],double v[3][3]) {
   return(n);
 }
 
+/**
+ * \brief Find eigenvalues and vectors of a set of symmetric 3x3 matrices.
+ * \param n number of matrices.
+ * \param mat array of pointers toward the matrices (6 coefficients each).
+ * \param lambda eigenvalues (\a lambda[i] for the matrix \a mat[i]).
+ * \param v eigenvectors (\a v[i] for the matrix \a mat[i]).
+ * \return 1 if success, 0 if one of the decompositions fails.
+ *
+ * Batched version of \ref _MMG5_eigenv for symmetric matrices: matrices are
+ * gathered by blocks of _MG_EIGBLOC so that the closed-form computation of the
+ * eigenvalues is vectorized, eigenvectors are then computed matrix per matrix.
+ *
+ */
+int _MMG5_eigenvBatch(int n,double **mat,double (*lambda)[3],
+                      double (*v)[3][3]) {
+  double    a[6][_MG_EIGBLOC],lv[3][_MG_EIGBLOC],maxm[_MG_EIGBLOC];
+  double    b[6],lb[3],mx,maxd,dd;
+  int       i0,nb,i,k,ier;
+
+  ier = 1;
+  for (i0=0; i0<n; i0+=_MG_EIGBLOC) {
+    nb = n-i0 < _MG_EIGBLOC ? n-i0 : _MG_EIGBLOC;
+
+    /* gather, normalize and compute the eigenvalues */
+#if defined(_OPENMP) && _OPENMP >= 201307
+#pragma omp simd private(b,lb,mx,dd,k)
+#endif
+    for (i=0; i<nb; i++) {
+      mx = 0.0;
+      for (k=0; k<6; k++) {
+        b[k] = mat[i0+i][k];
+        mx   = fabs(b[k]) > mx ? fabs(b[k]) : mx;
+      }
+      maxm[i] = mx;
+      dd = mx > 0.0 ? 1.0 / mx : 0.0;
+      for (k=0; k<6; k++)
+        a[k][i] = b[k]*dd;
+
+      _MMG5_eigvalsym3(a[0][i],a[1][i],a[2][i],a[3][i],a[4][i],a[5][i],lb);
+      lv[0][i] = lb[0];
+      lv[1][i] = lb[1];
+      lv[2][i] = lb[2];
+    }
+
+    /* eigenvectors */
+    for (i=0; i<nb; i++) {
+      memcpy(v[i0+i],Id,9*sizeof(double));
+      lambda[i0+i][0] = mat[i0+i][0];
+      lambda[i0+i][1] = mat[i0+i][3];
+      lambda[i0+i][2] = mat[i0+i][5];
+
+      /* single float accuracy or diagonal matrix */
+      if ( maxm[i] < _MG_EPS6 )  continue;
+      maxd = fabs(a[1][i]);
+      if ( fabs(a[2][i]) > maxd )  maxd = fabs(a[2][i]);
+      if ( fabs(a[4][i]) > maxd )  maxd = fabs(a[4][i]);
+      if ( maxd < _MG_EPSD )  continue;
+
+      for (k=0; k<6; k++)
+        b[k] = a[k][i];
+      lambda[i0+i][0] = lv[0][i];
+      lambda[i0+i][1] = lv[1][i];
+      lambda[i0+i][2] = lv[2][i];
+      if ( !_MMG5_eigvecsym3(b,lambda[i0+i],v[i0+i]) ) {
+        ier = 0;
+        continue;
+      }
+      lambda[i0+i][0] *= maxm[i];
+      lambda[i0+i][1] *= maxm[i];
+      lambda[i0+i][2] *= maxm[i];
+    }
+  }
+  return(ier);
+}
+
 /**
  * \brief Find eigenvalues and vectors of a 2x2 matrix.
  * \param mm pointer toward the matrix.
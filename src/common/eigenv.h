@@ -30,8 +30,11 @@ extern "C" {
 
 #define _MMG5_EPSD      1.e-30
 #define _MMG5_EPS       1.e-06
+#define _MMG5_EIGBATCH  64 /**< size of the batches for _MMG5_eigenvBatch */
 
 int _MMG5_eigenv(int symmat,double *mat,double lambda[3],double v[3][3]);
+int _MMG5_eigenvBatch(int n,double **mat,double (*lambda)[3],
+                      double (*v)[3][3]);
 int _MMG5_eigen2(double *mm,double *lambda,double vp[2][2]);
 extern int _MMG5_eigensym(double m[3],double lambda[2],double vp[2][2]);
 
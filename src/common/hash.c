@@ -50,20 +50,11 @@
 int _MMG5_mmgHashTria(MMG5_pMesh mesh, int *adjt, _MMG5_Hash *hash, int chkISO) {
   MMG5_pTria     pt,pt1;
   _MMG5_hedge    *ph;
-  int            *adja,k,jel,lel,hmax,dup,nmf,ia,ib;
-  char           i,i1,i2,j,l,ok;
-  unsigned int   key;
+  int            *adja,k,jel,lel,dup,nmf,ia,ib,key;
+  char           i,i1,i2,j,l;
 
-  /* adjust hash table params */
-  hmax = 3.71*mesh->np;
-  hash->siz  = mesh->np;
-  hash->max  = hmax + 1;
-  hash->nxt  = hash->siz;
-  _MMG5_ADD_MEM(mesh,(hash->max+1)*sizeof(_MMG5_hedge),"hash table",return(0));
-  _MMG5_SAFE_CALLOC(hash->item,hash->max+1,_MMG5_hedge);
-
-  for (k=hash->siz; k<hash->max; k++)
-    hash->item[k].nxt = k+1;
+  /* adjust hash table params: about 3/2 edges per point */
+  if ( !_MMG5_hashNew(mesh,hash,3*mesh->np/2+1) )  return(0);
 
   if ( mesh->info.ddebug )  fprintf(stdout,"  h- stage 1: init\n");
 
@@ -84,73 +75,59 @@ int _MMG5_mmgHashTria(MMG5_pMesh mesh, int *adjt, _MMG5_Hash *hash, int chkISO)
       /* compute key */
       ia  = MG_MIN(pt->v[i1],pt->v[i2]);
       ib  = MG_MAX(pt->v[i1],pt->v[i2]);
-      key = (_MMG5_KA*ia + _MMG5_KB*ib) % hash->siz;
+
+      if ( 2*(hash->nxt+1) > hash->siz && !_MMG5_hashGrow(mesh,hash) )
+        return(0);
+
+      key = _MMG5_hashSlot(ia,ib,hash->max);
       ph  = &hash->item[key];
+      while ( ph->a && (ph->a != ia || ph->b != ib) ) {
+        key = (key+1) & hash->max;
+        ph  = &hash->item[key];
+      }
 
       /* store edge */
-      if ( ph->a == 0 ) {
+      if ( !ph->a ) {
         ph->a = ia;
         ph->b = ib;
         ph->k = 3*k + i;
-        ph->nxt = 0;
-        ++ph->s;
+        ph->s = 1;
+        ++hash->nxt;
         continue;
       }
+
       /* update info about adjacent */
-      ok = 0;
-      while ( ph->a ) {
-        if ( ph->a == ia && ph->b == ib ) {
-          jel = ph->k / 3;
-          j   = ph->k % 3;
-          pt1 = &mesh->tria[jel];
-          /* discard duplicate face */
-          if ( pt1->v[j] == pt->v[i] ) {
-            pt1->v[0] = 0;
-            dup++;
-          }
-          /* update adjacent */
-          else if ( !adjt[3*(jel-1)+1+j] ) {
-            adja[i] = 3*jel + j;
-            adjt[3*(jel-1)+1+j] = 3*k + i;
-            ++ph->s;
-          }
-          /* non-manifold case */
-          else if ( adja[i] != 3*jel+j ) {
-            if ( chkISO && ( (pt->ref == MG_ISO) || (pt->ref < 0)) ) {
-              lel = adjt[3*(jel-1)+1+j]/3;
-              l   = adjt[3*(jel-1)+1+j]%3;
-              adjt[3*(lel-1)+1+l] = 0;
-              adja[i] = 3*jel+j;
-              adjt[3*(jel-1)+1+j] = 3*k + i;
-              (mesh->tria[lel]).tag[l] |= MG_GEO + MG_NOM;
-            }
-            else {
-              pt1->tag[j] |= MG_GEO + MG_NOM;
-            }
-            pt->tag[i] |= MG_GEO + MG_NOM;
-            nmf++;
-            ++ph->s;
-          }
-          ok = 1;
-          break;
+      jel = ph->k / 3;
+      j   = ph->k % 3;
+      pt1 = &mesh->tria[jel];
+      /* discard duplicate face */
+      if ( pt1->v[j] == pt->v[i] ) {
+        pt1->v[0] = 0;
+        dup++;
+      }
+      /* update adjacent */
+      else if ( !adjt[3*(jel-1)+1+j] ) {
+        adja[i] = 3*jel + j;
+        adjt[3*(jel-1)+1+j] = 3*k + i;
+        ++ph->s;
+      }
+      /* non-manifold case */
+      else if ( adja[i] != 3*jel+j ) {
+        if ( chkISO && ( (pt->ref == MG_ISO) || (pt->ref < 0)) ) {
+          lel = adjt[3*(jel-1)+1+j]/3;
+          l   = adjt[3*(jel-1)+1+j]%3;
+          adjt[3*(lel-1)+1+l] = 0;
+          adja[i] = 3*jel+j;
+          adjt[3*(jel-1)+1+j] = 3*k + i;
+          (mesh->tria[lel]).tag[l] |= MG_GEO + MG_NOM;
         }
-        else if ( !ph->nxt ) {
-          ph->nxt = hash->nxt;
-          ph = &hash->item[ph->nxt];
-          assert(ph);
-          hash->nxt = ph->nxt;
-          ph->a = ia;
-          ph->b = ib;
-          ph->k = 3*k + i;
-          ph->nxt = 0;
-          ++ph->s;
-          ok = 1;
-          break;
+        else {
+          pt1->tag[j] |= MG_GEO + MG_NOM;
         }
-        else
-          ph = &hash->item[ph->nxt];
+        pt->tag[i] |= MG_GEO + MG_NOM;
+        nmf++;
+        ++ph->s;
       }
-      assert(ok);
     }
   }
 
@@ -188,41 +165,30 @@ int _MMG5_mmgHashTria(MMG5_pMesh mesh, int *adjt, _MMG5_Hash *hash, int chkISO)
  */
 int _MMG5_hashEdge(MMG5_pMesh mesh,_MMG5_Hash *hash, int a,int b,int k) {
   _MMG5_hedge  *ph;
-  int          key,ia,ib,j;
+  int          key,ia,ib;
 
   ia  = MG_MIN(a,b);
   ib  = MG_MAX(a,b);
-  key = (_MMG5_KA*ia + _MMG5_KB*ib) % hash->siz;
-  ph  = &hash->item[key];
 
-  if ( ph->a == ia && ph->b == ib )
-    return(1);
-  else if ( ph->a ) {
-    while ( ph->nxt && ph->nxt < hash->max ) {
-      ph = &hash->item[ph->nxt];
-      if ( ph->a == ia && ph->b == ib )  return(1);
-    }
-    ph->nxt   = hash->nxt;
-    ph        = &hash->item[hash->nxt];
-
-    if ( hash->nxt >= hash->max-1 ) {
-      if ( mesh->info.ddebug )
-        fprintf(stdout,"  ## Memory alloc problem (edge): %d\n",hash->max);
-      _MMG5_TAB_RECALLOC(mesh,hash->item,hash->max,0.2,_MMG5_hedge,
-                         "_MMG5_edge",return(0));
-      /* ph pointer may be false after realloc */
-      ph        = &hash->item[hash->nxt];
-
-      for (j=ph->nxt; j<hash->max; j++)  hash->item[j].nxt = j+1;
-    }
-    hash->nxt = ph->nxt;
+  if ( 2*(hash->nxt+1) > hash->siz && !_MMG5_hashGrow(mesh,hash) ) {
+    if ( mesh->info.ddebug )
+      fprintf(stdout,"  ## Memory alloc problem (edge): %d\n",hash->siz);
+    return(0);
+  }
+
+  key = _MMG5_hashSlot(ia,ib,hash->max);
+  ph  = &hash->item[key];
+  while ( ph->a ) {
+    if ( ph->a == ia && ph->b == ib )  return(1);
+    key = (key+1) & hash->max;
+    ph  = &hash->item[key];
   }
 
   /* insert new edge */
   ph->a = ia;
   ph->b = ib;
   ph->k = k;
-  ph->nxt = 0;
+  ++hash->nxt;
 
   return(1);
 }
@@ -242,42 +208,115 @@ int _MMG5_hashGet(_MMG5_Hash *hash,int a,int b) {
 
   ia  = MG_MIN(a,b);
   ib  = MG_MAX(a,b);
-  key = (_MMG5_KA*ia + _MMG5_KB*ib) % hash->siz;
+  key = _MMG5_hashSlot(ia,ib,hash->max);
   ph  = &hash->item[key];
 
-  if ( !ph->a )  return(0);
-  if ( ph->a == ia && ph->b == ib )  return(ph->k);
-  while ( ph->nxt ) {
-    ph = &hash->item[ph->nxt];
+  while ( ph->a ) {
     if ( ph->a == ia && ph->b == ib )  return(ph->k);
+    key = (key+1) & hash->max;
+    ph  = &hash->item[key];
   }
   return(0);
 }
 
+/**
+ * \param hash pointer toward the hash table of edges.
+ * \param a index of the first extremity of the edge.
+ * \param b index of the second extremity of the edge.
+ * \return 1 if the edge has been removed, 0 if it is not in the table.
+ *
+ * Remove edge \f$[a;b]\f$ from the hash table. The following items of the
+ * probe sequence are shifted backward so that no tombstone is needed.
+ *
+ */
+int _MMG5_hashPop(_MMG5_Hash *hash,int a,int b) {
+  _MMG5_hedge  *ph;
+  int          key,ia,ib,i,h;
+
+  ia  = MG_MIN(a,b);
+  ib  = MG_MAX(a,b);
+  key = _MMG5_hashSlot(ia,ib,hash->max);
+  ph  = &hash->item[key];
+
+  while ( ph->a && (ph->a != ia || ph->b != ib) ) {
+    key = (key+1) & hash->max;
+    ph  = &hash->item[key];
+  }
+  if ( !ph->a )  return(0);
+
+  /* backward shift deletion */
+  i = key;
+  while ( 1 ) {
+    key = (key+1) & hash->max;
+    ph  = &hash->item[key];
+    if ( !ph->a )  break;
+    h = _MMG5_hashSlot(ph->a,ph->b,hash->max);
+    /* the item may move to i if its home slot is not in ]i,key] */
+    if ( ((key-h) & hash->max) >= ((key-i) & hash->max) ) {
+      hash->item[i] = *ph;
+      i = key;
+    }
+  }
+  memset(&hash->item[i],0,sizeof(_MMG5_hedge));
+  --hash->nxt;
+
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param hash pointer toward the hash table of edges.
+ * \return 1 if success, 0 if fail (the table is left unchanged).
+ *
+ * Double the number of slots of the hash table and reinsert the stored items.
+ *
+ */
+int _MMG5_hashGrow(MMG5_pMesh mesh,_MMG5_Hash *hash) {
+  _MMG5_hedge  *item,*ph;
+  int          k,key,siz;
+
+  siz = 2*hash->siz;
+  _MMG5_ADD_MEM(mesh,siz*sizeof(_MMG5_hedge),"larger hash table",return(0));
+  _MMG5_SAFE_CALLOC(item,siz,_MMG5_hedge);
+
+  for (k=0; k<hash->siz; k++) {
+    if ( !hash->item[k].a )  continue;
+    key = _MMG5_hashSlot(hash->item[k].a,hash->item[k].b,siz-1);
+    ph  = &item[key];
+    while ( ph->a ) {
+      key = (key+1) & (siz-1);
+      ph  = &item[key];
+    }
+    *ph = hash->item[k];
+  }
+  _MMG5_DEL_MEM(mesh,hash->item,hash->siz*sizeof(_MMG5_hedge));
+
+  hash->item = item;
+  hash->siz  = siz;
+  hash->max  = siz-1;
+
+  return(1);
+}
+
 /**
  * \param mesh pointer toward the mesh structure.
  * \param hash pointer toward the hash table of edges.
- * \param hsiz initial size of hash table.
- * \param hmax maximal size of hash table.
+ * \param hsiz expected number of items (the table grows if needed).
  * \return 1 if success.
  *
  * Hash edges or faces.
  *
  */
-int _MMG5_hashNew(MMG5_pMesh mesh,_MMG5_Hash *hash,int hsiz,int hmax) {
-  int   k;
+int _MMG5_hashNew(MMG5_pMesh mesh,_MMG5_Hash *hash,int hsiz) {
 
   /* adjust hash table params */
-  hash->siz  = hsiz;
-  hash->max  = hmax + 1;
-  hash->nxt  = hsiz;
+  hash->siz  = _MMG5_hashSiz(hsiz);
+  hash->max  = hash->siz - 1;
+  hash->nxt  = 0;
 
   _MMG5_ADD_MEM(mesh,(hash->max+1)*sizeof(_MMG5_hedge),"hash table",
                 return(0));
-  _MMG5_SAFE_CALLOC(hash->item,hmax+2,_MMG5_hedge);
-
-  for (k=hsiz; k<hash->max; k++)
-    hash->item[k].nxt = k+1;
+  _MMG5_SAFE_CALLOC(hash->item,hash->siz,_MMG5_hedge);
 
   return(1);
 }
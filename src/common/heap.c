@@ -0,0 +1,205 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Bx INP/Inria/UBordeaux/UPMC, 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file common/heap.c
+ * \brief Indexed binary heap used to process entities by increasing key.
+ * \author Charles Dapogny (UPMC)
+ * \author Cécile Dobrzynski (Bx INP/Inria/UBordeaux)
+ * \author Pascal Frey (UPMC)
+ * \author Algiane Froehly (Inria/UBordeaux)
+ * \version 5
+ * \copyright GNU Lesser General Public License.
+ */
+
+#include "mmgcommon.h"
+
+/**
+ * \param heap pointer toward the heap.
+ * \param i position of the item to move.
+ *
+ * Move up the item at position \a i until the heap property is restored.
+ *
+ */
+static inline
+void _MMG5_heapUp(_MMG5_Heap *heap,int i) {
+  int    k,ip;
+  double key;
+
+  k   = heap->item[i];
+  key = heap->key[k];
+  while ( i > 1 ) {
+    ip = i >> 1;
+    if ( heap->key[heap->item[ip]] <= key ) break;
+    heap->item[i] = heap->item[ip];
+    heap->pos[heap->item[i]] = i;
+    i = ip;
+  }
+  heap->item[i] = k;
+  heap->pos[k]  = i;
+}
+
+/**
+ * \param heap pointer toward the heap.
+ * \param i position of the item to move.
+ *
+ * Move down the item at position \a i until the heap property is restored.
+ *
+ */
+static inline
+void _MMG5_heapDown(_MMG5_Heap *heap,int i) {
+  int    k,ic;
+  double key;
+
+  k   = heap->item[i];
+  key = heap->key[k];
+  while ( (ic = i << 1) <= heap->n ) {
+    if ( ic < heap->n && heap->key[heap->item[ic+1]] < heap->key[heap->item[ic]] )
+      ic++;
+    if ( key <= heap->key[heap->item[ic]] ) break;
+    heap->item[i] = heap->item[ic];
+    heap->pos[heap->item[i]] = i;
+    i = ic;
+  }
+  heap->item[i] = k;
+  heap->pos[k]  = i;
+}
+
+/**
+ * \param mesh pointer toward the mesh structure (for memory count).
+ * \param heap pointer toward the heap.
+ * \param siz maximal index of the entities stored in the heap.
+ * \return 1 if success, 0 if fail.
+ *
+ * Allocate an empty heap able to store the entities \f$1..siz\f$.
+ *
+ */
+int _MMG5_heapNew(MMG5_pMesh mesh,_MMG5_Heap *heap,int siz) {
+
+  heap->siz = siz;
+  heap->n   = 0;
+  _MMG5_ADD_MEM(mesh,(2*sizeof(int)+sizeof(double))*(siz+1),"heap",
+                return(0));
+  _MMG5_SAFE_MALLOC(heap->item,siz+1,int);
+  _MMG5_SAFE_CALLOC(heap->pos,siz+1,int);
+  _MMG5_SAFE_MALLOC(heap->key,siz+1,double);
+
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure (for memory count).
+ * \param heap pointer toward the heap.
+ *
+ * Free the heap arrays.
+ *
+ */
+void _MMG5_heapFree(MMG5_pMesh mesh,_MMG5_Heap *heap) {
+
+  _MMG5_DEL_MEM(mesh,heap->item,(heap->siz+1)*sizeof(int));
+  _MMG5_DEL_MEM(mesh,heap->pos,(heap->siz+1)*sizeof(int));
+  _MMG5_DEL_MEM(mesh,heap->key,(heap->siz+1)*sizeof(double));
+  heap->siz = heap->n = 0;
+}
+
+/**
+ * \param heap pointer toward the heap.
+ * \param k index of the entity.
+ * \param key new key of the entity.
+ *
+ * Insert entity \a k with key \a key in the heap or, if \a k is already
+ * stored, update its key (decrease-key or increase-key).
+ *
+ */
+void _MMG5_heapPush(_MMG5_Heap *heap,int k,double key) {
+  int    i;
+  double old;
+
+  assert ( k > 0 && k <= heap->siz );
+
+  i = heap->pos[k];
+  if ( !i ) {
+    heap->key[k] = key;
+    heap->item[++heap->n] = k;
+    heap->pos[k] = heap->n;
+    _MMG5_heapUp(heap,heap->n);
+    return;
+  }
+
+  old = heap->key[k];
+  heap->key[k] = key;
+  if ( key < old )
+    _MMG5_heapUp(heap,i);
+  else if ( key > old )
+    _MMG5_heapDown(heap,i);
+}
+
+/**
+ * \param heap pointer toward the heap.
+ * \return the index of the entity with the smallest key, 0 if heap is empty.
+ *
+ * Remove the entity with the smallest key from the heap.
+ *
+ */
+int _MMG5_heapPop(_MMG5_Heap *heap) {
+  int k;
+
+  if ( !heap->n ) return(0);
+
+  k = heap->item[1];
+  heap->pos[k] = 0;
+
+  if ( --heap->n ) {
+    heap->item[1] = heap->item[heap->n+1];
+    heap->pos[heap->item[1]] = 1;
+    _MMG5_heapDown(heap,1);
+  }
+  return(k);
+}
+
+/**
+ * \param heap pointer toward the heap.
+ * \param k index of the entity to remove.
+ *
+ * Remove entity \a k from the heap (nothing is done if \a k is not stored).
+ *
+ */
+void _MMG5_heapDel(_MMG5_Heap *heap,int k) {
+  int    i,kl;
+  double key;
+
+  i = heap->pos[k];
+  if ( !i ) return;
+
+  heap->pos[k] = 0;
+  kl = heap->item[heap->n--];
+  if ( i > heap->n ) return;
+
+  key = heap->key[kl];
+  heap->item[i] = kl;
+  heap->pos[kl] = i;
+  if ( i > 1 && key < heap->key[heap->item[i>>1]] )
+    _MMG5_heapUp(heap,i);
+  else
+    _MMG5_heapDown(heap,i);
+}
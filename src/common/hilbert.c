@@ -0,0 +1,169 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Bx INP/Inria/UBordeaux/UPMC, 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file common/hilbert.c
+ * \brief Biased randomized insertion order (BRIO) along a Hilbert curve.
+ * \author Charles Dapogny (UPMC)
+ * \author Cécile Dobrzynski (Bx INP/Inria/UBordeaux)
+ * \author Pascal Frey (UPMC)
+ * \author Algiane Froehly (Inria/UBordeaux)
+ * \version 5
+ * \copyright GNU Lesser General Public License.
+ */
+
+#include "mmgcommon.h"
+
+/** Number of BRIO rounds */
+#define _MMG5_BRIORND  6
+
+typedef struct {
+  unsigned long long key; /*!< round (high bits) and Hilbert index */
+  int                idx; /*!< entity index */
+} _MMG5_Hilb;
+
+/**
+ * \param X integer coordinates (overwritten).
+ * \param dim space dimension (2 or 3).
+ * \param b number of bits per coordinate.
+ * \return the Hilbert index of \a X.
+ *
+ * Compute the Hilbert index of a point of the \f$ 2^b \f$ grid (transposed
+ * form of J. Skilling, "Programming the Hilbert curve", 2004).
+ *
+ */
+static inline
+unsigned long long _MMG5_hilbertKey(unsigned int X[3],int dim,int b) {
+  unsigned long long key;
+  unsigned int       M,P,Q,t;
+  int                i,j;
+
+  M = 1u << (b-1);
+
+  /* inverse undo */
+  for (Q=M; Q>1; Q>>=1) {
+    P = Q-1;
+    for (i=0; i<dim; i++) {
+      if ( X[i] & Q )  X[0] ^= P;
+      else {
+        t = (X[0] ^ X[i]) & P;
+        X[0] ^= t;
+        X[i] ^= t;
+      }
+    }
+  }
+  /* Gray encode */
+  for (i=1; i<dim; i++)  X[i] ^= X[i-1];
+  t = 0;
+  for (Q=M; Q>1; Q>>=1)
+    if ( X[dim-1] & Q )  t ^= Q-1;
+  for (i=0; i<dim; i++)  X[i] ^= t;
+
+  /* interleave the transposed bits */
+  key = 0;
+  for (j=b-1; j>=0; j--)
+    for (i=0; i<dim; i++)
+      key = (key << 1) | ((X[i] >> j) & 1);
+
+  return(key);
+}
+
+static int _MMG5_hilbCompare(const void *a,const void *b) {
+  const _MMG5_Hilb *pa = (const _MMG5_Hilb*)a;
+  const _MMG5_Hilb *pb = (const _MMG5_Hilb*)b;
+
+  if ( pa->key < pb->key )  return(-1);
+  if ( pa->key > pb->key )  return(1);
+  return(pa->idx - pb->idx);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure (memory accounting).
+ * \param n number of entities to order.
+ * \param dim space dimension (2 or 3).
+ * \param c coordinates of the entities (\a dim values per entity).
+ * \param idx entity indices, reordered in place.
+ * \return 1 if success, 0 if fail.
+ *
+ * Sort the entities \a idx following a biased randomized insertion order:
+ * entities are dispatched in rounds of geometrically increasing size (the
+ * round of an entity only depends on its index so the ordering is
+ * reproducible) and sorted along a Hilbert curve inside each round. The
+ * first rounds spread over the whole domain while the last ones, that
+ * contain most of the entities, are processed with a good spatial locality.
+ *
+ */
+int _MMG5_brioSort(MMG5_pMesh mesh,int n,int dim,double *c,int *idx) {
+  _MMG5_Hilb         *hilb;
+  double             min[3],max[3],dd;
+  unsigned int       X[3],h;
+  int                i,k,b,r;
+
+  if ( n < 2 )  return(1);
+  assert ( dim == 2 || dim == 3 );
+
+  _MMG5_ADD_MEM(mesh,n*sizeof(_MMG5_Hilb),"hilbert keys",return(0));
+  _MMG5_SAFE_MALLOC(hilb,n,_MMG5_Hilb);
+
+  for (i=0; i<dim; i++) {
+    min[i] =  DBL_MAX;
+    max[i] = -DBL_MAX;
+  }
+  for (k=0; k<n; k++) {
+    for (i=0; i<dim; i++) {
+      min[i] = MG_MIN(min[i],c[dim*k+i]);
+      max[i] = MG_MAX(max[i],c[dim*k+i]);
+    }
+  }
+  dd = 0.;
+  for (i=0; i<dim; i++)  dd = MG_MAX(dd,max[i]-min[i]);
+  if ( dd < _MMG5_EPSD )  dd = 1.;
+
+  /* 3 bits are kept for the round */
+  b  = (dim == 3) ? 20 : 30;
+  dd = ((double)((1u << b) - 1)) / dd;
+
+#pragma omp parallel for private(i,X,h,r)
+  for (k=0; k<n; k++) {
+    for (i=0; i<dim; i++)
+      X[i] = (unsigned int)((c[dim*k+i]-min[i])*dd);
+
+    /* round: each entity goes one round earlier with probability 1/2 */
+    h  = (unsigned int)idx[k]*2654435761u;
+    h ^= h >> 15;
+    r  = _MMG5_BRIORND-1;
+    while ( r > 0 && (h & 1) ) {
+      r--;
+      h >>= 1;
+    }
+    hilb[k].key = ((unsigned long long)r << (dim*b)) | _MMG5_hilbertKey(X,dim,b);
+    hilb[k].idx = idx[k];
+  }
+
+  qsort(hilb,n,sizeof(_MMG5_Hilb),_MMG5_hilbCompare);
+
+  for (k=0; k<n; k++)  idx[k] = hilb[k].idx;
+
+  _MMG5_DEL_MEM(mesh,hilb,n*sizeof(_MMG5_Hilb));
+  return(1);
+}
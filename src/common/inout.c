@@ -0,0 +1,519 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Bx INP/Inria/UBordeaux/UPMC, 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file common/inout.c
+ * \brief Buffered readers and writers shared by the mesh and solution files.
+ * \author Charles Dapogny (UPMC)
+ * \author Cécile Dobrzynski (Bx INP/Inria/UBordeaux)
+ * \author Pascal Frey (UPMC)
+ * \author Algiane Froehly (Inria/UBordeaux)
+ * \version 5
+ * \copyright GNU Lesser General Public License.
+ *
+ * The input file is mapped in memory (or read at once if mmap is not
+ * available). For ascii files, the number of words of each chunk of the
+ * file is computed once, so a data section can be skipped without being
+ * parsed and split into independent pieces that are parsed concurrently.
+ * The writers format blocks of records concurrently in a memory buffer
+ * that is written at once.
+ */
+
+#include "mmgcommon.h"
+
+#ifdef POSIX
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/** Size (in bytes) of the chunks of the word index */
+#define _MMG5_IOCHK   65536
+/** Number of records of the parsed/formatted blocks under which we stay serial */
+#define _MMG5_IOPAR   50000
+/** Number of records formatted per written block */
+#define _MMG5_IOBLK   32768
+/** Maximal number of fields of a record */
+#define _MMG5_IOFLD   16
+
+int _MMG5_swapbin(int sbin)
+{
+  int inv;
+  char *p_in = (char *) &sbin;
+  char *p = (char *)&inv;
+
+
+  p[0] = p_in[3];
+  p[1] = p_in[2];
+  p[2] = p_in[1];
+  p[3] = p_in[0];
+
+  return(inv);
+}
+
+float _MMG5_swapf(float sbin)
+{
+  float out;
+  char *p_in = (char *) &sbin;
+  char *p_out = (char *) &out;
+  p_out[0] = p_in[3];
+  p_out[1] = p_in[2];
+  p_out[2] = p_in[1];
+  p_out[3] = p_in[0];
+
+  return(out);
+}
+
+double _MMG5_swapd(double sbin)
+{
+  double out;
+  char *p_in = (char *) &sbin;
+  char *p_out = (char *) &out;
+  int i;
+
+  for(i=0;i<8;i++)
+  {
+    p_out[i] = p_in[7-i];
+  }
+  return(out);
+}
+
+static inline
+int _MMG5_isSpace(char c) {
+  return ( c==' ' || c=='\n' || c=='\r' || c=='\t' || c=='\f' || c=='\v' );
+}
+
+/**
+ * \param f pointer toward the input buffer.
+ * \param beg beginning of the range.
+ * \param end end of the range.
+ * \return the number of words beginning in the range \f$[beg,end[\f$.
+ *
+ */
+static inline
+int _MMG5_countWords(_MMG5_Inbuf *f,size_t beg,size_t end) {
+  size_t i;
+  int    nw;
+
+  nw = 0;
+  for (i=beg; i<end; i++) {
+    if ( _MMG5_isSpace(f->buf[i]) )  continue;
+    if ( !i || _MMG5_isSpace(f->buf[i-1]) )  nw++;
+  }
+  return(nw);
+}
+
+/**
+ * \param f pointer toward the input buffer.
+ *
+ * Count the words of each chunk of an ascii file (in parallel) and store in
+ * \a ctok[c] the number of words beginning before the chunk \a c.
+ *
+ */
+static void _MMG5_indexWords(_MMG5_Inbuf *f) {
+  int  c;
+
+  f->nchk = (int)(f->len/_MMG5_IOCHK) + 1;
+  _MMG5_SAFE_MALLOC(f->ctok,f->nchk+1,int);
+
+  f->ctok[0] = 0;
+#pragma omp parallel for schedule(static) if ( f->nchk > 16 )
+  for (c=0; c<f->nchk; c++)
+    f->ctok[c+1] = _MMG5_countWords(f,(size_t)c*_MMG5_IOCHK,
+                                    MG_MIN(f->len,(size_t)(c+1)*_MMG5_IOCHK));
+
+  for (c=0; c<f->nchk; c++)  f->ctok[c+1] += f->ctok[c];
+}
+
+/**
+ * \param f pointer toward the input buffer.
+ * \param pos position in the file.
+ * \return the number of words beginning before \a pos.
+ *
+ */
+static int _MMG5_wordsBefore(_MMG5_Inbuf *f,size_t pos) {
+  size_t c;
+
+  c = pos/_MMG5_IOCHK;
+  return(f->ctok[c] + _MMG5_countWords(f,c*_MMG5_IOCHK,pos));
+}
+
+/**
+ * \param f pointer toward the input buffer.
+ * \param w index of a word.
+ * \return the position of the beginning of the word \a w (the end of the
+ * file if the file has less than \a w words).
+ *
+ */
+static size_t _MMG5_wordPos(_MMG5_Inbuf *f,int w) {
+  size_t i;
+  int    lo,hi,mid,nw;
+
+  if ( w >= f->ctok[f->nchk] )  return(f->len);
+
+  /* last chunk c such that ctok[c] <= w */
+  lo = 0;
+  hi = f->nchk;
+  while ( hi - lo > 1 ) {
+    mid = (lo+hi) >> 1;
+    if ( f->ctok[mid] <= w )  lo = mid;
+    else  hi = mid;
+  }
+
+  nw = f->ctok[lo];
+  for (i=(size_t)lo*_MMG5_IOCHK; i<f->len; i++) {
+    if ( _MMG5_isSpace(f->buf[i]) )  continue;
+    if ( !i || _MMG5_isSpace(f->buf[i-1]) ) {
+      if ( nw == w )  return(i);
+      nw++;
+    }
+  }
+  return(f->len);
+}
+
+/**
+ * \param f pointer toward the input buffer (set).
+ * \param filename name of the file.
+ * \param bin 1 if the file is binary.
+ * \return 1 if success, 0 if the file can't be opened.
+ *
+ * Map (or read) the file \a filename and, for an ascii file, build the word
+ * index of the file.
+ *
+ */
+int _MMG5_openIn(_MMG5_Inbuf *f,const char *filename,int bin) {
+  FILE   *inm;
+  long    len;
+
+  memset(f,0,sizeof(_MMG5_Inbuf));
+  f->bin = bin;
+
+#ifdef POSIX
+  {
+    struct stat st;
+    void        *ptr;
+    int         fd;
+
+    fd = open(filename,O_RDONLY);
+    if ( fd < 0 )  return(0);
+    if ( !fstat(fd,&st) && st.st_size > 0 ) {
+      ptr = mmap(NULL,(size_t)st.st_size,PROT_READ,MAP_PRIVATE,fd,0);
+      if ( ptr != MAP_FAILED ) {
+        f->buf = (char*)ptr;
+        f->len = (size_t)st.st_size;
+        f->map = 1;
+      }
+    }
+    close(fd);
+  }
+#endif
+
+  if ( !f->map ) {
+    if ( !(inm = fopen(filename,"rb")) )  return(0);
+    fseek(inm,0,SEEK_END);
+    len = ftell(inm);
+    rewind(inm);
+    if ( len > 0 ) {
+      _MMG5_SAFE_MALLOC(f->buf,len,char);
+      f->len = fread(f->buf,1,(size_t)len,inm);
+    }
+    fclose(inm);
+  }
+
+  if ( !bin )  _MMG5_indexWords(f);
+
+  return(1);
+}
+
+/**
+ * \param f pointer toward the input buffer.
+ *
+ * Release the file buffer and the word index.
+ *
+ */
+void _MMG5_closeIn(_MMG5_Inbuf *f) {
+#ifdef POSIX
+  if ( f->map ) {
+    munmap(f->buf,f->len);
+    f->buf = NULL;
+  }
+#endif
+  if ( f->buf )  _MMG5_SAFE_FREE(f->buf);
+  if ( f->ctok ) _MMG5_SAFE_FREE(f->ctok);
+  f->len = f->pos = 0;
+}
+
+/**
+ * \param f pointer toward the input buffer.
+ * \param word buffer for the word.
+ * \param siz size of \a word.
+ * \return the length of the word, 0 at the end of the file.
+ *
+ * Read the next word of an ascii file (truncated to \a siz-1 characters).
+ *
+ */
+int _MMG5_getWord(_MMG5_Inbuf *f,char *word,int siz) {
+  int  l;
+
+  while ( f->pos < f->len && _MMG5_isSpace(f->buf[f->pos]) )  f->pos++;
+
+  l = 0;
+  while ( f->pos < f->len && !_MMG5_isSpace(f->buf[f->pos]) ) {
+    if ( l < siz-1 )  word[l++] = f->buf[f->pos];
+    f->pos++;
+  }
+  word[l] = '\0';
+
+  return(l);
+}
+
+/**
+ * \param f pointer toward the input buffer.
+ * \param val read integer.
+ * \return 1 if success, 0 otherwise.
+ *
+ * Read an integer in an ascii file or a 4 bytes integer in a binary file.
+ *
+ */
+int _MMG5_getInt(_MMG5_Inbuf *f,int *val) {
+  char  word[64],*end;
+
+  if ( f->bin ) {
+    if ( f->pos + 4 > f->len )  return(0);
+    memcpy(val,&f->buf[f->pos],4);
+    f->pos += 4;
+    if ( f->iswp ) *val = _MMG5_swapbin(*val);
+    return(1);
+  }
+
+  if ( !_MMG5_getWord(f,word,64) )  return(0);
+  *val = (int)strtol(word,&end,10);
+  return( end != word );
+}
+
+/**
+ * \param f pointer toward the input buffer.
+ * \param n number of words to skip.
+ *
+ * Skip the \a n next words of an ascii file.
+ *
+ */
+void _MMG5_skipWords(_MMG5_Inbuf *f,int n) {
+  if ( n <= 0 )  return;
+  f->pos = _MMG5_wordPos(f,_MMG5_wordsBefore(f,f->pos)+n);
+}
+
+/**
+ * \param f pointer toward the input buffer.
+ * \param pos position of the beginning of the record.
+ * \param typ type of the record fields.
+ * \param dv double fields of the record.
+ * \param iv integer fields of the record.
+ * \return the position after the record, 0 if the record is incomplete.
+ *
+ * Read a record at position \a pos.
+ *
+ */
+static size_t _MMG5_getRec(_MMG5_Inbuf *f,size_t pos,const char *typ,
+                           double *dv,int *iv) {
+  float   fv;
+  char    word[64],*end;
+  int     l,nd,ni;
+
+  nd = ni = 0;
+  for ( ; *typ; typ++) {
+    if ( f->bin ) {
+      l = ( *typ=='d' || *typ=='D' ) ? 8 : 4;
+      if ( pos + l > f->len )  return(0);
+      switch ( *typ ) {
+      case 'd':
+        memcpy(&dv[nd],&f->buf[pos],8);
+        if ( f->iswp )  dv[nd] = _MMG5_swapd(dv[nd]);
+        nd++;
+        break;
+      case 'f':
+        memcpy(&fv,&f->buf[pos],4);
+        if ( f->iswp )  fv = _MMG5_swapf(fv);
+        dv[nd++] = (double)fv;
+        break;
+      case 'i':
+        memcpy(&iv[ni],&f->buf[pos],4);
+        if ( f->iswp )  iv[ni] = _MMG5_swapbin(iv[ni]);
+        ni++;
+        break;
+      }
+      pos += l;
+      continue;
+    }
+
+    while ( pos < f->len && _MMG5_isSpace(f->buf[pos]) )  pos++;
+    l = 0;
+    while ( pos < f->len && !_MMG5_isSpace(f->buf[pos]) ) {
+      if ( l < 63 )  word[l++] = f->buf[pos];
+      pos++;
+    }
+    if ( !l )  return(0);
+    word[l] = '\0';
+
+    switch ( *typ ) {
+    case 'd':
+      dv[nd++] = strtod(word,&end);
+      break;
+    case 'f':
+      dv[nd++] = (double)strtof(word,&end);
+      break;
+    case 'i':
+      iv[ni++] = (int)strtol(word,&end,10);
+      break;
+    default:
+      end = word+1;
+    }
+    if ( end == word )  return(0);
+  }
+  return(pos);
+}
+
+/**
+ * \param f pointer toward the input buffer.
+ * \param n number of records.
+ * \param typ type of the record fields: \a d (double), \a f (float), \a i
+ * (integer), \a D and \a F (skipped double and float).
+ * \param fn function called for each record \a k (from 1 to \a n) with its
+ * double fields \a dv and its integer fields \a iv.
+ * \param data user data passed to \a fn.
+ * \return 1 if success, 0 if the file is truncated or a field can't be read.
+ *
+ * Read a section of \a n records from the current position and move the
+ * cursor after the section. Large sections are split in pieces that are read
+ * concurrently, so \a fn must only modify the data of record \a k.
+ *
+ */
+int _MMG5_getBlock(_MMG5_Inbuf *f,int n,const char *typ,
+                   void (*fn)(void*,int,double*,int*),void *data) {
+  size_t   pos,rsiz,end;
+  int      nw,w0,np,p,beg,last,k,ier;
+  double   dv[_MMG5_IOFLD];
+  int      iv[_MMG5_IOFLD];
+
+  nw = (int)strlen(typ);
+  assert ( nw <= _MMG5_IOFLD );
+  if ( n <= 0 )  return(1);
+
+  np = 1;
+#ifdef _OPENMP
+  if ( n > _MMG5_IOPAR )  np = 4*omp_get_max_threads();
+#endif
+
+  rsiz = 0;
+  w0   = 0;
+  if ( f->bin ) {
+    for (p=0; p<nw; p++)
+      rsiz += ( typ[p]=='d' || typ[p]=='D' ) ? 8 : 4;
+    if ( f->pos + (size_t)n*rsiz > f->len )  return(0);
+  }
+  else
+    w0 = _MMG5_wordsBefore(f,f->pos);
+
+  ier = 1;
+#pragma omp parallel for schedule(dynamic,1) if ( np > 1 ) \
+  private(pos,beg,last,k,dv,iv) reduction(min:ier)
+  for (p=0; p<np; p++) {
+    beg  = (int)(((long long)n*p)/np);
+    last = (int)(((long long)n*(p+1))/np);
+    if ( f->bin )
+      pos = f->pos + (size_t)beg*rsiz;
+    else
+      pos = np > 1 ? _MMG5_wordPos(f,w0+beg*nw) : f->pos;
+
+    for (k=beg; k<last; k++) {
+      pos = _MMG5_getRec(f,pos,typ,dv,iv);
+      if ( !pos ) {
+        ier = 0;
+        break;
+      }
+      fn(data,k+1,dv,iv);
+    }
+  }
+  if ( !ier )  return(0);
+
+  if ( f->bin )
+    end = f->pos + (size_t)n*rsiz;
+  else
+    end = _MMG5_wordPos(f,w0+n*nw);
+  f->pos = end;
+
+  return(1);
+}
+
+/**
+ * \param out pointer toward the output file.
+ * \param n number of records.
+ * \param fn function that writes the record \a k (from 1 to \a n) in the
+ * string \a s (of size _MMG5_IOREC) and returns its length (0 to skip the
+ * record).
+ * \param data user data passed to \a fn.
+ * \return 1 if success, 0 if an error occurs while writing.
+ *
+ * Write \a n records: blocks of records are formatted concurrently in a
+ * buffer that is written at once.
+ *
+ */
+int _MMG5_putBlock(FILE *out,int n,int (*fn)(void*,int,char*),void *data) {
+  char     *buf;
+  size_t   cur;
+  int      *len,k,k0,nb,l;
+
+  if ( n <= 0 )  return(1);
+
+  nb = MG_MIN(n,_MMG5_IOBLK);
+  _MMG5_SAFE_MALLOC(buf,(size_t)nb*_MMG5_IOREC,char);
+  _MMG5_SAFE_MALLOC(len,nb,int);
+
+  for (k0=0; k0<n; k0+=nb) {
+    nb = MG_MIN(n-k0,_MMG5_IOBLK);
+
+#pragma omp parallel for schedule(static) if ( n > _MMG5_IOPAR )
+    for (k=0; k<nb; k++)
+      len[k] = fn(data,k0+k+1,&buf[(size_t)k*_MMG5_IOREC]);
+
+    /* compaction */
+    cur = 0;
+    for (k=0; k<nb; k++) {
+      l = len[k];
+      assert ( l < _MMG5_IOREC );
+      if ( l && cur != (size_t)k*_MMG5_IOREC )
+        memmove(&buf[cur],&buf[(size_t)k*_MMG5_IOREC],l);
+      cur += l;
+    }
+    if ( cur && fwrite(buf,1,cur,out) != cur ) {
+      _MMG5_SAFE_FREE(len);
+      _MMG5_SAFE_FREE(buf);
+      return(0);
+    }
+  }
+
+  _MMG5_SAFE_FREE(len);
+  _MMG5_SAFE_FREE(buf);
+  return(1);
+}
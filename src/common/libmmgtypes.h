@@ -226,10 +226,15 @@ typedef struct {
   int   a; /*!< First extremity of edge */
   int   b;  /*!< Second extremity of edge */
   int   ref; /*!< Reference of edge */
-  int   nxt; /*!< Next element of hash table */
+  int   nxt; /*!< Unused (the table uses open addressing) */
   char  tag; /*!< tag of edge */
 } MMG5_hgeom;
 
+/**
+ * \struct MMG5_HGeom
+ * \brief Hash table of geometric edges (open addressing): \a siz slots (power
+ * of 2), \a max=siz-1 and \a nxt stored edges.
+ */
 typedef struct {
   int         siz,max,nxt;
   MMG5_hgeom  *geom;
@@ -277,6 +282,9 @@ typedef struct {
   MMG5_pEdge     edge; /*!< Pointer toward the \ref MMG5_Edge structure */
   MMG5_HGeom     htab; /*!< \ref MMG5_HGeom structure */
   MMG5_Info      info; /*!< \ref MMG5_Info structure */
+  int            nfield; /*!< Number of user fields carried through the remeshing */
+  struct MMG5_Sol **field; /*!< User fields interpolated at the new points */
+  struct MMG5_BezCache *bezcache; /*!< Cache of Bezier patches (internal use) */
 } MMG5_Mesh;
 typedef MMG5_Mesh  * MMG5_pMesh;
 
@@ -284,7 +292,7 @@ typedef MMG5_Mesh  * MMG5_pMesh;
  * \struct MMG5_sol
  * \brief MMG Solution structure (for solution or metric).
  */
-typedef struct {
+typedef struct MMG5_Sol {
   int       ver; /* Version of the solution file */
   int       dim; /* Dimension of the solution file*/
   int       np; /* Number of points of the solution */
@@ -266,7 +266,7 @@
 !   int   a; /*!< First extremity of edge */
 !   int   b;  /*!< Second extremity of edge */
 !   int   ref; /*!< Reference of edge */
-!   int   nxt; /*!< Next element of hash table */
+!   int   nxt; /*!< Unused (the table uses open addressing) */
 !   char  tag; /*!< tag of edge */
 ! } MMG5_hgeom;
 
@@ -318,6 +318,9 @@
 !   MMG5_pEdge     edge; /*!< Pointer toward the \ref MMG5_Edge structure */
 !   MMG5_HGeom     htab; /*!< \ref MMG5_HGeom structure */
 !   MMG5_Info      info; /*!< \ref MMG5_Info structure */
+!   int            nfield; /*!< Number of user fields carried through the remeshing */
+!   struct MMG5_Sol **field; /*!< User fields interpolated at the new points */
+!   struct MMG5_BezCache *bezcache; /*!< Cache of Bezier patches (internal use) */
 ! } MMG5_Mesh;
 ! typedef MMG5_Mesh  * MMG5_pMesh;
 
@@ -326,7 +329,7 @@
 !  * \brief MMG Solution structure (for solution or metric).
 !  */
 
-! typedef struct {
+! typedef struct MMG5_Sol {
 !   int       ver; /* Version of the solution file */
 !   int       dim; /* Dimension of the solution file*/
 !   int       np; /* Number of points of the solution */
@@ -35,6 +35,10 @@
 #include <math.h>
 #include <complex.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #define POSIX
 #define GNU
 
@@ -276,6 +280,44 @@ extern "C" {
 
 
 /** Inlined functions for libraries and executables */
+/**
+ * \param a first key (smallest edge extremity).
+ * \param b second key (largest edge extremity).
+ * \param mask slot mask of the table (number of slots minus 1).
+ * \return the first slot to probe for the key \f$(a,b)\f$.
+ *
+ * Mix the 64 bits key \f$(a,b)\f$ (finalizer of the murmur3 hash) so that
+ * consecutive point indices spread over the whole table.
+ *
+ */
+static inline
+int _MMG5_hashSlot(int a,int b,int mask) {
+  unsigned long long h;
+
+  h  = ((unsigned long long)(unsigned int)a << 32) | (unsigned int)b;
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+
+  return((int)(h & (unsigned long long)mask));
+}
+
+/**
+ * \param hsiz expected number of items.
+ * \return the number of slots of an open addressing table storing \a hsiz
+ * items (power of 2, load factor lower than 1/2).
+ */
+static inline
+int _MMG5_hashSiz(int hsiz) {
+  int siz;
+
+  siz = 16;
+  while ( siz < 2*hsiz && siz < (1<<30) )  siz <<= 1;
+  return(siz);
+}
+
 #ifdef USE_SCOTCH
 /** Warn user that we overflow asked memory during scotch call */
 static inline
@@ -379,12 +421,40 @@ typedef struct {
 } _MMG5_Bezier;
 typedef _MMG5_Bezier * _MMG5_pBezier;
 
+/**
+ * \struct _MMG5_BezCell
+ * \brief Cached Bezier patch of a boundary triangle.
+ */
+typedef struct {
+  unsigned long long sig; /*!< signature of the vertex data used by the patch */
+  int          v[3];   /*!< triangle vertices (v[0]=0 for an empty cell) */
+  char         ori;    /*!< triangle orientation */
+  char         tag[3]; /*!< triangle edge tags */
+  _MMG5_Bezier pb;     /*!< Bezier patch */
+} _MMG5_BezCell;
+
+/**
+ * \struct MMG5_BezCache
+ * \brief Direct mapped cache of the Bezier patches of the boundary triangles.
+ *
+ * A cell is valid as long as the coordinates, tags and normals of the
+ * triangle vertices are unchanged: they are checked through the signature
+ * stored in the cell, so the remeshing operators don't have to invalidate it.
+ */
+typedef struct MMG5_BezCache {
+  int            siz; /*!< number of cells (power of 2) */
+  _MMG5_BezCell *cell;
+} _MMG5_BezCache;
+
+/** Maximal number of cells of the Bezier cache (about 10Mo) */
+#define _MMG5_BEZCACHE  16384
+
 /**
  * \struct _MMG5_hedge
  * \brief Used to hash edges (memory economy compared to \ref MMG5_hgeom).
  */
 typedef struct {
-  int   a,b,nxt;
+  int   a,b; /*!< key: sorted extremities (a=0 for an empty slot) */
   int   s,k; /*!< k = point along edge a b or triangle index */
 } _MMG5_hedge;
 
@@ -392,18 +462,63 @@ typedef struct {
  * \struct _MMG5_Hash
  * \brief Identic as \ref MMG5_HGeom but use \ref _MMG5_hedge to store edges
  * instead of \ref MMG5_hgeom (memory economy).
+ *
+ * Open addressing table with linear probing: \a siz is the (power of 2)
+ * number of slots, \a max=siz-1 the slot mask and \a nxt the number of
+ * stored items. The table is doubled when it becomes half full.
  */
 typedef struct {
   int     siz,max,nxt;
   _MMG5_hedge  *item;
 } _MMG5_Hash;
 
+/**
+ * \struct _MMG5_Heap
+ * \brief Indexed binary heap (min-heap) of entities keyed by a double value.
+ *
+ * \a item[1..n] stores the entity indices in heap order, \a pos[k] is the
+ * position of entity \a k in \a item (0 if \a k is not in the heap) and \a
+ * key[k] its key.
+ */
+typedef struct {
+  int     siz,n; /*!< max entity index, number of items in the heap */
+  int    *item;
+  int    *pos;
+  double *key;
+} _MMG5_Heap;
+
+/**
+ * \struct _MMG5_Inbuf
+ * \brief Input file mapped (or read) in memory.
+ *
+ * For ascii files, \a ctok[c] is the number of words beginning before the
+ * chunk \a c of the file (see \ref _MMG5_openIn).
+ */
+typedef struct {
+  char    *buf;  /*!< file content */
+  size_t   len;  /*!< size of the file */
+  size_t   pos;  /*!< current position */
+  int     *ctok; /*!< word index of an ascii file */
+  int      nchk; /*!< number of chunks of the word index */
+  int      bin;  /*!< 1 for a binary file */
+  int      iswp; /*!< 1 if the bytes of a binary file must be swapped */
+  char     map;  /*!< 1 if the file is memory mapped */
+} _MMG5_Inbuf;
+
+/** Maximal length of a record formatted by \ref _MMG5_putBlock */
+#define _MMG5_IOREC  256
+
 
 /* Functions declarations */
 extern void   _MMG5_bezierEdge(MMG5_pMesh, int, int, double*, double*, char,double*);
+int    _MMG5_bezierCacheNew(MMG5_pMesh mesh,int nbdy);
+void   _MMG5_bezierCacheFree(MMG5_pMesh mesh);
+int    _MMG5_bezierCacheGet(MMG5_pMesh mesh,MMG5_pTria pt,_MMG5_pBezier pb,char ori);
+void   _MMG5_bezierCachePut(MMG5_pMesh mesh,MMG5_pTria pt,_MMG5_pBezier pb,char ori);
 int    _MMG5_buildridmet(MMG5_pMesh,MMG5_pSol,int,double,double,double,double*);
 extern int    _MMG5_buildridmetfic(MMG5_pMesh,double*,double*,double,double,double,double*);
 int    _MMG5_buildridmetnor(MMG5_pMesh, MMG5_pSol, int,double*, double*);
+int    _MMG5_brioSort(MMG5_pMesh mesh,int n,int dim,double *c,int *idx);
 int    _MMG5_paratmet(double c0[3],double n0[3],double m[6],double c1[3],double n1[3],double mt[6]);
 extern int    _MMG5_rmtr(double r[3][3],double m[6], double mr[6]);
 int    _MMG5_boundingBox(MMG5_pMesh mesh);
@@ -413,6 +528,9 @@ int    _MMG5_bouler(MMG5_pMesh, int*, int, int i,int *,int *,int *, int);
 double _MMG5_caltri33_ani(MMG5_pMesh mesh,MMG5_pSol met,MMG5_pTria pt);
 extern double _MMG5_caltri_ani(MMG5_pMesh mesh,MMG5_pSol met,MMG5_pTria ptt);
 extern double _MMG5_caltri_iso(MMG5_pMesh mesh,MMG5_pSol met,MMG5_pTria ptt);
+void   _MMG5_closeIn(_MMG5_Inbuf *f);
+int    _MMG5_coincidentPoints(MMG5_pMesh mesh,int dim,double tol,int ntrans,
+                              double *trans,int *img);
 void   _MMG5_defUninitSize(MMG5_pMesh mesh,MMG5_pSol met, char ismet);
 void   _MMG5_displayHisto(MMG5_pMesh,int, double*, int, int, double, int, int,
                           double, double*, int*);
@@ -420,10 +538,21 @@ int    _MMG5_elementWeight(MMG5_pMesh,MMG5_pSol,MMG5_pTria,MMG5_pPoint,
                            _MMG5_Bezier*,double r[3][3],double gv[2]);
 void   _MMG5_fillDefmetregSys( int, MMG5_pPoint, int, _MMG5_Bezier,double r[3][3],
                                double *, double *, double *, double *);
+int    _MMG5_getBlock(_MMG5_Inbuf *f,int n,const char *typ,
+                      void (*fn)(void*,int,double*,int*),void *data);
+int    _MMG5_getInt(_MMG5_Inbuf *f,int *val);
+int    _MMG5_getWord(_MMG5_Inbuf *f,char *word,int siz);
 int    _MMG5_grad2metSurf(MMG5_pMesh mesh, MMG5_pSol met, MMG5_pTria pt, int i);
 int    _MMG5_hashEdge(MMG5_pMesh mesh,_MMG5_Hash *hash,int a,int b,int k);
 int    _MMG5_hashGet(_MMG5_Hash *hash,int a,int b);
-int    _MMG5_hashNew(MMG5_pMesh mesh, _MMG5_Hash *hash,int hsiz,int hmax);
+int    _MMG5_hashNew(MMG5_pMesh mesh, _MMG5_Hash *hash,int hsiz);
+int    _MMG5_hashGrow(MMG5_pMesh mesh,_MMG5_Hash *hash);
+int    _MMG5_hashPop(_MMG5_Hash *hash,int a,int b);
+int    _MMG5_heapNew(MMG5_pMesh mesh,_MMG5_Heap *heap,int siz);
+void   _MMG5_heapFree(MMG5_pMesh mesh,_MMG5_Heap *heap);
+void   _MMG5_heapPush(_MMG5_Heap *heap,int k,double key);
+int    _MMG5_heapPop(_MMG5_Heap *heap);
+void   _MMG5_heapDel(_MMG5_Heap *heap,int k);
 int    _MMG5_intmetsavedir(MMG5_pMesh mesh, double *m,double *n,double *mr);
 int    _MMG5_intridmet(MMG5_pMesh,MMG5_pSol,int,int,double,double*,double*);
 int    _MMG5_mmgIntmet33_ani(double*,double*,double*,double);
@@ -440,7 +569,9 @@ int    _MMG5_nonUnitNorPts(MMG5_pMesh,int,int,int,double*);
 extern double _MMG5_nonorsurf(MMG5_pMesh mesh,MMG5_pTria pt);
 extern int    _MMG5_norpts(MMG5_pMesh,int,int,int,double *);
 extern int    _MMG5_nortri(MMG5_pMesh mesh,MMG5_pTria pt,double *n);
+int    _MMG5_openIn(_MMG5_Inbuf *f,const char *filename,int bin);
 void   _MMG5_printTria(MMG5_pMesh mesh,char* fileName);
+int    _MMG5_putBlock(FILE *out,int n,int (*fn)(void*,int,char*),void *data);
 extern int    _MMG5_rotmatrix(double n[3],double r[3][3]);
 int    _MMG5_invmat(double *m,double *mi);
 int    _MMG5_invmatg(double m[9],double mi[9]);
@@ -449,6 +580,7 @@ double _MMG5_ridSizeInTangentDir(MMG5_pMesh, MMG5_pPoint,int,int*,double,double)
 extern long _MMG5_safeLL2LCast(long long val);
 int    _MMG5_scaleMesh(MMG5_pMesh mesh,MMG5_pSol met);
 int    _MMG5_scotchCall(MMG5_pMesh mesh, MMG5_pSol sol);
+void   _MMG5_skipWords(_MMG5_Inbuf *f,int n);
 int    _MMG5_solveDefmetregSys( MMG5_pMesh, double r[3][3], double *, double *,
                                 double *, double *, double, double, double);
 int    _MMG5_solveDefmetrefSys( MMG5_pMesh,MMG5_pPoint,int*, double r[3][3],
@@ -457,6 +589,9 @@ int    _MMG5_solveDefmetrefSys( MMG5_pMesh,MMG5_pPoint,int*, double r[3][3],
 double _MMG5_surftri_ani(MMG5_pMesh mesh,MMG5_pSol met,MMG5_pTria ptt);
 double _MMG5_surftri33_ani(MMG5_pMesh,MMG5_pTria,double*,double*,double*);
 double _MMG5_surftri_iso(MMG5_pMesh mesh,MMG5_pSol met,MMG5_pTria ptt);
+int    _MMG5_swapbin(int sbin);
+double _MMG5_swapd(double sbin);
+float  _MMG5_swapf(float sbin);
 extern int    _MMG5_sys33sym(double a[6], double b[3], double r[3]);
 int    _MMG5_unscaleMesh(MMG5_pMesh mesh,MMG5_pSol met);
 int    _MMG5_interpreg_ani(MMG5_pMesh,MMG5_pSol,MMG5_pTria,char,double,double *mr);
@@ -87,3 +87,66 @@ int MMG2_boulep(MMG5_pMesh mesh, int ifirst, int iploc, int * list) {
 
   return(ilist);
 }
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param adr pointer toward the table of the ball addresses (allocated here).
+ * \param list pointer toward the table of the balls (allocated here).
+ * \return 1 if success, 0 if fail.
+ *
+ * Build the balls of all the points in compressed storage: the triangles
+ * containing the point \a ip are stored as \f$3*k+i\f$ (\a i local index of
+ * \a ip in \a k) in \f$list[adr[ip]..adr[ip+1]-1]\f$.
+ *
+ */
+int _MMG2_ballIncid(MMG5_pMesh mesh,int **adr,int **list) {
+  MMG5_pTria   pt;
+  int          *ad,*li,k,ip,pos;
+  char         i;
+
+  _MMG5_ADD_MEM(mesh,(mesh->np+2+3*mesh->nt+1)*sizeof(int),"point balls",
+                return(0));
+  _MMG5_SAFE_CALLOC(ad,mesh->np+2,int);
+  _MMG5_SAFE_MALLOC(li,3*mesh->nt+1,int);
+
+  /* count the triangles of each ball */
+  for (k=1; k<=mesh->nt; k++) {
+    pt = &mesh->tria[k];
+    if ( !M_EOK(pt) )  continue;
+    for (i=0; i<3; i++)
+      ad[pt->v[i]+1]++;
+  }
+  for (ip=1; ip<=mesh->np; ip++)
+    ad[ip+1] += ad[ip];
+
+  /* fill the balls: ad[ip] is used as insertion cursor then shifted back */
+  for (k=1; k<=mesh->nt; k++) {
+    pt = &mesh->tria[k];
+    if ( !M_EOK(pt) )  continue;
+    for (i=0; i<3; i++) {
+      pos = ad[pt->v[i]]++;
+      li[pos] = 3*k+i;
+    }
+  }
+  for (ip=mesh->np; ip>0; ip--)
+    ad[ip] = ad[ip-1];
+  ad[0] = 0;
+
+  *adr  = ad;
+  *list = li;
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param adr pointer toward the table of the ball addresses.
+ * \param list pointer toward the table of the balls.
+ *
+ * Free the point balls built by \ref _MMG2_ballIncid.
+ *
+ */
+void _MMG2_freeBallIncid(MMG5_pMesh mesh,int **adr,int **list) {
+
+  _MMG5_DEL_MEM(mesh,*adr,(mesh->np+2)*sizeof(int));
+  _MMG5_DEL_MEM(mesh,*list,(3*mesh->nt+1)*sizeof(int));
+}
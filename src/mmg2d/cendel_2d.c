@@ -22,7 +22,141 @@
 */
 #include "mmg2d.h"
 
+/** Number of points above which the edges are swapped by independent batches
+ * processed concurrently */
+#define _MMG2_SWPPAR  100000
+/** Size of batch under which the remaining edges are swapped serially */
+#define _MMG2_SWPMIN  512
 
+#ifdef _OPENMP
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the sol structure.
+ * \param declic quality threshold of the triangles to improve.
+ * \return the number of swapped edges, -1 if fail.
+ *
+ * Multithreaded version of \ref MMG2_cendel: the bad triangles whose
+ * quadrilaterals (the vertices of the triangle and of its three neighbours)
+ * do not share any point are selected greedily, then their edges are swapped
+ * concurrently. The triangles locked out of a batch and the new triangles
+ * that are still bad are processed by the next batch, until the batches
+ * become too small.
+ *
+ */
+static int _MMG2_cendelCol(MMG5_pMesh mesh,MMG5_pSol sol,double declic) {
+  MMG5_pTria      pt,pt1;
+  double          crit;
+  int             *lst,*bat,*swp,*lock,*flag,*adja,lsw[3];
+  int             nt,nlst,nbat,k,l,m,i,adj,ns,np,stamp,ok,serial;
+
+  nt = mesh->nt;
+  _MMG5_ADD_MEM(mesh,(4*(nt+1)+mesh->np+1)*sizeof(int),"swap batches",
+                return(-1));
+  _MMG5_SAFE_MALLOC(lst,nt+1,int);
+  _MMG5_SAFE_MALLOC(bat,nt+1,int);
+  _MMG5_SAFE_MALLOC(swp,nt+1,int);
+  _MMG5_SAFE_CALLOC(flag,nt+1,int);
+  _MMG5_SAFE_CALLOC(lock,mesh->np+1,int);
+
+  nlst = 0;
+  for (k=1; k<=nt; k++) {
+    pt = &mesh->tria[k];
+    if ( M_EOK(pt) && pt->qual >= declic )  lst[nlst++] = k;
+  }
+
+  ns    = 0;
+  np    = 0;
+  stamp = 0;
+  nbat  = _MMG2_SWPMIN;
+  while ( nlst ) {
+    /* batch of triangles with disjoint quadrilaterals, the triangles are
+     * processed serially once the batches become too small */
+    serial = ( nlst < _MMG2_SWPMIN || nbat < _MMG2_SWPMIN );
+    ++stamp;
+    nbat = m = 0;
+    for (l=0; l<nlst; l++) {
+      k  = lst[l];
+      pt = &mesh->tria[k];
+      if ( !M_EOK(pt) || pt->qual < declic )  continue;
+      if ( serial ) {
+        bat[nbat++] = k;
+        continue;
+      }
+
+      adja = &mesh->adja[3*(k-1) + 1];
+      ok   = 1;
+      for (i=0; i<3; i++) {
+        if ( lock[pt->v[i]] == stamp )  ok = 0;
+        if ( adja[i] && lock[mesh->tria[adja[i]/3].v[adja[i]%3]] == stamp )
+          ok = 0;
+      }
+      if ( !ok ) {
+        lst[m++] = k;
+        continue;
+      }
+      for (i=0; i<3; i++) {
+        lock[pt->v[i]] = stamp;
+        if ( adja[i] )  lock[mesh->tria[adja[i]/3].v[adja[i]%3]] = stamp;
+      }
+      bat[nbat++] = k;
+    }
+    nlst = m;
+    np  += nbat;
+
+#pragma omp parallel for schedule(dynamic,64) if ( !serial ) \
+  private(k,pt,pt1,adja,adj,i,crit,lsw)
+    for (l=0; l<nbat; l++) {
+      k      = bat[l];
+      pt     = &mesh->tria[k];
+      adja   = &mesh->adja[3*(k-1) + 1];
+      swp[l] = 0;
+      /* in the serial pass, k may have been swapped by a previous triangle */
+      if ( pt->qual < declic )  continue;
+      for (i=0; i<3; i++) {
+        adj = adja[i] / 3;
+        if ( !adj || pt->ref != mesh->tria[adj].ref )  continue;
+        //check required
+        if((mesh->point[pt->v[MMG2_iare[i][0]]].tag & M_REQUIRED)
+           && (mesh->point[pt->v[MMG2_iare[i][1]]].tag & M_REQUIRED)) {
+          continue;
+        }
+
+        pt1  = &mesh->tria[adj];
+        crit = 0.99 * M_MAX(pt->qual,pt1->qual);
+        if ( MMG2_swapar(mesh,sol,k,i,crit,lsw) ) {
+          swp[l] = adj;
+          break;
+        }
+      }
+    }
+
+    /* the two new triangles are processed again if still bad */
+    ++stamp;
+    for (l=0; l<nlst; l++)  flag[lst[l]] = stamp;
+    for (l=0; l<nbat; l++) {
+      if ( !swp[l] )  continue;
+      ns++;
+      for (i=0; i<2; i++) {
+        k  = i ? swp[l] : bat[l];
+        pt = &mesh->tria[k];
+        if ( flag[k] == stamp || pt->qual < declic )  continue;
+        flag[k] = stamp;
+        lst[nlst++] = k;
+      }
+    }
+  }
+
+  if ( mesh->info.imprim < - 4 )
+    fprintf(stdout,"     %7d PROPOSED  %7d SWAPPED\n",np,ns);
+
+  _MMG5_DEL_MEM(mesh,lock,(mesh->np+1)*sizeof(int));
+  _MMG5_DEL_MEM(mesh,flag,(nt+1)*sizeof(int));
+  _MMG5_DEL_MEM(mesh,swp,(nt+1)*sizeof(int));
+  _MMG5_DEL_MEM(mesh,bat,(nt+1)*sizeof(int));
+  _MMG5_DEL_MEM(mesh,lst,(nt+1)*sizeof(int));
+  return(ns);
+}
+#endif
 
 int MMG2_cendel(MMG5_pMesh mesh,MMG5_pSol sol,double declic,int base) {
   MMG5_pTria      pt,pt1;
@@ -30,9 +164,14 @@ int MMG2_cendel(MMG5_pMesh mesh,MMG5_pSol sol,double declic,int base) {
   double      crit;
   int       *adja,*list,adj,iadr,i,k,ns,np;
 
+#ifdef _OPENMP
+  if ( mesh->np > _MMG2_SWPPAR && omp_get_max_threads() > 1 )
+    return(_MMG2_cendelCol(mesh,sol,declic));
+#endif
+
   /* queue on quality */
   queue = MMG2_kiuini(mesh,mesh->nt,declic,-1);
-  assert(queue);
+  if ( !queue )  return(-1);
   list  = (int*)malloc(MMG2D_LMAX*sizeof(int));
   assert(list);
   ns = 0;
@@ -59,6 +198,9 @@ int MMG2_cendel(MMG5_pMesh mesh,MMG5_pSol sol,double declic,int base) {
       pt1  = &mesh->tria[adj];
       crit = 0.99 * M_MAX(pt->qual,pt1->qual);
       if ( MMG2_swapar(mesh,sol,k,i,crit,list) ) {
+        /* the two new triangles are processed again if still bad */
+        MMG2_kiuput(queue,k);
+        MMG2_kiuput(queue,adj);
         ns++;
         break;
       }
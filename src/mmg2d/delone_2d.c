@@ -25,9 +25,6 @@
 #define  _MMG2_EPSRAD       1.00005
 #define  _MMG2_AREAMIN       1e-30
 
-#define KTA     7
-#define KTB    11
-
 /* cavity correction for quality */
 static int
 _MMG2_correction_iso(MMG5_pMesh mesh,int ip,int *list,int ilist,int nedep) {
@@ -92,9 +89,9 @@ _MMG2_correction_iso(MMG5_pMesh mesh,int ip,int *list,int ilist,int nedep) {
 }
 
 /* hash mesh edge v[0],v[1] (face i of iel) */
-int _MMG2_hashEdgeDelone(MMG5_pMesh mesh,HashTable *hash,int iel,int i,int *v) {
+int _MMG2_hashEdgeDelone(MMG5_pMesh mesh,_MMG5_Hash *hash,int iel,int i,int *v) {
   int             *adja,iadr,jel,j,key,mins,maxs;
-  Hedge     *ha;
+  _MMG5_hedge     *ha;
 
   /* compute key */
   if ( v[0] < v[1] ) {
@@ -105,61 +102,38 @@ int _MMG2_hashEdgeDelone(MMG5_pMesh mesh,HashTable *hash,int iel,int i,int *v) {
     mins = v[1];
     maxs = v[0];
   }
-  key = KTA*mins + KTB*maxs;
-  key = key % hash->size;
+
+  if ( 2*(hash->nxt+1) > hash->siz && !_MMG5_hashGrow(mesh,hash) ) {
+    if(mesh->info.imprim > 6) fprintf(stdout," ## Warning: overflow\n");
+    return(0);
+  }
+
+  key = _MMG5_hashSlot(mins,maxs,hash->max);
   ha  = &hash->item[key];
 
-  if ( ha->min ) {
-    /* identical face */
-    if ( ha->min == mins && ha->max == maxs ) {
+  while ( ha->a ) {
+    /* identical edge */
+    if ( ha->a == mins && ha->b == maxs ) {
       iadr = (iel-1)*3 + 1;
       adja = &mesh->adja[iadr];
-      adja[i] = ha->iel;
+      adja[i] = ha->k;
 
-      jel  = ha->iel /3;
-      j    = ha->iel % 3;
+      jel  = ha->k /3;
+      j    = ha->k % 3;
       iadr = (jel-1)*3 + 1;
       adja = &mesh->adja[iadr];
       adja[j] = iel*3 + i;
       return(1);
     }
-    else {
-      while ( ha->nxt && ha->nxt < hash->nxtmax ) {
-        ha = &hash->item[ha->nxt];
-        if ( ha->min == mins && ha->max == maxs ) {
-          iadr = (iel-1)*3 + 1;
-          adja = &mesh->adja[iadr];
-          adja[i] = ha->iel;
-
-          jel  = ha->iel /3;
-          j    = ha->iel % 3;
-          iadr = (jel-1)*3 + 1;
-          adja = &mesh->adja[iadr];
-          adja[j] = iel*3 + i;
-          return(1);
-        }
-      }
-    }
-    ha->nxt   = hash->hnxt;
-    ha        = &hash->item[hash->hnxt];
-    ha->min     = mins;
-    ha->max     = maxs;
-    ha->iel     = iel*3 + i;
-    hash->hnxt = ha->nxt;
-    ha->nxt   = 0;
-
-    if ( hash->hnxt >= hash->nxtmax ) {
-      if(mesh->info.imprim > 6) fprintf(stdout," ## Warning: overflow\n");
-      return(0);
-    }
-    return(1);
+    key = (key+1) & hash->max;
+    ha  = &hash->item[key];
   }
 
   /* insert */
-  ha->min = mins;
-  ha->max = maxs;
-  ha->iel = iel*3 + i;
-  ha->nxt = 0;
+  ha->a = mins;
+  ha->b = maxs;
+  ha->k = iel*3 + i;
+  ++hash->nxt;
 
   return(1);
 }
@@ -256,7 +230,7 @@ int _MMG2_delone(MMG5_pMesh mesh,MMG5_pSol sol,int ip,int *list,int ilist) {
   short       i1;
   char        alert;
   int         tref,ielnum[3*MMG2_LONMAX+1];
-  HashTable   hedg;
+  _MMG5_Hash  hedg;
 
   base = mesh->base;
   /* external faces */
@@ -303,7 +277,8 @@ int _MMG2_delone(MMG5_pMesh mesh,MMG5_pSol sol,int ip,int *list,int ilist) {
   if ( alert )  {return(0);}
   /* hash table params */
   if ( size > 3*MMG2_LONMAX )  return(0);
-  if ( !MMG2_hashNew(&hedg,size,3*size) ) { /*3*size suffit */
+  /* size internal edges, each shared by two new tria */
+  if ( !_MMG5_hashNew(mesh,&hedg,2*size) ) {
     fprintf(stdout,"  ## Unable to complete mesh.\n");
     return(-1);
   }
@@ -387,6 +362,6 @@ int _MMG2_delone(MMG5_pMesh mesh,MMG5_pSol sol,int ip,int *list,int ilist) {
 
   //ppt = &mesh->point[ip];
   //  ppt->flag = mesh->flag;
-  _MMG5_SAFE_FREE(hedg.item);
+  _MMG5_DEL_MEM(mesh,hedg.item,hedg.siz*sizeof(_MMG5_hedge));
   return(1);
 }
@@ -23,25 +23,414 @@
 #include "mmg2d.h"
 
 
+/**
+ * \struct _MMG2_Cavity
+ * \brief Work arrays of the recovery of a boundary edge.
+ *
+ * \a cav stores the triangles crossed by the edge, \a poly the vertices of
+ * the two pseudo-polygons of the cavity (left one then right one), \a stk the
+ * sub-polygons to triangulate (4 ints each) and \a ed the edges of the cavity
+ * (3 ints each: sorted vertices and code of the edge).
+ */
+typedef struct {
+  int   cav[MMG2D_LMAX];
+  int   poly[MMG2D_LMAX+2];
+  int   stk[4*(MMG2D_LMAX+2)];
+  int   ed[3*(4*MMG2D_LMAX+2)];
+  int   oadj[MMG2D_LMAX+2],oedg[MMG2D_LMAX+2];
+  char  otag[MMG2D_LMAX+2];
+} _MMG2_Cavity;
+
+/**
+ * \param a pointer toward the first edge.
+ * \param b pointer toward the second edge.
+ * \return -1, 0 or 1 following the lexicographic order of the edge vertices.
+ *
+ * Comparison of the cavity edges for qsort.
+ *
+ */
+static int _MMG2_cmpEdge(const void *a,const void *b) {
+  const int  *ea,*eb;
+
+  ea = (const int*)a;
+  eb = (const int*)b;
+  if ( ea[0] != eb[0] )  return( ea[0] < eb[0] ? -1 : 1 );
+  if ( ea[1] != eb[1] )  return( ea[1] < eb[1] ? -1 : 1 );
+  return(0);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param ptri triangle incident to each point (may be outdated).
+ * \param ia first extremity of the edge.
+ * \param ib second extremity of the edge.
+ * \param kdep pointer toward the triangle of the ball of \a ia crossed by the
+ * edge.
+ * \param idep pointer toward the local index of \a ia in \a kdep.
+ * \return 1 if the edge \f$[ia;ib]\f$ exists, 2 if the edge is missing and
+ * leaves \a ia through the triangle \a kdep, 0 if the edge is missing and
+ * can't be recovered by a cavity (a vertex of the ball lies on the edge).
+ *
+ * Travel the ball of \a ia to check if the edge exists or to find the first
+ * triangle crossed by the edge.
+ *
+ */
+static int _MMG2_startEdge(MMG5_pMesh mesh,int *ptri,int ia,int ib,
+                           int *kdep,int *idep) {
+  MMG5_pTria   pt;
+  double       *pa,*pb,*c,oa,ob;
+  int          k,kstart,ilist,v;
+  char         i,j;
+
+  pa = mesh->point[ia].c;
+  pb = mesh->point[ib].c;
+
+  k  = ptri[ia];
+  pt = &mesh->tria[k];
+  if ( !k || !M_EOK(pt) || (pt->v[0]!=ia && pt->v[1]!=ia && pt->v[2]!=ia) ) {
+    k = MMG2_findTriaHint(mesh,ia,k);
+    if ( !k )  return(0);
+    ptri[ia] = k;
+  }
+  kstart = k;
+  ilist  = 0;
+
+  do {
+    pt = &mesh->tria[k];
+    for (i=0; i<3; i++)
+      if ( pt->v[i] == ia )  break;
+    if ( i == 3 )  return(0);
+
+    for (j=1; j<3; j++) {
+      v = pt->v[MMG2_inxt[i+j-1]];
+      if ( v == ib )  return(1);
+
+      /* vertex of the ball on the edge */
+      c = mesh->point[v].c;
+      if ( fabs(_MMG2_orient(pa,pb,c)) <= EPSA
+           && (c[0]-pa[0])*(pb[0]-pa[0]) + (c[1]-pa[1])*(pb[1]-pa[1]) > 0. )
+        return(0);
+    }
+    oa = _MMG2_orient(pa,pb,mesh->point[pt->v[MMG2_inxt[i]]].c);
+    ob = _MMG2_orient(pa,pb,mesh->point[pt->v[MMG2_inxt[i+1]]].c);
+    if ( oa < 0. && ob > 0. ) {
+      *kdep = k;
+      *idep = i;
+      return(2);
+    }
+    /* next triangle of the ball (counterclockwise) */
+    k = mesh->adja[3*(k-1)+1+MMG2_inxt[i]]/3;
+  }
+  while ( k && k != kstart && ++ilist < MMG2D_LMAX );
+
+  return(0);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the sol structure.
+ * \param cv pointer toward the work arrays.
+ * \param ptri triangle incident to each point.
+ * \param ia first extremity of the edge.
+ * \param ib second extremity of the edge.
+ * \param kdep first triangle crossed by the edge.
+ * \param idep local index of \a ia in \a kdep.
+ * \return 1 if the edge is recovered, 0 if the mesh is left unchanged.
+ *
+ * Recover the edge \f$[ia;ib]\f$ in one step: the triangles crossed by the
+ * edge are collected by walking from \a kdep, then the pseudo-polygons on
+ * each side of the edge are retriangulated (constrained Delaunay
+ * triangulation) in the cavity slots and the adjacencies are rebuilt.
+ *
+ */
+static int _MMG2_recoverEdge(MMG5_pMesh mesh,MMG5_pSol sol,_MMG2_Cavity *cv,
+                             int *ptri,int ia,int ib,int kdep,int idep) {
+  MMG5_pTria   pt;
+  MMG5_Tria    tmp;
+  double       *pa,*pb,o;
+  int          *adja,*ed,nc,nl,nr,no,ne,ns,k,adj,v,a,b,lo,hi,m,q,l,x,y;
+  char         i,j;
+
+  pa = mesh->point[ia].c;
+  pb = mesh->point[ib].c;
+
+  /* walk along the edge: left and right chains from ia to ib */
+  pt = &mesh->tria[kdep];
+  nc = nl = nr = 0;
+  cv->cav[nc++] = kdep;
+  cv->poly[nl++] = pt->v[MMG2_inxt[idep+1]];
+  cv->stk[nr++]  = pt->v[MMG2_inxt[idep]];
+  k = kdep;
+  i = idep;
+  while ( 1 ) {
+    adj = mesh->adja[3*(k-1)+1+i];
+    if ( !adj || nc >= MMG2D_LMAX )  return(0);
+    k  = adj/3;
+    j  = adj%3;
+    cv->cav[nc++] = k;
+    v  = mesh->tria[k].v[j];
+    if ( v == ib )  break;
+
+    o = _MMG2_orient(pa,pb,mesh->point[v].c);
+    if ( fabs(o) <= EPSA )  return(0);
+    if ( o > 0. ) {
+      cv->poly[nl++] = v;
+      i = MMG2_inxt[j];
+    }
+    else {
+      cv->stk[nr++] = v;
+      i = MMG2_inxt[j+1];
+    }
+  }
+  /* right chain stored reversed after the left one */
+  for (l=0; l<nr; l++)  cv->poly[nl+l] = cv->stk[nr-1-l];
+
+  /* boundary of the cavity: edges seen once by the crossed triangles */
+  ed = cv->ed;
+  for (l=0; l<nc; l++) {
+    pt = &mesh->tria[cv->cav[l]];
+    for (i=0; i<3; i++) {
+      a = pt->v[MMG2_inxt[i]];
+      b = pt->v[MMG2_inxt[i+1]];
+      ed[3*(3*l+i)]   = MG_MIN(a,b);
+      ed[3*(3*l+i)+1] = MG_MAX(a,b);
+      ed[3*(3*l+i)+2] = 3*cv->cav[l]+i;
+    }
+  }
+  qsort(ed,3*nc,3*sizeof(int),_MMG2_cmpEdge);
+
+  memcpy(&tmp,&mesh->tria[cv->cav[0]],sizeof(MMG5_Tria));
+  no = 0;
+  for (l=0; l<3*nc; l++) {
+    if ( l+1 < 3*nc && !_MMG2_cmpEdge(&ed[3*l],&ed[3*(l+1)]) ) {
+      ++l;
+      continue;
+    }
+    x = ed[3*l+2];
+    cv->oadj[no] = mesh->adja[3*(x/3-1)+1+x%3];
+    cv->oedg[no] = mesh->tria[x/3].edg[x%3];
+    cv->otag[no] = mesh->tria[x/3].tag[x%3];
+    ed[3*no]   = ed[3*l];
+    ed[3*no+1] = ed[3*l+1];
+    ed[3*no+2] = -(no+1);
+    no++;
+  }
+  assert ( no == nc+2 );
+
+  /* constrained Delaunay triangulation of the pseudo-polygons */
+  ne = 0;
+  ns = 0;
+  cv->stk[ns++] = ia;  cv->stk[ns++] = ib;  cv->stk[ns++] = 0;
+  cv->stk[ns++] = nl;
+  cv->stk[ns++] = ib;  cv->stk[ns++] = ia;  cv->stk[ns++] = nl;
+  cv->stk[ns++] = nl+nr;
+  while ( ns ) {
+    hi = cv->stk[--ns];
+    lo = cv->stk[--ns];
+    b  = cv->stk[--ns];
+    a  = cv->stk[--ns];
+    if ( lo >= hi )  continue;
+
+    m = lo;
+    for (q=lo+1; q<hi; q++) {
+      if ( _MMG2_incircle(mesh->point[a].c,mesh->point[b].c,
+                          mesh->point[cv->poly[m]].c,
+                          mesh->point[cv->poly[q]].c) > 0. )
+        m = q;
+    }
+    k  = cv->cav[ne++];
+    pt = &mesh->tria[k];
+    memcpy(pt,&tmp,sizeof(MMG5_Tria));
+    pt->v[0] = a;
+    pt->v[1] = b;
+    pt->v[2] = cv->poly[m];
+    for (i=0; i<3; i++) {
+      pt->edg[i] = 0;
+      pt->tag[i] = 0;
+      ptri[pt->v[i]] = k;
+    }
+    pt->qual = MMG2_caltri_in(mesh,sol,pt);
+
+    cv->stk[ns++] = a;  cv->stk[ns++] = cv->poly[m];
+    cv->stk[ns++] = lo; cv->stk[ns++] = m;
+    cv->stk[ns++] = cv->poly[m];  cv->stk[ns++] = b;
+    cv->stk[ns++] = m+1; cv->stk[ns++] = hi;
+  }
+  assert ( ne == nc );
+
+  /* adjacencies: each edge is shared by 2 new triangles or by a new
+   * triangle and the boundary of the cavity */
+  for (l=0; l<nc; l++) {
+    pt = &mesh->tria[cv->cav[l]];
+    for (i=0; i<3; i++) {
+      a = pt->v[MMG2_inxt[i]];
+      b = pt->v[MMG2_inxt[i+1]];
+      ed[3*(no+3*l+i)]   = MG_MIN(a,b);
+      ed[3*(no+3*l+i)+1] = MG_MAX(a,b);
+      ed[3*(no+3*l+i)+2] = 3*cv->cav[l]+i;
+    }
+  }
+  qsort(ed,no+3*nc,3*sizeof(int),_MMG2_cmpEdge);
+
+  for (l=0; l<no+3*nc; l+=2) {
+    assert ( !_MMG2_cmpEdge(&ed[3*l],&ed[3*(l+1)]) );
+    x = ed[3*l+2];
+    y = ed[3*(l+1)+2];
+    if ( x < 0 ) {
+      q = x;  x = y;  y = q;
+    }
+    adja = &mesh->adja[3*(x/3-1)+1];
+    if ( y > 0 ) {
+      adja[x%3] = y;
+      mesh->adja[3*(y/3-1)+1+y%3] = x;
+      continue;
+    }
+    q = -y-1;
+    adja[x%3] = cv->oadj[q];
+    if ( cv->oadj[q] )
+      mesh->adja[3*(cv->oadj[q]/3-1)+1+cv->oadj[q]%3] = x;
+    mesh->tria[x/3].edg[x%3] = cv->oedg[q];
+    mesh->tria[x/3].tag[x%3] = cv->otag[q];
+  }
+
+  return(1);
+}
+
 /**
  * \param mesh pointer toward the mesh structure.
  * \param sol pointer toward the sol structure.
+ * \param ia first extremity of the edge.
+ * \param ib second extremity of the edge.
+ * \param kdep triangle containing \a ia.
+ * \param list work array of size MMG2D_LMAX.
  * \return 0 if fail, 1 otherwise.
  *
- * Check if all edges exist and if not force them.
+ * Force the edge \f$[ia;ib]\f$ by random swaps of the crossed edges (used
+ * when a vertex lies on the edge).
  *
  */
-int MMG2_bdryenforcement(MMG5_pMesh mesh,MMG5_pSol sol) {
+static int _MMG2_swapEdge(MMG5_pMesh mesh,MMG5_pSol sol,int ia,int ib,
+                          int kdep,int *list) {
   MMG5_pTria      pt,pt1;
-  MMG5_pEdge      ped;
-  int       i,j,k,kk,nex,*list,kdep,lon,voy,iel,iare,ied;
-  int       ia,ib,ilon,rnd,idep,*adja,ir,adj,list2[3],iter,nbug;//,iadr,ped0,ped1;
-//  int       iadr2,*adja2,ndel;
+  int       i,k,lon,iare,ied;
+  int       ilon,rnd,idep,*adja,ir,adj,list2[3],iter;
+
+  if(mesh->info.ddebug)
+    printf("\n  -- edge enforcement %d %d\n",ia,ib);
+
+  if(!(lon=MMG2_locateEdge(mesh,ia,ib,&kdep,list))) {
+    if(mesh->info.ddebug)
+      printf("  ## Error: edge not found\n");
+    return(0);
+  }
+  if(!(lon<0 || lon==4)) {
+    if(mesh->info.ddebug)
+      printf("  ** Unexpected situation: edge %d %d -- %d\n",ia,ib,lon);
+    exit(EXIT_FAILURE);
+  }
+  /*edge exist*/
+  if(lon==4) {
+    if(mesh->info.ddebug) printf("  ** Existing edge\n");
+    //exit(EXIT_FAILURE);
+  }
+  if(lon>1000) {
+    printf(" ## Error: too many triangles (%d)\n",lon);
+    exit(EXIT_FAILURE);
+  }
+  if(lon<2) {
+    if(mesh->info.ddebug) printf("  ** few edges... %d\n",lon);
+    //exit(EXIT_FAILURE);
+  }
+  lon = -lon;
+  ilon = lon;
 
-  _MMG5_SAFE_CALLOC(list,MMG2D_LMAX,int);
+  /*retournement d'arêtes aleatoirement dans la liste, tant que */
+  srand(time(NULL));
+  iter=0;
+  while (ilon>0 && iter++<2*lon) {
+    rnd = (rand()%lon);
+    k = list[rnd]/3;
+    if(mesh->info.ddebug) {
+      printf("  ** Random edge swap\n");
+    }
+
+    /*check k in Pipe*/
+    i=0;
+    k = list[rnd]/3;
+    while(i++<lon) {
+      pt = &mesh->tria[k];
+      if(pt->base == mesh->base+1) break;
+      k = list[(++rnd)%lon]/3;
+    }
+    assert(i<=lon);
+    idep = list[rnd]%3;
+    adja = &mesh->adja[3*(k-1)+1];
+    for(i=0 ; i<3 ; i++) {
+      ir = (idep+i)%3;
+      /*check adj in Pipe*/
+      adj = adja[ir]/3;
+      pt1 = &mesh->tria[adj];
+      if (pt1->base != (mesh->base+1)) {
+        continue;
+      }
+      /************************/
+      /********swap***********/
+      /************************/
+      if(!MMG2_swapar(mesh,sol,k,ir,1e+4,list2)) {
+        if(mesh->info.ddebug) printf("  ## Warning: unable to swap\n");
+        continue;
+      }
+      if(mesh->info.ddebug) printf("  ** Successful swap\n");
+      /*new tr intersecté par ia-ib ??*/
+      for(ied=1 ; ied<3 ; ied++) {
+        iare = MMG2_cutEdgeTriangle(mesh,list2[ied],ia,ib);
+        if(!iare) { /*tr not in pipe*/
+          ilon--;
+          if(mesh->info.ddebug)
+            printf("  ## Warning: tr %d not intersected ==> %d\n",list2[ied],ilon);
+          mesh->tria[list2[ied]].base = mesh->base;
+        } else if(iare < 0) {
+          mesh->tria[list2[ied]].base = mesh->base;
+          ilon -= 2;
+        } else {
+          if(mesh->info.ddebug) printf("  ** tr intersected %d \n",list2[ied]);
+          mesh->tria[list2[ied]].base = mesh->base+1;
+        }
+      }
+      break;
+    }
+  }
+  return(1);
+}
 
-  nex = 0;
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the sol structure.
+ * \return 0 if fail, 1 otherwise.
+ *
+ * Check if all edges exist and if not force them. The missing edges are
+ * first collected, then each of them is recovered by retriangulating the
+ * triangles it crosses; the ball of an edge extremity is reached from the
+ * triangles stored at the previous recoveries.
+ *
+ */
+int MMG2_bdryenforcement(MMG5_pMesh mesh,MMG5_pSol sol) {
+  MMG5_pTria      pt;
+  MMG5_pEdge      ped;
+  _MMG2_Cavity    *cv;
+  int       i,k,nex,*list,*ptri,kdep,idep,ier,nsw;
 
+  /* triangle incident to each point */
+  _MMG5_ADD_MEM(mesh,(mesh->np+1)*sizeof(int),"incident triangles",
+                return(0));
+  _MMG5_SAFE_CALLOC(ptri,mesh->np+1,int);
+  for (k=1; k<=mesh->nt; k++) {
+    pt = &mesh->tria[k];
+    if ( !M_EOK(pt) )  continue;
+    for (i=0; i<3; i++)  ptri[pt->v[i]] = k;
+  }
+
+  nex  = 0;
   for(i=1 ; i<=mesh->na ; i++) {
     ped = &mesh->edge[i];
     if(!ped->a) continue;
@@ -49,201 +438,59 @@ int MMG2_bdryenforcement(MMG5_pMesh mesh,MMG5_pSol sol) {
       nex++;
       continue;
     }
-    kdep = mesh->nt;
-    kdep = MMG2_findTria(mesh,ped->a);
-    assert(kdep);
-    if(mesh->tria[kdep].v[0]==ped->a)
-      j=0;
-    else if(mesh->tria[kdep].v[1]==ped->a)
-      j=1;
-    else
-      j=2;
-    lon = MMG2_boulep(mesh,kdep,j,list);
-    if(lon>1000) {
-      printf("  ## Error: too many triangles (%d) around the vertex %d\n",
-             lon,ped->a);
-      exit(EXIT_FAILURE);
-    } else if(!lon) {
-      printf(" ## Error: problem with point %d of triangle %d\n",
-             mesh->tria[kdep].v[j],kdep);
-      _MMG5_SAFE_FREE(list);
-      return(0);
-    }
-    assert(lon);
-    for (j=1 ; j<=lon ; j++) {
-      iel = list[j];
-      pt = &mesh->tria[iel/3];
-      voy = iel%3;
-      if (pt->v[MMG2_iare[(voy+1)%3][0]]==ped->b) {
-        ped->base = -1;
-        nex++;
-        break;
-      }
-      else if (pt->v[MMG2_iare[(voy+2)%3][1]]==ped->b) {
-        ped->base = -1;
-        nex++;
-        break;
-      }
-    }
-    if(j>lon) {
-      if(mesh->info.imprim > 5) printf("  ** missing edge %d %d \n",
-                                       ped->a,ped->b);
-      ped->base = kdep;
+    if ( _MMG2_startEdge(mesh,ptri,ped->a,ped->b,&kdep,&idep) == 1 ) {
+      ped->base = -1;
+      nex++;
+      continue;
     }
-
+    if(mesh->info.imprim > 5) printf("  ** missing edge %d %d \n",
+                                     ped->a,ped->b);
+    ped->base = 0;
   }
 
   if(nex!=mesh->na) {
     if(mesh->info.imprim > 4)
       printf(" ** number of missing edges : %d\n",mesh->na-nex);
-    nbug = 0;
-    for(kk=1 ; kk<=mesh->na ; kk++) {
-      ped = &mesh->edge[kk];
+
+    _MMG5_ADD_MEM(mesh,sizeof(_MMG2_Cavity)+MMG2D_LMAX*sizeof(int),
+                  "edge recovery",
+                  _MMG5_DEL_MEM(mesh,ptri,(mesh->np+1)*sizeof(int));
+                  return(0));
+    _MMG5_SAFE_MALLOC(cv,1,_MMG2_Cavity);
+    _MMG5_SAFE_CALLOC(list,MMG2D_LMAX,int);
+
+    nsw = ier = 0;
+    for(i=1 ; i<=mesh->na ; i++) {
+      ped = &mesh->edge[i];
       if(!ped->a || ped->base < 0) continue;
-      ia = ped->a;
-      ib = ped->b;
-      kdep = ped->base;
-      if(mesh->info.ddebug)
-        printf("\n  -- edge enforcement %d %d\n",ia,ib);
-
-      if(!(lon=MMG2_locateEdge(mesh,ia,ib,&kdep,list))) {
-        if(mesh->info.ddebug)
-          printf("  ## Error: edge not found\n");
-        _MMG5_SAFE_FREE(list);
-        return(0);
-      }
-      if(!(lon<0 || lon==4)) {
-        if(mesh->info.ddebug)
-          printf("  ** Unexpected situation: edge %d %d -- %d\n",ia,ib,lon);
-        exit(EXIT_FAILURE);
-      }
-      /*edge exist*/
-      if(lon==4) {
-        if(mesh->info.ddebug) printf("  ** Existing edge\n");
-        //exit(EXIT_FAILURE);
-      }
-      if(lon>1000) {
-        printf(" ## Error: too many triangles (%d)\n",lon);
-        exit(EXIT_FAILURE);
+
+      ier = _MMG2_startEdge(mesh,ptri,ped->a,ped->b,&kdep,&idep);
+      if ( ier == 2 )
+        ier = _MMG2_recoverEdge(mesh,sol,cv,ptri,ped->a,ped->b,kdep,idep);
+      if ( ier ) {
+        ped->base = -1;
+        continue;
       }
-      if(lon<2) {
-        if(mesh->info.ddebug) printf("  ** few edges... %d\n",lon);
-        //exit(EXIT_FAILURE);
+
+      /* a vertex lies on the edge: swaps */
+      ++nsw;
+      kdep = MMG2_findTriaHint(mesh,ped->a,ptri[ped->a]);
+      if ( !kdep || !_MMG2_swapEdge(mesh,sol,ped->a,ped->b,kdep,list) ) {
+        ier = -1;
+        break;
       }
-      lon = -lon;
-      ilon = lon;
-
-      /*retournement d'arêtes aleatoirement dans la liste, tant que */
-      srand(time(NULL));
-      iter=0;
-      while (ilon>0 && iter++<2*lon) {
-        rnd = (rand()%lon);
-        k = list[rnd]/3;
-        if(mesh->info.ddebug) {
-          printf("  ** Random edge swap\n");
-          /* for(i=0 ; i<lon ; i++) { */
-          /*   if((mesh->tria[list[i]/3]).base == mesh->base+1) */
-          /*     printf("%de tr : %d base %d == %d\n",i+1,list[i]/3,mesh->tria[list[i]/3].base,mesh->base+1); */
-          /*   else */
-          /*     printf("pas base %de tr %d \n",i+1,list[i]/3); */
-
-          /*   printf("vertex %d %d %d\n",mesh->tria[list[i]/3].v[0],mesh->tria[list[i]/3].v[1], */
-          /*          mesh->tria[list[i]/3].v[2]); */
-          /* } */
-        }
+    }
+    if ( mesh->info.imprim > 5 && nsw )
+      printf(" ** edges forced by swaps : %d\n",nsw);
 
-        /*check k in Pipe*/
-        i=0;
-        k = list[rnd]/3;
-        while(i++<lon) {
-          pt = &mesh->tria[k];
-          if(pt->base == mesh->base+1) break;
-          k = list[(++rnd)%lon]/3;
-        }
-        assert(i<=lon);
-        idep = list[rnd]%3;
-        // if(mesh->info.ddebug) printf("i= %d < %d ? on demarre avec %d\n",i,lon+1,k);
-        adja = &mesh->adja[3*(k-1)+1];
-        for(i=0 ; i<3 ; i++) {
-          ir = (idep+i)%3;
-          /*check adj in Pipe*/
-          adj = adja[ir]/3;
-          voy = adja[ir]%3;
-          pt1 = &mesh->tria[adj];
-          if (pt1->base != (mesh->base+1)) {
-            continue;
-          }
-          /************************/
-          /********swap***********/
-          /************************/
-          if(!MMG2_swapar(mesh,sol,k,ir,1e+4,list2)) {
-            if(mesh->info.ddebug) printf("  ## Warning: unable to swap\n");
-            continue;
-          }
-          if(mesh->info.ddebug) printf("  ** Successful swap\n");
-          /*new tr intersecté par ia-ib ??*/
-          for(ied=1 ; ied<3 ; ied++) {
-            iare = MMG2_cutEdgeTriangle(mesh,list2[ied],ia,ib);
-            if(!iare) { /*tr not in pipe*/
-              ilon--;
-              if(mesh->info.ddebug)
-                printf("  ## Warning: tr %d not intersected ==> %d\n",list2[ied],ilon);
-              mesh->tria[list2[ied]].base = mesh->base;
-            } else if(iare < 0) {
-              mesh->tria[list2[ied]].base = mesh->base;
-              ilon -= 2;
-            } else {
-              if(mesh->info.ddebug) printf("  ** tr intersected %d \n",list2[ied]);
-              mesh->tria[list2[ied]].base = mesh->base+1;
-            }
-          }
-          break;
-        }
-     }
-    }/*end k --> mesh->na*/
-  }
-
-  _MMG5_SAFE_FREE(list);
-
-
-/*   //check if there are more bdry edges.. and delete tr      */
-/* #warning a optimiser en mettant un pile et un while */
-/*   //printf("tr 1 : %d %d %d\n",mesh->tria[1].v[0],mesh->tria[1].v[1],mesh->tria[1].v[2]);  */
-/*   do { */
-/*     ndel=0; */
-/*     for(k=1 ; k<=mesh->nt ; k++) { */
-/*       pt = &mesh->tria[k]; */
-/*       if(!pt->v[0]) continue;  */
-/*       iadr = 3*(k-1) + 1;                       */
-/*       adja = &mesh->adja[iadr];  */
-
-/*       for(i=0 ; i<3 ; i++)  { */
-/*  if(adja[i]) continue; */
-/*         ped0 = pt->v[MMG2_iare[i][0]]; */
-/*         ped1 = pt->v[MMG2_iare[i][1]]; */
-/*         for(j=1 ; j<=mesh->na ; j++) { */
-/*           ped = &mesh->edge[j]; */
-/*           if((ped->a == ped0 && ped->b==ped1) || (ped->b == ped0 && ped->a==ped1)) break;   */
-/*         } */
-/*         if(j<=mesh->na)  */
-/*           continue; */
-/*  else  */
-/*    break; */
-/*       } */
-/*       if(i==3) continue;  */
-  /*       fprintf(stdout,"WARNING BDRY EDGES MISSING : DO YOU HAVE DUPLICATED VERTEX ? %d %d %d\n", */
-/*        pt->v[0],pt->v[1],pt->v[2]); */
-/*       for(i=0 ; i<3 ; i++) {         */
-/*  if(!adja[i]) continue; */
-/*  iadr2 = 3*(adja[i]/3-1) + 1; */
-/*  adja2 = &mesh->adja[iadr2]; */
-/*  adja2[adja[i]%3] = 0; */
-/*       } */
-/*       MMG2_delElt(mesh,k);  */
-/*       ndel++; */
-
-/*     }           */
-/*   } while(ndel); */
+    _MMG5_SAFE_FREE(list);
+    _MMG5_DEL_MEM(mesh,cv,sizeof(_MMG2_Cavity)+MMG2D_LMAX*sizeof(int));
+    if ( ier < 0 ) {
+      _MMG5_DEL_MEM(mesh,ptri,(mesh->np+1)*sizeof(int));
+      return(0);
+    }
+  }
+  _MMG5_DEL_MEM(mesh,ptri,(mesh->np+1)*sizeof(int));
 
   return(1);
 }
@@ -22,125 +22,78 @@
 */
 #include "mmg2d.h"
 
-#define KTA     7
-#define KTB    11
-
-int MMG2_hashNew(HashTable *hash,int hsize,int hmax) {
-  int   k;
-
-  hash->size  = hsize;
-  hash->nxtmax =hmax+1;
-  hash->hnxt  = hsize;
-  _MMG5_SAFE_CALLOC(hash->item,hash->nxtmax,Hedge);
-
-  for (k=hash->size; k<hash->nxtmax; k++)
-    hash->item[k].nxt = k+1;
-
-  return(1);
-}
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \return 1 if success, 0 if fail.
+ *
+ * Build the triangle adjacency table with the common edge hash table, then
+ * create the boundary edges and compute the tangents (\ref MMG2_baseBdry).
+ *
+ */
 int MMG2_hashel(MMG5_pMesh mesh) {
-  MMG5_pTria     pt,pt1;
-  int       k,kk,pp,l,ll,mins,mins1,maxs,maxs1;
-  int      *hcode,*link,inival,hsize,iadr;
-  unsigned char  *hvoy,i,ii,i1,i2;
-  unsigned int    key;
+  MMG5_pTria     pt;
+  _MMG5_Hash     hash;
+  _MMG5_hedge    *ph;
+  int            *adja,k,jel,ia,ib,key;
+  char           i,i1,i2,j;
 
   if ( mesh->adja )  return(1);
   if ( !mesh->nt )  return(0);
 
-  /* memory alloc */
-  _MMG5_SAFE_CALLOC(hcode,mesh->nt+1,int);
-
   /* memory alloc */
   _MMG5_ADD_MEM(mesh,(3*mesh->ntmax+5)*sizeof(int),"adjacency table",
                 printf("  Exit program.\n");
                 exit(EXIT_FAILURE));
   _MMG5_SAFE_CALLOC(mesh->adja,3*mesh->ntmax+5,int);
 
-  link  = mesh->adja;
-  hsize = mesh->nt;
-  hvoy  = (unsigned char*)hcode;
-
-  /* init */
-  inival = 2147483647;
-  for (k=0; k<=mesh->nt; k++)
-    hcode[k] = -inival;
+  /* about 3/2 edges per triangle */
+  if ( !_MMG5_hashNew(mesh,&hash,3*mesh->nt/2+1) )  return(0);
 
-  /* build hash table */
   for (k=1; k<=mesh->nt; k++) {
     pt = &mesh->tria[k];
-
     if ( !pt->v[0] )  continue;
+
+    adja = &mesh->adja[3*(k-1)+1];
     for (i=0; i<3; i++) {
       i1 = MMG2_idir[i+1];
       i2 = MMG2_idir[i+2];
-      if ( pt->v[i1] < pt->v[i2] ) {
-        mins = pt->v[i1];
-        maxs = pt->v[i2];
-      }
-      else {
-        mins = pt->v[i2];
-        maxs = pt->v[i1];
-      }
+      ia = M_MIN(pt->v[i1],pt->v[i2]);
+      ib = M_MAX(pt->v[i1],pt->v[i2]);
 
-      /* compute key */
-      key = KTA*mins + KTB*maxs;
-      key = key % hsize + 1;
-
-      /* insert */
-      iadr = 3*(k-1) + i+1;
-      link[iadr] = hcode[key];
-      hcode[key] = -iadr;
-    }
-  }
-
-  /* set adjacency */
-  for (l=3*mesh->nt; l>0; l--) {
-    if ( link[l] >= 0 )  continue;
-    k = (l-1) / 3 + 1;
-    i = (l-1) % 3;
-    i1 = MMG2_idir[i+1];
-    i2 = MMG2_idir[i+2];
-    pt = &mesh->tria[k];
+      if ( 2*(hash.nxt+1) > hash.siz && !_MMG5_hashGrow(mesh,&hash) ) {
+        _MMG5_DEL_MEM(mesh,hash.item,hash.siz*sizeof(_MMG5_hedge));
+        return(0);
+      }
 
-    mins = M_MIN(pt->v[i1],pt->v[i2]);
-    maxs = M_MAX(pt->v[i1],pt->v[i2]);
-
-    /* accross link */
-    ll = -link[l];
-    pp = 0;
-    link[l] = 0;
-    hvoy[l] = 0;
-    while ( ll != inival ) {
-      kk = (ll-1) / 3 + 1;
-      ii = (ll-1) % 3;
-      i1 = MMG2_idir[ii+1];
-      i2 = MMG2_idir[ii+2];
-      pt1  = &mesh->tria[kk];
-      if ( pt1->v[i1] < pt1->v[i2] ) {
-        mins1 = pt1->v[i1];
-        maxs1 = pt1->v[i2];
+      key = _MMG5_hashSlot(ia,ib,hash.max);
+      ph  = &hash.item[key];
+      while ( ph->a && (ph->a != ia || ph->b != ib) ) {
+        key = (key+1) & hash.max;
+        ph  = &hash.item[key];
       }
-      else {
-        mins1 = pt1->v[i2];
-        maxs1 = pt1->v[i1];
+
+      /* first triangle sharing the edge */
+      if ( !ph->a ) {
+        ph->a = ia;
+        ph->b = ib;
+        ph->k = 3*k + i;
+        ++hash.nxt;
+        continue;
       }
 
-      if ( mins1 == mins  && maxs1 == maxs ) {
-        /* adjacent found */
-        if ( pp != 0 )  link[pp] = link[ll];
-        link[l] = 3*kk + ii;
-        link[ll]= 3*k + i;
-        break;
+      /* adjacent found: the edge is released for a non manifold third one */
+      if ( ph->k ) {
+        jel = ph->k / 3;
+        j   = ph->k % 3;
+        adja[i] = 3*jel + j;
+        mesh->adja[3*(jel-1)+1+j] = 3*k + i;
+        ph->k = 0;
       }
-      pp = ll;
-      ll = -link[ll];
     }
   }
-  _MMG5_SAFE_FREE(hcode);
+  _MMG5_DEL_MEM(mesh,hash.item,hash.siz*sizeof(_MMG5_hedge));
 
-  MMG2_baseBdry(mesh);
-  return(1);
+  return(MMG2_baseBdry(mesh));
 }
 
 /**
@@ -321,25 +274,18 @@ int MMG2_baseBdry(MMG5_pMesh mesh) {
   MMG5_pTria     pt,pt1;
   MMG5_pPoint    ppt;
   MMG5_pEdge     ped;
-  int      *adja,adj,iadr,k,i,ip,ned,num,i1,i2;
-  HashTable edgeT;
-
-  ned = 0;
-  if(mesh->na) {
-    ned = mesh->na;
-    /*edge treatment*/
-    edgeT.size  = mesh->namax;
-    edgeT.nxtmax = 3*mesh->namax+1;
-    edgeT.hnxt  = mesh->namax;
-    _MMG5_SAFE_CALLOC(edgeT.item,edgeT.nxtmax,Hedge);
-
-    memset(edgeT.item,0,edgeT.nxtmax*sizeof(Hedge));
-    for (k=edgeT.size; k<edgeT.nxtmax; k++)
-      edgeT.item[k].nxt = k+1;
-    for(k=1 ; k<=mesh->na ; k++) {
-      ped = &mesh->edge[k];
-      if(!ped->a) continue;
-      MMG2_hashEdge(&edgeT,k,ped->a,ped->b);
+  int      *adja,adj,iadr,k,i,ip,num,i1,i2;
+  _MMG5_Hash edgeT;
+
+  /*edge treatment: the created edges are hashed too so that an interface
+    edge is shared by its two triangles*/
+  if ( !_MMG5_hashNew(mesh,&edgeT,mesh->na+1) )  return(0);
+  for(k=1 ; k<=mesh->na ; k++) {
+    ped = &mesh->edge[k];
+    if(!ped->a) continue;
+    if ( !_MMG5_hashEdge(mesh,&edgeT,ped->a,ped->b,k) ) {
+      _MMG5_DEL_MEM(mesh,edgeT.item,edgeT.siz*sizeof(_MMG5_hedge));
+      return(0);
     }
   }
 
@@ -355,10 +301,7 @@ int MMG2_baseBdry(MMG5_pMesh mesh) {
       pt1 = &mesh->tria[adj];
       pt->edg[i] = 0;
       if ( !adj  ) {
-        num = 0;
-        if(ned) {
-          num = MMG2_hashEdge(&edgeT,k,pt->v[MMG2_iopp[i][0]],pt->v[MMG2_iopp[i][1]]);
-        }
+        num = _MMG5_hashGet(&edgeT,pt->v[MMG2_iopp[i][0]],pt->v[MMG2_iopp[i][1]]);
         ip  = pt->v[MMG2_iopp[i][0]];
         mesh->point[ip].tag |= M_BDRY;
         if ( mesh->info.nosurf && ( !( mesh->point[ip].tag & M_REQUIRED) ) ) {
@@ -388,12 +331,13 @@ int MMG2_baseBdry(MMG5_pMesh mesh) {
           ped = &mesh->edge[num];
           ped->a = pt->v[MMG2_iopp[i][0]];
           ped->b = pt->v[MMG2_iopp[i][1]];
+          if ( !_MMG5_hashEdge(mesh,&edgeT,ped->a,ped->b,num) ) {
+            _MMG5_DEL_MEM(mesh,edgeT.item,edgeT.siz*sizeof(_MMG5_hedge));
+            return(0);
+          }
         }
       } else if(pt->ref != pt1->ref) {
-        num = 0;
-        if(ned) {
-          num = MMG2_hashEdge(&edgeT,k,pt->v[MMG2_iopp[i][0]],pt->v[MMG2_iopp[i][1]]);
-        }
+        num = _MMG5_hashGet(&edgeT,pt->v[MMG2_iopp[i][0]],pt->v[MMG2_iopp[i][1]]);
         ip  = pt->v[MMG2_iopp[i][0]];
         mesh->point[ip].tag |= M_SD;
         if ( mesh->info.nosurf && ( !( mesh->point[ip].tag & M_REQUIRED) ) ) {
@@ -423,12 +367,16 @@ int MMG2_baseBdry(MMG5_pMesh mesh) {
           ped = &mesh->edge[num];
           ped->a = pt->v[MMG2_iopp[i][0]];
           ped->b = pt->v[MMG2_iopp[i][1]];
+          if ( !_MMG5_hashEdge(mesh,&edgeT,ped->a,ped->b,num) ) {
+            _MMG5_DEL_MEM(mesh,edgeT.item,edgeT.siz*sizeof(_MMG5_hedge));
+            return(0);
+          }
         }
       }
     }
   }
 
-  if(ned && edgeT.item)  _MMG5_SAFE_FREE(edgeT.item);
+  _MMG5_DEL_MEM(mesh,edgeT.item,edgeT.siz*sizeof(_MMG5_hedge));
 
   /*compute tangents*/
   mesh->base++;
@@ -481,54 +429,3 @@ int MMG2_baseBdry(MMG5_pMesh mesh) {
   }
   return(1);
 }
-
-
-/*hash edge :
-  return 1 if edge exist in the table*/
-int MMG2_hashEdge(pHashTable edgeTable,int iel,int ia, int ib) {
-  int       key,mins,maxs;
-  Hedge     *ha;
-
-  /* compute key */
-  if ( ia < ib ) {
-    mins = ia;
-    maxs = ib;
-  }
-  else {
-    mins = ib;
-    maxs = ia;
-  }
-
-  key = KTA*mins + KTB*maxs;
-  key = key % edgeTable->size;
-  ha  = &edgeTable->item[key];
-  if ( ha->min ) {
-    /* edge exist*/
-    if ( ha->min == mins && ha->max == maxs ) {
-      return(ha->iel);
-    }
-    else {
-      while ( ha->nxt && ha->nxt < edgeTable->nxtmax ) {
-        ha = &edgeTable->item[ha->nxt];
-        if ( ha->min == mins && ha->max == maxs )
-          return(ha->iel);
-      }
-      ha->nxt = edgeTable->hnxt;
-      ha      = &edgeTable->item[edgeTable->hnxt];
-      ++edgeTable->hnxt;
-      if ( edgeTable->hnxt == edgeTable->nxtmax ) {
-        fprintf(stdout,"  ## Memory alloc problem (edge): %d\n",edgeTable->nxtmax);
-        assert(0);
-        return(0);
-      }
-    }
-  }
-  /* insert */
-  ha->min = mins;
-  ha->max = maxs;
-  ha->iel = iel;
-  ha->nxt = 0;
-
-  return(0);
-
-}
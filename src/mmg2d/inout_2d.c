@@ -25,74 +25,93 @@
 #define sw 4
 #define sd 8
 
-int MMG_swapbin(int sbin)
-{
-  int inv;
-  char *p_in = (char *) &sbin;
-  char *p = (char *)&inv;
+/** Arguments of the record writers of the mesh and solution files */
+typedef struct {
+  MMG5_pMesh mesh;
+  MMG5_pSol  sol;
+  int        bin; /*!< 1 for a binary file */
+  int        msh; /*!< 1 to write the file in dimension 3 */
+} _MMG2_IOData;
+
+static void _MMG2_getVertex(void *data,int k,double *dv,int *iv) {
+  MMG5_pPoint  ppt;
+
+  ppt = &((MMG5_pMesh)data)->point[k];
+  ppt->c[0] = dv[0];
+  ppt->c[1] = dv[1];
+  ppt->ref  = iv[0];
+  ppt->tag  = M_NUL;
+}
 
+static void _MMG2_getEdge(void *data,int k,double *dv,int *iv) {
+  MMG5_pEdge  ped;
 
-  p[0] = p_in[3];
-  p[1] = p_in[2];
-  p[2] = p_in[1];
-  p[3] = p_in[0];
+  ped = &((MMG5_pMesh)data)->edge[k];
+  ped->a   = iv[0];
+  ped->b   = iv[1];
+  ped->ref = iv[2];
+}
 
-  return(inv);
-  /*unsigned char c1, c2, c3, c4;
+static void _MMG2_getTria(void *data,int k,double *dv,int *iv) {
+  MMG5_pTria  pt;
+  int         i;
 
-    c1 = sbin & 255;
-    c2 = (sbin >> 8) & 255;
-    c3 = (sbin >> 16) & 255;
-    c4 = (sbin >> 24) & 255;
+  pt = &((MMG5_pMesh)data)->tria[k];
+  for (i=0; i<3; i++) {
+    pt->v[i]   = iv[i];
+    pt->edg[i] = 0;
+  }
+  pt->ref = iv[3];
+}
 
-    return ((int)c1 << 24) + ((int)c2 << 16) + ((int)c3 << 8) + c4;   */
+static void _MMG2_getSol(void *data,int k,double *dv,int *iv) {
+  MMG5_pSol  sol;
+  int        i;
 
+  sol = (MMG5_pSol)data;
+  for (i=0; i<sol->size; i++)
+    sol->m[(k-1)*sol->size + 1 + i] = dv[i];
 }
-float MMG_swapf(float sbin)
-{
-  float out;
-  char *p_in = (char *) &sbin;
-  char *p_out = (char *) &out;
-  p_out[0] = p_in[3];
-  p_out[1] = p_in[2];
-  p_out[2] = p_in[1];
-  p_out[3] = p_in[0];
-
-  return(out);
-}
-double MMG_swapd(double sbin)
-{
-  float out;
-  char *p_in = (char *) &sbin;
-  char *p_out = (char *) &out;
-  int i;
-
-  for(i=0;i<8;i++)
-  {
-    p_out[i] = p_in[7-i];
-  }
-  //printf("CONVERTION DOUBLE\n");
-  return(out);
+
+/**
+ * \param inm pointer toward the input file.
+ * \param filename name of file.
+ * \return 0.
+ *
+ * Close a file that ends before the end of a section.
+ *
+ */
+static int _MMG2_loadTrunc(_MMG5_Inbuf *inm,char *filename) {
+  fprintf(stderr,"  ** UNEXPECTED END OF FILE %s.\n",filename);
+  _MMG5_closeIn(inm);
+  return(0);
 }
 
-/* read mesh data */
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param filename name of file.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Read mesh data. Meshes written in dimension 3 are accepted, the third
+ * coordinate of the vertices is ignored.
+ *
+ */
 int MMG2D_loadMesh(MMG5_pMesh mesh,char *filename) {
-  FILE        *inm;
-  MMG5_pPoint       ppt;
-  MMG5_pEdge        ped;
-  MMG5_pTria        pt;
-  float             fc;
-  int          k,ref,tmp,ncor,norient,nreq,nreqed;
-  int          posnp,posnt,posncor,posned,posnq,posreq,posreqed,bin,iswp,nq;
-  char        *ptr,data[128],chaine[128];
-  double       air,dtmp;
+  _MMG5_Inbuf  inm;
+  MMG5_pPoint  ppt;
+  MMG5_pTria   pt;
+  MMG5_pEdge   ped;
+  int          k,ip,tmp,ncor,norient,nreq,nreqed,dim;
+  int          posnp,posnt,posncor,posned,posnq,posreq,posreqed,bin,nq;
+  char         *ptr,data[128],chaine[128],typ[8];
+  double       air;
   int          i,bdim,binch,bpos;
 
 
   posnp = posnt = posncor = posned = posnq = posreq = posreqed = 0;
   ncor = nreq = nreqed = 0;
   bin = 0;
-  iswp = 0;
+  dim = 2;
   mesh->np = mesh->nt = mesh->na = mesh->xp = 0;
   nq = 0;
 
@@ -101,11 +120,11 @@ int MMG2D_loadMesh(MMG5_pMesh mesh,char *filename) {
   ptr = strstr(data,".mesh");
   if ( !ptr ) {
     strcat(data,".meshb");
-    if (!(inm = fopen(data,"rb")) ) {
+    if ( !_MMG5_openIn(&inm,data,1) ) {
       ptr  = strstr(data,".mesh");
       *ptr = '\0';
       strcat(data,".mesh");
-      if (!(inm = fopen(data,"rb")) ) {
+      if ( !_MMG5_openIn(&inm,data,0) ) {
         fprintf(stderr,"  ** %s  NOT FOUND.\n",data);
         return(0);
       }
@@ -117,7 +136,7 @@ int MMG2D_loadMesh(MMG5_pMesh mesh,char *filename) {
 
     if ( ptr )  bin = 1;
 
-    if( !(inm = fopen(data,"rb")) ) {
+    if ( !_MMG5_openIn(&inm,data,bin) ) {
       fprintf(stderr,"  ** %s  NOT FOUND.\n",data);
       return(0);
     }
@@ -126,151 +145,138 @@ int MMG2D_loadMesh(MMG5_pMesh mesh,char *filename) {
 
   if (!bin) {
     strcpy(chaine,"D");
-    while(fscanf(inm,"%s",&chaine[0])!=EOF && strncmp(chaine,"End",strlen("End")) ) {
+    while(_MMG5_getWord(&inm,chaine,128) && strncmp(chaine,"End",strlen("End")) ) {
       if(!strncmp(chaine,"MeshVersionFormatted",strlen("MeshVersionFormatted"))) {
-        fscanf(inm,"%d",&mesh->ver);
+        _MMG5_getInt(&inm,&mesh->ver);
         continue;
       } else if(!strncmp(chaine,"Dimension",strlen("Dimension"))) {
-        fscanf(inm,"%d",&mesh->dim);
-        if(mesh->info.nreg==2) {
-          if(mesh->dim!=3) {
-            fprintf(stdout,"WRONG USE OF -msh \n");
-            return(0);
-          }
-          mesh->dim = 2;
+        _MMG5_getInt(&inm,&dim);
+        if(mesh->info.nreg==2 && dim!=3) {
+          fprintf(stdout,"WRONG USE OF -msh \n");
+          _MMG5_closeIn(&inm);
+          return(0);
         }
-        if(mesh->dim!=2) {
-          fprintf(stdout,"BAD DIMENSION : %d\n",mesh->dim);
+        if(dim!=2 && dim!=3) {
+          fprintf(stdout,"BAD DIMENSION : %d\n",dim);
+          _MMG5_closeIn(&inm);
           return(0);
         }
         continue;
       } else if(!strncmp(chaine,"Vertices",strlen("Vertices"))) {
-        fscanf(inm,"%d",&mesh->np);
-        posnp = ftell(inm);
+        _MMG5_getInt(&inm,&mesh->np);
+        posnp = inm.pos;
+        _MMG5_skipWords(&inm,(dim+1)*mesh->np);
         continue;
       } else if(!strncmp(chaine,"Triangles",strlen("Triangles"))) {
-        fscanf(inm,"%d",&mesh->nt);
-        posnt = ftell(inm);
+        _MMG5_getInt(&inm,&mesh->nt);
+        posnt = inm.pos;
+        _MMG5_skipWords(&inm,4*mesh->nt);
         continue;
       } else if(!strncmp(chaine,"Corners",strlen("Corners"))) {
-        fscanf(inm,"%d",&ncor);
-        posncor = ftell(inm);
+        _MMG5_getInt(&inm,&ncor);
+        posncor = inm.pos;
+        _MMG5_skipWords(&inm,ncor);
         continue;
       } else if(!strncmp(chaine,"RequiredVertices",strlen("RequiredVertices"))) {
-        fscanf(inm,"%d",&nreq);
-        posreq = ftell(inm);
+        _MMG5_getInt(&inm,&nreq);
+        posreq = inm.pos;
+        _MMG5_skipWords(&inm,nreq);
         continue;
       } else if(!strncmp(chaine,"Edges",strlen("Edges"))) {
-        fscanf(inm,"%d",&mesh->na);
-        posned = ftell(inm);
+        _MMG5_getInt(&inm,&mesh->na);
+        posned = inm.pos;
+        _MMG5_skipWords(&inm,3*mesh->na);
         continue;
       } else if(!strncmp(chaine,"RequiredEdges",strlen("RequiredEdges"))) {
-        fscanf(inm,"%d",&nreqed);
-        posreqed = ftell(inm);
+        _MMG5_getInt(&inm,&nreqed);
+        posreqed = inm.pos;
+        _MMG5_skipWords(&inm,nreqed);
         continue;
       } else if(!strncmp(chaine,"Quadrilaterals",strlen("Quadrilaterals"))) {
-        fscanf(inm,"%d",&nq);
-        posnq = ftell(inm);
+        _MMG5_getInt(&inm,&nq);
+        posnq = inm.pos;
+        _MMG5_skipWords(&inm,5*nq);
         continue;
       }
     }
   } else {
     bdim = 0;
-    fread(&mesh->ver,sw,1,inm);
-    iswp=0;
+    _MMG5_getInt(&inm,&mesh->ver);
     if(mesh->ver==16777216)
-      iswp=1;
+      inm.iswp=1;
     else if(mesh->ver!=1) {
       fprintf(stdout,"BAD FILE ENCODING\n");
     }
-    fread(&mesh->ver,sw,1,inm);
-    if(iswp) mesh->ver = MMG_swapbin(mesh->ver);
-    while(fread(&binch,sw,1,inm)!=0 && binch!=54 ) {
-      if(iswp) binch=MMG_swapbin(binch);
-      if(binch==54) break;
+    _MMG5_getInt(&inm,&mesh->ver);
+    while(_MMG5_getInt(&inm,&binch) && binch!=54 ) {
       if(!bdim && binch==3) {  //Dimension
-        fread(&bdim,sw,1,inm);  //NulPos=>20
-        if(iswp) bdim=MMG_swapbin(bdim);
-        fread(&bdim,sw,1,inm);
-        if(iswp) bdim=MMG_swapbin(bdim);
-        mesh->dim = bdim;
-        if(bdim!=2) {
-          fprintf(stdout,"BAD SOL DIMENSION : %d\n",mesh->dim);
-          exit(EXIT_FAILURE);
-          return(1);
+        _MMG5_getInt(&inm,&bdim);  //NulPos=>20
+        _MMG5_getInt(&inm,&bdim);
+        dim = bdim;
+        if(mesh->info.nreg==2 && dim!=3) {
+          fprintf(stdout,"WRONG USE OF -msh \n");
+          _MMG5_closeIn(&inm);
+          return(0);
+        }
+        if(bdim!=2 && bdim!=3) {
+          fprintf(stdout,"BAD DIMENSION : %d\n",bdim);
+          _MMG5_closeIn(&inm);
+          return(0);
         }
         continue;
       } else if(!mesh->np && binch==4) {  //Vertices
-        fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=MMG_swapbin(bpos);
-        fread(&mesh->np,sw,1,inm);
-        if(iswp) mesh->np=MMG_swapbin(mesh->np);
-        posnp = ftell(inm);
-        rewind(inm);
-        fseek(inm,bpos,SEEK_SET);
+        _MMG5_getInt(&inm,&bpos); //NulPos
+        _MMG5_getInt(&inm,&mesh->np);
+        posnp = inm.pos;
+        inm.pos = bpos;
         continue;
       }  else if(!mesh->nt && binch==6) {//MMG5_Triangles
-        fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=MMG_swapbin(bpos);
-        fread(&mesh->nt,sw,1,inm);
-        if(iswp) mesh->nt=MMG_swapbin(mesh->nt);
-        posnt = ftell(inm);
-        rewind(inm);
-        fseek(inm,bpos,SEEK_SET);
+        _MMG5_getInt(&inm,&bpos); //NulPos
+        _MMG5_getInt(&inm,&mesh->nt);
+        posnt = inm.pos;
+        inm.pos = bpos;
         continue;
       } else if(!ncor && binch==13) {
-        fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=MMG_swapbin(bpos);
-        fread(&ncor,sw,1,inm);
-        if(iswp) ncor=MMG_swapbin(ncor);
-        posncor = ftell(inm);
-        rewind(inm);
-        fseek(inm,bpos,SEEK_SET);
+        _MMG5_getInt(&inm,&bpos); //NulPos
+        _MMG5_getInt(&inm,&ncor);
+        posncor = inm.pos;
+        inm.pos = bpos;
         continue;
       } else if(!mesh->na && binch==5) { //Edges
-        fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=MMG_swapbin(bpos);
-        fread(&mesh->na,sw,1,inm);
-        if(iswp) mesh->na=MMG_swapbin(mesh->na);
-        posned = ftell(inm);
-        rewind(inm);
-        fseek(inm,bpos,SEEK_SET);
+        _MMG5_getInt(&inm,&bpos); //NulPos
+        _MMG5_getInt(&inm,&mesh->na);
+        posned = inm.pos;
+        inm.pos = bpos;
         continue;
       } else if(!nreqed && binch==16) { //RequiredEdges
-        fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=MMG_swapbin(bpos);
-        fread(&nreqed,sw,1,inm);
-        if(iswp) nreqed=MMG_swapbin(nreqed);
-        posreqed = ftell(inm);
-        rewind(inm);
-        fseek(inm,bpos,SEEK_SET);
+        _MMG5_getInt(&inm,&bpos); //NulPos
+        _MMG5_getInt(&inm,&nreqed);
+        posreqed = inm.pos;
+        inm.pos = bpos;
         continue;
       } else if(!nreq && binch==15) { //RequiredVertices
-        fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=MMG_swapbin(bpos);
-        fread(&nreq,sw,1,inm);
-        if(iswp) nreq=MMG_swapbin(nreq);
-        posreq = ftell(inm);
-        rewind(inm);
-        fseek(inm,bpos,SEEK_SET);
+        _MMG5_getInt(&inm,&bpos); //NulPos
+        _MMG5_getInt(&inm,&nreq);
+        posreq = inm.pos;
+        inm.pos = bpos;
         continue;
       } else {
-        //printf("on traite ? %d\n",binch);
-        fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=MMG_swapbin(bpos);
-        //printf("on avance... Nulpos %d\n",bpos);
-        rewind(inm);
-        fseek(inm,bpos,SEEK_SET);
+        _MMG5_getInt(&inm,&bpos); //NulPos
+        inm.pos = bpos;
       }
     }
 
   }
+  mesh->dim = 2;
 
   if ( abs(mesh->info.imprim) > 5 )
     fprintf(stdout,"  -- READING DATA FILE %s\n",data);
+  if ( dim == 3 && mesh->info.nreg != 2 && abs(mesh->info.imprim) > 4 )
+    fprintf(stdout,"  -- 3D MESH: THIRD COORDINATE IGNORED\n");
 
   if ( !mesh->np  ) {
     fprintf(stdout,"  ** MISSING DATA : no point\n");
+    _MMG5_closeIn(&inm);
     return(0);
   }
   if (!mesh->nt) {
@@ -280,108 +286,39 @@ int MMG2D_loadMesh(MMG5_pMesh mesh,char *filename) {
   mesh->npi  = mesh->np;
   mesh->nai  = mesh->na;
   mesh->nti  = mesh->nt;
-  if ( !mesh->np ) {
-    fprintf(stdout,"  ** MISSING DATA\n");
-    return(0);
-  }
 
   /* mem alloc */
-  if ( !MMG2_zaldy(mesh) )  return(0);
+  if ( !MMG2_zaldy(mesh) )  {
+    _MMG5_closeIn(&inm);
+    return(0);
+  }
 
   /* read vertices */
-  rewind(inm);
-  fseek(inm,posnp,SEEK_SET);
-  for (k=1; k<=mesh->np; k++) {
-    ppt = &mesh->point[k];
-    if (mesh->ver < 2) { /*float*/
-      if (!bin) {
-        if(mesh->info.nreg==2) {
-          for (i=0 ; i<3 ; i++) {
-            fscanf(inm,"%f",&fc);
-            if(i==2) break;
-            ppt->c[i] = (double) fc;
-          }
-        } else {
-          for (i=0 ; i<2 ; i++) {
-            fscanf(inm,"%f",&fc);
-            ppt->c[i] = (double) fc;
-          }
-        }
-        fscanf(inm,"%d",&ppt->ref);
-      } else {
-        if(mesh->info.nreg==2) {
-          fprintf(stdout,"binary not available with -msh option\n");
-          return(0);
-        }
-        for (i=0 ; i<2 ; i++) {
-          fread(&fc,sw,1,inm);
-          if(iswp) fc=MMG_swapf(fc);
-          ppt->c[i] = (double) fc;
-        }
-        fread(&ppt->ref,sw,1,inm);
-        if(iswp) ppt->ref=MMG_swapbin(ppt->ref);
-      }
-    } else {
-      if (!bin) {
-        if(mesh->info.nreg==2) {
-          fscanf(inm,"%lf %lf %lf %d",&ppt->c[0],&ppt->c[1],&dtmp,&ppt->ref);
-        } else {
-          fscanf(inm,"%lf %lf %d",&ppt->c[0],&ppt->c[1],&ppt->ref);
-        }
-      }
-      else {
-        for (i=0 ; i<2 ; i++) {
-          fread(&ppt->c[i],sd,1,inm);
-          if(iswp) ppt->c[i]=MMG_swapd(ppt->c[i]);
-        }
-        fread(&ppt->ref,sw,1,inm);
-        if(iswp) ppt->ref=MMG_swapbin(ppt->ref);
-      }
-    }
-    ppt->tag = 0;
-    ppt->tag = M_NUL;
-  }
+  strcpy(typ, mesh->ver < 2 ? "ff" : "dd");
+  if ( dim == 3 )  strcat(typ, mesh->ver < 2 ? "F" : "D");
+  strcat(typ,"i");
+  inm.pos = posnp;
+  if ( !_MMG5_getBlock(&inm,mesh->np,typ,_MMG2_getVertex,mesh) )
+    return(_MMG2_loadTrunc(&inm,data));
 
   /* read edges */
-  rewind(inm);
-  fseek(inm,posned,SEEK_SET);
-  for (k=1; k<=mesh->na; k++) {
-    ped = &mesh->edge[k];
-    if (!bin)
-      fscanf(inm,"%d %d %d",&ped->a,&ped->b,&ped->ref);
-    else {
-      fread(&ped->a,sw,1,inm);
-      if(iswp) ped->a=MMG_swapbin(ped->a);
-      fread(&ped->b,sw,1,inm);
-      if(iswp) ped->b=MMG_swapbin(ped->b);
-      fread(&ped->ref,sw,1,inm);
-      if(iswp) ped->ref=MMG_swapbin(ped->ref);
-    }
-  }
+  inm.pos = posned;
+  if ( !_MMG5_getBlock(&inm,mesh->na,"iii",_MMG2_getEdge,mesh) )
+    return(_MMG2_loadTrunc(&inm,data));
 
   /* read triangles */
   if(mesh->nt) {
-    rewind(inm);
-    fseek(inm,posnt,SEEK_SET);
+    inm.pos = posnt;
+    if ( !_MMG5_getBlock(&inm,mesh->nt,"iiii",_MMG2_getTria,mesh) )
+      return(_MMG2_loadTrunc(&inm,data));
+
     norient = 0;
     for (k=1; k<=mesh->nt; k++) {
       pt = &mesh->tria[k];
-      if (!bin)
-        fscanf(inm,"%d %d %d %d",&pt->v[0],&pt->v[1],&pt->v[2],&pt->ref);
-      else {
-        for (i=0 ; i<3 ; i++) {
-          fread(&pt->v[i],sw,1,inm);
-          if(iswp) pt->v[i]=MMG_swapbin(pt->v[i]);
-        }
-        fread(&pt->ref,sw,1,inm);
-        if(iswp) pt->ref=MMG_swapbin(pt->ref);
-      }
       for (i=0; i<3; i++) {
         ppt = &mesh->point[ pt->v[i] ];
         ppt->tag &= ~M_NUL;
       }
-      for(i=0 ; i<3 ; i++)
-        pt->edg[i] = 0;
       air = MMG2_quickarea(mesh->point[pt->v[0]].c,mesh->point[pt->v[1]].c,
                            mesh->point[pt->v[2]].c);
       if(air < 0) {
@@ -401,59 +338,31 @@ int MMG2D_loadMesh(MMG5_pMesh mesh,char *filename) {
     }
   }
 
-  /* read corners*/
-  if (ncor) {
-    rewind(inm);
-    fseek(inm,posncor,SEEK_SET);
-    for (k=1; k<=ncor; k++) {
-      if (!bin)
-        fscanf(inm,"%d",&ref);
-      else {
-        fread(&ref,sw,1,inm);
-        if(iswp) ref=MMG_swapbin(ref);
-      }
-      ppt = &mesh->point[ref];
-      ppt->tag |= M_CORNER;
-    }
+  /* read corners (serially: consecutive records may tag the same point) */
+  inm.pos = posncor;
+  for (k=1; k<=ncor; k++) {
+    if ( !_MMG5_getInt(&inm,&ip) )  return(_MMG2_loadTrunc(&inm,data));
+    mesh->point[ip].tag |= M_CORNER;
   }
 
   /* read required vertices*/
-  if (nreq) {
-    rewind(inm);
-    fseek(inm,posreq,SEEK_SET);
-    for (k=1; k<=nreq; k++) {
-      if (!bin)
-        fscanf(inm,"%d",&ref);
-      else {
-        fread(&ref,sw,1,inm);
-        if(iswp) ref=MMG_swapbin(ref);
-      }
-      ppt = &mesh->point[ref];
-      ppt->tag |= M_REQUIRED;
-    }
+  inm.pos = posreq;
+  for (k=1; k<=nreq; k++) {
+    if ( !_MMG5_getInt(&inm,&ip) )  return(_MMG2_loadTrunc(&inm,data));
+    mesh->point[ip].tag |= M_REQUIRED;
   }
 
   /* read required edges*/
-  if (nreqed) {
-    rewind(inm);
-    fseek(inm,posreqed,SEEK_SET);
-    for (k=1; k<=nreqed; k++) {
-      if (!bin)
-        fscanf(inm,"%d",&ref);
-      else {
-        fread(&ref,sw,1,inm);
-        if(iswp) ref=MMG_swapbin(ref);
-      }
-      ped = &mesh->edge[ref];
-      ped->tag |= M_REQUIRED;
-      ppt = &mesh->point[ped->a];
-      ppt->tag |= M_REQUIRED;
-      ppt = &mesh->point[ped->b];
-      ppt->tag |= M_REQUIRED;
-    }
+  inm.pos = posreqed;
+  for (k=1; k<=nreqed; k++) {
+    if ( !_MMG5_getInt(&inm,&ip) )  return(_MMG2_loadTrunc(&inm,data));
+    ped = &mesh->edge[ip];
+    ped->tag |= M_REQUIRED;
+    mesh->point[ped->a].tag |= M_REQUIRED;
+    mesh->point[ped->b].tag |= M_REQUIRED;
   }
 
-  fclose(inm);
+  _MMG5_closeIn(&inm);
 
   /*maill periodique : remettre toutes les coord entre 0 et 1*/
   if(mesh->info.renum==-10) {
@@ -483,18 +392,16 @@ int MMG2D_loadMesh(MMG5_pMesh mesh,char *filename) {
 
 /* load metric */
 int MMG2D_loadSol(MMG5_pMesh mesh,MMG5_pSol sol,char *filename) {
-  FILE       *inm;
-  float       fsol;
-  double      dsol;
-  int         binch,bdim,iswp;
-  int         k,i,isol,type,bin,dim,btyp,bpos;
-  long        posnp;
-  char        *ptr,data[128],chaine[128];
-  int         msh;
+  _MMG5_Inbuf inm;
+  int         binch,bdim;
+  int         k,type,bin,dim,btyp,bpos;
+  size_t      posnp;
+  char        *ptr,data[128],chaine[128],typ[8];
 
-  msh = mesh->info.nreg;
-
-  bin = 0;
+  bin   = 0;
+  dim   = 2;
+  btyp  = 0;
+  posnp = 0;
 
   strcpy(data,filename);
 
@@ -505,7 +412,7 @@ int MMG2D_loadSol(MMG5_pMesh mesh,MMG5_pSol sol,char *filename) {
 
     if ( ptr )  bin = 1;
 
-    if( !(inm = fopen(data,"rb")) ) {
+    if ( !_MMG5_openIn(&inm,data,bin) ) {
       fprintf(stderr,"  ** %s  NOT FOUND.\n",data);
       return(0);
     }
@@ -517,11 +424,11 @@ int MMG2D_loadSol(MMG5_pMesh mesh,MMG5_pSol sol,char *filename) {
     if ( ptr ) *ptr = '\0';
 
     strcat(data,".solb");
-    if (!(inm = fopen(data,"rb")) ) {
+    if ( !_MMG5_openIn(&inm,data,1) ) {
       ptr  = strstr(data,".solb");
       *ptr = '\0';
       strcat(data,".sol");
-      if (!(inm = fopen(data,"rb")) ) {
+      if ( !_MMG5_openIn(&inm,data,0) ) {
         fprintf(stderr,"  ** %s  NOT FOUND.\n",data);
         return(0);
       }
@@ -533,77 +440,63 @@ int MMG2D_loadSol(MMG5_pMesh mesh,MMG5_pSol sol,char *filename) {
 
   if(!bin) {
     strcpy(chaine,"DDD");
-    while(fscanf(inm,"%s",&chaine[0])!=EOF && strncmp(chaine,"End",strlen("End")) ) {
+    while(_MMG5_getWord(&inm,chaine,128) && strncmp(chaine,"End",strlen("End")) ) {
       if(!strncmp(chaine,"Dimension",strlen("Dimension"))) {
-        fscanf(inm,"%d",&dim);
-        if(dim!=2 && !msh) {
+        _MMG5_getInt(&inm,&dim);
+        if(dim!=2 && dim!=3) {
           fprintf(stdout,"  -- BAD SOL DIMENSION : %d\n",dim);
+          _MMG5_closeIn(&inm);
           return(-1);
-        } else if(dim!=2 && msh) {
-          if(dim==3)
-            fprintf(stdout,"  -- READ 3D SOLUTION : %d\n",dim);
-          else {
-            fprintf(stdout,"  -- BAD SOL DIMENSION : %d\n",dim);
-            return(-1);
-          }
         }
+        else if ( dim==3 )
+          fprintf(stdout,"  -- READ 3D SOLUTION : %d\n",dim);
         continue;
       } else if(!strncmp(chaine,"SolAtVertices",strlen("SolAtVertices"))) {
-        fscanf(inm,"%d",&sol->np);
-        fscanf(inm,"%d",&type);
+        _MMG5_getInt(&inm,&sol->np);
+        _MMG5_getInt(&inm,&type);
         if(type!=1) {
           fprintf(stdout,"SEVERAL SOLUTION => IGNORED : %d\n",type);
+          _MMG5_closeIn(&inm);
           return(-1);
         }
-        fscanf(inm,"%d",&btyp);
-        posnp = ftell(inm);
+        _MMG5_getInt(&inm,&btyp);
+        posnp = inm.pos;
         break;
       }
     }
   } else {
-    fread(&binch,sw,1,inm);
-    iswp=0;
-    if(binch==16777216) iswp=1;
+    _MMG5_getInt(&inm,&binch);
+    if(binch==16777216) inm.iswp=1;
     else if(binch!=1) {
       fprintf(stdout,"BAD FILE ENCODING \n");
     }
-    fread(&sol->ver,sw,1,inm);
-    if(iswp) sol->ver = MMG_swapbin(sol->ver);
-    while(fread(&binch,sw,1,inm)!=EOF && binch!=54 ) {
-      if(iswp) binch=MMG_swapbin(binch);
-      if(binch==54) break;
+    _MMG5_getInt(&inm,&sol->ver);
+    while(_MMG5_getInt(&inm,&binch) && binch!=54 ) {
       if(binch==3) {  //Dimension
-        fread(&bdim,sw,1,inm);  //NulPos=>20
-        if(iswp) bdim=MMG_swapbin(bdim);
-        fread(&bdim,sw,1,inm);
-        if(iswp) bdim=MMG_swapbin(bdim);
+        _MMG5_getInt(&inm,&bdim);  //NulPos=>20
+        _MMG5_getInt(&inm,&bdim);
         dim = bdim;
-        if(bdim!=2) {
+        if(bdim!=2 && bdim!=3) {
           fprintf(stdout,"BAD SOL DIMENSION : %d\n",bdim);
-          exit(EXIT_FAILURE);
+          _MMG5_closeIn(&inm);
           return(-1);
         }
         continue;
       } else if(binch==62) {  //SolAtVertices
-        fread(&binch,sw,1,inm); //NulPos
-        if(iswp) binch=MMG_swapbin(binch);
-        fread(&sol->np,sw,1,inm);
-        if(iswp) sol->np=MMG_swapbin(sol->np);
-        fread(&binch,sw,1,inm); //nb sol
-        if(iswp) binch=MMG_swapbin(binch);
+        _MMG5_getInt(&inm,&binch); //NulPos
+        _MMG5_getInt(&inm,&sol->np);
+        _MMG5_getInt(&inm,&binch); //nb sol
         if(binch!=1) {
-          fprintf(stdout,"SEVERAL SOLUTION => IGNORED : %d\n",type);
+          fprintf(stdout,"SEVERAL SOLUTION => IGNORED : %d\n",binch);
+          _MMG5_closeIn(&inm);
           return(-1);
         }
-        fread(&btyp,sw,1,inm); //typsol
-        if(iswp) btyp=MMG_swapbin(btyp);
-        posnp = ftell(inm);
+        _MMG5_getInt(&inm,&btyp); //typsol
+        posnp = inm.pos;
         break;
       } else {
-        fread(&bpos,sw,1,inm); //Pos
-        if(iswp) bpos=MMG_swapbin(bpos);
-        rewind(inm);
-        fseek(inm,bpos,SEEK_SET);
+        _MMG5_getInt(&inm,&bpos); //Pos
+        inm.pos = bpos;
       }
     }
 
@@ -611,78 +504,127 @@ int MMG2D_loadSol(MMG5_pMesh mesh,MMG5_pSol sol,char *filename) {
 
   if ( !sol->np ) {
     fprintf(stdout,"  ** MISSING DATA.\n");
+    _MMG5_closeIn(&inm);
     return(-1);
   }
   if ( btyp!= 1 && btyp!=3 ) {
     fprintf(stdout,"  ** DATA IGNORED\n");
     sol->size = 1;
     sol->np = 0;
+    _MMG5_closeIn(&inm);
     return(-1);
   }
   sol->size = btyp;
 
   /* mem alloc */
   _MMG5_ADD_MEM(mesh,(sol->size*(mesh->npmax+1))*sizeof(double),
-                "initial solution",return(0));
+                "initial solution",_MMG5_closeIn(&inm);return(0));
   _MMG5_SAFE_CALLOC(sol->m,(sol->size*(mesh->npmax+1)),double);
 
-  /* read mesh solutions */
-  rewind(inm);
-  fseek(inm,posnp,SEEK_SET);
-  for (k=1; k<=sol->np; k++) {
-    isol = (k-1) * sol->size + 1;
-    if (sol->ver == 1) {
-      for (i=0; i<sol->size; i++) {
-        if(!bin){
-          fscanf(inm,"%f",&fsol);
-          sol->m[isol + i] = (double) fsol;
-        } else {
-          fread(&fsol,sw,1,inm);
-          if(iswp) fsol=MMG_swapf(fsol);
-          sol->m[isol + i] = (double) fsol;
-        }
-      }
-      if(dim==3 && (sol->size>1)) {
-        if(!bin){
-          fscanf(inm,"%f",&fsol);
-          fscanf(inm,"%f",&fsol);
-          fscanf(inm,"%f",&fsol);
-        } else {
-          fread(&fsol,sw,1,inm);
-          fread(&fsol,sw,1,inm);
-          fread(&fsol,sw,1,inm);
-        }
-      }
-    } else {
-      for (i=0; i<sol->size; i++) {
-        if(!bin){
-          fscanf(inm,"%lf",&sol->m[isol + i]);
+  /* read mesh solutions: the 3 last components of a 3D tensor are skipped */
+  typ[0] = '\0';
+  for (k=0; k<sol->size; k++)  strcat(typ, sol->ver == 1 ? "f" : "d");
+  if ( dim==3 && sol->size>1 )  strcat(typ, sol->ver == 1 ? "FFF" : "DDD");
 
-        } else {
-          fread(&sol->m[isol + i],sd,1,inm);
-          if(iswp) sol->m[isol + i]=MMG_swapd(sol->m[isol + i]);
-        }
-      }
-      if(dim==3 && (sol->size>1)) {
-        if(!bin){
-          fscanf(inm,"%lf",&dsol);
-          fscanf(inm,"%lf",&dsol);
-          fscanf(inm,"%lf",&dsol);
-        } else {
-          fread(&dsol,sw,1,inm);
-          fread(&dsol,sw,1,inm);
-          fread(&dsol,sw,1,inm);
-        }
-      }
-    }
+  inm.pos = posnp;
+  if ( !_MMG5_getBlock(&inm,sol->np,typ,_MMG2_getSol,sol) ) {
+    return(_MMG2_loadTrunc(&inm,data));
   }
 
   sol->npi = sol->np;
 
-  fclose(inm);
+  _MMG5_closeIn(&inm);
   return(1);
 }
 
+static inline int _MMG2_putInt(char *s,int bin,int val) {
+  if ( !bin )  return(snprintf(s,_MMG5_IOREC,"%d\n",val));
+  memcpy(s,&val,sw);
+  return(sw);
+}
+
+static int _MMG2_putVertex(void *data,int k,char *s) {
+  _MMG2_IOData  *io;
+  MMG5_pPoint   ppt;
+  double        dblb;
+  int           l;
+
+  io  = (_MMG2_IOData*)data;
+  ppt = &io->mesh->point[k];
+  if ( !M_VOK(ppt) )  return(0);
+
+  if ( !io->bin ) {
+    if ( io->msh )
+      return(snprintf(s,_MMG5_IOREC,"%.15lg %.15lg 0. %d\n",
+                      ppt->c[0],ppt->c[1],ppt->ref));
+    return(snprintf(s,_MMG5_IOREC,"%.15lg %.15lg %d\n",
+                    ppt->c[0],ppt->c[1],ppt->ref));
+  }
+  memcpy(s,ppt->c,2*sd);
+  l = 2*sd;
+  if ( io->msh ) {
+    dblb = 0.;
+    memcpy(&s[l],&dblb,sd);
+    l += sd;
+  }
+  memcpy(&s[l],&ppt->ref,sw);
+  return(l+sw);
+}
+
+static int _MMG2_putCorner(void *data,int k,char *s) {
+  _MMG2_IOData  *io;
+  MMG5_pPoint   ppt;
+
+  io  = (_MMG2_IOData*)data;
+  ppt = &io->mesh->point[k];
+  if ( !M_VOK(ppt) || !(ppt->tag & M_CORNER) )  return(0);
+  return(_MMG2_putInt(s,io->bin,ppt->tmp));
+}
+
+static int _MMG2_putRequired(void *data,int k,char *s) {
+  _MMG2_IOData  *io;
+  MMG5_pPoint   ppt;
+
+  io  = (_MMG2_IOData*)data;
+  ppt = &io->mesh->point[k];
+  if ( !M_VOK(ppt) || !(ppt->tag & M_REQUIRED) )  return(0);
+  if ( io->mesh->info.nosurf && (ppt->tag & M_NOSURF) )  return(0);
+  return(_MMG2_putInt(s,io->bin,ppt->tmp));
+}
+
+static int _MMG2_putEdge(void *data,int k,char *s) {
+  _MMG2_IOData  *io;
+  MMG5_pEdge    ped;
+  int           v[3];
+
+  io  = (_MMG2_IOData*)data;
+  ped = &io->mesh->edge[k];
+  if ( !ped->a )  return(0);
+  v[0] = io->mesh->point[ped->a].tmp;
+  v[1] = io->mesh->point[ped->b].tmp;
+  v[2] = ped->ref;
+  if ( !io->bin )
+    return(snprintf(s,_MMG5_IOREC,"%d %d %d\n",v[0],v[1],v[2]));
+  memcpy(s,v,3*sw);
+  return(3*sw);
+}
+
+static int _MMG2_putTria(void *data,int k,char *s) {
+  _MMG2_IOData  *io;
+  MMG5_pTria    pt;
+  int           v[4],i;
+
+  io = (_MMG2_IOData*)data;
+  pt = &io->mesh->tria[k];
+  if ( !M_EOK(pt) )  return(0);
+  for (i=0; i<3; i++)  v[i] = io->mesh->point[pt->v[i]].tmp;
+  v[3] = pt->ref;
+  if ( !io->bin )
+    return(snprintf(s,_MMG5_IOREC,"%d %d %d %d\n",v[0],v[1],v[2],v[3]));
+  memcpy(s,v,4*sw);
+  return(4*sw);
+}
+
 /**
  * \param mesh pointer toward the mesh structure.
  * \param filename name of file.
@@ -698,8 +640,8 @@ int MMG2D_saveMesh(MMG5_pMesh mesh,char *filename) {
   MMG5_pPoint       ppt;
   MMG5_pEdge        ped;
   MMG5_pTria        pt;
-  double            dblb;
-  int               k,ne,ref/*,nn*/,ntang;
+  _MMG2_IOData      io;
+  int               k,ne/*,nn*/,ntang;
   int               bin, binch, bpos;
   char              *ptr,data[128],chaine[128];
 
@@ -733,6 +675,11 @@ int MMG2D_saveMesh(MMG5_pMesh mesh,char *filename) {
   }
   fprintf(stdout,"  %%%% %s OPENED\n",data);
 
+  io.mesh = mesh;
+  io.sol  = NULL;
+  io.bin  = bin;
+  io.msh  = mesh->info.nreg ? 1 : 0;
+
   /*entete fichier*/
   binch=0; bpos=10;
   if (!bin) {
@@ -820,35 +767,7 @@ int MMG2D_saveMesh(MMG5_pMesh mesh,char *filename) {
     fwrite(&bpos,sw,1,inm);
     fwrite(&ne,sw,1,inm);
   }
-  fflush(inm);
-
-  for (k=1; k<=mesh->np; k++) {
-    ppt = &mesh->point[k];
-    if ( M_VOK(ppt) ) {
-      ref = ppt->ref;
-      if(mesh->info.nreg) {
-        if ( !bin )
-          fprintf(inm,"%.15lg %.15lg 0. %d\n",ppt->c[0],ppt->c[1],ref);
-        else {
-          dblb = 0.;
-          fwrite((unsigned char*)&ppt->c[0],sd,1,inm);
-          fwrite((unsigned char*)&ppt->c[1],sd,1,inm);
-          fwrite((unsigned char*)&dblb,sd,1,inm);
-          fwrite((unsigned char*)&ref,sw,1,inm);
-        }
-      } else {
-        if ( !bin ) {
-          fprintf(inm,"%.15lg %.15lg %d\n",ppt->c[0],ppt->c[1],ref);
-          fflush(inm);
-        }
-        else {
-          fwrite(&ppt->c[0],sd,1,inm);
-          fwrite(&ppt->c[1],sd,1,inm);
-          fwrite(&ref,sw,1,inm);
-        }
-      }
-    }
-  }
+  _MMG5_putBlock(inm,mesh->np,_MMG2_putVertex,&io);
 
   /* corners */
   ne = 0;
@@ -872,17 +791,7 @@ int MMG2D_saveMesh(MMG5_pMesh mesh,char *filename) {
       fwrite(&ne,sw,1,inm);
     }
 
-    for (k=1; k<=mesh->np; k++) {
-      ppt = &mesh->point[k];
-      if ( M_VOK(ppt) && (ppt->tag & M_CORNER) /*&& (ppt->tag & M_BDRY)*/) {
-        if(!bin) {
-          fprintf(inm,"%d\n",ppt->tmp);
-        }
-        else {
-          fwrite(&ppt->tmp,sw,1,inm);
-        }
-      }
-    }
+    _MMG5_putBlock(inm,mesh->np,_MMG2_putCorner,&io);
   }
 
   /* required vertex */
@@ -907,19 +816,7 @@ int MMG2D_saveMesh(MMG5_pMesh mesh,char *filename) {
       fwrite(&bpos,sw,1,inm);
       fwrite(&ne,sw,1,inm);
     }
-    for (k=1; k<=mesh->np; k++) {
-      ppt = &mesh->point[k];
-      if ( M_VOK(ppt) ) {
-        if ( mesh->info.nosurf && ( ppt->tag & M_NOSURF )) continue;
-        if ((ppt->tag & M_REQUIRED)
-            /*&& ( (ppt->tag & M_BDRY) || (ppt->tag & M_SD) ) */ ) {
-          if(!bin)
-            fprintf(inm,"%d\n",ppt->tmp);
-          else
-            fwrite(&ppt->tmp,sw,1,inm);
-        }
-      }
-    }
+    _MMG5_putBlock(inm,mesh->np,_MMG2_putRequired,&io);
   }
 
   /* edges */
@@ -945,19 +842,7 @@ int MMG2D_saveMesh(MMG5_pMesh mesh,char *filename) {
       fwrite(&bpos,sw,1,inm);
       fwrite(&ne,sw,1,inm);
     }
-    for (k=1; k<=mesh->na; k++) {
-      ped = &mesh->edge[k];
-      if(!ped->a) continue;
-      ref = ped->ref;
-      if(!bin)
-        fprintf(inm,"%d %d %d\n",mesh->point[ped->a].tmp,mesh->point[ped->b].tmp,ref);
-      else
-      {
-        fwrite(&mesh->point[ped->a].tmp,sw,1,inm);
-        fwrite(&mesh->point[ped->b].tmp,sw,1,inm);
-        fwrite(&ped->ref,sw,1,inm);
-      }
-    }
+    _MMG5_putBlock(inm,mesh->na,_MMG2_putEdge,&io);
 
     /* required edges */
     ne = 0;
@@ -1014,23 +899,7 @@ int MMG2D_saveMesh(MMG5_pMesh mesh,char *filename) {
       fwrite(&bpos,sw,1,inm);
       fwrite(&ne,sw,1,inm);
     }
-    for (k=1; k<=mesh->nt; k++) {
-      pt = &mesh->tria[k];
-      if ( M_EOK(pt) ) {
-        ref = pt->ref;
-        if ( !bin ) {
-          fprintf(inm,"%d %d %d %d\n",mesh->point[pt->v[0]].tmp,
-                  mesh->point[pt->v[1]].tmp,
-                  mesh->point[pt->v[2]].tmp,ref);
-        }
-        else {
-          fwrite(&mesh->point[pt->v[0]].tmp,sw,1,inm);
-          fwrite(&mesh->point[pt->v[1]].tmp,sw,1,inm);
-          fwrite(&mesh->point[pt->v[2]].tmp,sw,1,inm);
-          fwrite(&ref,sw,1,inm);
-        }
-      }
-    }
+    _MMG5_putBlock(inm,mesh->nt,_MMG2_putTria,&io);
   }
 
 
@@ -1298,12 +1167,69 @@ int MMG2_loadVect(MMG5_pMesh mesh,char *filename) {
   /* fclose(inm); */
   return(1);
 }
+static int _MMG2_putSol(void *data,int k,char *s) {
+  _MMG2_IOData  *io;
+  MMG5_pSol     sol;
+  MMG5_pPoint   ppt;
+  float         fsol;
+  double        dsol;
+  int           i,l,isol;
+
+  io  = (_MMG2_IOData*)data;
+  sol = io->sol;
+  ppt = &io->mesh->point[k];
+  if ( !M_VOK(ppt) )  return(0);
+
+  isol = (k-1) * sol->size + 1;
+  l    = 0;
+  if (sol->ver < 2) {
+    if(!io->bin) {
+      for (i=0; i<sol->size; i++)
+        l += snprintf(&s[l],_MMG5_IOREC-l,"%f ",(float)sol->m[isol + i]);
+      if(io->msh && sol->size > 1)
+        l += snprintf(&s[l],_MMG5_IOREC-l,"%f %f %f",0.,0.,1.);
+      s[l++] = '\n';
+    } else {
+      for (i=0; i<sol->size; i++) {
+        fsol = (float) sol->m[isol + i];
+        memcpy(&s[l],&fsol,sw);
+        l += sw;
+      }
+      if(io->msh && sol->size > 1) {
+        for (i=0; i<3; i++) {
+          fsol = ( i==2 ) ? 1 : 0;
+          memcpy(&s[l],&fsol,sw);
+          l += sw;
+        }
+      }
+    }
+  } else {
+    if(!io->bin) {
+      for (i=0; i<sol->size; i++)
+        l += snprintf(&s[l],_MMG5_IOREC-l,"%.15lg ",sol->m[isol + i]);
+      if(io->msh && sol->size > 1)
+        l += snprintf(&s[l],_MMG5_IOREC-l,"%.15lg %.15lg %.15lg",0.,0.,1.);
+      s[l++] = '\n';
+    } else {
+      memcpy(s,&sol->m[isol],sol->size*sd);
+      l = sol->size*sd;
+      if(io->msh && sol->size > 1) {
+        dsol = 0.;
+        for (i=0; i<3; i++) {
+          memcpy(&s[l],&dsol,sd);
+          l += sd;
+        }
+      }
+    }
+  }
+  return(l);
+}
+
 int MMG2D_saveSol(MMG5_pMesh mesh,MMG5_pSol sol,char *filename) {
   FILE*        inm;
-  MMG5_pPoint       ppt;
-  float        fsol;
-  double       dsol;
-  int          i,k,nbl,isol,bin,bpos,typ;
+  MMG5_pPoint  ppt;
+  _MMG2_IOData io;
+  int          k,nbl,bin,bpos,typ;
   char        *ptr,data[128],chaine[128];
   int          binch,msh;
 
@@ -1409,73 +1335,11 @@ int MMG2D_saveSol(MMG5_pMesh mesh,MMG5_pSol sol,char *filename) {
     fwrite(&binch,sw,1,inm);
   }
 
-  for (k=1; k<=mesh->np; k++) {
-    ppt = &mesh->point[k];
-    if ( !M_VOK(ppt) )  continue;
-    isol = (k-1) * sol->size + 1;
-    if (sol->ver < 2) {
-      if(!bin) {
-        if(msh && sol->size > 1) {
-          for (i=0; i<sol->size; i++) {
-            fsol = (float) sol->m[isol + i];
-            fprintf(inm,"%f ",fsol);
-          }
-          fprintf(inm,"%f %f %f",0.,0.,1.);
-        } else {
-          for (i=0; i<sol->size; i++) {
-            fsol = (float) sol->m[isol + i];
-            fprintf(inm,"%f ",fsol);
-          }
-        }
-        fprintf(inm,"\n");
-      } else {
-        if(msh && sol->size > 1) {
-          for (i=0; i<sol->size; i++) {
-            fsol = (float) sol->m[isol + i];
-            fwrite(&fsol,sw,1,inm);
-          }
-          fsol = 0;
-          fwrite(&fsol,sw,1,inm);
-          fsol = 0;
-          fwrite(&fsol,sw,1,inm);
-          fsol = 1;
-          fwrite(&fsol,sw,1,inm);
-        } else {
-          for (i=0; i<sol->size; i++) {
-            fsol = (float) sol->m[isol + i];
-            fwrite(&fsol,sw,1,inm);
-          }
-        }
-      }
-    } else {
-      if(!bin) {
-        if(msh && sol->size > 1) {
-          for (i=0; i<sol->size; i++)
-            fprintf(inm,"%.15lg ",sol->m[isol + i]);
-          fprintf(inm,"%.15lg %.15lg %.15lg",0.,0.,1.);
-        } else {
-          for (i=0; i<sol->size; i++)
-            fprintf(inm,"%.15lg ",sol->m[isol + i]);
-        }
-        fprintf(inm,"\n");
-      } else {
-        if(msh && sol->size > 1) {
-          for (i=0; i<sol->size; i++)
-            fwrite(&sol->m[isol + i],sd,1,inm);
-          dsol = 0.;
-          fwrite(&dsol,sd,1,inm);
-          dsol = 0.;
-          fwrite(&dsol,sd,1,inm);
-          dsol = 0.;
-          fwrite(&dsol,sd,1,inm);
-        } else {
-          for (i=0; i<sol->size; i++)
-            fwrite(&sol->m[isol + i],sd,1,inm);
-        }
-      }
-
-    }
-  }
+  io.mesh = mesh;
+  io.sol  = sol;
+  io.bin  = bin;
+  io.msh  = msh ? 1 : 0;
+  _MMG5_putBlock(inm,mesh->np,_MMG2_putSol,&io);
 
   /*fin fichier*/
   if(!bin) {
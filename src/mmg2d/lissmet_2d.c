@@ -32,209 +32,380 @@
  */
 #include "mmg2d.h"
 
+/** Number of points above which the iso gradation is done by parallel sweeps */
+#define _MMG2_GRADPAR  500000
+/** Maximal number of updates of a point during the aniso gradation */
+#define _MMG2_GRADUPD  100
+
+/**
+ * \param sol pointer toward the metric structure.
+ * \param k index of the point.
+ * \return the smallest size prescribed by the metric at point \a k.
+ *
+ * Heap key of the aniso gradation: the points with the smallest sizes are
+ * treated first.
+ *
+ */
+static inline
+double _MMG2_gradKey_ani(MMG5_pSol sol,int k) {
+  double   *m,tr,det,lmax;
+
+  m    = &sol->m[(k-1)*sol->size + 1];
+  tr   = 0.5*(m[0]+m[2]);
+  det  = 0.25*(m[0]-m[2])*(m[0]-m[2]) + m[1]*m[1];
+  lmax = tr + sqrt(det);
+
+  return( lmax > EPSD ? 1./sqrt(lmax) : DBL_MAX );
+}
+
 /**
- * Anisotropic gradation (h-gradation procedure). See:
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the metric structure.
+ * \param a first extremity of the edge.
+ * \param b second extremity of the edge.
+ * \return 0 if no metric is modified, 1 if the metric of \a a is modified, 2
+ * if the metric of \a b is modified (3 for both).
+ *
+ * Truncate the metrics at the extremities of the edge \f$[a;b]\f$ so that
+ * the size variation along the edge respects the gradation. See:
  * http://www.ann.jussieu.fr/frey/publications/ijnme4398.pdf
+ *
  */
-int lissmet_ani(MMG5_pMesh mesh,MMG5_pSol sol) {
-  HashTable      edgeTable;
-  Hedge         *pht;
-  MMG5_pTria     pt;
+static int
+_MMG2_grad2met_ani(MMG5_pMesh mesh,MMG5_pSol sol,int a,int b) {
   MMG5_pPoint    p1,p2;
-  double         hsiz,logh,logs,*ma,*mb,ux,uy,d1,d2,dd,rap,dh;
-  double         tail,coef,coef1,coef2,ma1[3],mb1[3],m[3],dd1,dd2;
-  int            i,nc,k,itour,maxtou,ncor,a,b,iadr;
+  double         logh,logs,*ma,*mb,ux,uy,d1,d2,dd,rap,dh;
+  double         tail,coef,ma1[3],mb1[3],m[3],dd1,dd2,o[6];
+  int            i,ret;
   double         SQRT3DIV2=0.8660254037844386;
 
-  hsiz   = mesh->info.hgrad;
-  logh   = log(hsiz);
-  logs   = 0.001 + logh;
-  maxtou = 100;
-  ncor   = 0;
-  itour  = 0;
-
-  /*alloc hashtable*/
-  //#warning revoir le dimensionnement!!!!
-  edgeTable.size  = mesh->ntmax;
-  edgeTable.nxtmax = 3*mesh->ntmax+1;
-  edgeTable.hnxt  = mesh->ntmax;
-  _MMG5_SAFE_CALLOC(edgeTable.item,edgeTable.nxtmax,Hedge);
-
-  memset(edgeTable.item,0,edgeTable.nxtmax*sizeof(Hedge));
-  for (k=edgeTable.size; k<edgeTable.nxtmax; k++)
-    edgeTable.item[k].nxt = k+1;
-
-  /*build edge table*/
-  //#warning optimiser!
-  for(k=1 ; k<=mesh->nt ; k++) {
-    pt = &mesh->tria[k];
-    for(i=0 ; i<3 ; i++)
-      MMG2_hashEdge(&edgeTable,k,pt->v[MMG2_iare[i][0]],pt->v[MMG2_iare[i][1]]);
+  logh = log(mesh->info.hgrad);
+  logs = 0.001 + logh;
+
+  p1 = &mesh->point[a];
+  p2 = &mesh->point[b];
+  ma = &sol->m[(a-1)*sol->size + 1];
+  mb = &sol->m[(b-1)*sol->size + 1];
+
+  /* compute edge lengths */
+  ux = p2->c[0] - p1->c[0];
+  uy = p2->c[1] - p1->c[1];
+
+  d1 = ma[0]*ux*ux + ma[2]*uy*uy + 2.0*ma[1]*ux*uy;
+  assert(d1 >=0);
+  if ( d1 < 0.0 )  d1 = 0.0;
+  dd1 = M_MAX(EPSD,sqrt(d1));
+
+  d2 = mb[0]*ux*ux + mb[2]*uy*uy+ 2.0*mb[1]*ux*uy;
+  assert(d2 >=0);
+  if ( d2 < 0.0 )  d2 = 0.0;
+  dd2 = M_MAX(EPSD,sqrt(d2));
+
+  /* swap vertices */
+  if ( dd1 > dd2 ) {
+    dd   = dd1;
+    dd1  = dd2;
+    dd2  = dd;
+    i    = a;
+    a    = b;
+    b    = i;
+    ma   = &sol->m[(a-1)*sol->size + 1];
+    mb   = &sol->m[(b-1)*sol->size + 1];
   }
+  rap = dd2 / dd1;
+  dh = rap - 1.0;
+  if ( fabs(dh) <= EPSD )  return(0);
 
-  /* reset color */
-  for (k=1; k<=mesh->np; k++)
-    (&mesh->point[k])->tagdel = mesh->base+1;
+  // Edge length in the metric
+  tail = (dd1+dd2+4*sqrt(0.5*(d1+d2))) / 6.0;
+  coef = log(rap) / tail;
+  if ( coef <= logs )  return(0);
 
-  /* analyze mesh edges via hash table */
-  do {
-    ++mesh->base;
-    nc = 0;
-    for (k=0; k<edgeTable.size; k++) {
-      pht = &edgeTable.item[k];
-      /* analyze linked list */
-      while ( pht ) {
-        if ( !pht->min )  break;
-        a  = pht->min;
-        b  = pht->max;
-        p1 = &mesh->point[a];
-        p2 = &mesh->point[b];
-        iadr = (a-1)*sol->size + 1;
-        ma   = &sol->m[iadr];
-        iadr = (b-1)*sol->size + 1;
-        mb   = &sol->m[iadr];
-
-        if ( (p1->tagdel < mesh->base) && (p2->tagdel < mesh->base) ) {
-          pht = pht->nxt ? &edgeTable.item[pht->nxt] : 0;
-          continue;
-        }
+  /* update sizes */
+  coef = exp(tail*logh);
+  coef = 1.0 / (coef*coef);
+  for (i=0; i<3; i++) {
+    ma1[i] = coef * ma[i];
+    mb1[i] = coef * mb[i];
+    o[i]   = ma[i];
+    o[i+3] = mb[i];
+  }
 
-        /* compute edge lengths */
-        ux = p2->c[0] - p1->c[0];
-        uy = p2->c[1] - p1->c[1];
-
-        d1 = ma[0]*ux*ux + ma[2]*uy*uy + 2.0*ma[1]*ux*uy;
-        assert(d1 >=0);
-        if ( d1 < 0.0 )  d1 = 0.0;
-        dd1 = M_MAX(EPSD,sqrt(d1));
-
-        d2 = mb[0]*ux*ux + mb[2]*uy*uy+ 2.0*mb[1]*ux*uy;
-        assert(d2 >=0);
-        if ( d2 < 0.0 )  d2 = 0.0;
-        dd2 = M_MAX(EPSD,sqrt(d2));
-
-        /* swap vertices */
-        if ( dd1 > dd2 ) {
-          p1   = &mesh->point[b];
-          p2   = &mesh->point[a];
-          mb   = ma;
-          iadr = (b-1)*sol->size + 1;
-          ma   = &sol->m[iadr];
-          dd   = dd1;
-          dd1  = dd2;
-          dd2  = dd;
-        }
-        rap = dd2 / dd1;
-        dh = rap - 1.0;
-        if ( fabs(dh) > EPSD ) {
-          // Edge length in the metric
-          tail = (dd1+dd2+4*sqrt(0.5*(d1+d2))) / 6.0;
-          coef = log(rap) / tail;
-          p1->tagdel = mesh->base+1;
-          p2->tagdel = mesh->base+1;
-
-          /* update sizes */
-          if ( coef > logs ) {
-            coef      = exp(tail*logh);
-            p1->tagdel = mesh->base;
-            p2->tagdel = mesh->base;
-
-            /*coef1 = exp(dd2*logh);*/
-            coef1 = 1.0 + logh*dd2;
-            coef1 = 1.0 / (coef1*coef1);
-            /*coef2 = exp(dd1*logh);*/
-            coef2 = 1.0 + logh*dd1;
-            coef2 = 1.0 / (coef2*coef2);
-
-            /* metric intersection */
-            coef = 1.0 / (coef*coef);
-            for (i=0; i<3; i++) {
-              ma1[i] = coef * ma[i];
-              mb1[i] = coef * mb[i];
-            }
-
-            if ( _MMG5_intersecmet22(mesh,ma,mb1,m) ) {
-              for (i=0; i<3; i++)  ma[i] = m[i];
-            }
-            else {
-              for (i=0; i<3; i++)  ma[i]  = SQRT3DIV2 * (ma[i]+mb1[i]);
-            }
-            if ( _MMG5_intersecmet22(mesh,ma1,mb,m) ) {
-              for (i=0; i<3; i++)  mb[i] = m[i];
-            }
-            else {
-              for (i=0; i<3; i++)  mb[i] = SQRT3DIV2 * (mb[i]+ma1[i]);
-            }
-            nc++;
-          }
-        }
-        /* next edge */
-        pht = pht->nxt ? &edgeTable.item[pht->nxt] : 0;
+  /* metric intersection */
+  if ( _MMG5_intersecmet22(mesh,ma,mb1,m) ) {
+    for (i=0; i<3; i++)  ma[i] = m[i];
+  }
+  else {
+    for (i=0; i<3; i++)  ma[i]  = SQRT3DIV2 * (ma[i]+mb1[i]);
+  }
+  if ( _MMG5_intersecmet22(mesh,ma1,mb,m) ) {
+    for (i=0; i<3; i++)  mb[i] = m[i];
+  }
+  else {
+    for (i=0; i<3; i++)  mb[i] = SQRT3DIV2 * (mb[i]+ma1[i]);
+  }
+
+  /* report the extremities whose metric really changed */
+  ret = 0;
+  for (i=0; i<3; i++) {
+    if ( fabs(ma[i]-o[i])   > EPSD*(fabs(o[i])+EPSD) )    ret |= ( a < b ) ? 1 : 2;
+    if ( fabs(mb[i]-o[i+3]) > EPSD*(fabs(o[i+3])+EPSD) )  ret |= ( a < b ) ? 2 : 1;
+  }
+  return(ret);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the metric structure.
+ * \return 1 if success, 0 if fail.
+ *
+ * Anisotropic gradation (h-gradation procedure). The metrics are propagated
+ * from the points with the smallest sizes to the largest ones and each point
+ * is updated a bounded number of times.
+ *
+ */
+int lissmet_ani(MMG5_pMesh mesh,MMG5_pSol sol) {
+  MMG5_pTria     pt;
+  MMG5_pPoint    ppt;
+  _MMG5_Heap     heap;
+  int            *adr,*list,*cnt,*seen,base,k,l,ip,ip1,ier,ncor;
+  char           i,j;
+
+  if ( !_MMG2_ballIncid(mesh,&adr,&list) )  return(0);
+
+  if ( !_MMG5_heapNew(mesh,&heap,mesh->np) ) {
+    _MMG2_freeBallIncid(mesh,&adr,&list);
+    return(0);
+  }
+  _MMG5_ADD_MEM(mesh,2*(mesh->np+1)*sizeof(int),"gradation counters",
+                _MMG5_heapFree(mesh,&heap);
+                _MMG2_freeBallIncid(mesh,&adr,&list);return(0));
+  _MMG5_SAFE_CALLOC(cnt,mesh->np+1,int);
+  _MMG5_SAFE_CALLOC(seen,mesh->np+1,int);
+
+  for (k=1; k<=mesh->np; k++) {
+    ppt = &mesh->point[k];
+    if ( !M_VOK(ppt) || adr[k] == adr[k+1] )  continue;
+    _MMG5_heapPush(&heap,k,_MMG2_gradKey_ani(sol,k));
+  }
+
+  ncor = base = 0;
+  while ( (ip = _MMG5_heapPop(&heap)) ) {
+    ++base;
+    for (l=adr[ip]; l<adr[ip+1]; l++) {
+      pt = &mesh->tria[list[l]/3];
+      i  = list[l]%3;
+
+      for (j=1; j<3; j++) {
+        /* each edge of ip is treated once */
+        ip1 = pt->v[MMG2_inxt[i+j-1]];
+        if ( seen[ip1] == base )  continue;
+        seen[ip1] = base;
+
+        ier = _MMG2_grad2met_ani(mesh,sol,MG_MIN(ip,ip1),MG_MAX(ip,ip1));
+        if ( !ier )  continue;
+        ncor++;
+
+        if ( (ier & 1) && ++cnt[MG_MIN(ip,ip1)] <= _MMG2_GRADUPD )
+          _MMG5_heapPush(&heap,MG_MIN(ip,ip1),_MMG2_gradKey_ani(sol,MG_MIN(ip,ip1)));
+        if ( (ier & 2) && ++cnt[MG_MAX(ip,ip1)] <= _MMG2_GRADUPD )
+          _MMG5_heapPush(&heap,MG_MAX(ip,ip1),_MMG2_gradKey_ani(sol,MG_MAX(ip,ip1)));
       }
     }
-    ncor += nc;
-  } while ( nc && ++itour < maxtou );
-  _MMG5_SAFE_FREE(edgeTable.item);
+  }
+
+  _MMG5_DEL_MEM(mesh,seen,(mesh->np+1)*sizeof(int));
+  _MMG5_DEL_MEM(mesh,cnt,(mesh->np+1)*sizeof(int));
+  _MMG5_heapFree(mesh,&heap);
+  _MMG2_freeBallIncid(mesh,&adr,&list);
 
   if ( abs(mesh->info.imprim) > 3 ) {
-    fprintf(stdout,"    gradation: %7d updated, %d iter\n",ncor,itour);
+    fprintf(stdout,"    gradation: %7d updated\n",ncor);
   }
 
   return(1);
 }
 
-int lissmet_iso(MMG5_pMesh mesh,MMG5_pSol sol) {
-  MMG5_pTria     ptt;
-  MMG5_pPoint    p1,p2;
-  double         logh,logs,dd,rap,dh;
-  double    tail,coef;
-  int   i,nc,k,maxtou;
-  int   it,i1,i2;
-  double hmax,ax,ay,lograp;
+/**
+ * \param p1 point of smallest size.
+ * \param p2 point of largest size.
+ * \param h1 size at \a p1.
+ * \param h2 size at \a p2.
+ * \param logh logarithm of the gradation.
+ * \param logs threshold on the size variation.
+ * \return the size allowed at \a p2 by the gradation, \a h2 if the edge
+ * respects the gradation.
+ *
+ */
+static inline
+double _MMG2_gradsiz_iso(MMG5_pPoint p1,MMG5_pPoint p2,double h1,double h2,
+                         double logh,double logs) {
+  double   ax,ay,dd,rap,dh,lograp,tail,coef;
+
+  rap = h2 / h1;
+  dh  = rap - 1.0f;
+  if ( fabs(dh) <= 1e-6 )  return(h2);
+
+  /* compute edge size */
+  ax = p2->c[0] - p1->c[0];
+  ay = p2->c[1] - p1->c[1];
+  dd = sqrt(ax*ax + ay*ay );
+
+  lograp = log(rap);
+  tail   = dd * dh / (h2*lograp);
+  coef   = lograp / tail;
+
+  return( coef > logs ? h1 * exp(tail*logh) : h2 );
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the metric structure.
+ * \param adr addresses of the point balls (see \ref _MMG2_ballIncid).
+ * \param list point balls.
+ * \return the number of updated sizes, -1 if fail.
+ *
+ * Propagate the sizes from the smallest to the largest ones (Dijkstra-like
+ * front). The size of a point popped from the heap is final, so each point is
+ * treated once.
+ *
+ */
+static int
+_MMG2_lissmetHeap_iso(MMG5_pMesh mesh,MMG5_pSol sol,int *adr,int *list) {
+  MMG5_pTria     pt;
+  MMG5_pPoint    p0;
+  _MMG5_Heap     heap;
+  double         logh,logs,hn;
+  int            ip0,ip1,k,nc;
+  char           i,j;
+
+  logh = log(mesh->info.hgrad);
+  logs = 0.01 + logh;
+
+  if ( !_MMG5_heapNew(mesh,&heap,mesh->np) )  return(-1);
+
+  for (k=1; k<=mesh->np; k++) {
+    p0 = &mesh->point[k];
+    if ( !M_VOK(p0) || sol->m[k] < EPSD )  continue;
+    _MMG5_heapPush(&heap,k,sol->m[k]);
+  }
+
+  nc = 0;
+  while ( (ip0 = _MMG5_heapPop(&heap)) ) {
+    p0 = &mesh->point[ip0];
+
+    for (k=adr[ip0]; k<adr[ip0+1]; k++) {
+      pt = &mesh->tria[list[k]/3];
+      i  = list[k]%3;
+
+      for (j=1; j<3; j++) {
+        ip1 = pt->v[MMG2_inxt[i+j-1]];
+        /* size of ip1 is already final */
+        if ( !heap.pos[ip1] || sol->m[ip1] <= sol->m[ip0] )  continue;
+
+        hn = _MMG2_gradsiz_iso(p0,&mesh->point[ip1],sol->m[ip0],sol->m[ip1],
+                               logh,logs);
+        if ( hn < sol->m[ip1] ) {
+          sol->m[ip1] = hn;
+          _MMG5_heapPush(&heap,ip1,hn);
+          nc++;
+        }
+      }
+    }
+  }
+  _MMG5_heapFree(mesh,&heap);
+
+  return(nc);
+}
+
+#ifdef _OPENMP
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the metric structure.
+ * \param adr addresses of the point balls (see \ref _MMG2_ballIncid).
+ * \param list point balls.
+ * \return the number of updated sizes.
+ *
+ * Multithreaded sweeps over the points: each point pulls the smallest size
+ * allowed by its neighbours so that a size is only written by the thread
+ * that owns the point.
+ *
+ */
+static int
+_MMG2_lissmetPar_iso(MMG5_pMesh mesh,MMG5_pSol sol,int *adr,int *list) {
+  MMG5_pTria     pt;
+  MMG5_pPoint    p0;
+  double         logh,logs,h0,h1,hmin;
+  int            ip0,ip1,k,it,maxtou,nc,ncor;
+  char           i,j;
 
-  it     = 0;
   logh   = log(mesh->info.hgrad);
   logs   = 0.01 + logh;
   maxtou = 1000;
 
+  it = ncor = 0;
   do {
-    nc   = 0;
-    hmax = 0.;
-    for(k=1 ; k<=mesh->nt; k++) {
-      ptt = &mesh->tria[k];
-      if(!M_EOK(ptt)) continue;
-      for(i=0 ; i<3 ; i++) {
-        i1 = ptt->v[MMG2_iare[i][0]];
-        i2 = ptt->v[MMG2_iare[i][1]];
-        /* swap vertices */
-        if ( sol->m[i1] > sol->m[i2] ) {
-          i1 = ptt->v[MMG2_iare[i][1]];
-          i2 = ptt->v[MMG2_iare[i][0]];
-        }
-        p1 = &mesh->point[i1];
-        p2 = &mesh->point[i2];
-
-        /* compute edge size */
-        ax = p2->c[0] - p1->c[0];
-        ay = p2->c[1] - p1->c[1];
-
-        rap = sol->m[i2] / sol->m[i1];
-        dh  = rap - 1.0f;
-        dd  = sqrt(ax*ax + ay*ay );
-        if ( fabs(dh) > 1e-6 ) {
-          lograp = log(rap);
-          tail   = dd * dh / (sol->m[i2]*lograp);
-          coef   = lograp / tail;
-
-          /* update sizes */
-          if ( coef > logs ) {
-            sol->m[i2]  = sol->m[i1] * exp(tail*logh);
-            hmax = M_MAX(hmax,sol->m[i2]);
-            nc++;
-          }
+    nc = 0;
+#pragma omp parallel for schedule(dynamic,1024) reduction(+:nc) \
+  private(pt,p0,h0,h1,hmin,ip1,k,i,j)
+    for (ip0=1; ip0<=mesh->np; ip0++) {
+      p0 = &mesh->point[ip0];
+      h0 = sol->m[ip0];
+      if ( !M_VOK(p0) || h0 < EPSD )  continue;
+
+      hmin = h0;
+      for (k=adr[ip0]; k<adr[ip0+1]; k++) {
+        pt = &mesh->tria[list[k]/3];
+        i  = list[k]%3;
+
+        for (j=1; j<3; j++) {
+          ip1 = pt->v[MMG2_inxt[i+j-1]];
+#pragma omp atomic read
+          h1 = sol->m[ip1];
+          if ( h1 < EPSD || h1 >= hmin )  continue;
+
+          hmin = _MMG2_gradsiz_iso(&mesh->point[ip1],p0,h1,hmin,logh,logs);
         }
       }
+      if ( hmin < h0 ) {
+#pragma omp atomic write
+        sol->m[ip0] = hmin;
+        nc++;
+      }
     }
-  } while(nc && it++ < maxtou);
+    ncor += nc;
+  }
+  while ( nc && ++it < maxtou );
+
+  return(ncor);
+}
+#endif
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the metric structure.
+ * \return 1 if success, 0 if fail.
+ *
+ * Isotropic gradation. Large meshes are treated by multithreaded sweeps if
+ * available, the others by front propagation.
+ *
+ */
+int lissmet_iso(MMG5_pMesh mesh,MMG5_pSol sol) {
+  int      *adr,*list,ncor;
+
+  if ( !_MMG2_ballIncid(mesh,&adr,&list) )  return(0);
+
+#ifdef _OPENMP
+  if ( mesh->np > _MMG2_GRADPAR && omp_get_max_threads() > 1 )
+    ncor = _MMG2_lissmetPar_iso(mesh,sol,adr,list);
+  else
+#endif
+    ncor = _MMG2_lissmetHeap_iso(mesh,sol,adr,list);
+
+  _MMG2_freeBallIncid(mesh,&adr,&list);
+  if ( ncor < 0 )  return(0);
+
+  if ( abs(mesh->info.imprim) > 4 )
+    fprintf(stdout,"     gradation: %7d updated.\n",ncor);
   return(1);
 }
@@ -228,93 +228,150 @@ int MMG2_cutEdgeTriangle(MMG5_pMesh mesh,int k,int ia,int ib) {
 }
 
 
-//cherche un des triangles contenant le point ip
-int MMG2_findTria(MMG5_pMesh mesh,int ip) {
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param c coordinates of the point to locate.
+ * \return a triangle close to \a c, 0 if the mesh has no triangle.
+ *
+ * Jump step of the jump-and-walk location: among a sample of about
+ * \f$nt^{1/3}\f$ triangles (picked with a fixed stride), return the one whose
+ * barycenter is the closest to \a c.
+ *
+ */
+static
+int _MMG2_jumpTria(MMG5_pMesh mesh,double c[2]) {
   MMG5_pTria     pt;
-  MMG5_pPoint    ppt,p0,p1,p2;
-  int       find,iel,base,iadr,*adja,isign;
-  double    ax,ay,bx,by,dd,epsra,cx,cy,aire1,aire2,aire3;
-
-  ppt  = &mesh->point[ip];
-  ++mesh->base;
-  base = ++mesh->base;
-  find = 0;
-  iel  = 1;
-  do {
-    pt = &mesh->tria[iel];
-    if ( !M_EOK(pt) )  {
-      iel++;
-      if(iel > mesh->nt) {
-        //fprintf(stdout,"exaustif search\n");
-        return(0);
+  MMG5_pPoint    p0,p1,p2;
+  double         dd,dmin,bx,by;
+  int            k,l,m,step,kmin;
+
+  if ( !mesh->nt )  return(0);
+
+  m    = (int)cbrt((double)mesh->nt) + 1;
+  step = mesh->nt / m + 1;
+  kmin = 0;
+  dmin = DBL_MAX;
+  for (l=0, k=1+(mesh->nt%step)/2; l<m; l++) {
+    pt = &mesh->tria[k];
+    if ( M_EOK(pt) ) {
+      p0 = &mesh->point[pt->v[0]];
+      p1 = &mesh->point[pt->v[1]];
+      p2 = &mesh->point[pt->v[2]];
+      bx = (p0->c[0]+p1->c[0]+p2->c[0])/3. - c[0];
+      by = (p0->c[1]+p1->c[1]+p2->c[1])/3. - c[1];
+      dd = bx*bx + by*by;
+      if ( dd < dmin ) {
+        dmin = dd;
+        kmin = k;
       }
-      continue;
-    }
-    if ( pt->base == base )  {
-      //printf("gloups  pour %d base %d -- %d\n",iel,base,ip);
-      fprintf(stdout,"Warning numerical problem in findTria, please make a bug report\n");
-      return(iel);
-    }
-    /*check not vertex*/
-    if (pt->v[0]==ip || pt->v[1]==ip || pt->v[2]==ip) return(iel);
-    pt->base = base;
-    iadr = 3*(iel-1)+1;
-    adja = &mesh->adja[iadr];
-    /*calcul des coor bary de ip dans le tr iel*/
-    /*det(BM,CM)AM + det(CM,AM)BM + det(AM,BM)CM = 0*/
-    p0 = &mesh->point[pt->v[0]];
-    p1 = &mesh->point[pt->v[1]];
-    p2 = &mesh->point[pt->v[2]];
-
-    ax = p1->c[0] - p0->c[0];
-    ay = p1->c[1] - p0->c[1];
-    bx = p2->c[0] - p0->c[0];
-    by = p2->c[1] - p0->c[1];
-    dd = ax*by - ay*bx;
-    isign = dd > 0.0 ? 1 : -1;
-    epsra = isign * (EPST*dd);
-    /* barycentric */
-    bx = p1->c[0] - ppt->c[0];
-    by = p1->c[1] - ppt->c[1];
-    cx = p2->c[0] - ppt->c[0];
-    cy = p2->c[1] - ppt->c[1];
-
-    /* p in 1 */
-    aire1 = isign*(bx*cy - by*cx);
-    if ( aire1 < epsra && adja[0]) {
-      iel = adja[0] / 3;
-      continue;
     }
+    k += step;
+    if ( k > mesh->nt )  k -= mesh->nt;
+  }
+  if ( kmin )  return(kmin);
 
-    ax = p0->c[0] - ppt->c[0];
-    ay = p0->c[1] - ppt->c[1];
-    aire2 = isign*(cx*ay - cy*ax);
-    if ( aire2 < epsra && adja[1]) {
-      iel = adja[1] / 3;
-      continue;
-    }
+  for (k=1; k<=mesh->nt; k++) {
+    pt = &mesh->tria[k];
+    if ( M_EOK(pt) )  return(k);
+  }
+  return(0);
+}
 
-    //aire3 = -epsra*EPSR - (aire1 + aire2);
-    /*try to be more robust...*/
-    // aire3 = M_MAX(aire3,isign*(bx*ay - by*ax));
-    aire3 = (isign*(ax*by - ay*bx));
-    if ( aire3 < epsra && adja[2]) {
-      iel = adja[2] / 3;
-      continue;
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param ip index of the point to locate.
+ * \param start triangle from which we start the walk.
+ * \return a triangle containing \a ip (or having \a ip as vertex), 0 if the
+ * walk fails.
+ *
+ * Visibility walk toward the point \a ip: we cross the first edge of the
+ * current triangle that separates it from \a ip. The first tested edge
+ * changes at each step and we never go back through the edge from which we
+ * come, so the walk does not need to mark the triangles. It fails if it is
+ * stopped by a boundary edge (non convex mesh) or takes more than \a nt
+ * steps.
+ *
+ */
+static
+int _MMG2_walkTria(MMG5_pMesh mesh,int ip,int start) {
+  MMG5_pTria     pt;
+  double         *a,*b,*c;
+  int            *adja,k,prev,i,i1,nstep,adj;
+
+  c     = mesh->point[ip].c;
+  k     = start;
+  prev  = 0;
+  nstep = 0;
+  while ( ++nstep <= mesh->nt ) {
+    pt = &mesh->tria[k];
+    if ( pt->v[0] == ip || pt->v[1] == ip || pt->v[2] == ip )  return(k);
+
+    adja = &mesh->adja[3*(k-1)+1];
+    for (i=0; i<3; i++) {
+      i1  = MMG2_inxt[nstep%3+i];
+      adj = adja[i1]/3;
+      if ( adj && adj == prev )  continue;
+      a = mesh->point[pt->v[MMG2_iare[i1][0]]].c;
+      b = mesh->point[pt->v[MMG2_iare[i1][1]]].c;
+      if ( (b[0]-a[0])*(c[1]-a[1]) - (b[1]-a[1])*(c[0]-a[0]) < 0. )  break;
     }
-    find = 1;
-    /*aire1 = M_MAX(aire1,0.0);
-      aire2 = M_MAX(aire2,0.0);
-      aire3 = M_MAX(aire3,0.0);
-
-      dd = aire1+aire2+aire3;
-      if ( dd != 0.0 )  dd = 1.0 / dd;
-      cb[0] = aire1 * dd;
-      cb[1] = aire2 * dd;
-      cb[2] = aire3 * dd;*/
-
-  } while (!find);
-  return(iel);
+    if ( i == 3 )  return(k);
+    if ( !adj )    return(0);
+
+    prev = k;
+    k    = adj;
+  }
+  return(0);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param ip index of the point to locate.
+ * \param start triangle from which we start the search (last created
+ * triangle, triangle of a neighbouring point...), 0 if unknown.
+ * \return a triangle containing \a ip (or having \a ip as vertex), 0 if not
+ * found.
+ *
+ * Locate the point \a ip by a visibility walk from the hint \a start or, if
+ * no hint is provided, from the closest triangle of a small sample of the
+ * mesh (jump-and-walk). Fall back to an exhaustive search if the walk fails.
+ *
+ */
+int MMG2_findTriaHint(MMG5_pMesh mesh,int ip,int start) {
+  MMG5_pTria     pt;
+  int            k;
+
+  pt = start > 0 && start <= mesh->nt ? &mesh->tria[start] : NULL;
+  if ( !M_EOK(pt) )
+    start = _MMG2_jumpTria(mesh,mesh->point[ip].c);
+  if ( !start )  return(0);
+
+  k = _MMG2_walkTria(mesh,ip,start);
+  if ( k )  return(k);
+
+  if ( mesh->info.ddebug )
+    printf(" ** exhaustive search of point location.\n");
+
+  for (k=1; k<=mesh->nt; k++) {
+    pt = &mesh->tria[k];
+    if ( !M_EOK(pt) )  continue;
+    if ( pt->v[0] == ip || pt->v[1] == ip || pt->v[2] == ip )  return(k);
+    if ( MMG2_isInTriangle(mesh,k,mesh->point[ip].c) )  return(k);
+  }
+  return(0);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param ip index of the point to locate.
+ * \return a triangle containing \a ip (or having \a ip as vertex), 0 if not
+ * found.
+ *
+ * Locate the point \a ip without hint (jump-and-walk).
+ *
+ */
+int MMG2_findTria(MMG5_pMesh mesh,int ip) {
+  return(MMG2_findTriaHint(mesh,ip,0));
 }
 
 
@@ -168,8 +168,14 @@ void _MMG2_excfun(int sigid) {
 /* } Sol; */
 /* typedef Sol * MMG5_pSol; */
 
+/** Number of buckets of the queue on quality */
+#define MMG2_QBUCK  64
+
 typedef struct squeue {
-  int    *stack,cur;
+  MMG5_pMesh  mesh;
+  double      declic;
+  int         siz,cur,head[MMG2_QBUCK];
+  int        *next,*prev,*buck;
 } Queue;
 typedef Queue * pQueue;
 
@@ -180,21 +186,44 @@ typedef struct {
 } Bucket;
 typedef Bucket * pBucket;
 
-typedef struct {
-  int      min,max,iel,nxt;
-} Hedge;
-
-typedef struct {
-  int      size,nxtmax,hnxt;
-  Hedge    *item;
-} HashTable;
-typedef HashTable * pHashTable;
-
 static const int MMG2_iare[3][2] = {{1,2},{2,0},{0,1}};
 static const int MMG2_iopp[3][2] = {{1,2},{0,2},{0,1}};
 static const unsigned int MMG2_idir[5] = {0,1,2,0,1};
 static const unsigned int MMG2_inxt[5] = {1,2,0,1,2};
 
+/**
+ * \param a first point.
+ * \param b second point.
+ * \param c third point.
+ * \return twice the signed area of the triangle (a,b,c).
+ *
+ */
+static inline
+double _MMG2_orient(double *a,double *b,double *c) {
+  return((b[0]-a[0])*(c[1]-a[1]) - (b[1]-a[1])*(c[0]-a[0]));
+}
+
+/**
+ * \param a first vertex of a direct triangle.
+ * \param b second vertex.
+ * \param c third vertex.
+ * \param d point to test.
+ * \return a positive value if \a d lies strictly inside the circumcircle of
+ * (a,b,c).
+ *
+ */
+static inline
+double _MMG2_incircle(double *a,double *b,double *c,double *d) {
+  double  adx,ady,bdx,bdy,cdx,cdy;
+
+  adx = a[0]-d[0];  ady = a[1]-d[1];
+  bdx = b[0]-d[0];  bdy = b[1]-d[1];
+  cdx = c[0]-d[0];  cdy = c[1]-d[1];
+
+  return( (adx*adx+ady*ady)*(bdx*cdy-cdx*bdy)
+          + (bdx*bdx+bdy*bdy)*(cdx*ady-adx*cdy)
+          + (cdx*cdx+cdy*cdy)*(adx*bdy-bdx*ady) );
+}
 
 /** Reallocation of point table and sol table and creation
     of point ip with coordinates o and tag tag*/
@@ -304,6 +333,8 @@ int MMG2_cendel(MMG5_pMesh ,MMG5_pSol ,double ,int );
 int MMG2_swapar(MMG5_pMesh ,MMG5_pSol ,int ,int ,double ,int *);
 int _MMG5_mmg2dChkmsh(MMG5_pMesh , int, int );
 int MMG2_boulep(MMG5_pMesh , int , int , int * );
+int _MMG2_ballIncid(MMG5_pMesh ,int **,int **);
+void _MMG2_freeBallIncid(MMG5_pMesh ,int **,int **);
 int MMG2_markBdry(MMG5_pMesh );
 int MMG2_doSol(MMG5_pMesh ,MMG5_pSol );
 int MMG2_prilen(MMG5_pMesh ,MMG5_pSol );
@@ -313,6 +344,7 @@ int MMG2_isInTriangle(MMG5_pMesh ,int,double c[2]);
   int MMG2_cutEdge(MMG5_pMesh ,MMG5_pTria ,MMG5_pPoint ,MMG5_pPoint,int );
 int MMG2_cutEdgeTriangle(MMG5_pMesh ,int ,int ,int );
 int MMG2_findTria(MMG5_pMesh ,int );
+int MMG2_findTriaHint(MMG5_pMesh ,int ,int );
 int MMG2_findpos(MMG5_pMesh ,MMG5_pTria ,int ,int ,int ,int ,int );
 int MMG2_locateEdge(MMG5_pMesh ,int ,int ,int* ,int* ) ;
 int MMG2_bdryenforcement(MMG5_pMesh ,MMG5_pSol);
@@ -331,9 +363,7 @@ void MMG2_freeBucket(pBucket bucket);
 int  MMG2_addBucket(MMG5_pMesh mesh,pBucket bucket,int ip);
 int  MMG2_delBucket(MMG5_pMesh mesh,pBucket bucket,int ip);
 
-int MMG2_hashEdge(pHashTable edgeTable,int iel,int ia, int ib);
 int MMG2_hashel(MMG5_pMesh mesh);
-int MMG2_hashNew(HashTable *hash,int hsize,int hmax);
 int MMG2_baseBdry(MMG5_pMesh mesh);
 
 int MMG2_invmat(double *m,double *minv);
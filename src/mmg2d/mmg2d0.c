@@ -49,6 +49,10 @@ int MMG2_mmg2d0(MMG5_pMesh mesh,MMG5_pSol sol) {
     if(!mesh->info.noswap) {
       declic = 1.5 / ALPHA;
       nsiter = MMG2_cendel(mesh,sol,declic,-1);
+      if ( nsiter < 0 ) {
+        fprintf(stdout,"  ## Unable to improve mesh. Exiting.\n");
+        return(0);
+      }
       if ( nsiter && mesh->info.imprim < 0)
         fprintf(stdout,"     %7d SWAPPED\n",nsiter);
 
@@ -60,6 +64,10 @@ int MMG2_mmg2d0(MMG5_pMesh mesh,MMG5_pSol sol) {
       nmiter = MMG2_optlen(mesh,sol,declic,-1);
       if(sol->size==1) nmbar =  optlen_iso_bar(mesh,sol,declic,-1);
       else nmbar=0;
+      if ( nmiter < 0 || nmbar < 0 ) {
+        fprintf(stdout,"  ## Unable to improve mesh. Exiting.\n");
+        return(0);
+      }
       nm += nmiter+nmbar;
       if ( mesh->info.imprim < 0)
         fprintf(stdout,"     %7d + %7d MOVED \n",nmiter,nmbar);
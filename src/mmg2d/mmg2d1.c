@@ -36,6 +36,12 @@
 #define M_LONG     1.4//1.85//1.4//1.421
 #define M_SHORT    0.65//0.8//0.65//0.707
 
+/** Number of points above which the edges are split and collapsed by
+ * independent batches processed concurrently */
+#define _MMG2_ANAPAR  100000
+/** Size of batch under which the remaining edges are processed serially */
+#define _MMG2_ANAMIN  512
+
 int MMG2_invmat(double *m,double *minv) {
   double        det;
 
@@ -343,171 +349,184 @@ static int cassarbdry(MMG5_pMesh mesh,MMG5_pSol sol,int ied,int ia,int ib,double
 }
 
 /**
- * \param mesh poitner toward the mesh structure.
+ * \param mesh pointer toward the mesh structure.
  * \param sol pointer toward the sol structure.
- * \param bucket pointer toward the bucket structure.
- * \param declic quality threshold.
+ * \param nt number of triangles to analyse.
+ * \param ver vertices of the triangles at the time of the analysis.
+ * \param len lengths of the triangle edges.
+ *
+ * Compute concurrently the length of the edges of the triangles \f$1..nt\f$
+ * (the metric and the point positions are not modified by \ref analar so
+ * the lengths stay valid as long as the triangle is unchanged).
+ *
+ */
+static void _MMG2_analarLen(MMG5_pMesh mesh,MMG5_pSol sol,int nt,int *ver,
+                            double *len) {
+  MMG5_pTria    pt;
+  double        *ma,*mb;
+  int           k,i,i1,i2;
+
+#pragma omp parallel for private(pt,i,i1,i2,ma,mb)
+  for (k=1; k<=nt; k++) {
+    pt = &mesh->tria[k];
+    if ( !M_EOK(pt) ) {
+      ver[3*(k-1)] = 0;
+      continue;
+    }
+    for (i=0; i<3; i++) {
+      ver[3*(k-1)+i] = pt->v[i];
+      i1 = pt->v[MMG2_idir[i+1]];
+      i2 = pt->v[MMG2_idir[i+2]];
+      ma = &sol->m[(i1-1)*sol->size + 1];
+      mb = &sol->m[(i2-1)*sol->size + 1];
+      len[3*(k-1)+i] = MMG2_length(mesh->point[i1].c,mesh->point[i2].c,ma,mb);
+    }
+  }
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the sol structure.
+ * \param k triangle to process.
+ * \param len lengths of the edges of \a k (NULL if they must be computed).
  * \param alert if 1, we are unable to create a new vertex.
  * \param ni number of inserted points.
  * \param nc nuber of collapsed points.
- * \return 0 if fail, 1 otherwise.
+ * \return -1 if fail, 1 if an edge of \a k has been split or collapsed, 0
+ * otherwise.
  *
- * Analyse the edges, split the longer and collapse the shorter one.
+ * Split the first long edge or collapse the first short edge of the triangle
+ * \a k that can be.
  *
  */
-static int analar(MMG5_pMesh mesh,MMG5_pSol sol,pBucket bucket,
-                  double declic,int *alert, int *ni, int *nc) {
+static int _MMG2_analarTria(MMG5_pMesh mesh,MMG5_pSol sol,int k,double *len,
+                            int *alert,int *ni,int *nc) {
   MMG5_pTria    pt;
   MMG5_pPoint   ppa,ppb;
   double  *ca,*cb,*ma,*mb,tail,t,tang[2];
-  int     *adja,voi[3],k,iadr,adj,/*base,*/nbp,npp,ip;
-  int     nt,ier;
-  int     i,i1,i2;
+  int     *adja,voi[3],iadr,adj,nbp,ip;
+  int     ier,i,i1,i2;
   int     ins,i0,ii0;
 
-//  base  = ++mesh->base;
-  (*ni)  = 0;
-  (*nc)  = 0;
-  nt  = mesh->nt;
-  npp = 0.0;
+  pt = &mesh->tria[k];
+  if ( !M_EOK(pt) )  return(0);
 
-  for (k=1; k<=nt; k++) {
-    pt = &mesh->tria[k];
-    if ( !M_EOK(pt) )  continue;
-    //else if ( /*pt->flag = base-1 || pt->qual < declic*/ )  continue;
+  /* base internal edges */
+  iadr  = 3*(k-1) + 1;
+  adja  = &mesh->adja[iadr];
+  voi[0] = adja[0];
+  voi[1] = adja[1];
+  voi[2] = adja[2];
+  i0 = 0;
+  if (!voi[1]) i0 = 1;
+  if (!voi[2]) i0 = 2;
+  for (ii0=i0; ii0<i0+3; ii0++) {
+    i = ii0%3;
+    adj = voi[i] / 3;
 
-    /* base internal edges */
-    iadr  = 3*(k-1) + 1;
-    adja  = &mesh->adja[iadr];
-    voi[0] = adja[0];
-    voi[1] = adja[1];
-    voi[2] = adja[2];
-    i0 = 0;
-    if (!voi[1]) i0 = 1;
-    if (!voi[2]) i0 = 2;
-    for (ii0=i0; ii0<i0+3; ii0++) {
-      i = ii0%3;
-      adj = voi[i] / 3;
-
-      i1   = pt->v[MMG2_idir[i+1]];
-      i2   = pt->v[MMG2_idir[i+2]];
-
-      ppa  = &mesh->point[i1];
-      ppb  = &mesh->point[i2];
-      //#warning bad test for edge required
-      if((ppa->tag & M_REQUIRED) && (ppb->tag & M_REQUIRED)) {
-        //printf("edge required %d %d\n",i1,i2);
-        continue;
-      }
-      ca   = &ppa->c[0];
-      cb   = &ppb->c[0];
-      iadr = (i1-1)*sol->size + 1;
-      ma   = &sol->m[iadr];
-      iadr = (i2-1)*sol->size + 1;
-      mb   = &sol->m[iadr];
-      tail = MMG2_length(ca,cb,ma,mb);
-
-      if ( tail > M_LONG && *alert <= 1 ) {
-        npp++;
-        nbp = tail + 0.5;
-        if ( nbp*(nbp+1) < 0.99*tail*tail )  nbp++;
-        t = 1.0 / (float)nbp;
-        if ( nbp < 3 || nbp > 15 )  t = 0.5;
-        if ( !adj || pt->ref != mesh->tria[adj].ref )  {
-          /*add bdry*/
-          if(!pt->edg[i])  {
-            /* if(mesh->info.ddebug) { */
-            /*   printf("tr %d : %d %d %d mais %d\n",k,pt->edg[0],pt->edg[1],pt->edg[2],i); */
-            /*   printf("%d %d %d\n",pt->v[0],pt->v[1],pt->v[2]); */
-            /* } */
-            assert(mesh->tria[adj].ref!=pt->ref);
-            assert((mesh->tria[adj]).edg[voi[i]%3]);
+    i1   = pt->v[MMG2_idir[i+1]];
+    i2   = pt->v[MMG2_idir[i+2]];
+
+    ppa  = &mesh->point[i1];
+    ppb  = &mesh->point[i2];
+    //#warning bad test for edge required
+    if((ppa->tag & M_REQUIRED) && (ppb->tag & M_REQUIRED)) {
+      //printf("edge required %d %d\n",i1,i2);
+      continue;
+    }
+    ca   = &ppa->c[0];
+    cb   = &ppb->c[0];
+    iadr = (i1-1)*sol->size + 1;
+    ma   = &sol->m[iadr];
+    iadr = (i2-1)*sol->size + 1;
+    mb   = &sol->m[iadr];
+    tail = len ? len[i] : MMG2_length(ca,cb,ma,mb);
+
+    if ( tail > M_LONG && *alert <= 1 ) {
+      nbp = tail + 0.5;
+      if ( nbp*(nbp+1) < 0.99*tail*tail )  nbp++;
+      t = 1.0 / (float)nbp;
+      if ( nbp < 3 || nbp > 15 )  t = 0.5;
+      if ( !adj || pt->ref != mesh->tria[adj].ref )  {
+        /*add bdry*/
+        if(!pt->edg[i])  {
+          /* if(mesh->info.ddebug) { */
+          /*   printf("tr %d : %d %d %d mais %d\n",k,pt->edg[0],pt->edg[1],pt->edg[2],i); */
+          /*   printf("%d %d %d\n",pt->v[0],pt->v[1],pt->v[2]); */
+          /* } */
+          assert(mesh->tria[adj].ref!=pt->ref);
+          assert((mesh->tria[adj]).edg[voi[i]%3]);
 //#warning find why we have to do that
-            pt->edg[i] = (mesh->tria[adj]).edg[voi[i]%3];
-          }
-          assert(pt->edg[i]);
-          ip = cassarbdry(mesh,sol,pt->edg[i],i1,i2,0.5,tang);
-        } else {
-          ip = cassar(mesh,sol,i1,i2,t);
+          pt->edg[i] = (mesh->tria[adj]).edg[voi[i]%3];
         }
-        if(ip < 0) {
-          if(mesh->info.imprim > 6)
-            printf("  ## Warning: impossible to create new vertex\n");
-          //return(0);
-          //printf("ahhhhhhhhhhhhhhhh\n");
-          *alert = 2;
-        } else {
-          if ( !adj || pt->ref != mesh->tria[adj].ref )  {
-            /*boundary edge*/
-            if(!adj) {
-              ins = MMG2_splitbdry(mesh,sol,ip,k,i,tang);
-              if(!ins) {
-                _MMG2D_delPt(mesh,ip);
-                continue;
-              }
-              mesh->point[ip].tag |= M_BDRY;
-              (*ni) += 1;
-              break;
-            } else {
-              mesh->point[ip].tag |= M_SD;
-              ins = MMG2_split(mesh,sol,ip,k,voi[i]);
-              if(!ins) {
-                _MMG2D_delPt(mesh,ip);
-                continue;
-              }
-              (*ni) += 1;
-              break;
+        assert(pt->edg[i]);
+        ip = cassarbdry(mesh,sol,pt->edg[i],i1,i2,0.5,tang);
+      } else {
+        ip = cassar(mesh,sol,i1,i2,t);
+      }
+      if(ip < 0) {
+        if(mesh->info.imprim > 6)
+          printf("  ## Warning: impossible to create new vertex\n");
+        //return(0);
+        //printf("ahhhhhhhhhhhhhhhh\n");
+        *alert = 2;
+      } else {
+        if ( !adj || pt->ref != mesh->tria[adj].ref )  {
+          /*boundary edge*/
+          if(!adj) {
+            ins = MMG2_splitbdry(mesh,sol,ip,k,i,tang);
+            if(!ins) {
+              _MMG2D_delPt(mesh,ip);
+              continue;
             }
-            continue;
+            mesh->point[ip].tag |= M_BDRY;
+            (*ni) += 1;
+            return(1);
           } else {
+            mesh->point[ip].tag |= M_SD;
             ins = MMG2_split(mesh,sol,ip,k,voi[i]);
             if(!ins) {
               _MMG2D_delPt(mesh,ip);
               continue;
             }
             (*ni) += 1;
-            break;
+            return(1);
+          }
+        } else {
+          ins = MMG2_split(mesh,sol,ip,k,voi[i]);
+          if(!ins) {
+            _MMG2D_delPt(mesh,ip);
+            continue;
           }
+          (*ni) += 1;
+          return(1);
         }
       }
+    }
 
-      else if ( tail < M_SHORT ) {
-        if ( !adj || pt->ref != mesh->tria[adj].ref )  {
-          if(!adj) {
+    else if ( tail < M_SHORT ) {
+      if ( !adj || pt->ref != mesh->tria[adj].ref )  {
+        if(!adj) {
 
-            ier = MMG2_colpoibdry(mesh,sol,k,i,MMG2_iare[i][0],
-                                  MMG2_iare[i][1],2.75);
-            if ( ier ==-1 ) return(0);
+          ier = MMG2_colpoibdry(mesh,sol,k,i,MMG2_iare[i][0],
+                                MMG2_iare[i][1],2.75);
+          if ( ier ==-1 ) return(-1);
 
+          else if ( !ier ){
+            ier = MMG2_colpoibdry(mesh,sol,k,i,MMG2_iare[i][1],
+                                  MMG2_iare[i][0],2.75);
+            if ( ier==-1 ) return(-1);
             else if ( !ier ){
-              ier = MMG2_colpoibdry(mesh,sol,k,i,MMG2_iare[i][1],
-                                    MMG2_iare[i][0],2.75);
-              if ( ier==-1 ) return(0);
-              else if ( !ier ){
-                continue;
-              } else {
-                (*nc)++;
-                _MMG2D_delPt(mesh,i1);
-                break;
-              }
-            }
-            (*nc)++;
-            _MMG2D_delPt(mesh,i2);
-            break;
-          } else {
-            if(!MMG2_colpoi(mesh,sol,k,i,MMG2_iare[i][0],MMG2_iare[i][1],2.75)) {
-              if(!MMG2_colpoi(mesh,sol,k,i,MMG2_iare[i][1],MMG2_iare[i][0],2.75)) {
-                continue;
-              } else {
-                (*nc)++;
-                _MMG2D_delPt(mesh,i1);
-                break;
-              }
+              continue;
+            } else {
+              (*nc)++;
+              _MMG2D_delPt(mesh,i1);
+              return(1);
             }
-            _MMG2D_delPt(mesh,i2);
-            (*nc)++;
-            break;
           }
+          (*nc)++;
+          _MMG2D_delPt(mesh,i2);
+          return(1);
         } else {
           if(!MMG2_colpoi(mesh,sol,k,i,MMG2_iare[i][0],MMG2_iare[i][1],2.75)) {
             if(!MMG2_colpoi(mesh,sol,k,i,MMG2_iare[i][1],MMG2_iare[i][0],2.75)) {
@@ -515,17 +534,410 @@ static int analar(MMG5_pMesh mesh,MMG5_pSol sol,pBucket bucket,
             } else {
               (*nc)++;
               _MMG2D_delPt(mesh,i1);
-              break;
-
+              return(1);
             }
           }
-          (*nc)++;
           _MMG2D_delPt(mesh,i2);
+          (*nc)++;
+          return(1);
+        }
+      } else {
+        if(!MMG2_colpoi(mesh,sol,k,i,MMG2_iare[i][0],MMG2_iare[i][1],2.75)) {
+          if(!MMG2_colpoi(mesh,sol,k,i,MMG2_iare[i][1],MMG2_iare[i][0],2.75)) {
+            continue;
+          } else {
+            (*nc)++;
+            _MMG2D_delPt(mesh,i1);
+            return(1);
+
+          }
+        }
+        (*nc)++;
+        _MMG2D_delPt(mesh,i2);
+        return(1);
+      }
+    }
+  }
+  return(0);
+}
+
+#ifdef _OPENMP
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the sol structure.
+ * \param n number of splits to do.
+ * \return 0 if we lack of memory, 1 otherwise.
+ *
+ * Enlarge the point, triangle and edge tables so that \a n splits (one point,
+ * two triangles and one edge each) can be done without reallocation. The new
+ * slots are appended at the end of the free lists so that the entities are
+ * created in the same order than after a reallocation by the
+ * _MMG2D_POINT_REALLOC, _MMG5_TRIA_REALLOC and _MMG5_EDGE_REALLOC macros.
+ *
+ */
+static int _MMG2_analarReserve(MMG5_pMesh mesh,MMG5_pSol sol,int n) {
+  double  wgap;
+  int     k,last,oldSiz;
+
+  /* points */
+  if ( mesh->npmax-mesh->np < n+2 ) {
+    oldSiz = mesh->npmax;
+    wgap   = MG_MAX(mesh->gap,(double)(n+2)/oldSiz);
+    _MMG5_TAB_RECALLOC(mesh,mesh->point,mesh->npmax,wgap,MMG5_Point,
+                       "larger point table",return(0));
+    for (k=oldSiz; k<mesh->npmax-1; k++)  mesh->point[k].tmp = k+1;
+    if ( !mesh->npnil )  mesh->npnil = oldSiz;
+    else {
+      for (last=mesh->npnil; mesh->point[last].tmp; last=mesh->point[last].tmp);
+      mesh->point[last].tmp = oldSiz;
+    }
+    if ( sol->m ) {
+      _MMG5_ADD_MEM(mesh,(sol->size*(mesh->npmax-sol->npmax))*sizeof(double),
+                    "larger solution",return(0));
+      _MMG5_SAFE_REALLOC(sol->m,sol->size*(mesh->npmax+1),double,
+                         "larger solution");
+    }
+    sol->npmax = mesh->npmax;
+  }
+
+  /* triangles */
+  if ( mesh->ntmax-mesh->nt < 2*n+2 ) {
+    oldSiz = mesh->ntmax;
+    wgap   = MG_MAX(mesh->gap,(double)(2*n+2)/oldSiz);
+    _MMG5_TAB_RECALLOC(mesh,mesh->tria,mesh->ntmax,wgap,MMG5_Tria,
+                       "larger tria table",return(0));
+    for (k=oldSiz; k<mesh->ntmax-1; k++)  mesh->tria[k].v[2] = k+1;
+    if ( !mesh->nenil )  mesh->nenil = oldSiz;
+    else {
+      for (last=mesh->nenil; mesh->tria[last].v[2]; last=mesh->tria[last].v[2]);
+      mesh->tria[last].v[2] = oldSiz;
+    }
+    _MMG5_ADD_MEM(mesh,3*(mesh->ntmax-oldSiz)*sizeof(int),
+                  "larger adja table",return(0));
+    _MMG5_SAFE_RECALLOC(mesh->adja,3*oldSiz+5,3*mesh->ntmax+5,int,
+                        "larger adja table");
+  }
+
+  /* edges */
+  if ( mesh->namax-mesh->na < n+2 ) {
+    oldSiz = mesh->namax;
+    wgap   = MG_MAX(mesh->gap,(double)(n+2)/oldSiz);
+    _MMG5_TAB_RECALLOC(mesh,mesh->edge,mesh->namax,wgap,MMG5_Edge,
+                       "larger edge table",return(0));
+    for (k=oldSiz; k<mesh->namax-1; k++)  mesh->edge[k].b = k+1;
+    if ( !mesh->nanil )  mesh->nanil = oldSiz;
+    else {
+      for (last=mesh->nanil; mesh->edge[last].b; last=mesh->edge[last].b);
+      mesh->edge[last].b = oldSiz;
+    }
+  }
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the sol structure.
+ * \param k triangle to analyse.
+ * \param len computed lengths of the edges of \a k.
+ * \param alert if 1, we are unable to create a new vertex.
+ * \return the edges of \a k to split (bits 0 to 2) or to collapse (bits 3 to
+ * 5), 0 if none.
+ *
+ */
+static int _MMG2_analarCand(MMG5_pMesh mesh,MMG5_pSol sol,int k,double *len,
+                            int alert) {
+  MMG5_pTria    pt;
+  MMG5_pPoint   ppa,ppb;
+  int           i,i1,i2,cand;
+
+  pt = &mesh->tria[k];
+  if ( !M_EOK(pt) )  return(0);
+
+  cand = 0;
+  for (i=0; i<3; i++) {
+    i1  = pt->v[MMG2_idir[i+1]];
+    i2  = pt->v[MMG2_idir[i+2]];
+    ppa = &mesh->point[i1];
+    ppb = &mesh->point[i2];
+    if ( (ppa->tag & M_REQUIRED) && (ppb->tag & M_REQUIRED) )  continue;
+
+    len[i] = MMG2_length(ppa->c,ppb->c,&sol->m[(i1-1)*sol->size + 1],
+                         &sol->m[(i2-1)*sol->size + 1]);
+    if ( len[i] > M_LONG && alert <= 1 )  cand |= 1 << i;
+    else if ( len[i] < M_SHORT )  cand |= 1 << (i+3);
+  }
+  return(cand);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param k triangle to lock.
+ * \param cand edges of \a k to split or collapse (see \ref _MMG2_analarCand).
+ * \param lock lock of the points (the point \a ip is locked if
+ * \f$lock[ip]=stamp\f$).
+ * \param stamp stamp of the current batch.
+ * \param list work array for the point balls.
+ * \param pts work array for the points to lock.
+ * \return 1 if the points are locked, 0 if one of them is already locked, -1
+ * if the triangle can't be locked.
+ *
+ * Lock the points that a split or a collapse of the edges \a cand of \a k may
+ * read or modify: the vertices of \a k and of its neighbours through the
+ * split edges, and the balls of the ends of the collapsed edges. Each
+ * triangle modified by such an operation (or whose adjacency is updated) has
+ * at least two locked points, so two operations with disjoint locks never
+ * touch the same triangle.
+ *
+ */
+static int _MMG2_analarLock(MMG5_pMesh mesh,int k,int cand,int *lock,int stamp,
+                            int *list,int *pts) {
+  MMG5_pTria    pt,pt1;
+  int           *adja,npts,lon,l,i,j,ball;
+
+  pt   = &mesh->tria[k];
+  adja = &mesh->adja[3*(k-1) + 1];
+  npts = 0;
+  ball = 0;
+
+  for (i=0; i<3; i++) {
+    pts[npts++] = pt->v[i];
+    if ( (cand & (1 << i)) && adja[i] )
+      pts[npts++] = mesh->tria[adja[i]/3].v[adja[i]%3];
+    if ( cand & (1 << (i+3)) )
+      ball |= (1 << MMG2_idir[i+1]) | (1 << MMG2_idir[i+2]);
+  }
+  for (i=0; i<3; i++) {
+    if ( !(ball & (1 << i)) )  continue;
+    lon = MMG2_boulep(mesh,k,i,list);
+    if ( !lon )  return(-1);
+    for (l=1; l<=lon; l++) {
+      pt1 = &mesh->tria[list[l]/3];
+      for (j=0; j<3; j++)  pts[npts++] = pt1->v[j];
+    }
+  }
+
+  for (l=0; l<npts; l++)
+    if ( lock[pts[l]] == stamp )  return(0);
+  for (l=0; l<npts; l++)  lock[pts[l]] = stamp;
+
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the sol structure.
+ * \param alert if 1, we are unable to create a new vertex.
+ * \param ni number of inserted points.
+ * \param nc nuber of collapsed points.
+ * \return 0 if fail, 1 otherwise.
+ *
+ * Multithreaded version of \ref analar: the edges of the triangles are
+ * classified concurrently, then the triangles whose operations are
+ * independent (see \ref _MMG2_analarLock) are selected, the tables are
+ * enlarged for their splits and the batch is split and collapsed
+ * concurrently. The triangles locked out of a batch are analysed again for
+ * the next one, until the batches become too small.
+ *
+ */
+static int _MMG2_analarCol(MMG5_pMesh mesh,MMG5_pSol sol,int *alert,
+                           int *ni,int *nc) {
+  MMG5_pTria    pt;
+  double  *len;
+  int     *lst,*cand,*bat,*lock,*list,*pts;
+  int     nt,nlst,nbat,ncand,nsp,nlock,cap,nins,ncol,ier,alt,a;
+  int     k,l,m,ok,stamp,nbatch,serial;
+
+  (*ni)  = 0;
+  (*nc)  = 0;
+  nt     = mesh->nt;
+  nlock  = mesh->npmax+1;
+
+  _MMG5_ADD_MEM(mesh,3*(nt+1)*sizeof(int)+3*(nt+1)*sizeof(double)
+                +nlock*sizeof(int)+(MMG2D_LMAX+9*MMG2D_LMAX)*sizeof(int),
+                "adaptation batches",return(0));
+  _MMG5_SAFE_MALLOC(lst,nt+1,int);
+  _MMG5_SAFE_MALLOC(cand,nt+1,int);
+  _MMG5_SAFE_MALLOC(bat,nt+1,int);
+  _MMG5_SAFE_MALLOC(len,3*(nt+1),double);
+  _MMG5_SAFE_CALLOC(lock,nlock,int);
+  _MMG5_SAFE_MALLOC(list,MMG2D_LMAX,int);
+  _MMG5_SAFE_MALLOC(pts,9*MMG2D_LMAX,int);
+
+  nlst = 0;
+  for (k=1; k<=nt; k++) {
+    pt = &mesh->tria[k];
+    if ( M_EOK(pt) )  lst[nlst++] = k;
+  }
+
+  ier    = 1;
+  stamp  = 0;
+  nbatch = 0;
+  nbat   = _MMG2_ANAMIN;
+  while ( nlst && ier > 0 ) {
+    /* 1. candidate edges of the remaining triangles */
+#pragma omp parallel for schedule(static) private(k)
+    for (l=0; l<nlst; l++) {
+      k = lst[l];
+      cand[l] = _MMG2_analarCand(mesh,sol,k,&len[3*(k-1)],*alert);
+    }
+
+    /* 2. batch of independent triangles, the others are kept for later. Once
+     * the batches become too small, the remaining triangles are processed by
+     * a last serial pass. */
+    for (l=ncand=0; l<nlst; l++)
+      if ( cand[l] )  ncand++;
+    serial = ( ncand < _MMG2_ANAMIN || nbat < _MMG2_ANAMIN );
+
+    ++stamp;
+    nbat = nsp = m = 0;
+    for (l=0; l<nlst; l++) {
+      if ( !cand[l] )  continue;
+      if ( serial ) {
+        bat[nbat++] = lst[l];
+        continue;
+      }
+      ok = _MMG2_analarLock(mesh,lst[l],cand[l],lock,stamp,list,pts);
+      if ( ok < 0 )  continue;
+      else if ( !ok ) {
+        lst[m]  = lst[l];
+        cand[m] = cand[l];
+        m++;
+        continue;
+      }
+      bat[nbat++] = lst[l];
+      if ( cand[l] & 7 )  nsp++;
+    }
+    nlst = m;
+
+    /* 3. room for the new entities: no reallocation in the parallel pass */
+    if ( nsp ) {
+      if ( _MMG2_analarReserve(mesh,sol,nsp) ) {
+        cap = MG_MIN(mesh->npmax-mesh->np,mesh->namax-mesh->na) - 2;
+        cap = MG_MIN(cap,(mesh->ntmax-mesh->nt-2)/2);
+      }
+      else
+        cap = 0;
+
+      if ( cap < nsp ) {
+        if ( mesh->info.imprim > 6 )
+          printf("  ## Warning: impossible to create new vertex\n");
+        *alert = 2;
+        /* the triangles with long edges are analysed again without splits */
+        for (l=0; l<nbat; l++)  lst[nlst++] = bat[l];
+        continue;
+      }
+      if ( mesh->npmax+1 > nlock ) {
+        ok = 1;
+        _MMG5_ADD_MEM(mesh,(mesh->npmax+1-nlock)*sizeof(int),"point locks",
+                      ok=0);
+        if ( !ok ) {
+          ier = 0;
           break;
         }
+        _MMG5_SAFE_RECALLOC(lock,nlock,mesh->npmax+1,int,"point locks");
+        nlock = mesh->npmax+1;
       }
     }
+
+    /* 4. concurrent splits and collapses of the batch (in the serial pass,
+     * the lengths of the triangles modified by a previous operation are no
+     * more valid) */
+    nins = ncol = 0;
+    alt  = *alert;
+#pragma omp parallel for schedule(dynamic,64) if ( !serial ) private(k,a) \
+  reduction(+:nins,ncol) reduction(min:ier) reduction(max:alt)
+    for (l=0; l<nbat; l++) {
+      k = bat[l];
+      a = MG_MAX(*alert,alt);
+      if ( _MMG2_analarTria(mesh,sol,k,serial ? NULL : &len[3*(k-1)],&a,
+                            &nins,&ncol) < 0 )
+        ier = -1;
+      alt = MG_MAX(alt,a);
+    }
+    (*ni)  += nins;
+    (*nc)  += ncol;
+    *alert  = alt;
+    nbatch++;
   }
+
+  _MMG5_DEL_MEM(mesh,pts,9*MMG2D_LMAX*sizeof(int));
+  _MMG5_DEL_MEM(mesh,list,MMG2D_LMAX*sizeof(int));
+  _MMG5_DEL_MEM(mesh,lock,nlock*sizeof(int));
+  _MMG5_DEL_MEM(mesh,len,3*(nt+1)*sizeof(double));
+  _MMG5_DEL_MEM(mesh,bat,(nt+1)*sizeof(int));
+  _MMG5_DEL_MEM(mesh,cand,(nt+1)*sizeof(int));
+  _MMG5_DEL_MEM(mesh,lst,(nt+1)*sizeof(int));
+  if ( ier <= 0 )  return(0);
+
+  if ( mesh->info.imprim > 5 ) {
+    fprintf(stdout,"    %8d INSERTED %8d COLLAPSED (%d BATCHES)\n",*ni,*nc,
+            nbatch);
+  }
+  return(1);
+}
+#endif
+
+/**
+ * \param mesh poitner toward the mesh structure.
+ * \param sol pointer toward the sol structure.
+ * \param bucket pointer toward the bucket structure.
+ * \param declic quality threshold.
+ * \param alert if 1, we are unable to create a new vertex.
+ * \param ni number of inserted points.
+ * \param nc nuber of collapsed points.
+ * \return 0 if fail, 1 otherwise.
+ *
+ * Analyse the edges, split the longer and collapse the shorter one.
+ *
+ */
+static int analar(MMG5_pMesh mesh,MMG5_pSol sol,pBucket bucket,
+                  double declic,int *alert, int *ni, int *nc) {
+  MMG5_pTria    pt;
+  double  tail,*len;
+  int     k,nt,ier,*ver,valid,i;
+
+#ifdef _OPENMP
+  if ( mesh->np > _MMG2_ANAPAR && omp_get_max_threads() > 1 )
+    return(_MMG2_analarCol(mesh,sol,alert,ni,nc));
+#endif
+
+//  base  = ++mesh->base;
+  (*ni)  = 0;
+  (*nc)  = 0;
+  nt  = mesh->nt;
+  ier = 0;
+
+  /* edge lengths of the current triangles */
+  _MMG5_ADD_MEM(mesh,(3*nt+1)*(sizeof(int)+sizeof(double)),"edge lengths",
+                return(0));
+  _MMG5_SAFE_MALLOC(ver,3*nt+1,int);
+  _MMG5_SAFE_MALLOC(len,3*nt+1,double);
+  _MMG2_analarLen(mesh,sol,nt,ver,len);
+
+  for (k=1; k<=nt; k++) {
+    pt = &mesh->tria[k];
+    if ( !M_EOK(pt) )  continue;
+    //else if ( /*pt->flag = base-1 || pt->qual < declic*/ )  continue;
+
+    /* the triangle may have been modified by a previous split or collapse */
+    valid = ( pt->v[0] == ver[3*(k-1)] && pt->v[1] == ver[3*(k-1)+1]
+              && pt->v[2] == ver[3*(k-1)+2] );
+    if ( valid ) {
+      for (i=0; i<3; i++) {
+        tail = len[3*(k-1)+i];
+        if ( (tail > M_LONG && *alert <= 1) || tail < M_SHORT )  break;
+      }
+      if ( i == 3 )  continue;
+    }
+
+    ier = _MMG2_analarTria(mesh,sol,k,valid ? &len[3*(k-1)] : NULL,alert,
+                           ni,nc);
+    if ( ier == -1 )  break;
+  }
+  _MMG5_DEL_MEM(mesh,len,(3*nt+1)*sizeof(double));
+  _MMG5_DEL_MEM(mesh,ver,(3*nt+1)*sizeof(int));
+  if ( ier == -1 )  return(0);
+
   if ( mesh->info.imprim > 5 ) {
     fprintf(stdout,"    %8d INSERTED %8d COLLAPSED\n",*ni,*nc);
   }
@@ -636,6 +1048,10 @@ int MMG2_mmg2d1(MMG5_pMesh mesh,MMG5_pSol sol) {
     declic = 1.1 / ALPHA;
     base   = mesh->base;
     ns = MMG2_cendel(mesh,sol,declic,base);
+    if ( ns < 0 ) {
+      fprintf(stdout,"  ## Unable to improve mesh. Exiting.\n");
+      return(0);
+    }
     nswp += ns;
     if ( mesh->info.imprim > 5 )
       fprintf(stdout,"  -- %8d SWAPPED\n",ns);
@@ -665,6 +1081,13 @@ int MMG2_mmg2d1(MMG5_pMesh mesh,MMG5_pSol sol) {
     ndel += nc;
     if(!mesh->info.noswap) {
       ns = MMG2_cendel(mesh,sol,declic,mesh->base);
+      if ( ns < 0 ) {
+        fprintf(stdout,"  ## Unable to improve mesh. Exiting.\n");
+        _MMG5_SAFE_FREE(bucket->head);
+        _MMG5_SAFE_FREE(bucket->link);
+        _MMG5_SAFE_FREE(bucket);
+        return(0);
+      }
       nswp += ns;
       if ( mesh->info.imprim > 5 )
         fprintf(stdout,"  -- %8d SWAPPED\n",ns);
@@ -113,315 +113,337 @@ int MMG2_settagtriangles(MMG5_pMesh mesh,MMG5_pSol sol) {
 }
 
 /**
- * \param mesh poitner toward the mesh structure
- * \param sol pointer toward the solution structure
- * \return  0 if fail.
+ * \param mesh pointer toward the mesh structure.
+ * \return index of the new triangle, 0 if fail.
  *
- * Insertion of the list of points inside the mesh
+ * Get a new triangle for the Delaunay insertion (with reallocation of the
+ * triangle and adjacency tables if needed).
  *
  */
-int MMG2_insertpointdelone(MMG5_pMesh mesh,MMG5_pSol sol) {
-  MMG5_pPoint  ppt;
-  //  MMG5_pTria   pt;
-  int     list[MMG2_LONMAX],lon;
-  int     k,i;
-  // int     kk, iadr,*adja,
+static inline
+int _MMG2_newTriaDel(MMG5_pMesh mesh) {
+  int     iel;
 
-  for(k=1 ; k<=mesh->np - 4 ; k++) {
+  iel = _MMG2D_newElt(mesh);
+  if ( !iel ) {
+    _MMG5_TRIA_REALLOC(mesh,iel,mesh->gap,
+                       printf("  ## Error: unable to allocate a new element.\n");
+                       _MMG5_INCREASE_MEM_MESSAGE();
+                       return(0));
+  }
+  mesh->tria[iel].base = mesh->base;
+  return(iel);
+}
 
-    ppt = &mesh->point[k];
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param stack pointer toward the stack of edges to check.
+ * \param siz pointer toward the size of the stack.
+ * \param n number of edges in the stack.
+ * \param code edge to push (3*iel+i).
+ * \return 1 if success, 0 if fail.
+ *
+ * Push an edge on the stack of the Lawson flips, the stack grows if needed.
+ *
+ */
+static inline
+int _MMG2_pushDel(MMG5_pMesh mesh,int **stack,int *siz,int n,int code) {
+  int   newsiz;
+
+  if ( n >= *siz ) {
+    newsiz = 2*(*siz);
+    _MMG5_ADD_MEM(mesh,(newsiz-*siz)*sizeof(int),"flip stack",return(0));
+    _MMG5_SAFE_REALLOC(*stack,newsiz,int,"flip stack");
+    *siz = newsiz;
+  }
+  (*stack)[n] = code;
+  return(1);
+}
 
-    /*recherche du triangle contenant le point : lel*/
-    list[0] = MMG2_findTria(mesh,k);
-    if(!list[0]) {
-      if ( mesh->info.ddebug )
-        printf(" ** exhaustive search of point location.\n");
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param ip index of the inserted point.
+ * \param stack pointer toward the stack of edges to check.
+ * \param siz pointer toward the size of the stack.
+ * \param n number of edges in the stack.
+ * \return 1 if success, 0 if fail.
+ *
+ * Restore the Delaunay property around the new point \a ip by Lawson flips:
+ * the stack contains the edges opposite to \a ip in its ball, each edge
+ * whose other triangle has \a ip in its circumcircle is flipped and the two
+ * new edges opposite to \a ip are stacked.
+ *
+ */
+static
+int _MMG2_flipDel(MMG5_pMesh mesh,int ip,int **stack,int *siz,int n) {
+  MMG5_pTria   pt,pt1;
+  double       *p,*a,*b,*q;
+  int          *adja,*adjb,k,i,i1,i2,kk,j,j1,j2,iq,adt,adu;
+
+  p = mesh->point[ip].c;
+  while ( n > 0 ) {
+    n--;
+    k    = (*stack)[n]/3;
+    i    = (*stack)[n]%3;
+    pt   = &mesh->tria[k];
+    adja = &mesh->adja[3*(k-1)+1];
+    if ( pt->v[i] != ip || !adja[i] )  continue;
+
+    kk   = adja[i]/3;
+    j    = adja[i]%3;
+    pt1  = &mesh->tria[kk];
+    iq   = pt1->v[j];
+    i1   = MMG2_inxt[i];
+    i2   = MMG2_inxt[i+1];
+    j1   = MMG2_inxt[j];
+    j2   = MMG2_inxt[j+1];
+
+    a = mesh->point[pt->v[i1]].c;
+    b = mesh->point[pt->v[i2]].c;
+    q = mesh->point[iq].c;
+    if ( _MMG2_incircle(p,a,b,q) <= 0. )  continue;
+
+    /* the quadrilateral (p,a,q,b) must be convex */
+    if ( _MMG2_orient(p,a,q) <= 0. || _MMG2_orient(q,b,p) <= 0. )  continue;
+
+    /* (p,a,b)+(q,b,a) -> (p,a,q)+(q,b,p) */
+    adjb = &mesh->adja[3*(kk-1)+1];
+    adt  = adjb[j1];
+    adu  = adja[i1];
+
+    pt->v[i2]  = iq;
+    pt1->v[j2] = ip;
+
+    adja[i]  = adt;
+    if ( adt )  mesh->adja[3*(adt/3-1)+1+adt%3] = 3*k+i;
+    adja[i1] = 3*kk+j1;
+
+    adjb[j]  = adu;
+    if ( adu )  mesh->adja[3*(adu/3-1)+1+adu%3] = 3*kk+j;
+    adjb[j1] = 3*k+i1;
+
+    if ( !_MMG2_pushDel(mesh,stack,siz,n++,3*k+i) )  return(0);
+    if ( !_MMG2_pushDel(mesh,stack,siz,n++,3*kk+j2) )  return(0);
+  }
+  return(1);
+}
 
-      for(i = 1 ; i<= mesh->nt ; i++) {
-        list[0] = MMG2_isInTriangle(mesh,i,&ppt->c[0]);
-        if(list[0]) break;
-      }
-      if(i>mesh->nt) {
-        fprintf(stdout,"  ## Error: no triangle found for vertex %d\n",k);
-        return(0);
-      }
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param k triangle in which we insert the point.
+ * \param i local index of the edge on which lies the point (-1 if the point
+ * is strictly inside \a k).
+ * \param ip index of the point to insert.
+ * \param stack pointer toward the stack of edges to check.
+ * \param siz pointer toward the size of the stack.
+ * \param last pointer toward the last created triangle.
+ * \return the number of stacked edges, -1 if fail.
+ *
+ * Split the triangle \a k into 3 triangles (or the triangle \a k and its
+ * neighbour through the edge \a i into 4 triangles) by insertion of \a ip.
+ *
+ */
+static
+int _MMG2_splitDel(MMG5_pMesh mesh,int k,int i,int ip,int **stack,int *siz,
+                   int *last) {
+  int          *adja,old[3],oldk[3],oldkk[3],nt[3],tA,tB,tC,tD,kk,ii,j,l,n;
+
+  if ( i < 0 ) {
+    /* 1 -> 3: the triangle nt[l] is the triangle k whose vertex l is ip */
+    nt[0] = k;
+    nt[1] = _MMG2_newTriaDel(mesh);
+    if ( !nt[1] )  return(-1);
+    nt[2] = _MMG2_newTriaDel(mesh);
+    if ( !nt[2] )  return(-1);
+
+    adja = &mesh->adja[3*(k-1)+1];
+    for (l=0; l<3; l++)  old[l] = adja[l];
+
+    for (l=0; l<3; l++) {
+      if ( l )  memcpy(&mesh->tria[nt[l]],&mesh->tria[k],sizeof(MMG5_Tria));
     }
+    for (l=0; l<3; l++) {
+      mesh->tria[nt[l]].v[l] = ip;
+      adja = &mesh->adja[3*(nt[l]-1)+1];
+      for (j=0; j<3; j++)
+        if ( j != l )  adja[j] = 3*nt[j]+l;
+      adja[l] = old[l];
+      if ( old[l] )  mesh->adja[3*(old[l]/3-1)+1+old[l]%3] = 3*nt[l]+l;
+    }
+    for (l=0; l<3; l++)
+      if ( !_MMG2_pushDel(mesh,stack,siz,l,3*nt[l]+l) )  return(-1);
 
-    lon = _MMG2_cavity(mesh,sol,k,list);
-
-    if ( lon < 1 ) {
-      fprintf(stdout,"  ## Error: unable to insert vertex %d\n",k);
-      return(0);
+    *last = nt[2];
+    return(3);
+  }
 
-    } else {
-      _MMG2_delone(mesh,sol,k,list,lon);
-    }
+  /* 2 -> 4: ip lies on the edge i of k, shared with the edge ii of kk */
+  adja = &mesh->adja[3*(k-1)+1];
+  kk   = adja[i]/3;
+  ii   = adja[i]%3;
+  for (l=0; l<3; l++)  oldk[l] = adja[l];
+  if ( kk ) {
+    adja = &mesh->adja[3*(kk-1)+1];
+    for (l=0; l<3; l++)  oldkk[l] = adja[l];
   }
 
-  return(1);
+  tA = k;
+  tB = _MMG2_newTriaDel(mesh);
+  if ( !tB )  return(-1);
+  memcpy(&mesh->tria[tB],&mesh->tria[tA],sizeof(MMG5_Tria));
+  mesh->tria[tA].v[MMG2_inxt[i+1]] = ip;
+  mesh->tria[tB].v[MMG2_inxt[i]]   = ip;
+
+  adja = &mesh->adja[3*(tA-1)+1];
+  adja[MMG2_inxt[i]] = 3*tB+MMG2_inxt[i+1];
+  adja = &mesh->adja[3*(tB-1)+1];
+  adja[MMG2_inxt[i+1]] = 3*tA+MMG2_inxt[i];
+  adja[MMG2_inxt[i]]   = oldk[MMG2_inxt[i]];
+  l = oldk[MMG2_inxt[i]];
+  if ( l )  mesh->adja[3*(l/3-1)+1+l%3] = 3*tB+MMG2_inxt[i];
+  adja[i] = 0;
+  mesh->adja[3*(tA-1)+1+i] = 0;
+
+  n = 0;
+  if ( !_MMG2_pushDel(mesh,stack,siz,n++,3*tA+MMG2_inxt[i+1]) )  return(-1);
+  if ( !_MMG2_pushDel(mesh,stack,siz,n++,3*tB+MMG2_inxt[i]) )    return(-1);
+  *last = tB;
+
+  if ( !kk )  return(n);
+
+  tC = kk;
+  tD = _MMG2_newTriaDel(mesh);
+  if ( !tD )  return(-1);
+  memcpy(&mesh->tria[tD],&mesh->tria[tC],sizeof(MMG5_Tria));
+  mesh->tria[tC].v[MMG2_inxt[ii+1]] = ip;
+  mesh->tria[tD].v[MMG2_inxt[ii]]   = ip;
+
+  adja = &mesh->adja[3*(tC-1)+1];
+  adja[MMG2_inxt[ii]] = 3*tD+MMG2_inxt[ii+1];
+  adja[ii]            = 3*tB+i;
+  adja = &mesh->adja[3*(tD-1)+1];
+  adja[MMG2_inxt[ii+1]] = 3*tC+MMG2_inxt[ii];
+  adja[MMG2_inxt[ii]]   = oldkk[MMG2_inxt[ii]];
+  l = oldkk[MMG2_inxt[ii]];
+  if ( l )  mesh->adja[3*(l/3-1)+1+l%3] = 3*tD+MMG2_inxt[ii];
+  adja[ii]            = 3*tA+i;
+  mesh->adja[3*(tA-1)+1+i] = 3*tD+ii;
+  mesh->adja[3*(tB-1)+1+i] = 3*tC+ii;
+
+  if ( !_MMG2_pushDel(mesh,stack,siz,n++,3*tC+MMG2_inxt[ii+1]) )  return(-1);
+  if ( !_MMG2_pushDel(mesh,stack,siz,n++,3*tD+MMG2_inxt[ii]) )    return(-1);
+
+  return(n);
 }
 
-/*insertion of the list of points inside the mesh*/
-/*return 0 if pbs occur*/
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the solution structure.
+ * \return 0 if fail, 1 if success.
+ *
+ * Incremental Delaunay triangulation of the mesh vertices inside the
+ * bounding box triangles. The points are inserted following a biased
+ * randomized order (Hilbert sort by rounds), each point is located by a
+ * visibility walk from the last created triangle, its host triangle (or its
+ * host edge) is split and the Delaunay property is restored by Lawson flips
+ * around the new point only.
+ *
+ */
 int MMG2_insertpoint(MMG5_pMesh mesh,MMG5_pSol sol) {
-  MMG5_pTria   pt,pt1;
+  MMG5_pTria   pt;
   MMG5_pPoint  ppt;
-  double  declic;
-  int     k,nsiter,lel,mel,nel,ia,ib,ic,aext0,aext1,aext2;
-  int     iadr,*adja,nflat,ie1,ie2,ie3,voy,text,atext1,atext2;
-  double  EPSDD = 1e+6;
-
-  for(k=1 ; k<=mesh->np - 4 ; k++) {
-    if(1){
-      if(mesh->info.ddebug) printf("------------------------------------try swap to increase mesh quality\n");
-      declic = 1.1 / ALPHA;
-      nsiter = 1;
-      while (nsiter) {
-        nsiter = MMG2_cendel(mesh,sol,declic,-1);
-        if ( nsiter && mesh->info.imprim < 0)
-          fprintf(stdout,"     %7d SWAPPED\n",nsiter);
-      }
-    }
+  double       *c,*a,*b,o[3];
+  int          *perm,*stack,siz,np,n,k,ip,i,j,iel,last,ier;
+
+  np = mesh->np - 4;
+  _MMG5_ADD_MEM(mesh,np*sizeof(int),"insertion order",return(0));
+  _MMG5_SAFE_MALLOC(perm,np,int);
+  _MMG5_ADD_MEM(mesh,2*np*sizeof(double),"insertion order",
+                _MMG5_DEL_MEM(mesh,perm,np*sizeof(int));
+                return(0));
+  _MMG5_SAFE_MALLOC(c,2*np,double);
+
+  n = 0;
+  for (k=1; k<=np; k++) {
     ppt = &mesh->point[k];
-    if(ppt->tmp==1) continue;
-    /*recherche du triangle contenant le point : lel*/
-    lel = MMG2_findTria(mesh,k);
-    assert(lel);
-
-    nflat = 0; // to avoid bad triangle  1, 2, 4, 3, 5, 7
-    pt  = &mesh->tria[lel];
-    iadr = 3*(lel-1) + 1;
-    adja = &mesh->adja[iadr];
-    ia  = pt->v[0];
-    ib  = pt->v[1];
-    ic  = pt->v[2];
-    aext0 = adja[0];
-    aext1 = adja[1];
-    aext2 = adja[2];
-
-    /*creation de trois triangles*/
-    mel = _MMG2D_newElt(mesh);
-    if ( !mel ) {
-      _MMG5_TRIA_REALLOC(mesh,mel,mesh->gap,
-                         printf("  ## Error: unable to allocate a new element.\n");
-                         _MMG5_INCREASE_MEM_MESSAGE();
-                         printf("  Exit program.\n");
-                         exit(EXIT_FAILURE));
-      pt  = &mesh->tria[lel];
-    }
-    nel = _MMG2D_newElt(mesh);
-    if ( !nel ) {
-      _MMG5_TRIA_REALLOC(mesh,mel,mesh->gap,
-                         printf("  ## Error: unable to allocate a new element.\n");
-                         _MMG5_INCREASE_MEM_MESSAGE();
-                         printf("  Exit program.\n");
-                         exit(EXIT_FAILURE));
-      pt  = &mesh->tria[lel];
-    }
-    pt->v[2] = k;
-    pt->qual = MMG2_caltri_in(mesh,sol,pt);
-    if(pt->qual > EPSDD) {
-      nflat = 1;
-    } else {
-      adja[0] = 3*nel + 1;
-      adja[1] = 3*mel + 0;
-      if(aext2)
-        (&mesh->adja[3*(aext2/3-1) + 1])[aext2%3] = 3*lel + 2;
-      //printf("adj of %d : %d %d %d -- %d(%d) : %d\n",lel,nel,mel,aext2/3,aext2/3,aext2%2,lel);
-    }
-    pt  = &mesh->tria[nel];
-    pt->base = mesh->base;
-    iadr = 3*(nel-1) + 1;
-    adja = &mesh->adja[iadr];
-    pt->v[0] = ib;
-    pt->v[1] = ic;
-    pt->v[2] = k;
-    pt->qual = MMG2_caltri_in(mesh,sol,pt);
-    if(pt->qual > EPSDD) {
-      nflat += 2;
-    } else {
-      adja[0] = 3*mel + 1;
-      adja[1] = 3*lel + 0;
-      adja[2] = aext0;
-      if(aext0)
-        (&mesh->adja[3*(aext0/3-1) + 1])[aext0%3] = 3*nel + 2;
-      //printf("adj of %d : %d %d %d -- %d(%d) : %d\n",nel,mel,lel,aext0/3,aext0/3,aext0%3,nel);
-    }
-    pt  = &mesh->tria[mel];
-    pt->base = mesh->base;
-    iadr = 3*(mel-1) + 1;
-    adja = &mesh->adja[iadr];
-    pt->v[0] = ic;
-    pt->v[1] = ia;
-    pt->v[2] = k;
-    pt->qual = MMG2_caltri_in(mesh,sol,pt);
-    if(pt->qual > EPSDD) {
-      nflat += 4;
-      /*on coupe le tr aext1 en 2*/
-      text = aext1/3;
-      voy  = aext1%3;
-      pt1  = &mesh->tria[text];
-      ie1  = pt1->v[voy];
-      ie2  = pt1->v[MMG2_inxt[voy]];
-      ie3  = pt1->v[MMG2_inxt[voy+1]];
-      pt1->v[0] = ie1;
-      pt1->v[1] = ie2;
-      pt1->v[2] = k;
-      pt1->qual = MMG2_caltri_in(mesh,sol,pt1);
-      pt->v[0] = ie3;
-      pt->v[1] = ie1;
-      pt->v[2] = k;
-      pt->qual = MMG2_caltri_in(mesh,sol,pt);
-      /*maj des adj*/
-      /*text*/
-      iadr = 3*(text-1) + 1;
-      adja = &mesh->adja[iadr];
-      atext1 = adja[MMG2_inxt[voy]];
-      atext2 = adja[MMG2_inxt[voy+1]];
-      adja[0] = 3*lel + 1;
-      adja[1] = 3*mel + 0;
-      adja[2] = atext2;
-      if(atext2)
-        (&mesh->adja[3*(atext2/3-1) + 1])[atext2%3] = 3*text + 2;
-      //if(ddebug) printf("adj of %d : %d %d %d \n",text,adja[0]/3,adja[1]/3,adja[2]/3);
-      /*mel*/
-      iadr = 3*(mel-1) + 1;
-      adja = &mesh->adja[iadr];
-      adja[0] = 3*text + 1;
-      adja[1] = 3*nel + 0;
-      adja[2] = atext1;
-      if(atext1)
-        (&mesh->adja[3*(atext1/3-1) + 1])[atext1%3] = 3*mel + 2;
-      if(nflat==6 /*|| (*adj)==7*/) {//CECILE 14/04/14:*adj ne veut rien dire!!!
-        adja[1] = 3*(aext0/3);
-        //pas de suite sinon on perd de l'info (&mesh->adja[3*(aext0/3-1) + 1])[0] = 3*mel + 1;
-
-      } else {
-        /*nel*/
-        iadr = 3*(nel-1) + 1;
-        adja = &mesh->adja[iadr];
-        adja[0] = 3*mel + 1;
-      }
-
-      /*lel*/
-      iadr = 3*(lel-1) + 1;
-      adja = &mesh->adja[iadr];
-      adja[1] = 3*text + 0;
+    /* periodic image of an already inserted point */
+    if ( mesh->info.renum == -10 && ppt->tmp == 1 )  continue;
+    c[2*n]   = ppt->c[0];
+    c[2*n+1] = ppt->c[1];
+    perm[n++] = k;
+  }
+  ier = _MMG5_brioSort(mesh,n,2,c,perm);
+  _MMG5_DEL_MEM(mesh,c,2*np*sizeof(double));
+  if ( !ier ) {
+    _MMG5_DEL_MEM(mesh,perm,np*sizeof(int));
+    return(0);
+  }
 
-    } else {
-      adja[0] = 3*lel + 1;
-      adja[1] = 3*nel + 0;
-      adja[2] = aext1;
-      if(aext1)
-        (&mesh->adja[3*(aext1/3-1) + 1])[aext1%3] = 3*mel + 2;
-      //printf("adj of %d : %d %d %d -- %d(%d) : %d\n",mel,lel,nel,aext1/3,aext1/3,aext1%3,mel);
+  siz = 64;
+  _MMG5_ADD_MEM(mesh,siz*sizeof(int),"flip stack",
+                _MMG5_DEL_MEM(mesh,perm,np*sizeof(int));
+                return(0));
+  _MMG5_SAFE_MALLOC(stack,siz,int);
 
+  last = 0;
+  for (k=1; k<=mesh->nt; k++) {
+    pt = &mesh->tria[k];
+    if ( M_EOK(pt) ) {
+      last = k;
+      break;
     }
-    if(nflat==1 || nflat==3 || nflat==7 || nflat==5){
-      /*on coupe le tr aext2 en 2*/
-      text = aext2/3;
-      voy  = aext2%3;
-      pt1  = &mesh->tria[text];
-      ie1  = pt1->v[voy];
-      ie2  = pt1->v[MMG2_inxt[voy]];
-      ie3  = pt1->v[MMG2_inxt[voy+1]];
-      pt1->v[0] = ie1;
-      pt1->v[1] = ie2;
-      pt1->v[2] = k;
-      pt1->qual = MMG2_caltri_in(mesh,sol,pt1);
-      pt = &mesh->tria[lel];
-      pt->v[0] = ie3;
-      pt->v[1] = ie1;
-      pt->v[2] = k;
-      pt->qual = MMG2_caltri_in(mesh,sol,pt);
-      /*maj des adj*/
-      /*text*/
-      iadr = 3*(text-1) + 1;
-      adja = &mesh->adja[iadr];
-      atext1 = adja[MMG2_inxt[voy]];
-      atext2 = adja[MMG2_inxt[voy+1]];
-      adja[0] = 3*nel + 1;
-      adja[1] = 3*lel + 0;
-      adja[2] = atext2;
-      if(atext2)
-        (&mesh->adja[3*(atext2/3-1) + 1])[atext2%3] = 3*text + 2;
-
-      /*lel*/
-      iadr = 3*(lel-1) + 1;
-      adja = &mesh->adja[iadr];
-      adja[0] = 3*text + 1;
-      adja[1] = 3*mel + 0;
-      adja[2] = atext1;
-      if(atext1)
-        (&mesh->adja[3*(atext1/3-1) + 1])[atext1%3] = 3*lel + 2;
-      if(nflat==5 || nflat==7) {
-        adja[1] = 3*(aext1/3);
-        if(aext1)
-          (&mesh->adja[3*(aext1/3-1) + 1])[0] = 3*lel + 1;
-      }
-
-      /*nel*/
-      iadr = 3*(nel-1) + 1;
-      adja = &mesh->adja[iadr];
-      adja[1] = 3*text + 0;
+  }
 
-      /*mel*/
-      iadr = 3*(mel-1) + 1;
-      adja = &mesh->adja[iadr];
-      if(!(nflat==5 || nflat==7))
-        adja[0] = 3*lel + 1;
+  for (k=0; k<n; k++) {
+    ip  = perm[k];
+    ppt = &mesh->point[ip];
+
+    iel = MMG2_findTriaHint(mesh,ip,last);
+    ier = 0;
+    if ( iel ) {
+      pt = &mesh->tria[iel];
+      for (i=0; i<3; i++) {
+        a = mesh->point[pt->v[i]].c;
+        if ( a[0] == ppt->c[0] && a[1] == ppt->c[1] )  ier = 1;
+      }
+    }
+    if ( !iel || ier ) {
+      fprintf(stdout,"  ## Error: unable to insert vertex %d\n",ip);
+      ier = 0;
+      break;
+    }
 
+    /* point on an edge of iel ? */
+    pt = &mesh->tria[iel];
+    for (i=0; i<3; i++) {
+      a    = mesh->point[pt->v[MMG2_iare[i][0]]].c;
+      b    = mesh->point[pt->v[MMG2_iare[i][1]]].c;
+      o[i] = _MMG2_orient(a,b,ppt->c);
     }
-    if(nflat==2 || nflat==3 || nflat==7 || nflat == 6){
-      /*on coupe le tr aext0 en 2*/
-      text = aext0/3;
-      voy  = aext0%3;
-      pt1  = &mesh->tria[text];
-      ie1  = pt1->v[voy];
-      ie2  = pt1->v[MMG2_inxt[voy]];
-      ie3  = pt1->v[MMG2_inxt[voy+1]];
-      pt1->v[0] = ie1;
-      pt1->v[1] = ie2;
-      pt1->v[2] = k;
-      pt1->qual = MMG2_caltri_in(mesh,sol,pt1);
-      pt = &mesh->tria[nel];
-      pt->v[0] = ie3;
-      pt->v[1] = ie1;
-      pt->v[2] = k;
-      pt->qual = MMG2_caltri_in(mesh,sol,pt);
-      /*maj des adj*/
-      /*text*/
-      iadr = 3*(text-1) + 1;
-      adja = &mesh->adja[iadr];
-      atext1 = adja[MMG2_inxt[voy]];
-      atext2 = adja[MMG2_inxt[voy+1]];
-      adja[0] = 3*mel + 1;
-      adja[1] = 3*nel + 0;
-      adja[2] = atext2;
-      if(atext2)
-        (&mesh->adja[3*(atext2/3-1) + 1])[atext2%3] = 3*text + 2;
-      /*nel*/
-      iadr = 3*(nel-1) + 1;
-      adja = &mesh->adja[iadr];
-      adja[0] = 3*text + 1;
-      adja[1] = 3*lel + 0;
-      adja[2] = atext1;
-      if(atext1)
-        (&mesh->adja[3*(atext1/3-1) + 1])[atext1%3] = 3*nel + 2;
-      if (nflat==3 || nflat==7) {
-        adja[1] = 3*(aext2/3);
-        //(&mesh->adja[3*(aext2/3-1) + 1])[aext2%3] = 3*nel + 1;
-      }
+    for (i=0; i<3; i++)
+      if ( o[i] <= 0. )  break;
 
-      /*mel*/
-      iadr = 3*(mel-1) + 1;
-      adja = &mesh->adja[iadr];
-      adja[1] = 3*text + 0;
+    j = _MMG2_splitDel(mesh,iel,i<3 ? i : -1,ip,&stack,&siz,&last);
+    if ( j < 0 || !_MMG2_flipDel(mesh,ip,&stack,&siz,j) ) {
+      ier = 0;
+      break;
     }
-    if(mesh->info.ddebug) {
+    ier = 1;
+
+    if ( mesh->info.ddebug ) {
       if ( !_MMG5_chkmsh(mesh,0,0) ) exit(EXIT_FAILURE);
     }
+  }
+  if ( !n )  ier = 1;
 
+  _MMG5_DEL_MEM(mesh,stack,siz*sizeof(int));
+  _MMG5_DEL_MEM(mesh,perm,np*sizeof(int));
+  if ( !ier )  return(0);
+
+  for (k=1; k<=mesh->nt; k++) {
+    pt = &mesh->tria[k];
+    if ( !M_EOK(pt) )  continue;
+    pt->qual = MMG2_caltri_in(mesh,sol,pt);
   }
   return(1);
 }
@@ -431,10 +453,23 @@ int MMG2_markSD(MMG5_pMesh mesh) {
   MMG5_pTria   pt,pt1;
   MMG5_pEdge   ped;
   MMG5_pPoint  ppt;
-  int     k,i,j,iadr,*adja,ped0,ped1,*list,ipil,ncurc,nref;
+  int     k,i,iadr,*adja,ped0,ped1,*list,ipil,ncurc,nref;
   int     kinit,nt,nsd,ip1,ip2,ip3,ip4,ned,iel,voy;
+  _MMG5_Hash edgeT;
 
   if ( !MMG2_hashel(mesh) )  return(0);
+
+  /* constrained edges stop the sub-domain propagation */
+  if ( !_MMG5_hashNew(mesh,&edgeT,mesh->na+1) )  return(0);
+  for(k=1 ; k<=mesh->na ; k++) {
+    ped = &mesh->edge[k];
+    if ( !ped->a ) continue;
+    if ( !_MMG5_hashEdge(mesh,&edgeT,ped->a,ped->b,k) ) {
+      _MMG5_DEL_MEM(mesh,edgeT.item,edgeT.siz*sizeof(_MMG5_hedge));
+      return(0);
+    }
+  }
+
   for(k=1 ; k<=mesh->nt ; k++) mesh->tria[k].flag = mesh->mark;
   _MMG5_SAFE_CALLOC(list,mesh->nt,int);
   kinit = 0;
@@ -465,12 +500,7 @@ int MMG2_markSD(MMG5_pMesh mesh) {
         if(pt1->ref==nref) continue;
         ped0 = pt->v[MMG2_iare[i][0]];
         ped1 = pt->v[MMG2_iare[i][1]];
-//#warning optimize th
-        for(j=1 ; j<=mesh->na ; j++) {
-          ped = &mesh->edge[j];
-          if((ped->a == ped0 && ped->b==ped1) || (ped->b == ped0 && ped->a==ped1)) break;
-        }
-        if(j<=mesh->na) continue;
+        if ( _MMG5_hashGet(&edgeT,ped0,ped1) ) continue;
 
         pt1->ref = nref;
         if(adja[i])
@@ -487,6 +517,8 @@ int MMG2_markSD(MMG5_pMesh mesh) {
     }
   } while (kinit);
 
+  _MMG5_DEL_MEM(mesh,edgeT.item,edgeT.siz*sizeof(_MMG5_hedge));
+
   fprintf(stdout," %8d SUB-DOMAINS\n",nref-1); //because we have BB triangles
 
   /*remove BB triangles*/
@@ -746,9 +778,8 @@ int MMG2_findpos(MMG5_pMesh mesh,MMG5_pTria pt,int ip1,int ip2,int ip3,int ip4,i
 int MMG2_mmg2d2(MMG5_pMesh mesh,MMG5_pSol sol) {
   MMG5_pTria     pt;
   //MMG5_pEdge     ped;
-  MMG5_pPoint    ppt,ppt2;
-  double    c[2],dd;
-  int       j,k,kk,ip1,ip2,ip3,ip4,jel,kel,nt,iadr,*adja;
+  double    c[2];
+  int       k,ip1,ip2,ip3,ip4,jel,kel,nt,iadr,*adja;
   int       *numper;
 
   mesh->base = 0;
@@ -764,31 +795,17 @@ int MMG2_mmg2d2(MMG5_pMesh mesh,MMG5_pSol sol) {
     }
   }
   if(mesh->info.renum==-10) {
-    /*traitement des points periodiques*/
+    /*traitement des points periodiques: the image of an already inserted
+      point is not inserted*/
+    _MMG5_ADD_MEM(mesh,(mesh->np+1)*sizeof(int),"periodic points",return(0));
     _MMG5_SAFE_CALLOC(numper,mesh->np+1,int);
-    for(k=1 ; k<=mesh->np ; k++) {
-      ppt = &mesh->point[k];
-      for(kk=k ; kk<=mesh->np ; kk++) {
-        if(k==kk) continue;
-        ppt2 = &mesh->point[kk];
-        dd = (ppt->c[0]-ppt2->c[0])*(ppt->c[0]-ppt2->c[0])+(ppt->c[1]-ppt2->c[1])*(ppt->c[1]-ppt2->c[1]);
-        if(dd<1e-6) {
-          //printf("point img %d %d\n",k,kk);
-          ppt2->tmp = 1;
-          if(!numper[k]) {
-            numper[k] = kk;
-          } else if(numper[k]!=kk){
-            j = numper[k];
-            // printf("j = %d %d\n",j,numper[j]) ;
-            while(numper[j] && numper[j]!=kk) {
-              j = numper[j];
-              //printf("j = %d %d\n",j,numper[j]) ;
-            }
-            if(numper[j]!=kk) numper[j] = kk;
-          }
-        }
-      }
+    if ( !_MMG5_coincidentPoints(mesh,2,1e-3,0,NULL,numper) ) {
+      _MMG5_DEL_MEM(mesh,numper,(mesh->np+1)*sizeof(int));
+      return(0);
     }
+    for(k=1 ; k<=mesh->np ; k++)
+      if ( numper[k] )  mesh->point[k].tmp = 1;
+    _MMG5_DEL_MEM(mesh,numper,(mesh->np+1)*sizeof(int));
   }
   /*add bounding box vertex*/
   c[0] = -0.5;//mesh->info.min[0] - 1.;
@@ -885,7 +902,7 @@ int MMG2_mmg2d2(MMG5_pMesh mesh,MMG5_pSol sol) {
   adja[1] = 3*jel + 2;
 
   /*vertex insertion*/
-  if(!MMG2_insertpointdelone(mesh,sol)) return(0);
+  if(!MMG2_insertpoint(mesh,sol)) return(0);
   fprintf(stdout,"  -- END OF INSERTION PHASE\n");
 
   /*bdry enforcement*/
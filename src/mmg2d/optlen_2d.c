@@ -35,21 +35,241 @@
 #define  HQCOEF    0.9
 #define  HCRIT     0.98
 
+/** Number of points above which the points are moved by colored parallel
+ * passes */
+#define _MMG2_OPTPAR   100000
+/** Maximal number of colors of the parallel passes */
+#define _MMG2_NCOLOR   64
+
+/**
+ * \struct _MMG2_Ball
+ * \brief Ball of a point stored by arrays for the vectorized evaluation of
+ * the qualities: the triangle \a l of the ball is \f$(p,b_l,c_l)\f$ and
+ * \a m stores the averaged metric of the triangle.
+ */
+typedef struct {
+  double  bx[MMG2D_LMAX],by[MMG2D_LMAX],cx[MMG2D_LMAX],cy[MMG2D_LMAX];
+  double  m0[MMG2D_LMAX],m1[MMG2D_LMAX],m2[MMG2D_LMAX];
+  double  qual[MMG2D_LMAX];
+  int     iel[MMG2D_LMAX],ib[MMG2D_LMAX],ic[MMG2D_LMAX];
+  int     lon;
+} _MMG2_Ball;
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the sol structure.
+ * \param ip index of the point.
+ * \param list triangles of the ball of \a ip (\f$3*iel+i\f$).
+ * \param lon number of triangles in \a list.
+ * \param ball pointer toward the ball to fill.
+ * \return the worst quality of the ball.
+ *
+ * Gather the ball of \a ip for \ref _MMG2_ballQual.
+ *
+ */
+static double _MMG2_ballGet(MMG5_pMesh mesh,MMG5_pSol sol,int ip,int *list,
+                            int lon,_MMG2_Ball *ball) {
+  MMG5_pTria   pt;
+  double       *ma,*mb,*mc,cal;
+  int          l,nk;
+
+  cal = 0.;
+  for (l=0; l<lon; l++) {
+    ball->iel[l] = list[l]/3;
+    nk = list[l]%3;
+    pt = &mesh->tria[ball->iel[l]];
+    ball->ib[l] = pt->v[MMG2_inxt[nk]];
+    ball->ic[l] = pt->v[MMG2_inxt[nk+1]];
+    ball->bx[l] = mesh->point[ball->ib[l]].c[0];
+    ball->by[l] = mesh->point[ball->ib[l]].c[1];
+    ball->cx[l] = mesh->point[ball->ic[l]].c[0];
+    ball->cy[l] = mesh->point[ball->ic[l]].c[1];
+    if ( pt->qual > cal )  cal = pt->qual;
+
+    if ( sol->size == 3 ) {
+      ma = &sol->m[(ip-1)*sol->size+1];
+      mb = &sol->m[(ball->ib[l]-1)*sol->size+1];
+      mc = &sol->m[(ball->ic[l]-1)*sol->size+1];
+      ball->m0[l] = (ma[0]+mb[0]+mc[0]) / 3.0;
+      ball->m1[l] = (ma[1]+mb[1]+mc[1]) / 3.0;
+      ball->m2[l] = (ma[2]+mb[2]+mc[2]) / 3.0;
+    }
+  }
+  ball->lon = lon;
+  return(cal);
+}
+
+/**
+ * \param sol pointer toward the sol structure.
+ * \param ball pointer toward the ball.
+ * \param x first coordinate of the point.
+ * \param y second coordinate of the point.
+ * \return the worst quality of the ball.
+ *
+ * Compute the qualities of the ball triangles (see \ref caltri_iso_in and
+ * \ref caltri_ani_in) for the position \f$(x,y)\f$ of its center. The
+ * triangles are treated together to allow the vectorization of the loop.
+ *
+ */
+static double _MMG2_ballQual(MMG5_pSol sol,_MMG2_Ball *ball,double x,double y) {
+  double   abx,aby,acx,acy,bcx,bcy,aire,h1,h2,h3,peri,hm,cal,qmax;
+  int      l;
+
+  qmax = 0.;
+  if ( sol->size == 1 ) {
+#pragma omp simd reduction(max:qmax) \
+  private(abx,aby,acx,acy,bcx,bcy,aire,h1,h2,h3,peri,hm,cal)
+    for (l=0; l<ball->lon; l++) {
+      abx = ball->bx[l] - x;
+      aby = ball->by[l] - y;
+      acx = ball->cx[l] - x;
+      acy = ball->cy[l] - y;
+      bcx = ball->cx[l] - ball->bx[l];
+      bcy = ball->cy[l] - ball->by[l];
+      aire = abx*acy - aby*acx;
+
+      h1   = sqrt(abx*abx + aby*aby);
+      h2   = sqrt(acx*acx + acy*acy);
+      h3   = sqrt(bcx*bcx + bcy*bcy);
+      peri = 0.5 * (h1 + h2 + h3);
+      hm   = M_MAX(h1,M_MAX(h2,h3));
+      cal  = ( peri > EPSD ) ? hm * peri / (0.5*aire) : 1e+9;
+      cal  = ( aire > 0. ) ? cal : 1e+24;
+
+      ball->qual[l] = cal;
+      qmax = M_MAX(qmax,cal);
+    }
+  }
+  else {
+#pragma omp simd reduction(max:qmax) \
+  private(abx,aby,acx,acy,bcx,bcy,aire,h1,h2,h3,peri,hm,cal)
+    for (l=0; l<ball->lon; l++) {
+      abx = ball->bx[l] - x;
+      aby = ball->by[l] - y;
+      acx = ball->cx[l] - x;
+      acy = ball->cy[l] - y;
+      bcx = ball->cx[l] - ball->bx[l];
+      bcy = ball->cy[l] - ball->by[l];
+
+      h1 = ball->m0[l]*abx*abx + ball->m2[l]*aby*aby + 2.0*ball->m1[l]*abx*aby;
+      h1 = h1 > 0.0 ? sqrt(h1) : 0.0;
+      h2 = ball->m0[l]*acx*acx + ball->m2[l]*acy*acy + 2.0*ball->m1[l]*acx*acy;
+      h2 = h2 > 0.0 ? sqrt(h2) : 0.0;
+      h3 = ball->m0[l]*bcx*bcx + ball->m2[l]*bcy*bcy + 2.0*ball->m1[l]*bcx*bcy;
+      h3 = h3 > 0.0 ? sqrt(h3) : 0.0;
+
+      peri = 0.5 * (h1 + h2 + h3);
+      hm   = M_MAX(h1,M_MAX(h2,h3));
+      aire = peri * (peri-h1) * (peri-h2) * (peri-h3);
+      cal  = ( peri > EPSD && aire > 0.0 ) ? hm * peri / sqrt(M_MAX(aire,EPS30)) : 1e+9;
+      cal  = ( abx*acy - aby*acx < 0. ) ? 1e+9 : cal;
+
+      ball->qual[l] = cal;
+      qmax = M_MAX(qmax,cal);
+    }
+  }
+  return(qmax);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the sol structure.
+ * \param ip index of the point.
+ * \param ball pointer toward the ball of \a ip.
+ * \param cp computed displacement toward the optimal point.
+ *
+ * Displacement of \a ip toward the point that gives unit lengths to the
+ * edges of its ball.
+ *
+ */
+static void _MMG2_optPoint(MMG5_pMesh mesh,MMG5_pSol sol,int ip,
+                           _MMG2_Ball *ball,double cp[2]) {
+  MMG5_pPoint  ppa,ppb;
+  double       cx,cy,ux,uy,len,*mp;
+  int          l,j,ipb;
+
+  ppa = &mesh->point[ip];
+  mp  = &sol->m[(ip-1)*sol->size + 1];
+  cx  = cy = 0.;
+  for (l=0; l<ball->lon; l++) {
+    for (j=0; j<2; j++) {
+      ipb = j ? ball->ic[l] : ball->ib[l];
+      ppb = &mesh->point[ipb];
+      len = MMG2_length(ppa->c,ppb->c,mp,&sol->m[(ipb-1)*sol->size + 1]);
+      ux  = ppb->c[0] - ppa->c[0];
+      uy  = ppb->c[1] - ppa->c[1];
+      cx += ppa->c[0] + ux*(1. - 1./len);
+      cy += ppa->c[1] + uy*(1. - 1./len);
+    }
+  }
+  cp[0] = cx / (double)(2*ball->lon) - ppa->c[0];
+  cp[1] = cy / (double)(2*ball->lon) - ppa->c[1];
+}
+
+/**
+ * \param cal worst quality of the ball.
+ * \return the quality that the moved ball must not exceed.
+ *
+ */
+static inline double _MMG2_optTarget(double cal) {
+  return( cal > 10./ALPHA ? 0.99*cal : cal*HCRIT );
+}
+
+/**
+ * \param sol pointer toward the sol structure.
+ * \param ppa pointer toward the point to move.
+ * \param ball pointer toward the ball of the point.
+ * \param cp displacement of the point.
+ * \param ctg quality that the moved ball must not exceed.
+ * \param coe initial relaxation of the displacement.
+ * \param maxtou maximal number of trials.
+ * \return 1 if the point is moved, 0 otherwise.
+ *
+ * Move the point by the largest fraction \f$coe/2^k\f$ of \a cp that keeps
+ * the ball qualities under \a ctg (the qualities are left in \a ball).
+ *
+ */
+static int _MMG2_movePoint(MMG5_pSol sol,MMG5_pPoint ppa,_MMG2_Ball *ball,
+                           double cp[2],double ctg,double coe,int maxtou) {
+  double   x,y;
+  int      iter;
+
+  for (iter=1; iter<=maxtou; iter++) {
+    x = ppa->c[0] + coe * cp[0];
+    y = ppa->c[1] + coe * cp[1];
+    if ( _MMG2_ballQual(sol,ball,x,y) <= ctg ) {
+      ppa->c[0] = x;
+      ppa->c[1] = y;
+      return(1);
+    }
+    coe *= 0.5;
+  }
+  return(0);
+}
+
+#ifdef _OPENMP
+static int _MMG2_optlenCol(MMG5_pMesh,MMG5_pSol,double,int);
+#endif
+
 int optlen_ani(MMG5_pMesh mesh,MMG5_pSol sol,double declic,int base) {
   MMG5_pTria     pt,pt1;
-  MMG5_pPoint    ppa,ppb;
+  MMG5_pPoint    ppa;
   pQueue    queue;
+  _MMG2_Ball *ball;
   int      *list;
-  double    oldc[3],cal,ctg,cx,cy,ux,uy,cpx,cpy,coe,dd,len;
-  double    *mb,*mp,*ca,*cb,*qual;
-  int       i,j,k,l,iel,lon,nm;
-  int       ipa,ipb,nb,nk,npp,iadr,iter,maxtou;
+  double    cal,ctg,cp[2];
+  int       i,k,l,iel,lon,nm;
+  int       ipa,npp,maxtou;
   int nrj;
-//  double tmp1,tmp2,tmp3;
+
+#ifdef _OPENMP
+  if ( mesh->np > _MMG2_OPTPAR && omp_get_max_threads() > 1 )
+    return(_MMG2_optlenCol(mesh,sol,declic,base));
+#endif
 
   /* queue on quality */
   queue = MMG2_kiuini(mesh,mesh->nt,declic,base - 1);
-  assert(queue);
+  if ( !queue )  return(-1);
 
   maxtou = 10;
   nm     = 0;
@@ -57,6 +277,7 @@ int optlen_ani(MMG5_pMesh mesh,MMG5_pSol sol,double declic,int base) {
   nrj = 0;
 
   _MMG5_SAFE_CALLOC(list,MMG2D_LMAX,int);
+  _MMG5_SAFE_MALLOC(ball,1,_MMG2_Ball);
 
   do {
     k = MMG2_kiupop(queue);
@@ -73,92 +294,27 @@ int optlen_ani(MMG5_pMesh mesh,MMG5_pSol sol,double declic,int base) {
       if ( ppa->tag & M_BDRY || ppa->tag & M_REQUIRED || ppa->tag & M_SD)  continue;
 
       lon   = MMG2_boulep(mesh,k,i,list);
-      _MMG5_SAFE_MALLOC(qual,lon+1,double);
 
       /* optimal point */
-      ca   = &ppa->c[0];
-      iadr = (ipa-1)*sol->size + 1;
-      mp   = &sol->m[iadr];
-      cx   = 0.0;
-      cy   = 0.0;
-      nb   = 0;
-      cal  = pt->qual;
-      for (l=1 ; l<=lon; l++) {
-        iel = list[l] / 3;
-        nk  = list[l] % 3;
-        pt1 = &mesh->tria[iel];
-        if ( pt1->qual > cal )  cal = pt1->qual;
-        /* tmp1 = 0; */
-        /* tmp2 = 0; */
-        /* tmp3 = 0; */
-        for (j=1; j<3; j++) {
-          ipb  = pt1->v[ MMG2_idir[nk + j] ];
-          ppb  = &mesh->point[ipb];
-          cb   = &ppb->c[0];
-          iadr = (ipb-1)*sol->size + 1;
-          mb   = &sol->m[iadr];
-
-          len = MMG2_length(ca,cb,mp,mb);
-          /* optimal point */
-          ux  = ppb->c[0] - ppa->c[0];
-          uy  = ppb->c[1] - ppa->c[1];
-          cx += ppa->c[0] + ux*(1. - 1./len);//ux * len;
-          cy += ppa->c[1] + uy*(1. - 1./len);//uy * len;
-          nb++;
-        }
-      }
-
-      //if ( nb < 3 )  continue;
-      dd  = 1.0 / (double)nb;
-      cpx = cx*dd - ppa->c[0];
-      cpy = cy*dd - ppa->c[1];
+      cal = _MMG2_ballGet(mesh,sol,ipa,&list[1],lon,ball);
+      _MMG2_optPoint(mesh,sol,ipa,ball,cp);
 
       /* adjust position */
-      coe  = HQCOEF;
-      iter = 1;
-      if(cal > 10./ALPHA) {
-        ctg  = 0.99 * cal;
-      } else {
-        ctg  = cal * HCRIT;
-      }
-      memcpy(oldc,ppa->c,3*sizeof(double));
-      do {
-        ppa->c[0] =/* (1. - coe) * */oldc[0] + coe * cpx;
-        ppa->c[1] =/* (1. - coe) * */oldc[1] + coe * cpy;
-
-        for (l=1; l<=lon; l++) {
-          iel = list[l] / 3;
-          nk  = list[l] % 3;
-          pt1 = &mesh->tria[iel];
-
-          cal = MMG2_caltri_in(mesh,sol,pt1);
-          if ( cal > ctg )  {
-            break;  }
-          qual[l] = cal;
-        }
-        if ( l > lon )  break;
-        coe *= 0.5;
-      }
-      while ( ++iter <= maxtou );
-      if ( iter > maxtou ) {
-        memcpy(ppa->c,oldc,3*sizeof(double));
+      ctg = _MMG2_optTarget(cal);
+      if ( !_MMG2_movePoint(sol,ppa,ball,cp,ctg,HQCOEF,maxtou) ) {
         ppa->flag = base - 2;
         nrj++;
-        _MMG5_SAFE_FREE(qual);
         continue;
       }
 
       /* update tria */
-      for (l=1; l<=lon; l++) {
-        iel = list[l] / 3;
-        nk  = list[l] % 3;
+      for (l=0; l<lon; l++) {
+        iel = ball->iel[l];
         pt1 = &mesh->tria[iel];
 
         if ( (iel!=k) && (pt1->qual > declic) ) /*k est enleve par le pop*/
           MMG2_kiudel(queue,iel);
-        /*else if ( coe > 0.1 )
-          kiuput(queue,iel);  */
-        pt1->qual = qual[l];
+        pt1->qual = ball->qual[l];
         pt1->flag = base;
         for(i=0; i<2; i++)  mesh->point[pt1->v[i]].flag = base;
       }
@@ -166,7 +322,6 @@ int optlen_ani(MMG5_pMesh mesh,MMG5_pSol sol,double declic,int base) {
       /* interpol metric */
       ppa->flag = base + 1;
       nm++;
-      _MMG5_SAFE_FREE(qual);
       break;
     }
   }
@@ -175,6 +330,7 @@ int optlen_ani(MMG5_pMesh mesh,MMG5_pSol sol,double declic,int base) {
     fprintf(stdout,"     %7d PROPOSED  %7d MOVED %d REJ \n",npp,nm,nrj);
 
   MMG2_kiufree(queue);
+  _MMG5_SAFE_FREE(ball);
   _MMG5_SAFE_FREE(list);
 
   return(nm);
@@ -183,24 +339,30 @@ int optlen_ani(MMG5_pMesh mesh,MMG5_pSol sol,double declic,int base) {
 /* optimise using heap */
 int optlen_iso(MMG5_pMesh mesh,MMG5_pSol sol,double declic,int base) {
   MMG5_pTria     pt,pt1;
-  MMG5_pPoint    ppa,ppb;
+  MMG5_pPoint    ppa;
   pQueue    queue;
+  _MMG2_Ball *ball;
   int      *list;
-  double    oldc[3],cal,ctg,cx,cy,ux,uy,cpx,cpy,coe,dd,len;
-  double    hb,hp,*ca,*cb,*qual;
-  int       i,j,k,l,iel,lon,nm;
-  int       ipa,ipb,nb,nk,npp,iadr,iter,maxtou;
+  double    cal,ctg,cp[2];
+  int       i,k,l,iel,lon,nm;
+  int       ipa,npp,maxtou;
   int nrj;
-//  double tmp1,tmp2,tmp3;
+
+#ifdef _OPENMP
+  if ( mesh->np > _MMG2_OPTPAR && omp_get_max_threads() > 1 )
+    return(_MMG2_optlenCol(mesh,sol,declic,base));
+#endif
+
   /* queue on quality */
   queue = MMG2_kiuini(mesh,mesh->nt,declic,base - 1);
-  assert(queue);
+  if ( !queue )  return(-1);
 
   maxtou = 10;
   nm     = 0;
   npp    = 0;
   nrj = 0;
   _MMG5_SAFE_MALLOC(list,MMG2D_LMAX,int);
+  _MMG5_SAFE_MALLOC(ball,1,_MMG2_Ball);
 
   do {
     k = MMG2_kiupop(queue);
@@ -217,117 +379,34 @@ int optlen_iso(MMG5_pMesh mesh,MMG5_pSol sol,double declic,int base) {
       if ( ppa->tag & M_BDRY || ppa->tag & M_REQUIRED || ppa->tag & M_SD)  continue;
 
       lon   = MMG2_boulep(mesh,k,i,list);
-      _MMG5_SAFE_MALLOC(qual,lon+1,double);
 
       /* optimal point */
-      ca   = &ppa->c[0];
-      iadr = (ipa-1)*sol->size + 1;
-      hp   = sol->m[iadr];
-      cx   = 0.0;
-      cy   = 0.0;
-      nb   = 0;
-      cal  = pt->qual;
-      for (l=1 ; l<=lon; l++) {
-        iel = list[l] / 3;
-        nk  = list[l] % 3;
-        pt1 = &mesh->tria[iel];
-        if ( pt1->qual > cal )  cal = pt1->qual;
-        /* tmp1 = 0; */
-        /* tmp2 = 0; */
-        /* tmp3 = 0; */
-        for (j=1; j<3; j++) {
-          ipb  = pt1->v[ MMG2_idir[nk + j] ];
-          ppb  = &mesh->point[ipb];
-          cb   = &ppb->c[0];
-          iadr = (ipb-1)*sol->size + 1;
-          hb   = sol->m[iadr];
-
-          len = MMG2_length(ca,cb,&hp,&hb);
-          /* optimal point */
-          ux  = ppb->c[0] - ppa->c[0];
-          uy  = ppb->c[1] - ppa->c[1];
-          cx += ppa->c[0] + ux*(1. - 1./len);//ux * len;
-          cy += ppa->c[1] + uy*(1. - 1./len);//uy * len;
-          nb++;
-        }
-        /*check amelioration*/
-        /*memcpy(oldc,ppa->c,3*sizeof(double));
-          ppa->c[0] = oldc[0] + tmp1/3.;
-          ppa->c[1] = oldc[1] + tmp2/3.;
-          ppa->c[2] = oldc[2] + tmp3/3.;
-          if(MMG_caltet(mesh,sol,iel) > pt1->qual) {
-          printf("oups %d -- cal of %d ( %d ) %e > %e\n",nb,iel,ipa,pt1->qual,MMG_caltet(mesh,sol,iel));
-
-          //exit(EXIT_FAILURE);
-          }
-          else {
-          //printf("%d -- cal of %d ( %d ) %e > %e\n",nb,iel,ipa,pt1->qual,MMG_caltet(mesh,sol,iel));
-          }
-          memcpy(ppa->c,oldc,3*sizeof(double));
-        */
-
-      }
-
-      //if ( nb < 3 )  continue;
-      dd  = 1.0 / (double)nb;
-      cpx = cx*dd - ppa->c[0];
-      cpy = cy*dd - ppa->c[1];
+      cal = _MMG2_ballGet(mesh,sol,ipa,&list[1],lon,ball);
+      _MMG2_optPoint(mesh,sol,ipa,ball,cp);
 
       /* adjust position */
-      coe  = HQCOEF;
-      iter = 1;
-      if(cal > 10./ALPHA) {
-        ctg  = 0.99 * cal;
-      } else {
-        ctg  = cal * HCRIT;
-      }
-      memcpy(oldc,ppa->c,3*sizeof(double));
-      do {
-        ppa->c[0] =/* (1. - coe) * */oldc[0] + coe * cpx;
-        ppa->c[1] =/* (1. - coe) * */oldc[1] + coe * cpy;
-
-        for (l=1; l<=lon; l++) {
-          iel = list[l] / 3;
-          nk  = list[l] % 3;
-          pt1 = &mesh->tria[iel];
-
-          cal = MMG2_caltri_in(mesh,sol,pt1);
-          if ( cal > ctg )  {
-
-            break;  }
-          qual[l] = cal;
-        }
-        if ( l > lon )  break;
-        coe *= 0.5;
-      }
-      while ( ++iter <= maxtou );
-      if ( iter > maxtou ) {
-        memcpy(ppa->c,oldc,3*sizeof(double));
+      ctg = _MMG2_optTarget(cal);
+      if ( !_MMG2_movePoint(sol,ppa,ball,cp,ctg,HQCOEF,maxtou) ) {
         ppa->flag = base - 2;
         nrj++;
-        _MMG5_SAFE_FREE(qual);
         continue;
       }
 
       /* update tria */
-      for (l=1; l<=lon; l++) {
-        iel = list[l] / 3;
-        nk  = list[l] % 3;
+      for (l=0; l<lon; l++) {
+        iel = ball->iel[l];
         pt1 = &mesh->tria[iel];
-        pt1->qual = qual[l];
+        pt1->qual = ball->qual[l];
         pt1->flag = base;
         for(i=0; i<2; i++)  mesh->point[pt1->v[i]].flag = base;
 
         if ( pt1->qual < declic )
           MMG2_kiudel(queue,iel);
-        /*else if ( coe > 0.1 )
-          kiuput(queue,iel);  */
       }
 
       /* interpol metric */
       ppa->flag = base + 1;
       nm++;
-      _MMG5_SAFE_FREE(qual);
       break;
     }
   }
@@ -337,6 +416,7 @@ int optlen_iso(MMG5_pMesh mesh,MMG5_pSol sol,double declic,int base) {
 
 
   MMG2_kiufree(queue);
+  _MMG5_SAFE_FREE(ball);
   _MMG5_SAFE_FREE(list);
   return(nm);
 }
@@ -349,22 +429,23 @@ int optlen_iso_bar(MMG5_pMesh mesh,MMG5_pSol sol,double declic,int base) {
   MMG5_pTria     pt,pt1;
   MMG5_pPoint    ppa,ppb;
   pQueue    queue;
+  _MMG2_Ball *ball;
   int      *list;
-  double    oldc[3],cal,ctg,cx,cy,cpx,cpy,coe,dd;
-  double    *qual;
+  double    cal,ctg,cx,cy,cp[2],dd;
   int       i,j,k,l,iel,lon,nm;
-  int       ipa,ipb,nb,nk,npp,iter,maxtou;
+  int       ipa,ipb,nb,npp,maxtou;
   int nrj;
-//  double tmp1,tmp2,tmp3;
+
   /* queue on quality */
   queue = MMG2_kiuini(mesh,mesh->nt,declic,base - 1);
-  assert(queue);
+  if ( !queue )  return(-1);
 
   maxtou = 15;
   nm     = 0;
   npp    = 0;
   nrj = 0;
   _MMG5_SAFE_MALLOC(list,MMG2D_LMAX,int);
+  _MMG5_SAFE_MALLOC(ball,1,_MMG2_Ball);
 
   do {
     k = MMG2_kiupop(queue);
@@ -381,24 +462,15 @@ int optlen_iso_bar(MMG5_pMesh mesh,MMG5_pSol sol,double declic,int base) {
       if ( ppa->tag & M_BDRY || ppa->tag & M_REQUIRED || ppa->tag & M_SD)  continue;
 
       lon   = MMG2_boulep(mesh,k,i,list);
-
-      _MMG5_SAFE_MALLOC(qual,lon+1,double);
+      cal   = _MMG2_ballGet(mesh,sol,ipa,&list[1],lon,ball);
 
       /* optimal point */
       cx   = 0.0;
       cy   = 0.0;
       nb   = 0;
-      cal  = pt->qual;
-      for (l=1 ; l<=lon; l++) {
-        iel = list[l] / 3;
-        nk  = list[l] % 3;
-        pt1 = &mesh->tria[iel];
-        if ( pt1->qual > cal )  cal = pt1->qual;
-        /* tmp1 = 0; */
-        /* tmp2 = 0; */
-        /* tmp3 = 0; */
-        for (j=1; j<3; j++) {
-          ipb  = pt1->v[ MMG2_idir[nk + j] ];
+      for (l=0 ; l<lon; l++) {
+        for (j=0; j<2; j++) {
+          ipb  = j ? ball->ic[l] : ball->ib[l];
           ppb  = &mesh->point[ipb];
 
           /* optimal point */
@@ -406,83 +478,36 @@ int optlen_iso_bar(MMG5_pMesh mesh,MMG5_pSol sol,double declic,int base) {
           cy += ppa->c[1] ;
           nb++;
         }
-        /*check amelioration*/
-        /*memcpy(oldc,ppa->c,3*sizeof(double));
-          ppa->c[0] = oldc[0] + tmp1/3.;
-          ppa->c[1] = oldc[1] + tmp2/3.;
-          ppa->c[2] = oldc[2] + tmp3/3.;
-          if(MMG_caltet(mesh,sol,iel) > pt1->qual) {
-          printf("oups %d -- cal of %d ( %d ) %e > %e\n",nb,iel,ipa,pt1->qual,MMG_caltet(mesh,sol,iel));
-
-          //exit(EXIT_FAILURE);
-          }
-          else {
-          //printf("%d -- cal of %d ( %d ) %e > %e\n",nb,iel,ipa,pt1->qual,MMG_caltet(mesh,sol,iel));
-          }
-          memcpy(ppa->c,oldc,3*sizeof(double));
-        */
-
       }
 
       //if ( nb < 3 )  continue;
-      dd  = 1.0 / (double)nb;
-      cpx = cx*dd ;//- ppa->c[0];
-      cpy = cy*dd ;//- ppa->c[1];
+      dd    = 1.0 / (double)nb;
+      cp[0] = cx*dd - ppa->c[0];
+      cp[1] = cy*dd - ppa->c[1];
 
       /* adjust position */
-      coe  = HQCOEF;
-      iter = 1;
-      if(cal > 10./ALPHA) {
-        ctg  = 0.99 * cal;
-      } else {
-        ctg  = cal * HCRIT;
-      }
-      memcpy(oldc,ppa->c,3*sizeof(double));
-      do {
-        ppa->c[0] = (1. - coe) * oldc[0] + coe * cpx;
-        ppa->c[1] = (1. - coe) * oldc[1] + coe * cpy;
-
-        for (l=1; l<=lon; l++) {
-          iel = list[l] / 3;
-          nk  = list[l] % 3;
-          pt1 = &mesh->tria[iel];
-
-          cal = MMG2_caltri_in(mesh,sol,pt1);
-          if ( cal > ctg )  {
-            break;  }
-          qual[l] = cal;
-        }
-        if ( l > lon )  break;
-        coe *= 0.5;
-      }
-      while ( ++iter <= maxtou );
-      if ( iter > maxtou ) {
-        memcpy(ppa->c,oldc,3*sizeof(double));
+      ctg = _MMG2_optTarget(cal);
+      if ( !_MMG2_movePoint(sol,ppa,ball,cp,ctg,HQCOEF,maxtou) ) {
         ppa->flag = base - 2;
         nrj++;
-        _MMG5_SAFE_FREE(qual);
         continue;
       }
 
       /* update tria */
-      for (l=1; l<=lon; l++) {
-        iel = list[l] / 3;
-        nk  = list[l] % 3;
+      for (l=0; l<lon; l++) {
+        iel = ball->iel[l];
         pt1 = &mesh->tria[iel];
-        pt1->qual = qual[l];
+        pt1->qual = ball->qual[l];
         pt1->flag = base;
         for(i=0; i<2; i++)  mesh->point[pt1->v[i]].flag = base;
 
         if ( pt1->qual < declic )
           MMG2_kiudel(queue,iel);
-        /*else if ( coe > 0.1 )
-          kiuput(queue,iel);  */
       }
 
       /* interpol metric */
       ppa->flag = base + 1;
       nm++;
-      _MMG5_SAFE_FREE(qual);
       break;
     }
   }
@@ -490,7 +515,150 @@ int optlen_iso_bar(MMG5_pMesh mesh,MMG5_pSol sol,double declic,int base) {
   if ( mesh->info.imprim < - 4 )
     fprintf(stdout,"     %7d PROPOSED  %7d MOVED %d REJ \n",npp,nm,nrj);
 
+  _MMG5_SAFE_FREE(ball);
   _MMG5_SAFE_FREE(list);
   MMG2_kiufree(queue);
   return(nm);
 }
+
+#ifdef _OPENMP
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param adr addresses of the point balls (see \ref _MMG2_ballIncid).
+ * \param list point balls.
+ * \param declic quality threshold of the triangles to improve.
+ * \param col color of the points to move (1..ncol, 0 for the others).
+ * \return the number of colors, 0 if no point has to be moved.
+ *
+ * Mark the interior points of the triangles of quality worse than \a declic
+ * and color them so that two points of the same color are never neighbours.
+ *
+ */
+static int _MMG2_optColor(MMG5_pMesh mesh,int *adr,int *list,double declic,
+                          int *col) {
+  MMG5_pTria          pt;
+  MMG5_pPoint         ppt;
+  unsigned long long  mask;
+  int                 k,l,ip,ncol,c;
+  char                i,j;
+
+#pragma omp parallel for schedule(static)
+  for (k=1; k<=mesh->np; k++)  col[k] = 0;
+
+  for (k=1; k<=mesh->nt; k++) {
+    pt = &mesh->tria[k];
+    if ( !M_EOK(pt) || pt->qual <= declic )  continue;
+    for (i=0; i<3; i++) {
+      ppt = &mesh->point[pt->v[i]];
+      if ( ppt->tag & M_BDRY || ppt->tag & M_REQUIRED || ppt->tag & M_SD )
+        continue;
+      col[pt->v[i]] = -1;
+    }
+  }
+
+  /* greedy coloring */
+  ncol = 0;
+  for (ip=1; ip<=mesh->np; ip++) {
+    if ( col[ip] >= 0 )  continue;
+    mask = 0;
+    for (l=adr[ip]; l<adr[ip+1]; l++) {
+      pt = &mesh->tria[list[l]/3];
+      i  = list[l]%3;
+      for (j=1; j<3; j++) {
+        c = col[pt->v[MMG2_inxt[i+j-1]]];
+        if ( c > 0 )  mask |= 1ULL << (c-1);
+      }
+    }
+    for (c=0; c<_MMG2_NCOLOR; c++)
+      if ( !(mask & (1ULL << c)) )  break;
+    col[ip] = ( c < _MMG2_NCOLOR && adr[ip+1]-adr[ip] < MMG2D_LMAX ) ? c+1 : 0;
+    ncol = M_MAX(ncol,col[ip]);
+  }
+  return(ncol);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the sol structure.
+ * \param declic quality threshold of the triangles to improve.
+ * \param base flag of the moved points.
+ * \return the number of moved points, -1 if fail.
+ *
+ * Multithreaded version of \ref optlen_iso and \ref optlen_ani: the points
+ * of the bad triangles are colored and the points of a same color, whose
+ * balls are disjoint, are moved concurrently.
+ *
+ */
+static int _MMG2_optlenCol(MMG5_pMesh mesh,MMG5_pSol sol,double declic,
+                           int base) {
+  MMG5_pTria     pt1;
+  MMG5_pPoint    ppa;
+  _MMG2_Ball     *balls,*ball;
+  double         cal,ctg,cp[2];
+  int            *adr,*list,*col,*perm,cadr[_MMG2_NCOLOR+2];
+  int            k,l,c,ip,ncol,nm,nrj,nth;
+  char           i;
+
+  if ( !_MMG2_ballIncid(mesh,&adr,&list) )  return(-1);
+
+  nth = omp_get_max_threads();
+  _MMG5_ADD_MEM(mesh,2*(mesh->np+1)*sizeof(int)+nth*sizeof(_MMG2_Ball),
+                "smoothing colors",
+                _MMG2_freeBallIncid(mesh,&adr,&list);return(-1));
+  _MMG5_SAFE_MALLOC(col,mesh->np+1,int);
+  _MMG5_SAFE_MALLOC(perm,mesh->np+1,int);
+  _MMG5_SAFE_MALLOC(balls,nth,_MMG2_Ball);
+
+  /* sort the points by color */
+  ncol = _MMG2_optColor(mesh,adr,list,declic,col);
+  memset(cadr,0,(_MMG2_NCOLOR+2)*sizeof(int));
+  for (ip=1; ip<=mesh->np; ip++)
+    if ( col[ip] > 0 )  cadr[col[ip]+1]++;
+  for (c=1; c<=ncol; c++)  cadr[c+1] += cadr[c];
+  for (ip=1; ip<=mesh->np; ip++)
+    if ( col[ip] > 0 )  perm[cadr[col[ip]]++] = ip;
+  for (c=ncol; c>0; c--)  cadr[c] = cadr[c-1];
+  cadr[1] = 0;
+
+  nm = nrj = 0;
+  for (c=1; c<=ncol; c++) {
+#pragma omp parallel for schedule(dynamic,64) reduction(+:nm,nrj) \
+  private(ppa,pt1,ball,cal,ctg,cp,ip,l,i)
+    for (k=cadr[c]; k<cadr[c+1]; k++) {
+      ip   = perm[k];
+      ppa  = &mesh->point[ip];
+      ball = &balls[omp_get_thread_num()];
+
+      cal = _MMG2_ballGet(mesh,sol,ip,&list[adr[ip]],adr[ip+1]-adr[ip],ball);
+      _MMG2_optPoint(mesh,sol,ip,ball,cp);
+
+      ctg = _MMG2_optTarget(cal);
+      if ( !_MMG2_movePoint(sol,ppa,ball,cp,ctg,HQCOEF,10) ) {
+        ppa->flag = base - 2;
+        nrj++;
+        continue;
+      }
+
+      /* update tria: the ball is only shared with points of other colors */
+      for (l=0; l<ball->lon; l++) {
+        pt1 = &mesh->tria[ball->iel[l]];
+        pt1->qual = ball->qual[l];
+        pt1->flag = base;
+        for(i=0; i<2; i++)  mesh->point[pt1->v[i]].flag = base;
+      }
+      ppa->flag = base + 1;
+      nm++;
+    }
+  }
+  if ( mesh->info.imprim < - 4 )
+    fprintf(stdout,"     %7d PROPOSED  %7d MOVED %d REJ (%d COLORS)\n",
+            nm+nrj,nm,nrj,ncol);
+
+  _MMG5_DEL_MEM(mesh,balls,nth*sizeof(_MMG2_Ball));
+  _MMG5_DEL_MEM(mesh,perm,(mesh->np+1)*sizeof(int));
+  _MMG5_DEL_MEM(mesh,col,(mesh->np+1)*sizeof(int));
+  _MMG2_freeBallIncid(mesh,&adr,&list);
+
+  return(nm);
+}
+#endif
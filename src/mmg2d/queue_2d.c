@@ -33,113 +33,182 @@
  **/
 #include "mmg2d.h"
 
+/** Number of quality buckets per octave of \f$qual/declic\f$ */
+#define _MMG2_QBOCT   4
 
+/**
+ * \param q pointer toward the queue.
+ * \param qual quality of a triangle (at least \a q->declic).
+ * \return the bucket of the quality \a qual.
+ *
+ */
+static inline
+int _MMG2_kiubuck(pQueue q,double qual) {
+  int   b;
+
+  if ( qual <= q->declic )  return(0);
+  b = (int)(_MMG2_QBOCT*log2(qual/q->declic));
+  return(MG_MIN(MG_MAX(b,0),MMG2_QBUCK-1));
+}
+
+/**
+ * \param q pointer toward the queue.
+ * \param iel triangle to unlink.
+ *
+ * Unlink the triangle \a iel from its bucket.
+ *
+ */
+static inline
+void _MMG2_kiuunlink(pQueue q,int iel) {
+  int  b;
+
+  b = q->buck[iel];
+  if ( q->prev[iel] )  q->next[q->prev[iel]] = q->next[iel];
+  else                 q->head[b] = q->next[iel];
+  if ( q->next[iel] )  q->prev[q->next[iel]] = q->prev[iel];
+  q->buck[iel] = -1;
+}
+
+/**
+ * \param q pointer toward the queue.
+ * \param iel triangle to link.
+ * \param b bucket of the triangle.
+ *
+ * Link the triangle \a iel at the head of the bucket \a b.
+ *
+ */
+static inline
+void _MMG2_kiulink(pQueue q,int iel,int b) {
+  q->buck[iel] = b;
+  q->prev[iel] = 0;
+  q->next[iel] = q->head[b];
+  if ( q->head[b] )  q->prev[q->head[b]] = iel;
+  q->head[b] = iel;
+  if ( b > q->cur )  q->cur = b;
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param nbel maximal index of the stored triangles.
+ * \param declic quality threshold: the triangles of quality lower than
+ * \a declic are not stored.
+ * \param base if positive, only the triangles with flag greater than
+ * \a base-1 are stored.
+ * \return pointer toward the queue, NULL if fail.
+ *
+ * Queue on quality: bucket queue of the bad triangles, the buckets being
+ * spaced geometrically in quality so that the worst triangles are popped
+ * first. Inside a bucket, the triangles are popped in decreasing index
+ * order to keep the locality of the former stack.
+ *
+ */
 pQueue MMG2_kiuini(MMG5_pMesh mesh,int nbel,double declic,int base) {
   pQueue   q;
   MMG5_pTria    pt;
   int      k;
 
   _MMG5_SAFE_CALLOC(q,1,Queue);
-  _MMG5_SAFE_CALLOC(q->stack,(1+nbel),int);
-
-  q->cur = 0;
-  for (k=1; k<=mesh->nt; k++) {
+  q->mesh   = mesh;
+  q->declic = declic;
+  q->siz    = nbel;
+  q->cur    = 0;
+  _MMG5_ADD_MEM(mesh,3*(nbel+1)*sizeof(int),"quality queue",
+                _MMG5_SAFE_FREE(q);
+                return(NULL));
+  _MMG5_SAFE_MALLOC(q->next,nbel+1,int);
+  _MMG5_SAFE_MALLOC(q->prev,nbel+1,int);
+  _MMG5_SAFE_MALLOC(q->buck,nbel+1,int);
+  memset(q->head,0,MMG2_QBUCK*sizeof(int));
+
+  for (k=0; k<=nbel; k++)  q->buck[k] = -1;
+  for (k=1; k<=MG_MIN(nbel,mesh->nt); k++) {
     pt = &mesh->tria[k];
     if ( !M_EOK(pt) || pt->qual < declic )     continue;
     else if ( base > 0 && pt->flag < base-1 )  continue;
-    q->stack[q->cur] = k;
-    q->cur++;
+    _MMG2_kiulink(q,k,_MMG2_kiubuck(q,pt->qual));
   }
   return(q);
 }
 
 
+/**
+ * \param q pointer toward the queue.
+ *
+ * Free the queue.
+ *
+ */
 void MMG2_kiufree(pQueue q) {
-  _MMG5_SAFE_FREE(q->stack);
+  _MMG5_DEL_MEM(q->mesh,q->next,(q->siz+1)*sizeof(int));
+  _MMG5_DEL_MEM(q->mesh,q->prev,(q->siz+1)*sizeof(int));
+  _MMG5_DEL_MEM(q->mesh,q->buck,(q->siz+1)*sizeof(int));
   _MMG5_SAFE_FREE(q);
 }
 
 
+/**
+ * \param q pointer toward the queue.
+ * \param iel triangle to remove.
+ * \return 1 if \a iel was stored, 0 otherwise.
+ *
+ * Remove the triangle \a iel from the queue.
+ *
+ */
 int MMG2_kiudel(pQueue q,int iel) {
-  int   k;
-  if ( !q->stack[0] )
-    return(0);
-
-  else if ( q->cur != iel && !q->stack[iel] )
-    return(0);
 
-  else {
-    /*recherche un peu longue!!!!*/
-    for (k=q->cur-1; k>0; k--)
-      if ( q->stack[k] == iel )  break;
-    if(!k) return(0);
-    assert(q->stack[k] == iel);
-    if ( k == q->cur-1 ) { /*dernier elt de la pile*/
-      q->cur--;
-      q->stack[k]   = 0;
-      return(1);
-    }
-    else { /*on met le dernier elt et on le met dans la case*/
-      q->stack[k]   = q->stack[q->cur-1];
-      q->stack[q->cur-1] = 0;
-      q->cur--;
-      return(1);
-    }
-  }
+  if ( iel < 1 || iel > q->siz || q->buck[iel] < 0 )  return(0);
 
-  return(0);
+  _MMG2_kiuunlink(q,iel);
+  return(1);
 }
 
 
+/**
+ * \param q pointer toward the queue.
+ * \param iel triangle to store.
+ * \return 1 if \a iel is stored, 0 otherwise.
+ *
+ * Store the triangle \a iel with its current quality (or move it to the
+ * bucket of its new quality if it is already stored); the triangle is
+ * removed from the queue if it is no longer worse than the threshold.
+ *
+ */
 int MMG2_kiuput(pQueue q,int iel) {
-  int    k;
-  puts("on put");
-  if ( !q->stack[0] )
-    return(0);
-
-  else if ( iel == q->cur || q->stack[iel] )
-    return(0);
+  MMG5_pTria  pt;
+  int         b;
 
-  else if ( iel > q->cur ) {
-    q->stack[q->cur] = iel;
-    q->stack[iel]    = 0;
-    q->cur = iel;
-    return(1);
-  }
-
-  else if ( iel < q->stack[0] ) {
-    q->stack[iel] = q->stack[0];
-    q->stack[0]   = iel;
-    return(1);
-  }
+  if ( iel < 1 || iel > q->siz )  return(0);
 
-  else {
-    for (k=iel-1; k>=0; k--)
-      if ( q->stack[k] )  break;
-    q->stack[iel] = q->stack[k];
-    q->stack[k]   = iel;
-    return(1);
+  pt = &q->mesh->tria[iel];
+  if ( !M_EOK(pt) || pt->qual < q->declic ) {
+    if ( q->buck[iel] >= 0 )  _MMG2_kiuunlink(q,iel);
+    return(0);
   }
-
-  return(0);
+  b = _MMG2_kiubuck(q,pt->qual);
+  if ( q->buck[iel] == b )  return(1);
+  if ( q->buck[iel] >= 0 )  _MMG2_kiuunlink(q,iel);
+  _MMG2_kiulink(q,iel,b);
+  return(1);
 }
 
 
+/**
+ * \param q pointer toward the queue.
+ * \return the worst triangle of the queue, 0 if the queue is empty.
+ *
+ * Pop a triangle of the worst non empty bucket (the triangles deleted since
+ * their insertion are skipped).
+ *
+ */
 int MMG2_kiupop(pQueue q) {
-  int  cur;
-
-  /*cur = q->stack[0];
-    q->stack[0]   = q->stack[q->cur-1];
-    q->stack[q->cur] = 0;
-    if(q->cur) q->cur--;*/
-
-  /*on depile par le haut*/
-  if(!q->cur) return(0);
-  cur = q->stack[q->cur-1];
-  q->stack[q->cur-1] = 0;
-  q->cur--;
-
-  return(cur);
+  MMG5_pTria  pt;
+  int         k;
+
+  while ( 1 ) {
+    while ( q->cur > 0 && !q->head[q->cur] )  q->cur--;
+    k = q->head[q->cur];
+    if ( !k )  return(0);
+    _MMG2_kiuunlink(q,k);
+    pt = &q->mesh->tria[k];
+    if ( M_EOK(pt) )  return(k);
+  }
 }
-
-
@@ -39,6 +39,7 @@
 /*insert ip on edge between k1 and adj1/3 */
 int MMG2_split(MMG5_pMesh mesh,MMG5_pSol sol,int ip,int k1,int adj1) {
   MMG5_pTria     pt1,pt2,pt3,pt4,ptmp;
+  MMG5_Tria      tmp0;
   MMG5_pEdge     ped,ped1;
   int       k2,adj2,jel,kel,voy1,voy2,iar1,iar2,iara1,iara2;
   int       *adja,*adja1,*adja2,tmp1,tmp2,piar1,piar2,pvoy1,piara1,piara2,pvoy2;
@@ -83,8 +84,9 @@ int MMG2_split(MMG5_pMesh mesh,MMG5_pSol sol,int ip,int k1,int adj1) {
   air = MMG2_quickarea(mesh->point[ip].c,mesh->point[piara2].c,mesh->point[pvoy2].c);
   if(air < EPSA) return(0);
 
-  /*test qual*/
-  ptmp = &mesh->tria[0];
+  /*test qual: local tria, the splits of independent edges may be done
+    concurrently*/
+  ptmp = &tmp0;
   ptmp->v[0] = piar2;
   ptmp->v[1] = pvoy1;
   ptmp->v[2] = ip;
@@ -167,7 +169,6 @@ int MMG2_split(MMG5_pMesh mesh,MMG5_pSol sol,int ip,int k1,int adj1) {
                        exit(EXIT_FAILURE));
     pt1  = &mesh->tria[k1];
     pt2  = &mesh->tria[k2];
-    ptmp = &mesh->tria[0];
     adja2 =  &mesh->adja[3*(k2-1) + 1];
   }
   kel  = _MMG2D_newElt(mesh);
@@ -179,7 +180,6 @@ int MMG2_split(MMG5_pMesh mesh,MMG5_pSol sol,int ip,int k1,int adj1) {
                        exit(EXIT_FAILURE));
     pt1  = &mesh->tria[k1];
     pt2  = &mesh->tria[k2];
-    ptmp = &mesh->tria[0];
     adja2 =  &mesh->adja[3*(k2-1) + 1];
   }
   pt3  = &mesh->tria[jel];
@@ -298,8 +298,10 @@ int MMG2_split(MMG5_pMesh mesh,MMG5_pSol sol,int ip,int k1,int adj1) {
 
 
 
-  if(MMG2D_callbackinsert)
+  if(MMG2D_callbackinsert) {
+#pragma omp critical (MMG2D_callbackinsert)
     MMG2D_callbackinsert((int) ip,(int) k1,(int) k2,(int)jel,(int) kel);
+  }
 
   return(1);
 }
@@ -307,6 +309,7 @@ int MMG2_split(MMG5_pMesh mesh,MMG5_pSol sol,int ip,int k1,int adj1) {
 /*insert ip on edge in k1 */
 int MMG2_splitbdry(MMG5_pMesh mesh,MMG5_pSol sol,int ip,int k1,int voy1,double *tang) {
   MMG5_pTria     pt1,pt3,ptmp;
+  MMG5_Tria      tmp0;
   MMG5_pEdge     ped,ped1;
   MMG5_pPoint    ppt;
   int       jel,iar1,iar2,i,num,newed,num1,num2;
@@ -331,7 +334,7 @@ int MMG2_splitbdry(MMG5_pMesh mesh,MMG5_pSol sol,int ip,int k1,int voy1,double *
   air = MMG2_quickarea(mesh->point[ip].c,mesh->point[pvoy1].c,mesh->point[piar1].c);
   if(air < EPSA) return(0);
 
-  ptmp = &mesh->tria[0];
+  ptmp = &tmp0;
   ptmp->v[0] = piar2;
   ptmp->v[1] = pvoy1;
   ptmp->v[2] = ip;
@@ -358,7 +361,6 @@ int MMG2_splitbdry(MMG5_pMesh mesh,MMG5_pSol sol,int ip,int k1,int voy1,double *
                        printf("  Exit program.\n");
                        exit(EXIT_FAILURE));
     pt1  = &mesh->tria[k1];
-    ptmp = &mesh->tria[0];
 
   }
   pt3  = &mesh->tria[jel];
@@ -34,23 +34,29 @@
 #include "mmg2d.h"
 
 
+/* The free lists are shared by the splits and collapses of independent
+ * edges done concurrently in analar, so they are updated in a critical
+ * section (the tables are never reallocated in the parallel passes). */
+
 /* get new point address */
 int _MMG2D_newPt(MMG5_pMesh mesh,double c[2],int tag) {
   MMG5_pPoint  ppt;
   int     curpt;
 
-  if ( !mesh->npnil )  return(0);
-
-  curpt = mesh->npnil;
-  if ( mesh->npnil > mesh->np )  mesh->np = mesh->npnil;
-  ppt   = &mesh->point[curpt];
-  memcpy(ppt->c,c,2*sizeof(double));
-  ppt->tag   &= ~M_NUL;
-  mesh->npnil = ppt->tmp;
-  ppt->tmp    = 0;
-  ppt->xp     = 0;
-  //ppt->fla   = mesh->flag;
-
+#pragma omp critical (_MMG2D_zaldy)
+  {
+    curpt = mesh->npnil;
+    if ( curpt ) {
+      if ( mesh->npnil > mesh->np )  mesh->np = mesh->npnil;
+      ppt   = &mesh->point[curpt];
+      memcpy(ppt->c,c,2*sizeof(double));
+      ppt->tag   &= ~M_NUL;
+      mesh->npnil = ppt->tmp;
+      ppt->tmp    = 0;
+      ppt->xp     = 0;
+      //ppt->fla   = mesh->flag;
+    }
+  }
   return(curpt);
 }
 
@@ -67,24 +73,29 @@ void _MMG2D_delPt(MMG5_pMesh mesh,int ip) {
 
   memset(ppt,0,sizeof(MMG5_Point));
   ppt->tag    = M_NUL;
-  ppt->tmp    = mesh->npnil;
 
-  mesh->npnil = ip;
-  if ( ip == mesh->np )  mesh->np--;
+#pragma omp critical (_MMG2D_zaldy)
+  {
+    ppt->tmp    = mesh->npnil;
+
+    mesh->npnil = ip;
+    if ( ip == mesh->np )  mesh->np--;
+  }
 }
 
 /* get new elt address */
 int _MMG5_newEdge(MMG5_pMesh mesh) {
   int     curiel;
 
-  if ( !mesh->nanil ) {
-    return(0);
+#pragma omp critical (_MMG2D_zaldy)
+  {
+    curiel = mesh->nanil;
+    if ( curiel ) {
+      if ( mesh->nanil > mesh->na )  mesh->na = mesh->nanil;
+      mesh->nanil = mesh->edge[curiel].b;
+      mesh->edge[curiel].b = 0;
+    }
   }
-  curiel = mesh->nanil;
-  if ( mesh->nanil > mesh->na )  mesh->na = mesh->nanil;
-  mesh->nanil = mesh->edge[curiel].b;
-  mesh->edge[curiel].b = 0;
-
   return(curiel);
 }
 
@@ -98,22 +109,30 @@ void _MMG5_delEdge(MMG5_pMesh mesh,int iel) {
     return;
   }
   memset(pt,0,sizeof(MMG5_Edge));
-  pt->b = mesh->nanil;
-  mesh->nanil = iel;
-  if ( iel == mesh->na )  mesh->na--;
+
+#pragma omp critical (_MMG2D_zaldy)
+  {
+    pt->b = mesh->nanil;
+    mesh->nanil = iel;
+    if ( iel == mesh->na )  mesh->na--;
+  }
 }
 
 /* get new elt address */
 int _MMG2D_newElt(MMG5_pMesh mesh) {
   int     curiel;
 
-  if ( !mesh->nenil ) {
-    return(0);
+#pragma omp critical (_MMG2D_zaldy)
+  {
+    curiel = mesh->nenil;
+    if ( curiel ) {
+      if ( mesh->nenil > mesh->nt )  mesh->nt = mesh->nenil;
+      mesh->nenil = mesh->tria[curiel].v[2];
+      mesh->tria[curiel].v[2] = 0;
+    }
   }
-  curiel = mesh->nenil;
-  if ( mesh->nenil > mesh->nt )  mesh->nt = mesh->nenil;
-  mesh->nenil = mesh->tria[curiel].v[2];
-  mesh->tria[curiel].v[2] = 0;
+  if ( !curiel )  return(0);
+
   mesh->tria[curiel].ref = 0;
   mesh->tria[curiel].base = 0;
   mesh->tria[curiel].edg[0] = 0;
@@ -135,14 +154,17 @@ void _MMG2D_delElt(MMG5_pMesh mesh,int iel) {
     return;
   }
   memset(pt,0,sizeof(MMG5_Tria));
-  pt->v[2] = mesh->nenil;
   pt->qual = 0.0;
   iadr = (iel-1)*3 + 1;
   if ( mesh->adja )
     memset(&mesh->adja[iadr],0,3*sizeof(int));
 
-  mesh->nenil = iel;
-  if ( iel == mesh->nt )  mesh->nt--;
+#pragma omp critical (_MMG2D_zaldy)
+  {
+    pt->v[2] = mesh->nenil;
+    mesh->nenil = iel;
+    if ( iel == mesh->nt )  mesh->nt--;
+  }
 }
 
 
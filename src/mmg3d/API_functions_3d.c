@@ -215,6 +215,48 @@ int MMG3D_Set_solSize(MMG5_pMesh mesh, MMG5_pSol sol, int typEntity, int np, int
   return(1);
 }
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the sol structure of the field.
+ * \param size number of values per vertex of the field.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Attach a user field to the mesh. If \a sol is not allocated, a field of
+ * \a size zero values per vertex is allocated, the value of the vertex \a ip
+ * starting at sol->m[size*ip]. The field is linearly interpolated at the
+ * points created by the remeshing and packed with the mesh. Its values are
+ * freed with the mesh.
+ *
+ */
+int MMG3D_Add_field(MMG5_pMesh mesh, MMG5_pSol sol, int size) {
+
+  if ( !mesh->point ) {
+    fprintf(stdout,"  ## Error: set the mesh size before adding a field.\n");
+    return(0);
+  }
+  if ( size < 1 || (sol->m && sol->size != size) ) {
+    fprintf(stdout,"  ## Error: wrong size of the user field: %d.\n",size);
+    return(0);
+  }
+
+  if ( !sol->m ) {
+    sol->dim   = 3;
+    sol->size  = size;
+    sol->npmax = mesh->npmax;
+    _MMG5_ADD_MEM(mesh,(sol->size*(sol->npmax+1))*sizeof(double),"user field",
+                  return(0));
+    _MMG5_SAFE_CALLOC(sol->m,(sol->size*(sol->npmax+1)),double);
+  }
+  sol->np  = mesh->np;
+  sol->npi = mesh->np;
+
+  _MMG5_ADD_MEM(mesh,sizeof(MMG5_pSol),"user field",return(0));
+  _MMG5_SAFE_REALLOC(mesh->field,mesh->nfield+1,MMG5_pSol,"user fields");
+  mesh->field[mesh->nfield++] = sol;
+
+  return(_MMG3D_reallocField(mesh));
+}
+
 /**
  * \param mesh pointer toward the mesh structure.
  * \param np number of vertices.
@@ -1386,17 +1428,9 @@ int MMG3D_Set_iparameter(MMG5_pMesh mesh, MMG5_pSol sol, int iparam,int val){
         exit(EXIT_FAILURE);
     break;
   case MMG3D_IPARAM_lag :
-#ifdef USE_SUSCELAS
     if ( val < 0 || val > 2 )
       exit(EXIT_FAILURE);
     mesh->info.lag = val;
-#else
-    fprintf(stdout,"  ## Error:"
-            " \"lagrangian motion\" option unavailable (-lag):\n"
-            " set the USE_SUSCELAS CMake's flag to ON when compiling the mmg3d"
-            " library to enable this feature.\n");
-    return(0);
-#endif
     break;
   case MMG3D_IPARAM_optim :
     mesh->info.optim = val;
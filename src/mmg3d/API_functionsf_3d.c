@@ -146,6 +146,16 @@ FORTRAN_NAME(MMG3D_SET_SOLSIZE,mmg3d_set_solsize,
   return;
 }
 
+/**
+ * See \ref MMG3D_Add_field function in \ref mmg3d/libmmg3d.h file.
+ */
+FORTRAN_NAME(MMG3D_ADD_FIELD,mmg3d_add_field,
+             (MMG5_pMesh *mesh, MMG5_pSol *sol, int* size, int* retval),
+             (mesh, sol, size, retval)) {
+  *retval = MMG3D_Add_field(*mesh,*sol,*size);
+  return;
+}
+
 /**
  * See \ref MMG3D_Set_meshSize function in \ref mmg3d/libmmg3d.h file.
  */
@@ -147,7 +147,8 @@ int _MMG5_movintpt_ani(MMG5_pMesh mesh,MMG5_pSol met,int *list,int ilist,
     return(0);
   }
 
-  /* update position */
+  /* update position (and the user fields) */
+  _MMG3D_movfield(mesh,list,ilist,ppt0->c);
   p0 = &mesh->point[pt->v[i0]];
   p0->c[0] = ppt0->c[0];
   p0->c[1] = ppt0->c[1];
@@ -532,6 +533,9 @@ int _MMG5_movbdyregpt_ani(MMG5_pMesh mesh, MMG5_pSol met,int *listv,
     return(0);
   }
 
+  /* interpolate the user fields at the new position */
+  _MMG3D_movfield(mesh,listv,ilistv,o);
+
   /* When all tests have been carried out, update coordinates, normals and metrics*/
   p0->c[0] = o[0];
   p0->c[1] = o[1];
@@ -843,6 +847,9 @@ int _MMG5_movbdyrefpt_ani(MMG5_pMesh mesh, MMG5_pSol met, int *listv,
 	  return(0);
   }
 
+  /* interpolate the user fields at the new position */
+  _MMG3D_movfield(mesh,listv,ilistv,o);
+
   /* Update coordinates, normals, for new point */
   p0->c[0] = o[0];
   p0->c[1] = o[1];
@@ -1159,6 +1166,9 @@ int _MMG5_movbdynompt_ani(MMG5_pMesh mesh,MMG5_pSol met, int *listv,
 	  return(0);
   }
 
+  /* interpolate the user fields at the new position */
+  _MMG3D_movfield(mesh,listv,ilistv,o);
+
   /* Update coordinates, normals, for new point */
   p0->c[0] = o[0];
   p0->c[1] = o[1];
@@ -1477,6 +1487,9 @@ int _MMG5_movbdyridpt_ani(MMG5_pMesh mesh, MMG5_pSol met, int *listv,
 	  return(0);
   }
 
+  /* interpolate the user fields at the new position */
+  _MMG3D_movfield(mesh,listv,ilistv,o);
+
   /* Update coordinates, normals, for new point */
   p0->c[0] = o[0];
   p0->c[1] = o[1];
@@ -35,6 +35,9 @@
 
 #include "mmg3d.h"
 
+/** Maximal number of gradation updates of a point */
+#define _MMG5_GRADUPD  100
+
 /**
  * \param mesh pointer toward the mesh structure.
  * \param met pointer toward the sol structure.
@@ -264,7 +267,7 @@ static int _MMG5_defmetsin(MMG5_pMesh mesh,MMG5_pSol met,int kel, int iface, int
   double             *m,n[3],isqhmin,isqhmax,b0[3],b1[3],ps1,tau[3];
   double             ntau2,gammasec[3];
   double             c[3],kappa,maxkappa,alpha, hausd,hausd_v;
-  int                lists[MMG3D_LMAX+2],listv[MMG3D_LMAX+2],ilist,ilists,ilistv;
+  int                lists[MMG3D_LMAX+2],ilist,ilists;
   int                k,iel,idp,ifac,isloc,init_s;
   unsigned char      i,i0,i1,i2;
 
@@ -290,7 +293,7 @@ static int _MMG5_defmetsin(MMG5_pMesh mesh,MMG5_pSol met,int kel, int iface, int
 
   if ( mesh->adja[4*(kel-1)+iface+1] ) return(0);
   ilist = _MMG5_boulesurfvolp(mesh,kel,ip,iface,
-                              listv,&ilistv,lists,&ilists,(p0->tag & MG_NOM));
+                              NULL,NULL,lists,&ilists,(p0->tag & MG_NOM));
 
   if ( ilist!=1 ) {
     printf("Error; unable to compute the ball af the point %d.\n", idp);
@@ -609,7 +612,7 @@ static int _MMG5_defmetref(MMG5_pMesh mesh,MMG5_pSol met,int kel, int iface, int
   MMG5_pxPoint  px0;
   _MMG5_Bezier  b;
   MMG5_pPar     par;
-  int           lists[MMG3D_LMAX+2],listv[MMG3D_LMAX+2],ilists,ilistv,ilist;
+  int           lists[MMG3D_LMAX+2],ilists,ilist;
   int           k,iel,ipref[2],idp,ifac,isloc;
   double        *m,isqhmin,isqhmax,*n,r[3][3],lispoi[3*MMG3D_LMAX+1];
   double        ux,uy,uz,det2d,c[3];
@@ -637,7 +640,7 @@ static int _MMG5_defmetref(MMG5_pMesh mesh,MMG5_pSol met,int kel, int iface, int
   /*   } */
   /* } */
 
-  ilist = _MMG5_boulesurfvolp(mesh,kel,ip,iface,listv,&ilistv,lists,&ilists,0);
+  ilist = _MMG5_boulesurfvolp(mesh,kel,ip,iface,NULL,NULL,lists,&ilists,0);
 
   if ( ilist!=1 ) {
     printf("%s:%d:Error: unable to compute the ball af the point %d.\n",
@@ -825,7 +828,7 @@ static int _MMG5_defmetreg(MMG5_pMesh mesh,MMG5_pSol met,int kel,int iface, int
   MMG5_pxPoint   px0;
   _MMG5_Bezier   b;
   MMG5_pPar      par;
-  int            lists[MMG3D_LMAX+2],listv[MMG3D_LMAX+2],ilists,ilistv,ilist;
+  int            lists[MMG3D_LMAX+2],ilists,ilist;
   int            k,iel,idp,ifac,isloc;
   double         *n,*m,r[3][3],ux,uy,uz,lispoi[3*MMG3D_LMAX+1];
   double         det2d,c[3],isqhmin,isqhmax;
@@ -851,7 +854,7 @@ static int _MMG5_defmetreg(MMG5_pMesh mesh,MMG5_pSol met,int kel,int iface, int
     }
   }
 
-  ilist = _MMG5_boulesurfvolp(mesh,kel,ip,iface,listv,&ilistv,lists,&ilists,0);
+  ilist = _MMG5_boulesurfvolp(mesh,kel,ip,iface,NULL,NULL,lists,&ilists,0);
 
   if ( ilist!=1 ) {
     printf("%s:%d:Error: unable to compute the ball af the point %d.\n",
@@ -996,8 +999,9 @@ static int _MMG5_defmetreg(MMG5_pMesh mesh,MMG5_pSol met,int kel,int iface, int
 static inline
 int _MMG5_defmetvol(MMG5_pMesh mesh,MMG5_pSol met) {
   MMG5_pPoint   ppt;
-  double        v[3][3],lambda[3],isqhmax,isqhmin,*m;
-  int           k,i;
+  double        vb[_MMG5_EIGBATCH][3][3],lb[_MMG5_EIGBATCH][3],(*v)[3];
+  double        *mt[_MMG5_EIGBATCH],*lambda,isqhmax,isqhmin,*m;
+  int           ip[_MMG5_EIGBATCH],k,i,l,nb;
 
   isqhmin = 1./(mesh->info.hmin*mesh->info.hmin);
   isqhmax = 1./(mesh->info.hmax*mesh->info.hmax);
@@ -1037,38 +1041,51 @@ int _MMG5_defmetvol(MMG5_pMesh mesh,MMG5_pSol met) {
     }
   }
   else {
-    for (k=1; k<=mesh->np; k++) {
-      ppt = &mesh->point[k];
-
-      if ( ppt->tag & MG_BDY || !MG_VOK(ppt) ) continue;
-
-      /** 2. A metric is provided: truncate it by hmax/hmin */
-      m = &met->m[met->size*k];
-      _MMG5_eigenv(1,m,lambda,v);
-
-      for (i=0; i<3; i++) {
-        if(lambda[i]<=0) {
-          printf("%s:%d:Error: wrong metric at point %d -- eigenvalues :"
-                 " %e %e %e\n",__FILE__,__LINE__,
-                 k,lambda[0],lambda[1],lambda[2]);
-          return(0);
-        }
-        lambda[i]=MG_MIN(isqhmin,lambda[i]);
-        lambda[i]=MG_MAX(isqhmax,lambda[i]);
+    /** 2. A metric is provided: truncate it by hmax/hmin. The metrics are
+     * decomposed by batches of _MMG5_EIGBATCH points. */
+    nb = 0;
+    for (k=1; k<=mesh->np+1; k++) {
+      if ( k <= mesh->np ) {
+        ppt = &mesh->point[k];
+        if ( ppt->tag & MG_BDY || !MG_VOK(ppt) ) continue;
+
+        ip[nb]   = k;
+        mt[nb++] = &met->m[met->size*k];
+        if ( nb < _MMG5_EIGBATCH ) continue;
       }
+      if ( !nb )  break;
+
+      _MMG5_eigenvBatch(nb,mt,lb,vb);
+
+      for (l=0; l<nb; l++) {
+        m      = mt[l];
+        lambda = lb[l];
+        v      = vb[l];
+        for (i=0; i<3; i++) {
+          if(lambda[i]<=0) {
+            printf("%s:%d:Error: wrong metric at point %d -- eigenvalues :"
+                   " %e %e %e\n",__FILE__,__LINE__,
+                   ip[l],lambda[0],lambda[1],lambda[2]);
+            return(0);
+          }
+          lambda[i]=MG_MIN(isqhmin,lambda[i]);
+          lambda[i]=MG_MAX(isqhmax,lambda[i]);
+        }
 
-      m[0] = v[0][0]*v[0][0]*lambda[0] + v[1][0]*v[1][0]*lambda[1]
-        + v[2][0]*v[2][0]*lambda[2];
-      m[1] = v[0][0]*v[0][1]*lambda[0] + v[1][0]*v[1][1]*lambda[1]
-        + v[2][0]*v[2][1]*lambda[2];
-      m[2] = v[0][0]*v[0][2]*lambda[0] + v[1][0]*v[1][2]*lambda[1]
-        + v[2][0]*v[2][2]*lambda[2];
-      m[3] = v[0][1]*v[0][1]*lambda[0] + v[1][1]*v[1][1]*lambda[1]
-        + v[2][1]*v[2][1]*lambda[2];
-      m[4] = v[0][1]*v[0][2]*lambda[0] + v[1][1]*v[1][2]*lambda[1]
-        + v[2][1]*v[2][2]*lambda[2];
-      m[5] = v[0][2]*v[0][2]*lambda[0] + v[1][2]*v[1][2]*lambda[1]
-        + v[2][2]*v[2][2]*lambda[2];
+        m[0] = v[0][0]*v[0][0]*lambda[0] + v[1][0]*v[1][0]*lambda[1]
+          + v[2][0]*v[2][0]*lambda[2];
+        m[1] = v[0][0]*v[0][1]*lambda[0] + v[1][0]*v[1][1]*lambda[1]
+          + v[2][0]*v[2][1]*lambda[2];
+        m[2] = v[0][0]*v[0][2]*lambda[0] + v[1][0]*v[1][2]*lambda[1]
+          + v[2][0]*v[2][2]*lambda[2];
+        m[3] = v[0][1]*v[0][1]*lambda[0] + v[1][1]*v[1][1]*lambda[1]
+          + v[2][1]*v[2][1]*lambda[2];
+        m[4] = v[0][1]*v[0][2]*lambda[0] + v[1][1]*v[1][2]*lambda[1]
+          + v[2][1]*v[2][2]*lambda[2];
+        m[5] = v[0][2]*v[0][2]*lambda[0] + v[1][2]*v[1][2]*lambda[1]
+          + v[2][2]*v[2][2]*lambda[2];
+      }
+      nb = 0;
     }
   }
 
@@ -1129,12 +1146,10 @@ int _MMG3D_intextmet(MMG5_pMesh mesh,MMG5_pSol met,int np,double me[6]) {
  *
  */
 int _MMG3D_defsiz_ani(MMG5_pMesh mesh,MMG5_pSol met) {
-  MMG5_pTetra   pt;
-  MMG5_pxTetra  pxt;
   MMG5_pPoint   ppt;
   double        mm[6];
-  int           k,l,iploc;
-  char          i,ismet;
+  int           k,l,ip,iploc,ok,ier,*adr,*list;
+  char          *loc,i,ismet;
 
   if ( abs(mesh->info.imprim) > 5 || mesh->info.ddebug )
     fprintf(stdout,"  ** Defining anisotropic map\n");
@@ -1154,49 +1169,52 @@ int _MMG3D_defsiz_ani(MMG5_pMesh mesh,MMG5_pSol met) {
     ppt->flag = 0;
   }
 
-  for (k=1; k<=mesh->ne; k++) {
-    pt = &mesh->tetra[k];
-    // Warning: why are we skipped the tetra with negative refs ?
-    if ( !MG_EOK(pt) || pt->ref < 0 || (pt->tag & MG_REQ) )   continue;
-    else if ( !pt->xt )  continue;
-
-    pxt = &mesh->xtetra[pt->xt];
-    for (l=0; l<4; l++) {
-      if ( !(pxt->ftag[l] & MG_BDY) ) continue;
-      // In multidomain case, acces the face through a tetra for which it is
-      // well oriented.
-      if ( !(MG_GET(pxt->ori,l)) ) continue;
-
-      for (i=0; i<3; i++) {
-        iploc = _MMG5_idir[l][i];
-        ppt   = &mesh->point[pt->v[iploc]];
-
-        if ( ppt->flag || !MG_VOK(ppt) )  continue;
-        if ( ismet )  memcpy(mm,&met->m[6*(pt->v[iploc])],6*sizeof(double));
-
-        if ( MG_SIN(ppt->tag) || (ppt->tag & MG_NOM) ) {
-          if ( !_MMG5_defmetsin(mesh,met,k,l,iploc) )  continue;
-        }
-        else if ( ppt->tag & MG_GEO ) {
-          if ( !_MMG5_defmetrid(mesh,met,k,l,iploc))  continue;
-        }
-        else if ( ppt->tag & MG_REF ) {
-          if ( !_MMG5_defmetref(mesh,met,k,l,iploc) )  continue;
-        }
-        else {
-          if ( !_MMG5_defmetreg(mesh,met,k,l,iploc) )  continue;
+  /* In multidomain case, acces the faces through a tetra for which they are
+   * well oriented. The metric at a point is computed from the first face for
+   * which it succeeds, points are independent. */
+  if ( !_MMG3D_surfIncid(mesh,&adr,&list,&loc) )  return(0);
+
+  ier = 1;
+#pragma omp parallel for schedule(dynamic,64) private(ppt,mm,k,l,iploc,i,ok)
+  for (ip=1; ip<=mesh->np; ip++) {
+    ppt = &mesh->point[ip];
+    if ( !MG_VOK(ppt) )  continue;
+    if ( adr[ip] == adr[ip+1] )  continue;
+
+    if ( ismet )  memcpy(mm,&met->m[6*ip],6*sizeof(double));
+
+    for (l=adr[ip]; l<adr[ip+1]; l++) {
+      k     = list[l] / 4;
+      i     = list[l] % 4;
+      iploc = loc[l];
+
+      if ( MG_SIN(ppt->tag) || (ppt->tag & MG_NOM) )
+        ok = _MMG5_defmetsin(mesh,met,k,i,iploc);
+      else if ( ppt->tag & MG_GEO )
+        ok = _MMG5_defmetrid(mesh,met,k,i,iploc);
+      else if ( ppt->tag & MG_REF )
+        ok = _MMG5_defmetref(mesh,met,k,i,iploc);
+      else
+        ok = _MMG5_defmetreg(mesh,met,k,i,iploc);
+      if ( !ok )  continue;
+
+      if ( ismet ) {
+        if ( !_MMG3D_intextmet(mesh,met,ip,mm) ) {
+          fprintf(stdout,"%s:%d:Error: unable to intersect metrics"
+                  " at point %d.\n",__FILE__,__LINE__,ip);
+#ifdef _OPENMP
+#pragma omp atomic write
+#endif
+          ier = 0;
+          break;
         }
-        if ( ismet ) {
-          if ( !_MMG3D_intextmet(mesh,met,pt->v[iploc],mm) ) {
-            fprintf(stdout,"%s:%d:Error: unable to intersect metrics"
-                    " at point %d.\n",__FILE__,__LINE__, pt->v[iploc]);
-            return(0);
-          }
-        }
-        ppt->flag = 1;
       }
+      ppt->flag = 1;
+      break;
     }
   }
+  _MMG3D_freeSurfIncid(mesh,&adr,&list,&loc);
+  if ( !ier )  return(0);
 
   /* search for unintialized metric */
   _MMG5_defUninitSize(mesh,met,ismet);
@@ -1431,29 +1449,202 @@ int _MMG5_grad2metVol(MMG5_pMesh mesh,MMG5_pSol met,MMG5_pTetra pt,int ia) {
 /**
  * \param mesh pointer toward the mesh structure.
  * \param met pointer toward the metric structure.
- * \return 1
+ * \param k point index.
+ * \return the smallest size prescribed by the metric at point \a k.
  *
+ * Compute the heap key used to order the gradation of the metric at point \a k.
  *
- * Enforces mesh gradation by truncating metric field.
+ */
+static inline
+double _MMG5_gradKey_ani(MMG5_pMesh mesh,MMG5_pSol met,int k) {
+  MMG5_pPoint    p0;
+  double         *m,lambda[3],vp[3][3],lmax;
+
+  p0 = &mesh->point[k];
+  m  = &met->m[6*k];
+
+  if ( (!( MG_SIN(p0->tag) || (p0->tag & MG_NOM) )) && (p0->tag & MG_GEO) ) {
+    /* ridge metric: sizes along the tangent and the 2 normals */
+    lmax = MG_MAX(MG_MAX(m[0],m[1]),MG_MAX(m[2],MG_MAX(m[3],m[4])));
+  }
+  else if ( _MMG5_eigenv(1,m,lambda,vp) ) {
+    lmax = MG_MAX(lambda[0],MG_MAX(lambda[1],lambda[2]));
+  }
+  else
+    lmax = MG_MAX(m[0],MG_MAX(m[3],m[5]));
+
+  return( lmax > _MMG5_EPSD ? 1./sqrt(lmax) : DBL_MAX );
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param heap pointer toward the heap.
+ * \param cnt number of updates of each point.
+ * \param k index of the updated point.
+ *
+ * Push the updated point \a k in the heap unless it has reached its maximal
+ * number of updates.
  *
  */
-int _MMG5_gradsiz_ani(MMG5_pMesh mesh,MMG5_pSol met) {
+static inline
+void _MMG5_gradPush_ani(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_Heap *heap,
+                        int *cnt,int k) {
+  if ( ++cnt[k] > _MMG5_GRADUPD )  return;
+  _MMG5_heapPush(heap,k,_MMG5_gradKey_ani(mesh,met,k));
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param adr addresses of the point balls (see \ref _MMG3D_ballIncid).
+ * \param list point balls.
+ * \param cnt number of updates of each point (zeroed).
+ * \return the number of updated metrics, -1 if fail.
+ *
+ * Enforces the surface gradation of the metric along the boundary edges,
+ * treating first the points with the smallest sizes.
+ *
+ */
+static int
+_MMG5_gradsizSurf_ani(MMG5_pMesh mesh,MMG5_pSol met,int *adr,int *list,
+                      int *cnt) {
   MMG5_pTetra   pt;
   MMG5_pxTetra  pxt;
   MMG5_Tria     ptt;
-  MMG5_pPoint   p0,p1;
+  _MMG5_Heap    heap;
+  int           k,l,iel,ip,ier,nu;
+  char          i,j,iloc,i0,i1;
+
+  if ( !_MMG5_heapNew(mesh,&heap,mesh->np) )  return(-1);
+
+  for (k=1; k<=mesh->np; k++) {
+    if ( !MG_VOK(&mesh->point[k]) || !(mesh->point[k].tag & MG_BDY) )
+      continue;
+    _MMG5_heapPush(&heap,k,_MMG5_gradKey_ani(mesh,met,k));
+  }
+
+  nu = 0;
+  while ( (ip = _MMG5_heapPop(&heap)) ) {
+    for (l=adr[ip]; l<adr[ip+1]; l++) {
+      iel  = list[l]/4;
+      iloc = list[l]%4;
+      pt   = &mesh->tetra[iel];
+      if ( !pt->xt )  continue;
+      pxt  = &mesh->xtetra[pt->xt];
+
+      for (i=0; i<4; i++) {
+        if ( i == iloc || !(pxt->ftag[i] & MG_BDY) )  continue;
+
+        /* Gradation along the surface edges of ip: virtual triangle */
+        _MMG5_tet2tri(mesh,iel,i,&ptt);
+        for (j=0; j<3; j++) {
+          i0  = _MMG5_inxt2[j];
+          i1  = _MMG5_iprv2[j];
+          if ( ptt.v[i0] != ip && ptt.v[i1] != ip )  continue;
+
+          /* gradation along the tangent plane */
+          ier = _MMG5_grad2metSurf(mesh,met,&ptt,j);
+          if ( ier == i0 ) {
+            _MMG5_gradPush_ani(mesh,met,&heap,cnt,ptt.v[i0]);
+            nu++;
+          }
+          else if ( ier == i1 ) {
+            _MMG5_gradPush_ani(mesh,met,&heap,cnt,ptt.v[i1]);
+            nu++;
+          }
+        }
+      }
+    }
+  }
+  _MMG5_heapFree(mesh,&heap);
+
+  return(nu);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param adr addresses of the point balls (see \ref _MMG3D_ballIncid).
+ * \param list point balls.
+ * \param cnt number of updates of each point (zeroed).
+ * \return the number of updated metrics, -1 if fail.
+ *
+ * Enforces the volume gradation of the metric along the mesh edges, treating
+ * first the points with the smallest sizes.
+ *
+ */
+static int
+_MMG5_gradsizVol_ani(MMG5_pMesh mesh,MMG5_pSol met,int *adr,int *list,
+                     int *cnt) {
+  MMG5_pTetra   pt;
+  _MMG5_Heap    heap;
+  int           *seen,base,k,l,ip,ip1,ier,nu;
+  char          j,iloc,ia,i0,i1;
+
+  if ( !_MMG5_heapNew(mesh,&heap,mesh->np) )  return(-1);
+
+  _MMG5_ADD_MEM(mesh,(mesh->np+1)*sizeof(int),"seen points",
+                _MMG5_heapFree(mesh,&heap);return(-1));
+  _MMG5_SAFE_CALLOC(seen,mesh->np+1,int);
+
+  for (k=1; k<=mesh->np; k++) {
+    if ( !MG_VOK(&mesh->point[k]) )  continue;
+    _MMG5_heapPush(&heap,k,_MMG5_gradKey_ani(mesh,met,k));
+  }
+
+  nu = base = 0;
+  while ( (ip = _MMG5_heapPop(&heap)) ) {
+    ++base;
+    for (l=adr[ip]; l<adr[ip+1]; l++) {
+      iloc = list[l]%4;
+      pt   = &mesh->tetra[list[l]/4];
+
+      for (j=0; j<3; j++) {
+        /* Gradation along a volume edge, each edge of ip is treated once */
+        ia  = _MMG5_arpt[iloc][j];
+        i0  = _MMG5_iare[ia][0];
+        i1  = _MMG5_iare[ia][1];
+        ip1 = ( pt->v[i0] == ip ) ? pt->v[i1] : pt->v[i0];
+        if ( seen[ip1] == base )  continue;
+        seen[ip1] = base;
+
+        ier = _MMG5_grad2metVol(mesh,met,pt,ia);
+        if ( ier == i0 ) {
+          _MMG5_gradPush_ani(mesh,met,&heap,cnt,pt->v[i0]);
+          nu++;
+        }
+        else if ( ier == i1 ) {
+          _MMG5_gradPush_ani(mesh,met,&heap,cnt,pt->v[i1]);
+          nu++;
+        }
+      }
+    }
+  }
+  _MMG5_DEL_MEM(mesh,seen,(mesh->np+1)*sizeof(int));
+  _MMG5_heapFree(mesh,&heap);
+
+  return(nu);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \return 0 if fail, 1 otherwise.
+ *
+ * Enforces mesh gradation by truncating metric field. The metrics are
+ * propagated from the smallest sizes to the largest ones and each point is
+ * updated a bounded number of times.
+ *
+ */
+int _MMG5_gradsiz_ani(MMG5_pMesh mesh,MMG5_pSol met) {
+  MMG5_pPoint   p1;
   double        *m,mv;
-  int           k,it,itv,nup,nu,nupv,maxit;
-  int           i,j,ip0,ip1;
-  char          ier,i0,i1;
+  int           *adr,*list,*cnt,k,nup,nupv;
 
   if ( abs(mesh->info.imprim) > 5 || mesh->info.ddebug )
     fprintf(stdout,"  ** Anisotropic mesh gradation\n");
 
-  mesh->base = 0;
-  for (k=1; k<=mesh->np; k++)
-    mesh->point[k].flag = mesh->base;
-
   /* First step : make ridges iso in each apairing direction */
   for (k=1; k<= mesh->np; k++) {
     p1 = &mesh->point[k];
@@ -1470,97 +1661,31 @@ int _MMG5_gradsiz_ani(MMG5_pMesh mesh,MMG5_pSol met) {
     m[4] = mv;
   }
 
-  it = nup = 0;
-  maxit = 100;
-  do {
-    mesh->base++;
-    nu = 0;
-    for (k=1; k<=mesh->ne; k++) {
-      pt = &mesh->tetra[k];
-      if ( !MG_EOK(pt) )  continue;
-      pxt = pt->xt ? &mesh->xtetra[pt->xt] : 0;
-
-      if ( pxt ) {
-        for (i=0; i<4; i++) {
-          if ( pxt->ftag[i] & MG_BDY) {
-            /* Gradation along a surface edge */
-            /* virtual triangle */
-            _MMG5_tet2tri(mesh,k,i,&ptt);
-            for (j=0; j<3; j++) {
-              i0  = _MMG5_inxt2[j];
-              i1  = _MMG5_iprv2[j];
-              ip0 = ptt.v[i0];
-              ip1 = ptt.v[i1];
-              p0  = &mesh->point[ip0];
-              p1  = &mesh->point[ip1];
-              if ( (p0->flag < mesh->base-1) && (p1->flag < mesh->base-1) )
-                continue;
-              /* gradation along the tangent plane */
-              ier = _MMG5_grad2metSurf(mesh,met,&ptt,j);
-              if ( ier == i0 ) {
-                p0->flag = mesh->base;
-                nu++;
-              }
-              else if ( ier == i1 ) {
-                p1->flag = mesh->base;
-                nu++;
-              }
-            }
-          }
+  if ( !_MMG3D_ballIncid(mesh,&adr,&list) )  return(0);
 
-          else continue;
-        }
-      }
-    }
-    nup += nu;
-  }
-  while( ++it < maxit && nu > 0 );
-
-  mesh->base = 0;
-  for (k=1; k<=mesh->np; k++)
-    mesh->point[k].flag = mesh->base;
+  _MMG5_ADD_MEM(mesh,(mesh->np+1)*sizeof(int),"gradation counters",
+                _MMG3D_freeBallIncid(mesh,&adr,&list);return(0));
+  _MMG5_SAFE_CALLOC(cnt,mesh->np+1,int);
 
-  nupv = itv = 0;
-  maxit = 500;
+  nup = _MMG5_gradsizSurf_ani(mesh,met,adr,list,cnt);
 
-  do {
-    mesh->base++;
-    nu = 0;
-    for (k=1; k<=mesh->ne; k++) {
-      pt = &mesh->tetra[k];
-      if ( !MG_EOK(pt) )  continue;
-      for (i=0; i<4; i++) {
-        /* Gradation along a volume edge */
-        i0  = _MMG5_iare[i][0];
-        i1  = _MMG5_iare[i][1];
-        ip0 = pt->v[i0];
-        ip1 = pt->v[i1];
-        p0  = &mesh->point[ip0];
-        p1  = &mesh->point[ip1];
-        if ( p0->flag < mesh->base-1 && p1->flag < mesh->base-1 )  continue;
-
-        ier = _MMG5_grad2metVol(mesh,met,pt,i);
-        if ( ier == i0 ) {
-          p0->flag = mesh->base;
-          nu++;
-        }
-        else if ( ier == i1 ) {
-          p1->flag = mesh->base;
-          nu++;
-        }
-      }
-    }
-    nupv += nu;
+  nupv = -1;
+  if ( nup >= 0 ) {
+    memset(cnt,0,(mesh->np+1)*sizeof(int));
+    nupv = _MMG5_gradsizVol_ani(mesh,met,adr,list,cnt);
   }
-  while( ++itv < maxit && nu > 0 );
+
+  _MMG5_DEL_MEM(mesh,cnt,(mesh->np+1)*sizeof(int));
+  _MMG3D_freeBallIncid(mesh,&adr,&list);
+  if ( nup < 0 || nupv < 0 )  return(0);
 
   if ( abs(mesh->info.imprim) > 3 ) {
     if ( abs(mesh->info.imprim) < 5 && !mesh->info.ddebug ) {
-      fprintf(stdout,"    gradation: %7d updated, %d iter\n",nup+nupv,it+itv);
+      fprintf(stdout,"    gradation: %7d updated\n",nup+nupv);
     }
     else {
-      fprintf(stdout,"    surface gradation: %7d updated, %d iter\n"
-              "    volume gradation:  %7d updated, %d iter\n",nup,it,nupv,itv);
+      fprintf(stdout,"    surface gradation: %7d updated\n"
+              "    volume gradation:  %7d updated\n",nup,nupv);
     }
   }
   return(1);
@@ -333,6 +333,8 @@ int _MMG5_mmg3dBezierCP(MMG5_pMesh mesh,MMG5_Tria *pt,_MMG5_pBezier pb,char ori)
   p[1] = &mesh->point[ib];
   p[2] = &mesh->point[ic];
 
+  if ( _MMG5_bezierCacheGet(mesh,pt,pb,ori) )  return(1);
+
   memset(pb,0,sizeof(_MMG5_Bezier));
 
   /* first 3 CP = vertices, normals */
@@ -530,6 +532,7 @@ int _MMG5_mmg3dBezierCP(MMG5_pMesh mesh,MMG5_Tria *pt,_MMG5_pBezier pb,char ori)
     pb->b[9][2] += 0.25 * (pb->b[2*i+3][2] + pb->b[2*i+4][2]);
   }
 
+  _MMG5_bezierCachePut(mesh,pt,pb,ori);
   return(1);
 }
 
@@ -37,30 +37,152 @@
 
 extern MMG5_Info  info;
 
+/**
+ * \param vset pointer toward the visited set.
+ *
+ * Initialize an empty visited set on its local storage.
+ *
+ */
+void _MMG3D_initVset(_MMG3D_Vset *vset) {
+  vset->tab = vset->loc;
+  vset->siz = _MMG3D_VSETSIZ;
+  vset->shf = 24;
+  vset->nel = 0;
+  memset(vset->loc,0,_MMG3D_VSETSIZ*sizeof(int));
+}
+
+/**
+ * \param vset pointer toward the visited set.
+ * \param k index of the tetra to insert (k > 0).
+ * \return 1 if \a k is inserted, 0 if it was already in the set.
+ *
+ * Insert the tetra \a k in the visited set. The table is enlarged (and moved
+ * on the heap) when it is half full.
+ *
+ */
+int _MMG3D_addVset(_MMG3D_Vset *vset,int k) {
+  int   *old,siz,i,h;
+
+  h = (int)(((unsigned int)k * 2654435761u) >> vset->shf);
+  while ( vset->tab[h] ) {
+    if ( vset->tab[h] == k )  return(0);
+    h = (h+1) & (vset->siz-1);
+  }
+  vset->tab[h] = k;
+  vset->nel++;
+
+  if ( 2*vset->nel < vset->siz )  return(1);
+
+  /* rehash in a 4 times bigger table */
+  old = vset->tab;
+  siz = vset->siz;
+  vset->siz *= 4;
+  vset->shf -= 2;
+  _MMG5_SAFE_CALLOC(vset->tab,vset->siz,int);
+  for (i=0; i<siz; i++) {
+    if ( !old[i] )  continue;
+    h = (int)(((unsigned int)old[i] * 2654435761u) >> vset->shf);
+    while ( vset->tab[h] )  h = (h+1) & (vset->siz-1);
+    vset->tab[h] = old[i];
+  }
+  if ( old != vset->loc )  _MMG5_SAFE_FREE(old);
+
+  return(1);
+}
+
+/**
+ * \param vset pointer toward the visited set.
+ *
+ * Release the heap storage of a visited set.
+ *
+ */
+void _MMG3D_freeVset(_MMG3D_Vset *vset) {
+  if ( vset->tab != vset->loc )  _MMG5_SAFE_FREE(vset->tab);
+  vset->tab = NULL;
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param lst pointer toward the list.
+ * \param max initial capacity of the list.
+ * \return 1 if success, 0 if the memory limit is reached.
+ *
+ * Allocate an empty list of capacity \a max.
+ *
+ */
+int _MMG3D_initList(MMG5_pMesh mesh,_MMG3D_List *lst,int max) {
+  lst->item = NULL;
+  lst->max  = 0;
+  max = MG_MAX(max,4);
+  _MMG5_ADD_MEM(mesh,max*sizeof(int),"cavity list",return(0));
+  _MMG5_SAFE_MALLOC(lst->item,max,int);
+  lst->max = max;
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param lst pointer toward the list.
+ * \param n wanted capacity.
+ * \return 1 if success, 0 if the memory limit is reached (the list is then
+ * unchanged).
+ *
+ * Enlarge the list so that it can store at least \a n items (the capacity is
+ * at least doubled to amortize the reallocations).
+ *
+ */
+int _MMG3D_growList(MMG5_pMesh mesh,_MMG3D_List *lst,int n) {
+  int   max;
+
+  if ( n <= lst->max )  return(1);
+  max = MG_MAX(n,2*lst->max);
+  _MMG5_ADD_MEM(mesh,(max-lst->max)*sizeof(int),"larger cavity list",
+                return(0));
+  _MMG5_SAFE_REALLOC(lst->item,max,int,"larger cavity list");
+  lst->max = max;
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param lst pointer toward the list.
+ *
+ * Release the storage of a list.
+ *
+ */
+void _MMG3D_freeList(MMG5_pMesh mesh,_MMG3D_List *lst) {
+  _MMG5_DEL_MEM(mesh,lst->item,lst->max*sizeof(int));
+  lst->max = 0;
+}
+
 /**
  * \param mesh pointer toward the mesh structure.
  * \param start index of the starting tetrahedra.
  * \param ip local index of the point in the tetrahedra \a start.
- * \param list pointer toward the list of the tetra in the volumic ball of
- * \a ip.
+ * \param lst pointer toward the list of the tetra in the volumic ball of
+ * \a ip (enlarged if needed).
  * \return 0 if fail and the number of the tetra in the ball otherwise.
  *
  * Fill the volumic ball (i.e. filled with tetrahedra) of point \a ip in tetra
- * \a start. Results are stored under the form \f$4*kel + jel\f$, kel = number
- * of the tetra, jel = local index of p within kel.
+ * \a start. Results are stored in \a lst->item under the form \f$4*kel +
+ * jel\f$, kel = number of the tetra, jel = local index of p within kel. The
+ * visited tetra are stored in a local \ref _MMG3D_Vset: the mesh is not
+ * modified and the function may be called concurrently on distinct lists.
  *
  */
-int _MMG5_boulevolp (MMG5_pMesh mesh, int start, int ip, int * list){
+int _MMG5_boulevolp (MMG5_pMesh mesh, int start, int ip, _MMG3D_List *lst){
   MMG5_pTetra  pt,pt1;
-  int    *adja,nump,ilist,base,cur,k,k1;
+  _MMG3D_Vset  vset;
+  int    *adja,*list,nump,ilist,cur,k,k1;
   char    j,l,i;
 
-  base = ++mesh->base;
+  _MMG3D_initVset(&vset);
   pt   = &mesh->tetra[start];
   nump = pt->v[ip];
 
   /* Store initial tetrahedron */
-  pt->flag = base;
+  _MMG3D_addVset(&vset,start);
+  list    = lst->item;
   list[0] = 4*start + ip;
   ilist=1;
 
@@ -75,22 +197,262 @@ int _MMG5_boulevolp (MMG5_pMesh mesh, int start, int ip, int * list){
       i  = _MMG5_inxt3[i];
       k1 = adja[i] / 4;
       if ( !k1 )  continue;
+      if ( !_MMG3D_addVset(&vset,k1) )  continue;
       pt1 = &mesh->tetra[k1];
-      if ( pt1->flag == base )  continue;
-      pt1->flag = base;
       for (j=0; j<4; j++)
         if ( pt1->v[j] == nump )  break;
       assert(j<4);
-      /* overflow */
-      if ( ilist > MMG3D_LMAX-3 )  return(0);
+      /* enlarge the list */
+      if ( ilist >= lst->max ) {
+        if ( !_MMG3D_growList(mesh,lst,ilist+1) ) {
+          _MMG3D_freeVset(&vset);
+          return(0);
+        }
+        list = lst->item;
+      }
       list[ilist] = 4*k1+j;
       ilist++;
     }
     cur++;
   }
+  _MMG3D_freeVset(&vset);
   return(ilist);
 }
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param adr pointer toward the table of the ball addresses (allocated here).
+ * \param list pointer toward the table of the balls (allocated here).
+ * \return 1 if success, 0 if fail.
+ *
+ * Build the volumic balls of all the mesh points in compressed storage: the
+ * ball of point \a k is stored in \f$list[adr[k]..adr[k+1]-1]\f$ under the
+ * form \f$4*kel + jel\f$ (as in \ref _MMG5_boulevolp), by increasing tetra
+ * index. Tables must be freed by \ref _MMG3D_freeBallIncid.
+ *
+ * The balls are counted and filled concurrently over the tetra, then each
+ * ball is sorted so that the result does not depend on the thread schedule.
+ *
+ */
+int _MMG3D_ballIncid(MMG5_pMesh mesh,int **adr,int **list) {
+  MMG5_pTetra  pt;
+  int          *ad,*li,k,ip,pos,l,m,val;
+  char         i;
+
+  _MMG5_ADD_MEM(mesh,(mesh->np+2+4*mesh->ne+1)*sizeof(int),"point balls",
+                return(0));
+  _MMG5_SAFE_CALLOC(ad,mesh->np+2,int);
+  _MMG5_SAFE_MALLOC(li,4*mesh->ne+1,int);
+
+  /* count the tetra of each ball */
+#pragma omp parallel for schedule(static) private(pt,i)
+  for (k=1; k<=mesh->ne; k++) {
+    pt = &mesh->tetra[k];
+    if ( !MG_EOK(pt) )  continue;
+    for (i=0; i<4; i++) {
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+      ad[pt->v[i]+1]++;
+    }
+  }
+  for (ip=1; ip<=mesh->np; ip++)
+    ad[ip+1] += ad[ip];
+
+  /* fill the balls: ad[ip] is used as insertion cursor then shifted back */
+#pragma omp parallel for schedule(static) private(pt,i,pos)
+  for (k=1; k<=mesh->ne; k++) {
+    pt = &mesh->tetra[k];
+    if ( !MG_EOK(pt) )  continue;
+    for (i=0; i<4; i++) {
+#ifdef _OPENMP
+#pragma omp atomic capture
+#endif
+      pos = ad[pt->v[i]]++;
+      li[pos] = 4*k+i;
+    }
+  }
+  for (ip=mesh->np; ip>0; ip--)
+    ad[ip] = ad[ip-1];
+  ad[0] = 0;
+
+  /* sort the balls (insertion sort, balls are small) */
+#pragma omp parallel for schedule(dynamic,256) private(l,m,val)
+  for (ip=1; ip<=mesh->np; ip++) {
+    for (l=ad[ip]+1; l<ad[ip+1]; l++) {
+      val = li[l];
+      for (m=l; m>ad[ip] && li[m-1] > val; m--)
+        li[m] = li[m-1];
+      li[m] = val;
+    }
+  }
+
+  *adr  = ad;
+  *list = li;
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param adr pointer toward the table of the ball addresses.
+ * \param list pointer toward the table of the balls.
+ *
+ * Free the point balls built by \ref _MMG3D_ballIncid.
+ *
+ */
+void _MMG3D_freeBallIncid(MMG5_pMesh mesh,int **adr,int **list) {
+
+  _MMG5_DEL_MEM(mesh,*adr,(mesh->np+2)*sizeof(int));
+  _MMG5_DEL_MEM(mesh,*list,(4*mesh->ne+1)*sizeof(int));
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ *
+ * Store in the field \a s of each point the index of a tetra containing it.
+ * The remeshing kernels keep this field up to date (see \ref _MMG3D_SETSTART
+ * and \ref _MMG3D_delElt) so the ball of a point can be computed without
+ * searching a starting tetra.
+ *
+ */
+void _MMG3D_setPointStart(MMG5_pMesh mesh) {
+  MMG5_pTetra  pt;
+  int          k;
+  char         i;
+
+#pragma omp parallel for schedule(static)
+  for (k=1; k<=mesh->np; k++)
+    mesh->point[k].s = 0;
+
+  /* any incident tetra is suitable: keep the last one */
+  for (k=1; k<=mesh->ne; k++) {
+    pt = &mesh->tetra[k];
+    if ( !MG_EOK(pt) )  continue;
+    for (i=0; i<4; i++)
+      mesh->point[pt->v[i]].s = k;
+  }
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param ip index of the point.
+ * \param iloc pointer toward the local index of \a ip in the returned tetra.
+ * \return the index of a tetra containing \a ip, 0 if the stored incident
+ * tetra is out of date (in this case, \ref _MMG3D_setPointStart must be
+ * called) or if \a ip doesn't belong to any tetra.
+ *
+ */
+int _MMG3D_ptStart(MMG5_pMesh mesh,int ip,char *iloc) {
+  MMG5_pTetra  pt;
+  int          k;
+  char         i;
+
+  k = mesh->point[ip].s;
+  if ( k <= 0 || k > mesh->ne )  return(0);
+
+  pt = &mesh->tetra[k];
+  if ( !MG_EOK(pt) )  return(0);
+
+  for (i=0; i<4; i++) {
+    if ( pt->v[i] == ip ) {
+      *iloc = i;
+      return(k);
+    }
+  }
+  return(0);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param adr pointer toward the table of the addresses (allocated here).
+ * \param list pointer toward the table of the faces (allocated here).
+ * \param loc pointer toward the table of the local indices (allocated here).
+ * \return 1 if success, 0 if fail.
+ *
+ * List, for each point, the boundary faces that contain it and that are well
+ * oriented in a non required tetra with a non negative reference: the faces of
+ * point \a k are stored in \f$list[adr[k]..adr[k+1]-1]\f$ under the form
+ * \f$4*kel + iface\f$, in increasing tetra order, and \a loc gives the local
+ * index of the point in \a kel. Tables must be freed by \ref
+ * _MMG3D_freeSurfIncid.
+ *
+ */
+int _MMG3D_surfIncid(MMG5_pMesh mesh,int **adr,int **list,char **loc) {
+  MMG5_pTetra  pt;
+  MMG5_pxTetra pxt;
+  int          *ad,*li,k,ip,ns;
+  char         *lo,i,j,i0;
+
+  _MMG5_ADD_MEM(mesh,(mesh->np+2)*sizeof(int),"surface balls",return(0));
+  _MMG5_SAFE_CALLOC(ad,mesh->np+2,int);
+
+  /* count the boundary faces of each point */
+  for (k=1; k<=mesh->ne; k++) {
+    pt = &mesh->tetra[k];
+    if ( !MG_EOK(pt) || pt->ref < 0 || (pt->tag & MG_REQ) )   continue;
+    else if ( !pt->xt )  continue;
+
+    pxt = &mesh->xtetra[pt->xt];
+    for (i=0; i<4; i++) {
+      if ( !(pxt->ftag[i] & MG_BDY) || !MG_GET(pxt->ori,i) ) continue;
+      for (j=0; j<3; j++)
+        ad[pt->v[_MMG5_idir[i][j]]+1]++;
+    }
+  }
+  for (ip=1; ip<=mesh->np; ip++)
+    ad[ip+1] += ad[ip];
+  ns = ad[mesh->np+1];
+
+  _MMG5_ADD_MEM(mesh,(ns+1)*(sizeof(int)+sizeof(char)),"surface balls",
+                _MMG5_DEL_MEM(mesh,ad,(mesh->np+2)*sizeof(int));return(0));
+  _MMG5_SAFE_MALLOC(li,ns+1,int);
+  _MMG5_SAFE_MALLOC(lo,ns+1,char);
+
+  /* fill the lists: ad[ip] is used as insertion cursor then shifted back */
+  for (k=1; k<=mesh->ne; k++) {
+    pt = &mesh->tetra[k];
+    if ( !MG_EOK(pt) || pt->ref < 0 || (pt->tag & MG_REQ) )   continue;
+    else if ( !pt->xt )  continue;
+
+    pxt = &mesh->xtetra[pt->xt];
+    for (i=0; i<4; i++) {
+      if ( !(pxt->ftag[i] & MG_BDY) || !MG_GET(pxt->ori,i) ) continue;
+      for (j=0; j<3; j++) {
+        i0 = _MMG5_idir[i][j];
+        ip = pt->v[i0];
+        li[ad[ip]]   = 4*k+i;
+        lo[ad[ip]++] = i0;
+      }
+    }
+  }
+  for (ip=mesh->np; ip>0; ip--)
+    ad[ip] = ad[ip-1];
+  ad[0] = 0;
+
+  *adr  = ad;
+  *list = li;
+  *loc  = lo;
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param adr pointer toward the table of the addresses.
+ * \param list pointer toward the table of the faces.
+ * \param loc pointer toward the table of the local indices.
+ *
+ * Free the tables built by \ref _MMG3D_surfIncid.
+ *
+ */
+void _MMG3D_freeSurfIncid(MMG5_pMesh mesh,int **adr,int **list,char **loc) {
+  int ns;
+
+  ns = (*adr)[mesh->np+1];
+  _MMG5_DEL_MEM(mesh,*list,(ns+1)*sizeof(int));
+  _MMG5_DEL_MEM(mesh,*loc,(ns+1)*sizeof(char));
+  _MMG5_DEL_MEM(mesh,*adr,(mesh->np+2)*sizeof(int));
+}
+
 /**
  * \param mesh pointer toward the mesh  structure.
  * \param start tetra index.
@@ -109,12 +471,11 @@ int _MMG5_boulenm(MMG5_pMesh mesh,int start,int ip,int iface,
   MMG5_pTetra   pt;
   MMG5_pPoint   p0,p1,ppt;
   double   dd,nt[3],l0,l1;
-  int      base,nump,nr,nnm,k,piv,na,nb,adj,nvstart,fstart,aux,ip0,ip1;
+  int      nump,nr,nnm,k,piv,na,nb,adj,nvstart,fstart,aux,ip0,ip1;
   int     *adja;
   char     iopp,ipiv,indb,inda,i,ipa,ipb,isface,tag;
   char     indedg[4][4] = { {-1,0,1,2}, {0,-1,3,4}, {1,3,-1,5}, {2,4,5,-1} };
 
-  base = ++mesh->base;
   nr  = nnm = 0;
   ip0 = ip1 = 0;
 
@@ -174,12 +535,6 @@ int _MMG5_boulenm(MMG5_pMesh mesh,int start,int ip,int iface,
       k = adj;
       pt = &mesh->tetra[k];
       adja = &mesh->adja[4*(k-1)+1];
-      if ( pt->flag != base ) {
-        for (i=0; i<4; i++)
-          if ( pt->v[i] == nump )  break;
-        assert(i<4);
-        pt->flag = base;
-      }
 
       /* identification of edge number in tetra k */
       for (i=0; i<6; i++) {
@@ -267,6 +622,8 @@ int _MMG5_boulenm(MMG5_pMesh mesh,int start,int ip,int iface,
 
 /**
  * \param mesh pointer toward the mesh structure.
+ * \param lst pointer toward a list used to store the volumic ball of \a ip
+ * (enlarged if needed).
  * \param start index of the starting tetrahedra.
  * \param ip local index of the point in the tetrahedra \a start.
  * \param ng pointer toward the number of ridges.
@@ -277,35 +634,27 @@ int _MMG5_boulenm(MMG5_pMesh mesh,int start,int ip,int iface,
  * the vertex \a ip when ip is non-manifold.
  *
  */
-int _MMG5_boulernm(MMG5_pMesh mesh, int start, int ip, int *ng, int *nr){
+int _MMG5_boulernm(MMG5_pMesh mesh,_MMG3D_List *lst,int start,int ip,
+                   int *ng,int *nr){
   MMG5_pTetra    pt,pt1;
   MMG5_pxTetra   pxt;
   _MMG5_Hash     hash;
-  _MMG5_hedge    *ph;
-  int            *adja,nump,ilist,base,cur,k,k1,ns;
-  int            hmax, list[MMG3D_LMAX+2];
-  int            key,ia,ib,jj,a,b;
+  _MMG3D_Vset    vset;
+  int            *adja,*list,nump,ilist,cur,k,k1,ns;
+  int            nhash;
   char           j,l,i;
   unsigned char  ie;
 
   /* allocate hash table to store the special edges passing through ip */
-  hmax = 3.71*mesh->np;
-  hash.siz  = mesh->np;
-  hash.max  = hmax + 1;
-  hash.nxt  = hash.siz;
-  _MMG5_ADD_MEM(mesh,(hash.max+1)*sizeof(_MMG5_hedge),"hash table",return(0));
-  _MMG5_SAFE_CALLOC(hash.item,hash.max+1,_MMG5_hedge);
-
-  for (k=hash.siz; k<hash.max; k++)
-    hash.item[k].nxt = k+1;
+  if ( !_MMG5_hashNew(mesh,&hash,32) )  return(0);
 
-
-  base = ++mesh->base;
+  _MMG3D_initVset(&vset);
   pt   = &mesh->tetra[start];
   nump = pt->v[ip];
 
   /* Store initial tetrahedron */
-  pt->flag = base;
+  _MMG3D_addVset(&vset,start);
+  list    = lst->item;
   list[0] = 4*start + ip;
   ilist = 1;
 
@@ -327,41 +676,14 @@ int _MMG5_boulernm(MMG5_pMesh mesh, int start, int ip, int *ng, int *nr){
         if ( MG_EDG(pxt->tag[ie]) ) {
           /* Seek if we have already seen the edge. If not, hash it and
            * increment ng or nr.*/
-          a = pt->v[_MMG5_iare[ie][0]];
-          b = pt->v[_MMG5_iare[ie][1]];
-          ia  = MG_MIN(a,b);
-          ib  = MG_MAX(a,b);
-          key = (_MMG5_KA*ia + _MMG5_KB*ib) % hash.siz;
-          ph  = &hash.item[key];
-
-          if ( ph->a == ia && ph->b == ib )
-            continue;
-          else if ( ph->a ) {
-            while ( ph->nxt && ph->nxt < hash.max ) {
-              ph = &hash.item[ph->nxt];
-              if ( ph->a == ia && ph->b == ib )  continue;
-            }
-            ph->nxt   = hash.nxt;
-            ph        = &hash.item[hash.nxt];
-
-            if ( hash.nxt >= hash.max-1 ) {
-              if ( mesh->info.ddebug )
-                fprintf(stdout,"  ## Memory alloc problem (edge): %d\n",
-                        hash.max);
-              _MMG5_TAB_RECALLOC(mesh,hash.item,hash.max,0.2,_MMG5_hedge,
-                                 "_MMG5_edge",return(0));
-              /* ph pointer may be false after realloc */
-              ph        = &hash.item[hash.nxt];
-
-              for (jj=ph->nxt; jj<hash.max; jj++)  hash.item[jj].nxt = jj+1;
-            }
-            hash.nxt = ph->nxt;
+          nhash = hash.nxt;
+          if ( !_MMG5_hashEdge(mesh,&hash,pt->v[_MMG5_iare[ie][0]],
+                               pt->v[_MMG5_iare[ie][1]],1) ) {
+            _MMG3D_freeVset(&vset);
+            _MMG5_DEL_MEM(mesh,hash.item,(hash.max+1)*sizeof(_MMG5_hedge));
+            return(0);
           }
-
-          /* insert new edge */
-          ph->a = ia;
-          ph->b = ib;
-          ph->nxt = 0;
+          if ( hash.nxt == nhash )  continue;
 
           if ( pxt->tag[ie] & MG_GEO )
             ++(*ng);
@@ -379,19 +701,26 @@ int _MMG5_boulernm(MMG5_pMesh mesh, int start, int ip, int *ng, int *nr){
       i  = _MMG5_inxt3[i];
       k1 = adja[i] / 4;
       if ( !k1 )  continue;
+      if ( !_MMG3D_addVset(&vset,k1) )  continue;
       pt1 = &mesh->tetra[k1];
-      if ( pt1->flag == base )  continue;
-      pt1->flag = base;
       for (j=0; j<4; j++)
         if ( pt1->v[j] == nump )  break;
       assert(j<4);
-      /* overflow */
-      if ( ilist > MMG3D_LMAX-3 )  return(0);
+      /* enlarge the list */
+      if ( ilist >= lst->max ) {
+        if ( !_MMG3D_growList(mesh,lst,ilist+1) ) {
+          _MMG3D_freeVset(&vset);
+          _MMG5_DEL_MEM(mesh,hash.item,(hash.max+1)*sizeof(_MMG5_hedge));
+          return(0);
+        }
+        list = lst->item;
+      }
       list[ilist] = 4*k1+j;
       ilist++;
     }
     cur++;
   }
+  _MMG3D_freeVset(&vset);
 
   /* Free the edge hash table */
   _MMG5_DEL_MEM(mesh,hash.item,(hash.max+1)*sizeof(_MMG5_hedge));
@@ -404,7 +733,8 @@ int _MMG5_boulernm(MMG5_pMesh mesh, int start, int ip, int *ng, int *nr){
  * \param start index of the starting tetra.
  * \param ip index in \a start of the looked point.
  * \param iface index in \a start of the starting face.
- * \param listv pointer toward the computed volumic ball.
+ * \param lstv pointer toward the list of the computed volumic ball, enlarged
+ * if needed (may be NULL).
  * \param ilistv pointer toward the computed volumic ball size.
  * \param lists pointer toward the computed surfacic ball.
  * \param ilists pointer toward the computed surfacic ball size.
@@ -414,27 +744,37 @@ int _MMG5_boulernm(MMG5_pMesh mesh, int start, int ip, int *ng, int *nr){
  * Compute the volumic ball of a SURFACE point \a p, as well as its surfacic
  * ball, starting from tetra \a start, with point \a ip, and face \a if in tetra
  * volumic ball.
- * \a listv[k] = 4*number of tet + index of point surfacic ball.
+ * \a lstv->item[k] = 4*number of tet + index of point surfacic ball.
  * \a lists[k] = 4*number of tet + index of face.
  *
+ * If \a lstv is NULL, only the surfacic ball is computed. The visited tetra
+ * are stored in a local \ref _MMG3D_Vset so the mesh is not modified and the
+ * function may be called concurrently.
+ *
  * \warning Don't work for a non-manifold point if \a start has an adjacent
  * through \a iface (for example : a non-manifold subdomain). Thus, if \a ip is
  * non-manifold, must be called only if \a start has no adjacent through iface.
  *
  */
 int _MMG5_boulesurfvolp(MMG5_pMesh mesh,int start,int ip,int iface,
-                        int *listv,int *ilistv,int *lists,int*ilists, int isnm)
+                        _MMG3D_List *lstv,int *ilistv,int *lists,int*ilists,
+                        int isnm)
 {
   MMG5_pTetra  pt,pt1;
   MMG5_pxTetra pxt;
-  int  base,nump,k,k1,*adja,piv,na,nb,adj,cur,nvstart,fstart,aux;
+  _MMG3D_Vset  vset;
+  int  nump,k,k1,*adja,*listv,piv,na,nb,adj,cur,nvstart,fstart,aux;
   char iopp,ipiv,i,j,l,ipa,ipb,isface;
 
   if ( isnm ) assert(!mesh->adja[4*(start-1)+iface+1]);
 
-  base = ++mesh->base;
   *ilists = 0;
-  *ilistv = 0;
+  listv   = NULL;
+  if ( lstv ) {
+    *ilistv = 0;
+    listv   = lstv->item;
+    _MMG3D_initVset(&vset);
+  }
 
   pt = &mesh->tetra[start];
   nump = pt->v[ip];
@@ -457,6 +797,7 @@ int _MMG5_boulesurfvolp(MMG5_pMesh mesh,int start,int ip,int iface,
               _MMG3D_indPt(mesh,nump));
       fprintf(stdout,"  ##          Try to modify the hausdorff number,");
       fprintf(stdout," or/and the maximum mesh.\n");
+      if ( listv )  _MMG3D_freeVset(&vset);
       return(-1);
     }
 
@@ -471,13 +812,19 @@ int _MMG5_boulesurfvolp(MMG5_pMesh mesh,int start,int ip,int iface,
       k = adj;
       pt = &mesh->tetra[k];
       adja = &mesh->adja[4*(k-1)+1];
-      if ( pt->flag != base ) {
+      if ( listv && _MMG3D_addVset(&vset,k) ) {
         for (i=0; i<4; i++)
           if ( pt->v[i] == nump )  break;
         assert(i<4);
+        if ( *ilistv >= lstv->max ) {
+          if ( !_MMG3D_growList(mesh,lstv,*ilistv+1) ) {
+            _MMG3D_freeVset(&vset);
+            return(-1);
+          }
+          listv = lstv->item;
+        }
         listv[(*ilistv)] = 4*k+i;
         (*ilistv)++;
-        pt->flag = base;
       }
 
       /* identification of edge number in tetra k */
@@ -517,6 +864,8 @@ int _MMG5_boulesurfvolp(MMG5_pMesh mesh,int start,int ip,int iface,
   }
   while ( 4*k+iopp != fstart );
 
+  if ( !listv )  return(1);
+
   /* Now, surfacic ball is complete ; finish travel of volumic ball */
   cur = 0;  // Check numerotation
   while ( cur < (*ilistv) ) {
@@ -528,28 +877,27 @@ int _MMG5_boulesurfvolp(MMG5_pMesh mesh,int start,int ip,int iface,
       i  = _MMG5_inxt3[i];
       k1 = adja[i]/4;
       if ( !k1 )  continue;
+      if ( !_MMG3D_addVset(&vset,k1) )  continue;
       pt1 = &mesh->tetra[k1];
-      if ( pt1->flag == base )  continue;
-      pt1->flag = base;
 
       for (j=0; j<4; j++)
         if ( pt1->v[j] == nump )  break;
       assert(j<4);
 
-      /* overflow */
-      if ( *ilistv > MMG3D_LMAX-3 ) {
-        fprintf(stdout,"  ## Warning: problem in remesh process.");
-        fprintf(stdout," Volumic ball of point %d contains too many elts.\n",
-                _MMG3D_indPt(mesh,nump));
-        fprintf(stdout,"  ##          Try to modify the hausdorff number,");
-        fprintf(stdout," or/and the maximum mesh.\n");
-        return(-1);
+      /* enlarge the list */
+      if ( *ilistv >= lstv->max ) {
+        if ( !_MMG3D_growList(mesh,lstv,*ilistv+1) ) {
+          _MMG3D_freeVset(&vset);
+          return(-1);
+        }
+        listv = lstv->item;
       }
       listv[(*ilistv)] = 4*k1+j;
       (*ilistv)++;
     }
     cur++;
   }
+  _MMG3D_freeVset(&vset);
 
   return(1);
 }
@@ -583,7 +931,7 @@ int _MMG5_bouletrid(MMG5_pMesh mesh,int start,int iface,int ip,int *il1,int *l1,
   MMG5_pPoint          ppt;
   int                  k,*adja,*ilist1,*ilist2,*list1,*list2,aux;
   int                  lists[MMG3D_LMAX+2], ilists;
-  int                  idp,na, nb, base, iopp, ipiv, piv, fstart, nvstart, adj;
+  int                  idp,na, nb, iopp, ipiv, piv, fstart, nvstart, adj;
   int                  i,ifac,idx,idx2,idx_tmp,i1,ipa,ipb, isface;
   double               *n1,*n2,nt[3],ps1,ps2;
 
@@ -610,8 +958,6 @@ int _MMG5_bouletrid(MMG5_pMesh mesh,int start,int iface,int ip,int *il1,int *l1,
   iopp = iface;
   fstart = 4*k+iopp;
 
-  base = ++mesh->base;
-
   /* Set pointers on lists il1 and il2 to have il1 associated to the normal of
      the face iface.*/
   _MMG5_norpts(mesh, pt->v[_MMG5_idir[iface][0]],pt->v[_MMG5_idir[iface][1]],
@@ -663,7 +1009,6 @@ int _MMG5_bouletrid(MMG5_pMesh mesh,int start,int iface,int ip,int *il1,int *l1,
       k = adj;
       pt = &mesh->tetra[k];
       adja = &mesh->adja[4*(k-1)+1];
-      pt->flag = base;
 
       /* identification of edge number in tetra k */
       for (i=0; i<6; i++) {
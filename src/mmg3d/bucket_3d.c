@@ -24,6 +24,13 @@
 /**
  * \file mmg3d/bucket_3d.c
  * \brief Functions for bucket computations in Delaunay mode.
+ *
+ * The bucket is an octree stored in an open-addressing hash table: level
+ * \a l splits the unit cube in \f$ 2^l \f$ cells per dimension and a point
+ * is stored in the finest level whose cells are larger than its filtering
+ * radius. Only the non-empty cells are stored so the memory does not depend
+ * on the resolution and the filtering stays accurate for sizes ranging over
+ * 6 orders of magnitude.
  * \author Cécile Dobrzynski (Bx INP/Inria/UBordeaux)
  * \author Pascal Frey (UPMC)
  * \version 5
@@ -39,337 +46,474 @@
 #define PRECI 1
 #define LFILT    0.2//0.7
 
-/* create bucket structure and store initial vertices */
-_MMG5_pBucket _MMG5_newBucket(MMG5_pMesh mesh,int nmax) {
-  MMG5_pPoint        ppt;
-  _MMG5_pBucket       bucket;
-  double        dd;
-  int           k,ic,ii,jj,kk;
+/** Number of bits of a cell index along one direction */
+#define _MMG5_BUCKBIT  19
+
+/**
+ * \param l level of the cell.
+ * \param i first index of the cell.
+ * \param j second index of the cell.
+ * \param k third index of the cell.
+ * \return the (non null) key of the cell.
+ */
+static inline
+unsigned long long _MMG5_bucketKey(int l,int i,int j,int k) {
+  return( ((unsigned long long)(l+1) << (3*_MMG5_BUCKBIT))
+          | ((unsigned long long)i << (2*_MMG5_BUCKBIT))
+          | ((unsigned long long)j << _MMG5_BUCKBIT)
+          | (unsigned long long)k );
+}
+
+/**
+ * \param bucket pointer toward the bucket structure.
+ * \param key key of the cell.
+ * \return the slot of the cell \a key in the cell table, or of the empty
+ * slot where it should be inserted.
+ */
+static inline
+int _MMG5_bucketSlot(_MMG5_pBucket bucket,unsigned long long key) {
+  int  h,msk;
+
+  msk = bucket->hsiz-1;
+  h   = (int)((key*0x9E3779B97F4A7C15ULL) >> 32) & msk;
+  while ( bucket->cell[h].key && bucket->cell[h].key != key )
+    h = (h+1) & msk;
+
+  return(h);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param bucket pointer toward the bucket structure.
+ * \return 1 if success, 0 if fail.
+ *
+ * Double the size of the cell table.
+ *
+ */
+static int _MMG5_bucketGrow(MMG5_pMesh mesh,_MMG5_pBucket bucket) {
+  _MMG5_Bcell   *old;
+  int           k,h,osiz;
+
+  old  = bucket->cell;
+  osiz = bucket->hsiz;
+
+  _MMG5_ADD_MEM(mesh,2*osiz*sizeof(_MMG5_Bcell),"bucket cells",return(0));
+  bucket->hsiz = 2*osiz;
+  _MMG5_SAFE_CALLOC(bucket->cell,bucket->hsiz,_MMG5_Bcell);
+
+  for (k=0; k<osiz; k++) {
+    if ( !old[k].key )  continue;
+    h = _MMG5_bucketSlot(bucket,old[k].key);
+    bucket->cell[h] = old[k];
+  }
+  _MMG5_DEL_MEM(mesh,old,osiz*sizeof(_MMG5_Bcell));
+
+  return(1);
+}
+
+/**
+ * \param bucket pointer toward the bucket structure.
+ * \param l level.
+ * \param x coordinate.
+ * \return the index along one direction of the cell of level \a l
+ * containing \a x.
+ */
+static inline
+int _MMG5_bucketIdx(_MMG5_pBucket bucket,int l,double x) {
+  double  n;
+
+  n = (double)(1 << l);
+  x = n * x / (double)PRECI;
+  if ( x < 0. )  return(0);
+  if ( x >= n )  return((int)n-1);
+  return((int)x);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the metric structure.
+ * \param ip index of the point.
+ * \return the radius of the euclidean ball containing the filtering region
+ * of the point \a ip.
+ */
+static inline
+double _MMG5_bucketRad(MMG5_pMesh mesh,MMG5_pSol sol,int ip) {
+  double  *ma,det,m1,m2,m3;
+
+  if ( sol->size == 1 )  return(LFILT * sol->m[ip]);
+
+  /* bounding box of the unit ball of the metric */
+  ma  = &sol->m[6*ip];
+  det = ma[0] * (ma[3]*ma[5] - ma[4]*ma[4])     \
+    - ma[1] * (ma[1]*ma[5] - ma[2]*ma[4])       \
+    + ma[2] * (ma[1]*ma[4] - ma[3]*ma[2]);
+  m1 = ma[3]*ma[5] - ma[4]*ma[4];
+  m2 = ma[0]*ma[5] - ma[2]*ma[2];
+  m3 = ma[0]*ma[3] - ma[1]*ma[1];
+  if ( det <= 0.0 || m1 < 0.0 || m2 < 0.0 || m3 < 0.0 )  return(0.);
+
+  return(LFILT * sqrt(MG_MAX(m1,MG_MAX(m2,m3)) / det));
+}
+
+/**
+ * \param bucket pointer toward the bucket structure.
+ * \param r filtering radius of a point.
+ * \return the level in which a point of radius \a r is stored.
+ *
+ * Finest level whose cells are larger than \a r.
+ *
+ */
+static inline
+int _MMG5_bucketLev(_MMG5_pBucket bucket,double r) {
+  int  e;
+
+  if ( r <= 0. )  return(bucket->lmax);
+  frexp(r / (double)PRECI,&e);
+
+  return(MG_MAX(0,MG_MIN(-e,bucket->lmax)));
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the metric structure.
+ * \param nmax initial number of cells per dimension (sizes the cell table).
+ * \return the bucket structure or NULL if fail.
+ *
+ * Create the bucket structure and store the initial interior vertices.
+ *
+ */
+_MMG5_pBucket _MMG5_newBucket(MMG5_pMesh mesh,MMG5_pSol sol,int nmax) {
+  MMG5_pPoint   ppt;
+  _MMG5_pBucket bucket;
+  int           k,np;
 
   /* memory alloc */
   _MMG5_ADD_MEM(mesh,sizeof(_MMG5_Bucket),"bucket",return(NULL));
-  _MMG5_SAFE_MALLOC(bucket,1,_MMG5_Bucket);
-  bucket->size = nmax;
-  _MMG5_ADD_MEM(mesh,(nmax*nmax*nmax+1)*sizeof(int),"bucket->head",return(NULL));
-  _MMG5_SAFE_CALLOC(bucket->head,nmax*nmax*nmax+1,int);
-  _MMG5_ADD_MEM(mesh,(mesh->npmax+1)*sizeof(int),"bucket->link",return(NULL));
+  _MMG5_SAFE_CALLOC(bucket,1,_MMG5_Bucket);
+  bucket->size = MG_MAX(1,MG_MIN(nmax,1024));
+  bucket->lmax = _MMG5_BUCKLEV-1;
+
+  np = 0;
+  for (k=1; k<=mesh->np; k++) {
+    ppt = &mesh->point[k];
+    if ( MG_VOK(ppt) && !(ppt->tag & MG_BDY) )  np++;
+  }
+  bucket->hsiz = 1024;
+  while ( bucket->hsiz < 4*np || bucket->hsiz < bucket->size*bucket->size )
+    bucket->hsiz *= 2;
+
+  _MMG5_ADD_MEM(mesh,bucket->hsiz*sizeof(_MMG5_Bcell),"bucket cells",
+                _MMG5_DEL_MEM(mesh,bucket,sizeof(_MMG5_Bucket));
+                return(NULL));
+  _MMG5_SAFE_CALLOC(bucket->cell,bucket->hsiz,_MMG5_Bcell);
+  _MMG5_ADD_MEM(mesh,(mesh->npmax+1)*sizeof(int),"bucket->link",
+                _MMG5_DEL_MEM(mesh,bucket->cell,bucket->hsiz*sizeof(_MMG5_Bcell));
+                _MMG5_DEL_MEM(mesh,bucket,sizeof(_MMG5_Bucket));
+                return(NULL));
   _MMG5_SAFE_CALLOC(bucket->link,mesh->npmax+1,int);
+  _MMG5_ADD_MEM(mesh,(mesh->npmax+1)*sizeof(char),"bucket->lev",
+                _MMG5_DEL_MEM(mesh,bucket->link,(mesh->npmax+1)*sizeof(int));
+                _MMG5_DEL_MEM(mesh,bucket->cell,bucket->hsiz*sizeof(_MMG5_Bcell));
+                _MMG5_DEL_MEM(mesh,bucket,sizeof(_MMG5_Bucket));
+                return(NULL));
+  _MMG5_SAFE_CALLOC(bucket->lev,mesh->npmax+1,char);
 
   /* insert vertices */
-  dd = nmax / (double)PRECI;
   for (k=1; k<=mesh->np; k++) {
     ppt = &mesh->point[k];
     if ( !MG_VOK(ppt) )  continue;
     if (ppt->tag & MG_BDY) continue;
-    ii = MG_MAX(0,(int)(dd * ppt->c[0])-1);
-    jj = MG_MAX(0,(int)(dd * ppt->c[1])-1);
-    kk = MG_MAX(0,(int)(dd * ppt->c[2])-1);
-    ic = (kk*nmax + jj)*nmax + ii;
-
-    if ( !bucket->head[ic] )
-      bucket->head[ic] = k;
-    else {
-      bucket->link[k]  = bucket->head[ic];
-      bucket->head[ic] = k;
+    if ( !_MMG5_addBucket(mesh,sol,bucket,k) ) {
+      _MMG5_freeBucket(mesh,bucket);
+      return(NULL);
     }
   }
 
   return(bucket);
 }
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param bucket pointer toward the bucket structure.
+ *
+ * Free the bucket structure.
+ *
+ */
+void _MMG5_freeBucket(MMG5_pMesh mesh,_MMG5_pBucket bucket) {
+  _MMG5_DEL_MEM(mesh,bucket->cell,bucket->hsiz*sizeof(_MMG5_Bcell));
+  _MMG5_DEL_MEM(mesh,bucket->link,(mesh->npmax+1)*sizeof(int));
+  _MMG5_DEL_MEM(mesh,bucket->lev,(mesh->npmax+1)*sizeof(char));
+  _MMG5_DEL_MEM(mesh,bucket,sizeof(_MMG5_Bucket));
+}
 
-/* check and eventually insert vertex */
-int _MMG5_buckin_ani(MMG5_pMesh mesh,MMG5_pSol sol,_MMG5_pBucket bucket,int ip) {
-  MMG5_pPoint        ppt,pp1;
-  double        dd,d2,det,ux,uy,uz,dmi,m1,m2,m3,dx,dy,dz;
-  double        *ma,*mb;
-  int           i,j,k,ii,jj,kk,ic,icc,siz,ip1;
-  int           iadr,imin,imax,jmin,jmax,kmin,kmax;
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the metric structure.
+ * \param ip index of the tested point.
+ * \param ip1 index of a point of the bucket.
+ * \return 1 if \a ip is too close from \a ip1, 0 otherwise.
+ */
+static int _MMG5_filt_iso(MMG5_pMesh mesh,MMG5_pSol sol,int ip,int ip1) {
+  MMG5_pPoint   ppt,pp1;
+  double        d2,ux,uy,uz,hp1,hp2;
 
   ppt = &mesh->point[ip];
-  siz = bucket->size;
-  dd  = siz / (double)PRECI;
-
-  iadr = ip*sol->size;
-  ma   = &sol->m[iadr];
-  dmi  = LFILT*LFILT;
-
-  ii = MG_MAX(0,(int)(dd * ppt->c[0])-1);
-  jj = MG_MAX(0,(int)(dd * ppt->c[1])-1);
-  kk = MG_MAX(0,(int)(dd * ppt->c[2])-1);
-  ic = (kk*siz + jj)*siz + ii;
-
-  /* check current cell */
-  if ( bucket->head[ic] ) {
-    ip1 = bucket->head[ic];
-    pp1 = &mesh->point[ip1];
-    ux = pp1->c[0] - ppt->c[0];
-    uy = pp1->c[1] - ppt->c[1];
-    uz = pp1->c[2] - ppt->c[2];
-    d2 =      ma[0]*ux*ux + ma[3]*uy*uy + ma[5]*uz*uz \
-      + 2.0*(ma[1]*ux*uy + ma[2]*ux*uz + ma[4]*uy*uz);
-    if ( d2 < dmi ) {
-      iadr = ip1*sol->size;
-      mb = &sol->m[iadr];
-      d2 =      mb[0]*ux*ux + mb[3]*uy*uy + mb[5]*uz*uz \
-        + 2.0*(mb[1]*ux*uy + mb[2]*ux*uz + mb[4]*uy*uz);
-      if ( d2 < dmi )  return(0);
-    }
+  pp1 = &mesh->point[ip1];
+  hp1 = LFILT * sol->m[ip];
+  hp2 = LFILT * sol->m[ip1];
+  ux = pp1->c[0] - ppt->c[0];
+  uy = pp1->c[1] - ppt->c[1];
+  uz = pp1->c[2] - ppt->c[2];
+  d2 = ux*ux + uy*uy + uz*uz;
+
+  return( d2 < hp1*hp1 || d2 < hp2*hp2 );
+}
 
-    while ( bucket->link[ip1] ) {
-      ip1 = bucket->link[ip1];
-      pp1 = &mesh->point[ip1];
-      ux = pp1->c[0] - ppt->c[0];
-      uy = pp1->c[1] - ppt->c[1];
-      uz = pp1->c[2] - ppt->c[2];
-      d2 =      ma[0]*ux*ux + ma[3]*uy*uy + ma[5]*uz*uz \
-        + 2.0*(ma[1]*ux*uy + ma[2]*ux*uz + ma[4]*uy*uz);
-      if ( d2 < dmi ) {
-        iadr = ip1*sol->size;
-        mb = &sol->m[iadr];
-        d2 =      mb[0]*ux*ux + mb[3]*uy*uy + mb[5]*uz*uz \
-          + 2.0*(mb[1]*ux*uy + mb[2]*ux*uz + mb[4]*uy*uz);
-        if ( d2 < dmi )  return(0);
-      }
-    }
-  }
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the metric structure.
+ * \param ip index of the tested point.
+ * \param ip1 index of a point of the bucket.
+ * \return 1 if \a ip is too close from \a ip1 in both metrics, 0 otherwise.
+ */
+static int _MMG5_filt_ani(MMG5_pMesh mesh,MMG5_pSol sol,int ip,int ip1) {
+  MMG5_pPoint   ppt,pp1;
+  double        d2,ux,uy,uz,dmi,*ma,*mb;
 
-  /* bounding box */
-  det = ma[0] * (ma[3]*ma[5] - ma[4]*ma[4]) \
-    - ma[1] * (ma[1]*ma[5] - ma[2]*ma[4]) \
-    + ma[2] * (ma[1]*ma[4] - ma[3]*ma[2]);
-  det = 1.0 / det;
-  m1 = ma[3]*ma[5] - ma[4]*ma[4];
-  m2 = ma[0]*ma[5] - ma[2]*ma[2];
-  m3 = ma[0]*ma[3] - ma[1]*ma[1];
-  if ( det < 0.0 || m1 < 0.0 )
-    return(1);
-  else {
-    dx = LFILT * sqrt(m1 * det) ;
-    dy = LFILT * sqrt(m2 * det) ;
-    dz = LFILT * sqrt(m3 * det) ;
+  ppt = &mesh->point[ip];
+  pp1 = &mesh->point[ip1];
+  dmi = LFILT*LFILT;
+  ma  = &sol->m[6*ip];
+  mb  = &sol->m[6*ip1];
+  ux = pp1->c[0] - ppt->c[0];
+  uy = pp1->c[1] - ppt->c[1];
+  uz = pp1->c[2] - ppt->c[2];
+  d2 =      ma[0]*ux*ux + ma[3]*uy*uy + ma[5]*uz*uz \
+    + 2.0*(ma[1]*ux*uy + ma[2]*ux*uz + ma[4]*uy*uz);
+  if ( d2 >= dmi )  return(0);
+  d2 =      mb[0]*ux*ux + mb[3]*uy*uy + mb[5]*uz*uz \
+    + 2.0*(mb[1]*ux*uy + mb[2]*ux*uz + mb[4]*uy*uz);
+
+  return( d2 < dmi );
+}
+
+/**
+ * \param bucket pointer toward the bucket structure.
+ * \param c coordinates of the query point.
+ * \param l level of the cell.
+ * \param ijk indices of the cell.
+ * \return the squared distance between \a c and the cell (the cells of the
+ * border of the unit cube are unbounded outward).
+ */
+static inline
+double _MMG5_bucketDist(_MMG5_pBucket bucket,double c[3],int l,int ijk[3]) {
+  double  h,lo,d,d2;
+  int     i,n;
+
+  n  = 1 << l;
+  h  = (double)PRECI / (double)n;
+  d2 = 0.;
+  for (i=0; i<3; i++) {
+    lo = ijk[i]*h;
+    if ( ijk[i] > 0 && c[i] < lo )            d = lo - c[i];
+    else if ( ijk[i] < n-1 && c[i] > lo+h )   d = c[i] - lo - h;
+    else  continue;
+    d2 += d*d;
   }
+  return(d2);
+}
 
-  imin = (int)(dd * (ppt->c[0]-dx))-1;
-  jmin = (int)(dd * (ppt->c[1]-dy))-1;
-  kmin = (int)(dd * (ppt->c[2]-dz))-1;
-  imax = (int)(dd * (ppt->c[0]+dx))-1;
-  jmax = (int)(dd * (ppt->c[1]+dy))-1;
-  kmax = (int)(dd * (ppt->c[2]+dz))-1;
-
-  imin = MG_MAX(0,MG_MIN(imin,siz-1));
-  imax = MG_MIN(siz-1,MG_MAX(0,imax));
-  jmin = MG_MAX(0,MG_MIN(jmin,siz-1));
-  jmax = MG_MIN(siz-1,MG_MAX(0,jmax));
-  kmin = MG_MAX(0,MG_MIN(kmin,siz-1));
-  kmax = MG_MIN(siz-1,MG_MAX(0,kmax));
-  if ( imin == imax && jmin == jmax && kmin == kmax )  return(1);
-
-  /* explore neighbours */
-  for (k=kmin; k<=kmax; k++)
-    for (j=jmin; j<=jmax; j++)
-      for (i=imin; i<=imax; i++) {
-        icc = (k*siz + j)*siz + i;
-        ip1 = bucket->head[icc];
-        if ( !ip1 )  continue;
-        pp1 = &mesh->point[ip1];
-        ux = pp1->c[0] - ppt->c[0];
-        uy = pp1->c[1] - ppt->c[1];
-        uz = pp1->c[2] - ppt->c[2];
-        d2 =      ma[0]*ux*ux + ma[3]*uy*uy + ma[5]*uz*uz \
-          + 2.0*(ma[1]*ux*uy + ma[2]*ux*uz + ma[4]*uy*uz);
-        if ( d2 < dmi ) {
-          iadr = ip1*sol->size;
-          mb = &sol->m[iadr];
-          d2 =      mb[0]*ux*ux + mb[3]*uy*uy + mb[5]*uz*uz \
-            + 2.0*(mb[1]*ux*uy + mb[2]*ux*uz + mb[4]*uy*uz);
-          if ( d2 < dmi )  return(0);
-        }
-
-        while ( bucket->link[ip1] ) {
-          ip1 = bucket->link[ip1];
-          pp1 = &mesh->point[ip1];
-          ux = pp1->c[0] - ppt->c[0];
-          uy = pp1->c[1] - ppt->c[1];
-          uz = pp1->c[2] - ppt->c[2];
-          d2 =      ma[0]*ux*ux + ma[3]*uy*uy + ma[5]*uz*uz \
-            + 2.0*(ma[1]*ux*uy + ma[2]*ux*uz + ma[4]*uy*uz);
-          if ( d2 < dmi ) {
-            iadr = ip1*sol->size;
-            mb = &sol->m[iadr];
-            d2 =      mb[0]*ux*ux + mb[3]*uy*uy + mb[5]*uz*uz \
-              + 2.0*(mb[1]*ux*uy + mb[2]*ux*uz + mb[4]*uy*uz);
-            if ( d2 < dmi )  return(0);
-          }
-        }
-      }
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the metric structure.
+ * \param bucket pointer toward the bucket structure.
+ * \param ip index of the tested point.
+ * \param r radius of the filtering ball of \a ip.
+ * \param sym 1 if the filtering balls of the stored points must be
+ * considered too.
+ * \param filt filtering test.
+ * \return 0 if a stored point filters \a ip, 1 otherwise.
+ *
+ * Descend the octree from the root, only visiting the non-empty cells that
+ * intersect the filtering ball of \a ip (enlarged by the largest radius of
+ * the stored points if \a sym), so the cost does not depend on the size
+ * ratio between \a ip and the stored points.
+ *
+ */
+static int
+_MMG5_bucketScan(MMG5_pMesh mesh,MMG5_pSol sol,_MMG5_pBucket bucket,int ip,
+                 double r,int sym,int (*filt)(MMG5_pMesh,MMG5_pSol,int,int)) {
+  MMG5_pPoint   ppt;
+  double        rsub[_MMG5_BUCKLEV+1],rl,d2;
+  int           stack[8*_MMG5_BUCKLEV+1][4],nst;
+  int           l,h,ip1,ijk[3],a;
+
+  ppt = &mesh->point[ip];
+
+  /* radius of the ball that may meet a filtering point below each level */
+  rsub[bucket->lmax+1] = r;
+  for (l=bucket->lmax; l>=0; l--)
+    rsub[l] = sym ? MG_MAX(rsub[l+1],bucket->rmax[l]) : r;
+
+  nst = 0;
+  stack[nst][0] = 0;
+  stack[nst][1] = stack[nst][2] = stack[nst][3] = 0;
+  nst++;
+
+  while ( nst ) {
+    nst--;
+    l      = stack[nst][0];
+    ijk[0] = stack[nst][1];
+    ijk[1] = stack[nst][2];
+    ijk[2] = stack[nst][3];
+
+    h = _MMG5_bucketSlot(bucket,_MMG5_bucketKey(l,ijk[0],ijk[1],ijk[2]));
+    if ( !bucket->cell[h].key || !bucket->cell[h].nsub )  continue;
+
+    d2 = _MMG5_bucketDist(bucket,ppt->c,l,ijk);
+    if ( d2 > rsub[l]*rsub[l] )  continue;
+
+    /* points stored in this cell */
+    rl = sym ? MG_MAX(r,bucket->rmax[l]) : r;
+    if ( d2 <= rl*rl ) {
+      for (ip1=bucket->cell[h].head; ip1; ip1=bucket->link[ip1])
+        if ( filt(mesh,sol,ip,ip1) )  return(0);
+    }
+
+    /* children */
+    if ( l == bucket->lmax )  continue;
+    for (a=0; a<8; a++) {
+      stack[nst][0] = l+1;
+      stack[nst][1] = 2*ijk[0] + (a & 1);
+      stack[nst][2] = 2*ijk[1] + ((a >> 1) & 1);
+      stack[nst][3] = 2*ijk[2] + ((a >> 2) & 1);
+      nst++;
+    }
+  }
 
   return(1);
 }
 
-
-int _MMG5_buckin_iso(MMG5_pMesh mesh,MMG5_pSol sol,_MMG5_pBucket bucket,int ip) {
-  MMG5_pPoint        ppt,pp1;
-  double        dd,d2,ux,uy,uz,hpi,hp1,hp2;
-  int           i,j,k,ii,jj,kk,ic,icc,siz,ip1;
-  int           imin,imax,jmin,jmax,kmin,kmax;
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param bucket pointer toward the bucket structure.
+ * \param ip index of the point.
+ * \param l level of the point.
+ * \param inc +1 when the point is added, -1 when it is removed, 0 to only
+ * look the cell up.
+ * \return the slot of the cell of level \a l containing \a ip, -1 if fail.
+ *
+ * Update the number of points of the cells containing \a ip from the root
+ * to the level \a l (the cells are created if needed when a point is added).
+ *
+ */
+static int
+_MMG5_bucketPath(MMG5_pMesh mesh,_MMG5_pBucket bucket,int ip,int l,int inc) {
+  MMG5_pPoint        ppt;
+  unsigned long long key;
+  int                ll,h;
 
   ppt = &mesh->point[ip];
-  siz = bucket->size;
-  dd  = siz / (double)PRECI;
-  hpi = LFILT * sol->m[ip];
-  hp1 = hpi*hpi;
-
-  ii = MG_MAX(0,(int)(dd * ppt->c[0])-1);
-  jj = MG_MAX(0,(int)(dd * ppt->c[1])-1);
-  kk = MG_MAX(0,(int)(dd * ppt->c[2])-1);
-  ic = (kk*siz + jj)*siz + ii;
-
-  /* check current cell */
-  if ( bucket->head[ic] ) {
-    ip1 = bucket->head[ic];
-    pp1 = &mesh->point[ip1];
-    hp2 = LFILT * sol->m[ip1];
-    ux = pp1->c[0] - ppt->c[0];
-    uy = pp1->c[1] - ppt->c[1];
-    uz = pp1->c[2] - ppt->c[2];
-    d2 = ux*ux + uy*uy + uz*uz;
-    if ( d2 < hp1 || d2 < hp2*hp2 )  {
-      //printf("filtre current %d : %e %e %e %e\n",ip1,d2,hp1,d2,hp2*hp2);
-      return(0);
-    }
-
-    while ( bucket->link[ip1] ) {
-      ip1 = bucket->link[ip1];
-      pp1 = &mesh->point[ip1];
-      hp2 = LFILT * sol->m[ip1];
-      ux = pp1->c[0] - ppt->c[0];
-      uy = pp1->c[1] - ppt->c[1];
-      uz = pp1->c[2] - ppt->c[2];
-      d2 = ux*ux + uy*uy + uz*uz;
-      if ( d2 < hp1 || d2 < hp2*hp2 )  {
-        //printf("filtre link %d : %e %e %e %e\n",ip1,d2,hp1,d2,hp2*hp2);
-        return(0);
+  h   = -1;
+  for (ll=0; ll<=l; ll++) {
+    key = _MMG5_bucketKey(ll,_MMG5_bucketIdx(bucket,ll,ppt->c[0]),
+                          _MMG5_bucketIdx(bucket,ll,ppt->c[1]),
+                          _MMG5_bucketIdx(bucket,ll,ppt->c[2]));
+    h = _MMG5_bucketSlot(bucket,key);
+    if ( !bucket->cell[h].key ) {
+      if ( inc <= 0 )  return(-1);
+      if ( 2*(bucket->ncell+1) > bucket->hsiz ) {
+        if ( !_MMG5_bucketGrow(mesh,bucket) )  return(-1);
+        h = _MMG5_bucketSlot(bucket,key);
       }
+      bucket->cell[h].key  = key;
+      bucket->cell[h].head = 0;
+      bucket->cell[h].nsub = 0;
+      bucket->ncell++;
     }
+    bucket->cell[h].nsub += inc;
   }
+  return(h);
+}
 
-  /* explore neighbors */
-  imin = (int)(dd * (ppt->c[0]-hpi))-1;
-  jmin = (int)(dd * (ppt->c[1]-hpi))-1;
-  kmin = (int)(dd * (ppt->c[2]-hpi))-1;
-  imax = (int)(dd * (ppt->c[0]+hpi))-1;
-  jmax = (int)(dd * (ppt->c[1]+hpi))-1;
-  kmax = (int)(dd * (ppt->c[2]+hpi))-1;
-
-  imin = MG_MAX(0,MG_MIN(imin,siz-1));
-  imax = MG_MIN(siz-1,MG_MAX(0,imax));
-  jmin = MG_MAX(0,MG_MIN(jmin,siz-1));
-  jmax = MG_MIN(siz-1,MG_MAX(0,jmax));
-  kmin = MG_MAX(0,MG_MIN(kmin,siz-1));
-  kmax = MG_MIN(siz-1,MG_MAX(0,kmax));
-  if ( imin == imax && jmin == jmax && kmin == kmax )  return(1);
-
-  for (k=kmin; k<=kmax; k++)
-    for (j=jmin; j<=jmax; j++)
-      for (i=imin; i<=imax; i++) {
-        icc = (k*siz + j)*siz + i;
-        ip1 = bucket->head[icc];
-        if ( !ip1 )  continue;
-        pp1 = &mesh->point[ip1];
-        hp2 = LFILT * sol->m[ip1];
-        ux = pp1->c[0] - ppt->c[0];
-        uy = pp1->c[1] - ppt->c[1];
-        uz = pp1->c[2] - ppt->c[2];
-        d2 = ux*ux + uy*uy + uz*uz;
-        if ( d2 < hp1 || d2 < hp2*hp2 ) {
-          /*     printf("other cell %d %e < %e -- %e < %e \n",ip1,d2,MMG_length(mesh,sol,ip,ip1),d2,hp2*hp2);
-                 printf("on filtre avec %d : %e %e %e\n",ip1,pp1->c[0],pp1->c[1],pp1->c[2]);
-          */ return(0);
-        }
-
-        while ( bucket->link[ip1] ) {
-          ip1 = bucket->link[ip1];
-          pp1 = &mesh->point[ip1];
-          hp2 = LFILT * sol->m[ip1];
-          ux = pp1->c[0] - ppt->c[0];
-          uy = pp1->c[1] - ppt->c[1];
-          uz = pp1->c[2] - ppt->c[2];
-          d2 = ux*ux + uy*uy + uz*uz;
-          if ( d2 < hp1 || d2 < hp2*hp2 )  {
-            //      printf("link cell %d %e < %e -- %e < %e \n",ip1,d2,hp1,d2,hp2*hp2);
-            return(0);
-          }
-        }
-      }
+/* check and eventually insert vertex */
+int _MMG5_buckin_ani(MMG5_pMesh mesh,MMG5_pSol sol,_MMG5_pBucket bucket,int ip) {
+  double   r;
 
-  return(1);
+  r = _MMG5_bucketRad(mesh,sol,ip);
+  if ( r <= 0. )  return(1);
+
+  /* a filtering point lies in the metric ball of ip */
+  return(_MMG5_bucketScan(mesh,sol,bucket,ip,r,0,_MMG5_filt_ani));
 }
 
 
-int _MMG5_addBucket(MMG5_pMesh mesh,_MMG5_pBucket bucket,int ip) {
-  MMG5_pPoint        ppt;
-  double        dd;
-  int           ic,ii,jj,kk,siz;
+int _MMG5_buckin_iso(MMG5_pMesh mesh,MMG5_pSol sol,_MMG5_pBucket bucket,int ip) {
+  double   r;
 
-  ppt = &mesh->point[ip];
-  siz = bucket->size;
-  dd  = siz / (double)PRECI;
+  r = _MMG5_bucketRad(mesh,sol,ip);
 
-  ii = MG_MAX(0,(int)(dd * ppt->c[0])-1);
-  jj = MG_MAX(0,(int)(dd * ppt->c[1])-1);
-  kk = MG_MAX(0,(int)(dd * ppt->c[2])-1);
-  ic = (kk*siz + jj)*siz + ii;
+  return(_MMG5_bucketScan(mesh,sol,bucket,ip,r,1,_MMG5_filt_iso));
+}
+
+
+int _MMG5_addBucket(MMG5_pMesh mesh,MMG5_pSol sol,_MMG5_pBucket bucket,int ip) {
+  double             r;
+  int                l,h;
+
+  if ( bucket->lev[ip] )  _MMG5_delBucket(mesh,bucket,ip);
+
+  r = _MMG5_bucketRad(mesh,sol,ip);
+  l = _MMG5_bucketLev(bucket,r);
+
+  h = _MMG5_bucketPath(mesh,bucket,ip,l,1);
+  if ( h < 0 )  return(0);
 
   /* store new point */
-  if ( !bucket->head[ic] ) {
-    bucket->head[ic] = ip;
-    bucket->link[ip] = 0;
-  }
-  else {
-    //  assert(!bucket->link[ip]);
-    bucket->link[ip] = bucket->head[ic];
-    bucket->head[ic] = ip;
-    assert(ip!=bucket->link[ip]);
-  }
+  bucket->link[ip]     = bucket->cell[h].head;
+  bucket->cell[h].head = ip;
+  bucket->lev[ip]      = l+1;
+  bucket->rmax[l]      = MG_MAX(bucket->rmax[l],r);
+  assert(ip!=bucket->link[ip]);
 
   return(1);
 }
 
 
 int _MMG5_delBucket(MMG5_pMesh mesh,_MMG5_pBucket bucket,int ip) {
-  MMG5_pPoint        ppt;
-  double        dd;
-  int           ic,ii,jj,kk,siz,ip1;
+  int                l,h,ip1;
 
-  ppt = &mesh->point[ip];
-  siz = bucket->size;
-  dd  = siz / (double)PRECI;
+  if ( !bucket->lev[ip] )  return(1);
 
-  ii = MG_MAX(0,(int)(dd * ppt->c[0])-1);
-  jj = MG_MAX(0,(int)(dd * ppt->c[1])-1);
-  kk = MG_MAX(0,(int)(dd * ppt->c[2])-1);
-  ic = (kk*siz + jj)*siz + ii;
+  /* look the cell up without modifying the tree */
+  l = bucket->lev[ip]-1;
+  h = _MMG5_bucketPath(mesh,bucket,ip,l,0);
 
   /* remove vertex from cell */
-  if ( bucket->head[ic] ) {
-    if ( bucket->head[ic] == ip ) {
-      bucket->head[ic] = bucket->link[ip];
-      bucket->link[ip] = 0;
+  ip1 = 0;
+  if ( h >= 0 ) {
+    if ( bucket->cell[h].head == ip ) {
+      bucket->cell[h].head = bucket->link[ip];
+      ip1 = ip;
     }
     else {
-      ip1 = bucket->head[ic];
-      while ( ip1 && bucket->link[ip1] != ip ) {
+      ip1 = bucket->cell[h].head;
+      while ( ip1 && bucket->link[ip1] != ip )
         ip1 = bucket->link[ip1];
-      }
-      if ( bucket->link[ip1] == ip ) {
-        bucket->link[ip1] = bucket->link[ip];
-        bucket->link[ip] = 0;
-      } else {
-        printf("point non trouve %d %c -- %d\n",ip,mesh->point[ip].tag,ic);
-      }
+      if ( ip1 )  bucket->link[ip1] = bucket->link[ip];
     }
   }
+  bucket->link[ip] = 0;
+  bucket->lev[ip]  = 0;
+
+  if ( !ip1 ) {
+    if ( mesh->info.ddebug )
+      fprintf(stdout,"  ## Warning: point %d not found in the bucket.\n",ip);
+    return(0);
+  }
+
+  /* the point is unlinked: update the counts of its cells */
+  _MMG5_bucketPath(mesh,bucket,ip,l,-1);
 
   return(1);
 }
@@ -524,9 +524,12 @@ int _MMG5_chkfemtopo(MMG5_pMesh mesh) {
   MMG5_pTetra      pt,pt1;
   MMG5_pxTetra     pxt;
   MMG5_pPoint      p0,p1;
-  int         k,nf,ntet,ned,np,ischk,ilist,list[MMG3D_LMAX+2],l,np1,npchk,iel;
+  _MMG3D_List      lst;
+  int         k,nf,ntet,ned,np,ischk,ilist,*list,l,np1,npchk,iel;
   char        i0,j,i,i1,ia;
 
+  if ( !_MMG3D_initList(mesh,&lst,MMG3D_LMAX+2) )  return(0);
+
   ntet = ned = 0;
   for(k=1; k<=mesh->np; k++)
     mesh->point[k].flag = 0;
@@ -561,7 +564,8 @@ int _MMG5_chkfemtopo(MMG5_pMesh mesh) {
       if ( ischk )  continue;
       p0->flag += 1;
 
-      ilist = _MMG5_boulevolp(mesh,k,i,list);
+      ilist = _MMG5_boulevolp(mesh,k,i,&lst);
+      list  = lst.item;
       for (l=0; l<ilist; l++) {
         iel = list[l] / 4;
         i0  = list[l] % 4;
@@ -588,6 +592,8 @@ int _MMG5_chkfemtopo(MMG5_pMesh mesh) {
   }
   if ( mesh->info.imprim && ned )
     printf("  *** %d internal edges connecting boundary points.\n",ned);
+
+  _MMG3D_freeList(mesh,&lst);
   return(1);
 }
 
@@ -40,11 +40,11 @@ extern char  ddb;
 /** Check whether collapse ip -> iq could be performed, ip internal ;
  *  'mechanical' tests (positive jacobian) are not performed here */
 int _MMG5_chkcol_int(MMG5_pMesh mesh,MMG5_pSol met,int k,char iface,
-                     char iedg,int *list,char typchk) {
+                     char iedg,_MMG3D_List *lst,char typchk) {
   MMG5_pTetra   pt,pt0;
   MMG5_pPoint   p0;
   double   calold,calnew,caltmp,lon,ll;
-  int      j,iel,ilist,nq,nr;
+  int      j,iel,ilist,nq,nr,*list;
   char     i,jj,ip,iq;
 
   ip  = _MMG5_idir[iface][_MMG5_inxt2[iedg]];
@@ -52,7 +52,8 @@ int _MMG5_chkcol_int(MMG5_pMesh mesh,MMG5_pSol met,int k,char iface,
   pt  = &mesh->tetra[k];
   pt0 = &mesh->tetra[0];
   nq  = pt->v[iq];
-  ilist = _MMG5_boulevolp(mesh,k,ip,list);
+  ilist = _MMG5_boulevolp(mesh,k,ip,lst);
+  list  = lst->item;
   lon = 1.e20;
   if ( typchk == 2 && met->m ) {
     lon = _MMG5_lenedg(mesh,met,_MMG5_iarf[iface][iedg],pt);
@@ -417,7 +418,8 @@ _MMG5_topchkcol_bdy(MMG5_pMesh mesh,int k,int iface,char iedg,int *lists,int ili
  * \param k index of element in which we collapse.
  * \param iface face through wich we perform the collapse
  * \param iedg edge to collapse
- * \param listv pointer toward the list of the tetra in the ball of \a p0.
+ * \param lstv pointer toward the (growable) list of the tetra in the ball of
+ * \a p0, filled by the function.
  * \param typchk  typchk type of checking permformed for edge length
  * (hmax or _MMG5_LLONG criterion).
  *
@@ -428,13 +430,14 @@ _MMG5_topchkcol_bdy(MMG5_pMesh mesh,int k,int iface,char iedg,int *lists,int ili
  *
  */
 int _MMG5_chkcol_bdy(MMG5_pMesh mesh,MMG5_pSol met,int k,char iface,
-                     char iedg,int *listv,char typchk) {
+                     char iedg,_MMG3D_List *lstv,char typchk) {
   MMG5_pTetra        pt,pt0;
   MMG5_pxTetra       pxt;
   MMG5_pPoint        p0;
   MMG5_Tria          tt;
   double        calold,calnew,caltmp,nprvold[3],nprvnew[3],ncurold[3],ncurnew[3],ps,devold,devnew;
   int           ipp,ilistv,nump,numq,ilists,lists[MMG3D_LMAX+2],l,iel,nbbdy,ndepmin,ndepplus;
+  int           *listv;
   int           nr;
   char          iopp,ia,ip,tag,i,iq,i0,i1,ier,isminp,isplp;
 
@@ -454,8 +457,9 @@ int _MMG5_chkcol_bdy(MMG5_pMesh mesh,MMG5_pSol met,int k,char iface,
 
   /* collect triangles and tetras around ip */
   if (_MMG5_boulesurfvolp(mesh,k,ip,iface,
-                          listv,&ilistv,lists,&ilists,(p0->tag & MG_NOM)) < 0 )
+                          lstv,&ilistv,lists,&ilists,(p0->tag & MG_NOM)) < 0 )
     return(-1);
+  listv = lstv->item;
 
   /* prevent collapse in case surface ball has 3 triangles */
   if ( ilists <= 2 )  return(0);  // ATTENTION, Normalement, avec 2 c est bon !
@@ -1086,6 +1090,7 @@ int _MMG5_colver(MMG5_pMesh mesh,MMG5_pSol met,int *list,int ilist,char indq,cha
     ip  = list[k] % 4;
     pt  = &mesh->tetra[iel];
     pt->v[ip] = nq;
+    _MMG3D_SETSTART(mesh,iel);
     if ( typchk==1 && met->m && met->size > 1 )
       pt->qual=_MMG5_caltet33_ani(mesh,met,pt);
     else
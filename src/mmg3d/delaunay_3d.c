@@ -41,16 +41,13 @@
 //pbs with _MMG5_EPSCON=5e-4 and VOLMIN=1e-15 (MMG3D does not insert enough vertex...)
 #define  _MMG5_EPSCON       1e-5//5.0e-4//1.e-4//1.0e-3
 #define  VOLMIN       1e-15//1.e-10//1.0e-15  --> vol negatif qd on rejoue
-#define LONMAX     4096
+/** size of the local storage of the new tetra of a cavity */
+#define _MMG5_DELLOC  1024
 
 // int MMG_cas; uncomment to debug
 
 // extern int MMG_npuiss,MMG_nvol,MMG_npres;
 
-#define KTA     7
-#define KTB    11
-#define KTC    13
-
 /* hash mesh edge v[0],v[1] (face i of iel) */
 int _MMG5_hashEdgeDelone(MMG5_pMesh mesh,_MMG5_Hash *hash,int iel,int i,int *v) {
   int             *adja,iadr,jel,j,key,mins,maxs;
@@ -65,11 +62,14 @@ int _MMG5_hashEdgeDelone(MMG5_pMesh mesh,_MMG5_Hash *hash,int iel,int i,int *v)
     mins = v[1];
     maxs = v[0];
   }
-  key = KTA*mins + KTB*maxs;
-  key = key % hash->siz;
+
+  if ( 2*(hash->nxt+1) > hash->siz && !_MMG5_hashGrow(mesh,hash) )
+    return(0);
+
+  key = _MMG5_hashSlot(mins,maxs,hash->max);
   ha  = &hash->item[key];
 
-  if ( ha->a ) {
+  while ( ha->a ) {
     /* identical face */
     if ( ha->a == mins && ha->b == maxs ) {
       iadr = (iel-1)*4 + 1;
@@ -83,43 +83,15 @@ int _MMG5_hashEdgeDelone(MMG5_pMesh mesh,_MMG5_Hash *hash,int iel,int i,int *v)
       adja[j] = iel*4 + i;
       return(1);
     }
-    else {
-      while ( ha->nxt && ha->nxt < hash->max ) {
-        ha = &hash->item[ha->nxt];
-        if ( ha->a == mins && ha->b == maxs ) {
-          iadr = (iel-1)*4 + 1;
-          adja = &mesh->adja[iadr];
-          adja[i] = ha->k;
-
-          jel  = ha->k >> 2;
-          j    = ha->k % 4;
-          iadr = (jel-1)*4 + 1;
-          adja = &mesh->adja[iadr];
-          adja[j] = iel*4 + i;
-          return(1);
-        }
-      }
-    }
-    ha->nxt   = hash->nxt;
-    ha        = &hash->item[hash->nxt];
-    ha->a     = mins;
-    ha->b     = maxs;
-    ha->k     = iel*4 + i;
-    hash->nxt = ha->nxt;
-    ha->nxt   = 0;
-
-    if ( hash->nxt >= hash->max ) {
-      _MMG5_TAB_RECALLOC(mesh,hash->item,hash->max,0.2,_MMG5_hedge,"face",return(0));
-      for (j=hash->nxt; j<hash->max; j++)  hash->item[j].nxt = j+1;
-    }
-    return(1);
+    key = (key+1) & hash->max;
+    ha  = &hash->item[key];
   }
 
   /* insert */
   ha->a = mins;
   ha->b = maxs;
   ha->k = iel*4 + i;
-  ha->nxt = 0;
+  ++hash->nxt;
 
   return(1);
 }
@@ -145,7 +117,7 @@ int _MMG5_delone(MMG5_pMesh mesh,MMG5_pSol sol,int ip,int *list,int ilist) {
   int              vois[4],iadrold;/*,ii,kk,_MMG5_iare1,_MMG5_iare2;*/
   short            i1;
   char             alert;
-  int              tref,isused=0,ixt,ielnum[3*LONMAX+1],ll;
+  int              tref,isused=0,ixt,ielloc[_MMG5_DELLOC],*ielnum,ll;
   _MMG5_Hash       hedg;
 
   //obsolete avec la realloc
@@ -195,13 +167,20 @@ int _MMG5_delone(MMG5_pMesh mesh,MMG5_pSol sol,int ip,int *list,int ilist) {
   }
   if ( alert )  {return(0);}
   /* hash table params */
-  if ( size > 3*LONMAX )  return(0);
-  if ( !_MMG5_hashNew(mesh,&hedg,size,3*size) ) { /*3*size suffit */
+  /* about 3/2 internal faces per new tetra */
+  if ( !_MMG5_hashNew(mesh,&hedg,2*size) ) {
     fprintf(stdout,"  ## Unable to complete mesh.\n");
     return(-1);
   }
 
   /*tetra allocation : we create "size" tetra*/
+  if ( size < _MMG5_DELLOC )  ielnum = ielloc;
+  else {
+    _MMG5_ADD_MEM(mesh,(size+1)*sizeof(int),"new tetra indices",
+                  _MMG5_DEL_MEM(mesh,hedg.item,(hedg.max+1)*sizeof(_MMG5_hedge));
+                  return(-1));
+    _MMG5_SAFE_MALLOC(ielnum,size+1,int);
+  }
   ielnum[0] = size;
   for (k=1 ; k<=size ; k++) {
     ielnum[k] = _MMG3D_newElt(mesh);
@@ -213,6 +192,9 @@ int _MMG5_delone(MMG5_pMesh mesh,MMG5_pSol sol,int ip,int *list,int ilist) {
                             mesh->tetra[ielnum[ll]].v[0] = 1;
                             _MMG3D_delElt(mesh,ielnum[ll]);
                           }
+                          if ( ielnum != ielloc )
+                            _MMG5_DEL_MEM(mesh,ielnum,(ielnum[0]+1)*sizeof(int));
+                          _MMG5_DEL_MEM(mesh,hedg.item,(hedg.max+1)*sizeof(_MMG5_hedge));
                           return(-1);
         );
     }
@@ -251,6 +233,7 @@ int _MMG5_delone(MMG5_pMesh mesh,MMG5_pSol sol,int ip,int *list,int ilist) {
         pt1 = &mesh->tetra[iel];
         memcpy(pt1,pt,sizeof(MMG5_Tetra));
         pt1->v[i] = ip;
+        _MMG3D_SETSTART(mesh,iel);
         pt1->qual = _MMG5_orcal(mesh,sol,iel);
         pt1->ref = mesh->tetra[old].ref;
 
@@ -343,6 +326,7 @@ int _MMG5_delone(MMG5_pMesh mesh,MMG5_pSol sol,int ip,int *list,int ilist) {
 
   //ppt = &mesh->point[ip];
   //  ppt->flag = mesh->flag;
+  if ( ielnum != ielloc )  _MMG5_DEL_MEM(mesh,ielnum,(ielnum[0]+1)*sizeof(int));
   _MMG5_DEL_MEM(mesh,hedg.item,(hedg.max+1)*sizeof(_MMG5_hedge));
   return(1);
 }
@@ -588,8 +572,8 @@ _MMG5_correction_iso(MMG5_pMesh mesh,int ip,int *list,int ilist,int nedep) {
  * \param met pointer toward the sol structure.
  * \param iel tetra index.
  * \param ip point local index in \a iel.
- * \param list pointer toward the list of tetra in the shell of edge where
- * ip will be inserted.
+ * \param cav pointer toward the list of tetra in the shell of edge where
+ * ip will be inserted, enlarged if needed to store the cavity.
  * \param lon number of tetra in the list.
  * \return ilist number of tetra inside the cavity or -ilist if one of the tet
  * of the cavity is required.
@@ -597,12 +581,12 @@ _MMG5_correction_iso(MMG5_pMesh mesh,int ip,int *list,int ilist,int nedep) {
  * Mark elements in cavity and update the list of tetra in the cavity.
  *
  */
-int _MMG5_cavity_ani(MMG5_pMesh mesh,MMG5_pSol met,int iel,int ip,int* list,int lon) {
+int _MMG5_cavity_ani(MMG5_pMesh mesh,MMG5_pSol met,int iel,int ip,_MMG3D_List *cav,int lon) {
   MMG5_pPoint    ppt;
   MMG5_pTetra    pt,pt1,ptc;
   double    c[3],eps,dd,ray,ux,uy,uz,crit;
   double    *mj,*mp,ct[12];
-  int       *adja,*adjb,k,adj,adi,voy,i,j,ia,ilist,ipil,jel,iadr,base;
+  int       *adja,*adjb,*list,k,adj,adi,voy,i,j,ia,ilist,ipil,jel,iadr,base;
   int       vois[4],l,isreq,tref;
 
   if ( lon < 1 )  return(0);
@@ -611,6 +595,7 @@ int _MMG5_cavity_ani(MMG5_pMesh mesh,MMG5_pSol met,int iel,int ip,int* list,int
   base  = ++mesh->mark;
 
   isreq = 0;
+  list  = cav->item;
 
   tref = mesh->tetra[list[0]/6].ref;
   for (k=0; k<lon; k++) {
@@ -632,6 +617,11 @@ int _MMG5_cavity_ani(MMG5_pMesh mesh,MMG5_pSol met,int iel,int ip,int* list,int
   mp    = &met->m[iadr];
 
   do {
+    /* room for the 4 neighbours of jel */
+    if ( ilist+4 > cav->max ) {
+      if ( !_MMG3D_growList(mesh,cav,ilist+4) )  return(0);
+      list = cav->item;
+    }
     jel  = list[ipil];
     iadr = (jel-1)*4 + 1;
     adja = &mesh->adja[iadr];
@@ -703,7 +693,6 @@ int _MMG5_cavity_ani(MMG5_pMesh mesh,MMG5_pSol met,int iel,int ip,int* list,int
         list[ilist++] = adj;
       }
     }
-    if ( ilist > LONMAX - 3 )  return(-1);
     ++ipil;
   }
   while ( ipil < ilist );
@@ -729,8 +718,8 @@ int _MMG5_cavity_ani(MMG5_pMesh mesh,MMG5_pSol met,int iel,int ip,int* list,int
  * \param sol pointer toward the sol structure.
  * \param iel tetra index.
  * \param ip point local index in \a iel.
- * \param list pointer toward the list of tetra in the shell of edge where
- * ip will be inserted.
+ * \param cav pointer toward the list of tetra in the shell of edge where
+ * ip will be inserted, enlarged if needed to store the cavity.
  * \param lon number of tetra in the list.
  * \return ilist number of tetra inside the cavity or -ilist if one of the tet
  * of the cavity is required.
@@ -738,11 +727,11 @@ int _MMG5_cavity_ani(MMG5_pMesh mesh,MMG5_pSol met,int iel,int ip,int* list,int
  * Mark elements in cavity and update the list of tetra in the cavity.
  *
  */
-int _MMG5_cavity_iso(MMG5_pMesh mesh,MMG5_pSol sol,int iel,int ip,int *list,int lon) {
+int _MMG5_cavity_iso(MMG5_pMesh mesh,MMG5_pSol sol,int iel,int ip,_MMG3D_List *cav,int lon) {
   MMG5_pPoint ppt;
   MMG5_pTetra      pt,pt1,ptc;
   double           c[3],crit,dd,eps,ray,ct[12];
-  int             *adja,*adjb,k,adj,adi,voy,i,j,ilist,ipil,jel,iadr,base;
+  int             *adja,*adjb,*list,k,adj,adi,voy,i,j,ilist,ipil,jel,iadr,base;
   int              vois[4],l;
   int              tref,isreq;
 
@@ -752,6 +741,7 @@ int _MMG5_cavity_iso(MMG5_pMesh mesh,MMG5_pSol sol,int iel,int ip,int *list,int
   base  = ++mesh->mark;
 
   isreq = 0;
+  list  = cav->item;
 
   tref = mesh->tetra[list[0]/6].ref;
   for (k=0; k<lon; k++) {
@@ -771,6 +761,11 @@ int _MMG5_cavity_iso(MMG5_pMesh mesh,MMG5_pSol sol,int iel,int ip,int *list,int
   ipil  = 0;
 
   do {
+    /* room for the 4 neighbours of jel */
+    if ( ilist+4 > cav->max ) {
+      if ( !_MMG3D_growList(mesh,cav,ilist+4) )  return(0);
+      list = cav->item;
+    }
     jel  = list[ipil];
     iadr = (jel-1)*4 + 1;
     adja = &mesh->adja[iadr];
@@ -822,8 +817,6 @@ int _MMG5_cavity_iso(MMG5_pMesh mesh,MMG5_pSol sol,int iel,int ip,int *list,int
         list[ilist++] = adj;
       }
     }
-    if ( ilist > LONMAX - 3 ) return(-1);
-
     ++ipil;
   }
   while ( ipil < ilist );
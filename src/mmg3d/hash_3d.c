@@ -70,41 +70,39 @@ _MMG5_paktet(MMG5_pMesh mesh) {
   }
 }
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param hash pointer toward the face hash table.
+ * \param ia first vertex of the face.
+ * \param ib second vertex of the face.
+ * \param ic third vertex of the face.
+ * \param k index of element to store.
+ * \return the stored index if the face is already hashed, 1 if it is
+ * inserted, 0 if fail.
+ *
+ * Store the face \f$(ia,ib,ic)\f$: the face is keyed by its extremal vertices
+ * and identified by the sum of its vertices.
+ *
+ */
 static int _MMG5_hashFace(MMG5_pMesh mesh,_MMG5_Hash *hash,int ia,int ib,int ic,int k) {
   _MMG5_hedge     *ph;
-  int        key,mins,maxs,sum,j;
+  int        key,mins,maxs,sum;
 
   mins = MG_MIN(ia,MG_MIN(ib,ic));
   maxs = MG_MAX(ia,MG_MAX(ib,ic));
+  sum  = ia + ib + ic;
+
+  if ( 2*(hash->nxt+1) > hash->siz && !_MMG5_hashGrow(mesh,hash) )
+    return(0);
 
   /* compute key */
-  sum = ia + ib + ic;
-  key = (_MMG5_KA*mins + _MMG5_KB*maxs) % hash->siz;
+  key = _MMG5_hashSlot(mins,maxs,hash->max);
   ph  = &hash->item[key];
-
-  if ( ph->a ) {
+  while ( ph->a ) {
     if ( ph->a == mins && ph->b == maxs && ph->s == sum )
       return(ph->k);
-    else {
-      while ( ph->nxt && ph->nxt < hash->max ) {
-        ph = &hash->item[ph->nxt];
-        if ( ph->a == mins && ph->b == maxs && ph->s == sum )  return(ph->k);
-      }
-    }
-    ph->nxt = hash->nxt;
-    ph      = &hash->item[hash->nxt];
-    ph->a   = mins;
-    ph->b   = maxs;
-    ph->s   = sum;
-    ph->k   = k;
-    hash->nxt = ph->nxt;
-    ph->nxt = 0;
-
-    if ( hash->nxt >= hash->max ) {
-      _MMG5_TAB_RECALLOC(mesh,hash->item,hash->max,0.2,_MMG5_hedge,"face",return(0));
-      for (j=hash->nxt; j<hash->max; j++)  hash->item[j].nxt = j+1;
-    }
-    return(1);
+    key = (key+1) & hash->max;
+    ph  = &hash->item[key];
   }
 
   /* insert new face */
@@ -112,7 +110,7 @@ static int _MMG5_hashFace(MMG5_pMesh mesh,_MMG5_Hash *hash,int ia,int ib,int ic,
   ph->b = maxs;
   ph->s = sum;
   ph->k = k;
-  ph->nxt = 0;
+  ++hash->nxt;
 
   return(1);
 }
@@ -128,18 +126,13 @@ static int _MMG5_hashGetFace(_MMG5_Hash *hash,int ia,int ib,int ic) {
 
   /* compute key */
   sum = ia + ib + ic;
-  key = (_MMG5_KA*mins + _MMG5_KB*maxs) % hash->siz;
+  key = _MMG5_hashSlot(mins,maxs,hash->max);
   ph  = &hash->item[key];
 
-  if ( ph->a ) {
-    if ( ph->a == mins && ph->b == maxs && ph->s == sum )
-      return(ph->k);
-    else {
-      while ( ph->nxt ) {
-        ph = &hash->item[ph->nxt];
-        if ( ph->a == mins && ph->b == maxs && ph->s == sum )  return(ph->k);
-      }
-    }
+  while ( ph->a ) {
+    if ( ph->a == mins && ph->b == maxs && ph->s == sum )  return(ph->k);
+    key = (key+1) & hash->max;
+    ph  = &hash->item[key];
   }
 
   return(0);
@@ -259,6 +252,8 @@ int MMG3D_hashTetra(MMG5_pMesh mesh, int pack) {
     }
   }
   _MMG5_SAFE_FREE(hcode);
+
+  _MMG3D_setPointStart(mesh);
   return(1);
 }
 
@@ -305,22 +300,23 @@ int _MMG5_setEdgeNmTag(MMG5_pMesh mesh, _MMG5_Hash *hash) {
         /* compute key */
         ia  = MG_MIN(pt->v[i1],pt->v[i2]);
         ib  = MG_MAX(pt->v[i1],pt->v[i2]);
-        key = (_MMG5_KA*ia + _MMG5_KB*ib) % hash->siz;
+        key = _MMG5_hashSlot(ia,ib,hash->max);
         ph  = &hash->item[key];
 
         assert(ph->a);
         while ( ph->a ) {
           if ( ph->a == ia && ph->b == ib ) break;
-          assert(ph->nxt);
-          ph = &hash->item[ph->nxt];
+          key = (key+1) & hash->max;
+          ph  = &hash->item[key];
         }
+        assert(ph->a);
         /* Set edge tag and point tags to MG_REQ if the non-manifold edge shared
          * separated domains */
         if ( ph->s > 3 ) {
           if ( !ok ) {
 
             /* If not already done, hash all the boundary tetra faces. */
-            if ( ! _MMG5_hashNew(mesh,&hashF,0.51*mesh->nt,1.51*mesh->nt) )
+            if ( ! _MMG5_hashNew(mesh,&hashF,mesh->nt) )
               return(0);
 
             for ( kel=1; kel<=mesh->ne; ++kel ) {
@@ -483,6 +479,7 @@ int _MMG5_setEdgeNmTag(MMG5_pMesh mesh, _MMG5_Hash *hash) {
 
 /**
  * \param mesh pointer towar the mesh structure.
+ * \return 1 if success, 0 if failed.
  *
  * Seek the non-required non-manifold points and try to analyse whether they are
  * corner or required.
@@ -492,12 +489,15 @@ int _MMG5_setEdgeNmTag(MMG5_pMesh mesh, _MMG5_Hash *hash) {
  * _MMG5_singul function.
  */
 static inline
-void _MMG5_setVertexNmTag(MMG5_pMesh mesh) {
+int _MMG5_setVertexNmTag(MMG5_pMesh mesh) {
   MMG5_pTetra         ptet;
   MMG5_pPoint         ppt;
+  _MMG3D_List         lst;
   int                 k,i;
   int                 nc, nre, ng, nrp;
 
+  if ( !_MMG3D_initList(mesh,&lst,MMG3D_LMAX+2) )  return(0);
+
   /* Second: seek the non-required non-manifold points and try to analyse
    * whether they are corner or required. */
   nc = nre = 0;
@@ -513,7 +513,7 @@ void _MMG5_setVertexNmTag(MMG5_pMesh mesh) {
 
       if ( (!(ppt->tag & MG_NOM)) || (ppt->tag & MG_REQ) ) continue;
 
-      if ( !_MMG5_boulernm(mesh, k, i, &ng, &nrp) ) continue;
+      if ( !_MMG5_boulernm(mesh, &lst, k, i, &ng, &nrp) ) continue;
       if ( (ng+nrp) > 2 ) {
         ppt->tag |= MG_CRN + MG_REQ;
         nre++;
@@ -539,6 +539,8 @@ void _MMG5_setVertexNmTag(MMG5_pMesh mesh) {
   if ( mesh->info.ddebug || abs(mesh->info.imprim) > 3 )
     fprintf(stdout,"     %d corner and %d required vertices added\n",nc,nre);
 
+  _MMG3D_freeList(mesh,&lst);
+  return(1);
 }
 
 /**
@@ -560,7 +562,7 @@ int _MMG5_setNmTag(MMG5_pMesh mesh, _MMG5_Hash *hash) {
 
   /* Second: seek the non-required non-manifold points and try to analyse
    * whether they are corner or required. */
-  _MMG5_setVertexNmTag(mesh);
+  if ( !_MMG5_setVertexNmTag(mesh) ) return(0);
 
   return(1);
 }
@@ -584,90 +586,48 @@ int _MMG3D_hashTria(MMG5_pMesh mesh, _MMG5_Hash *hash) {
 
 
 
-/** remove edge from hash table */
-int _MMG5_hashPop(_MMG5_Hash *hash,int a,int b) {
-  _MMG5_hedge  *ph,*php;
-  int          key,ia,ib,iph,iphp;
-
-  ia  = MG_MIN(a,b);
-  ib  = MG_MAX(a,b);
-  key = (_MMG5_KA*ia + _MMG5_KB*ib) % hash->siz;
-  ph  = &hash->item[key];
+/**
+ * \param hash pointer toward the hash table of geometric edges.
+ * \param ia smallest extremity of the edge.
+ * \param ib largest extremity of the edge.
+ * \return the slot of edge \f$[ia;ib]\f$ or of the empty slot ending its probe
+ * sequence.
+ *
+ */
+static inline
+int _MMG5_hSeek(MMG5_HGeom *hash,int ia,int ib) {
+  MMG5_hgeom  *ph;
+  int         key;
 
-  if ( !ph->a ) return(0);
-  else if ( ph->a == ia && ph->b == ib ) {
-    if ( !ph->nxt ) {
-      memset(ph,0,sizeof(_MMG5_hedge));
-      return(1);
-    }
-    else {
-      iph = ph->nxt;
-      php = ph;
-      ph  = &hash->item[ph->nxt];
-      memcpy(php,ph,sizeof(_MMG5_hedge));
-      memset(ph,0,sizeof(_MMG5_hedge));
-      ph->nxt   = hash->nxt;
-      hash->nxt = iph;
-      return(1);
-    }
-  }
-  while ( ph->nxt ) {
-    php = ph;
-    ph  = &hash->item[ph->nxt];
-    if ( ph->a == ia && ph->b == ib ) {
-      if ( !ph->nxt ) {
-        memset(ph,0,sizeof(_MMG5_hedge));
-        ph->nxt   = hash->nxt;
-        hash->nxt = php->nxt;
-        php->nxt  = 0;
-      }
-      else {
-        iph  = ph->nxt;
-        iphp = php->nxt;
-        php->nxt = iph;
-        memset(ph,0,sizeof(_MMG5_hedge));
-        ph->nxt   = hash->nxt;
-        hash->nxt = iphp;
-      }
-      return(1);
-    }
+  key = _MMG5_hashSlot(ia,ib,hash->max);
+  ph  = &hash->geom[key];
+  while ( ph->a && (ph->a != ia || ph->b != ib) ) {
+    key = (key+1) & hash->max;
+    ph  = &hash->geom[key];
   }
-  return(0);
+  return(key);
 }
 
-
 /** set tag to edge on geometry */
 int _MMG5_hTag(MMG5_HGeom *hash,int a,int b,int ref,char tag) {
   MMG5_hgeom  *ph;
-  int     key,ia,ib;
+  int     ia,ib;
 
+  if ( !hash->siz )  return(0);
   ia  = MG_MIN(a,b);
   ib  = MG_MAX(a,b);
-  key = (_MMG5_KA*ia + _MMG5_KB*ib) % hash->siz;
-  ph  = &hash->geom[key];
+  ph  = &hash->geom[_MMG5_hSeek(hash,ia,ib)];
 
-  if ( !ph->a )
-    return(0);
-  else if ( ph->a == ia && ph->b == ib ) {
-    ph->tag |= tag;
-    ph->ref  = ref;
-    return(1);
-  }
-  while ( ph->nxt ) {
-    ph = &hash->geom[ph->nxt];
-    if ( ph->a == ia && ph->b == ib ) {
-      ph->tag |= tag;
-      ph->ref  = ref;
-      return(1);
-    }
-  }
-  return(0);
+  if ( !ph->a )  return(0);
+  ph->tag |= tag;
+  ph->ref  = ref;
+  return(1);
 }
 
 /** remove edge from hash table */
 int _MMG5_hPop(MMG5_HGeom *hash,int a,int b,int *ref,char *tag) {
-  MMG5_hgeom  *ph,*php;
-  int     key,ia,ib,iph,iphp;
+  MMG5_hgeom  *ph;
+  int     key,ia,ib,i,h;
 
   *ref = 0;
   *tag = 0;
@@ -675,141 +635,119 @@ int _MMG5_hPop(MMG5_HGeom *hash,int a,int b,int *ref,char *tag) {
 
   ia  = MG_MIN(a,b);
   ib  = MG_MAX(a,b);
-  key = (_MMG5_KA*ia + _MMG5_KB*ib) % hash->siz;
+  key = _MMG5_hSeek(hash,ia,ib);
   ph  = &hash->geom[key];
 
   if ( !ph->a )  return(0);
-  else if ( ph->a == ia && ph->b == ib ) {
-    *ref = ph->ref;
-    *tag = ph->tag;
-    if ( !ph->nxt ) {
-      memset(ph,0,sizeof(MMG5_hgeom));
-    }
-    else {
-      iph = ph->nxt;
-      php = ph;
-      ph  = &hash->geom[ph->nxt];
-      memcpy(php,ph,sizeof(MMG5_hgeom));
-      memset(ph,0,sizeof(MMG5_hgeom));
-      ph->nxt   = hash->nxt;
-      hash->nxt = iph;
-    }
-    return(1);
-  }
-  while ( ph->nxt ) {
-    php = ph;
-    ph  = &hash->geom[ph->nxt];
-    if ( ph->a == ia && ph->b == ib ) {
-      *ref = ph->ref;
-      *tag = ph->tag;
-      if ( !ph->nxt ) {
-        memset(ph,0,sizeof(MMG5_hgeom));
-        ph->nxt   = hash->nxt;
-        hash->nxt = php->nxt;
-        php->nxt  = 0;
-      }
-      else {
-        iph  = ph->nxt;
-        iphp = php->nxt;
-        php->nxt = iph;
-        memset(ph,0,sizeof(MMG5_hgeom));
-        ph->nxt   = hash->nxt;
-        hash->nxt = iphp;
-      }
-      return(1);
+  *ref = ph->ref;
+  *tag = ph->tag;
+
+  /* backward shift deletion (see _MMG5_hashPop) */
+  i = key;
+  while ( 1 ) {
+    key = (key+1) & hash->max;
+    ph  = &hash->geom[key];
+    if ( !ph->a )  break;
+    h = _MMG5_hashSlot(ph->a,ph->b,hash->max);
+    if ( ((key-h) & hash->max) >= ((key-i) & hash->max) ) {
+      hash->geom[i] = *ph;
+      i = key;
     }
   }
-  return(0);
+  memset(&hash->geom[i],0,sizeof(MMG5_hgeom));
+  --hash->nxt;
+
+  return(1);
 }
 
 /** get ref and tag to edge on geometry */
 int _MMG5_hGet(MMG5_HGeom *hash,int a,int b,int *ref,char *tag) {
   MMG5_hgeom  *ph;
-  int     key,ia,ib;
+  int     ia,ib;
 
   *tag = 0;
   *ref = 0;
   if ( !hash->siz )  return(0);
   ia  = MG_MIN(a,b);
   ib  = MG_MAX(a,b);
-  key = (_MMG5_KA*ia + _MMG5_KB*ib) % hash->siz;
-  ph  = &hash->geom[key];
+  ph  = &hash->geom[_MMG5_hSeek(hash,ia,ib)];
 
   if ( !ph->a )  return(0);
-  else if ( ph->a == ia && ph->b == ib ) {
-    *ref = ph->ref;
-    *tag = ph->tag;
-    return(1);
-  }
-  while ( ph->nxt ) {
-    ph = &hash->geom[ph->nxt];
-    if ( ph->a == ia && ph->b == ib ) {
-      *ref = ph->ref;
-      *tag = ph->tag;
-      return(1);
-    }
-  }
-  return(0);
+  *ref = ph->ref;
+  *tag = ph->tag;
+  return(1);
 }
 
 /** store edge on geometry */
 void _MMG5_hEdge(MMG5_pMesh mesh,int a,int b,int ref,char tag) {
-  MMG5_hgeom  *ph;
-  int     key,ia,ib,j;
+  MMG5_HGeom  *hash;
+  MMG5_hgeom  *ph,*geom;
+  int          k,key,ia,ib,siz;
 
-  if ( !mesh->htab.siz )  return;
+  hash = &mesh->htab;
+  if ( !hash->siz )  return;
   ia  = MG_MIN(a,b);
   ib  = MG_MAX(a,b);
-  key = (_MMG5_KA*ia + _MMG5_KB*ib) % mesh->htab.siz;
-  ph  = &mesh->htab.geom[key];
-
-  if ( ph->a == ia && ph->b == ib )
-    return;
-  else if ( ph->a ) {
-    while ( ph->nxt ) {
-      ph = &mesh->htab.geom[ph->nxt];
-      if ( ph->a == ia && ph->b == ib )  return;
-    }
-    ph->nxt = mesh->htab.nxt;
-    ph      = &mesh->htab.geom[mesh->htab.nxt];
-    ph->a   = ia;   ph->b   = ib;
-    ph->ref = ref;  ph->tag = tag;
-    mesh->htab.nxt = ph->nxt;
-    ph->nxt = 0;
-    if ( mesh->htab.nxt >= mesh->htab.max ) {
-      if ( mesh->info.ddebug )
-        fprintf(stdout,"  ## Memory alloc problem (edge): %d\n",mesh->htab.max);
-      _MMG5_TAB_RECALLOC(mesh,mesh->htab.geom,mesh->htab.max,0.2,MMG5_hgeom,
-                         "larger htab table",
-                         printf("  Exit program.\n");
-                         exit(EXIT_FAILURE));
-      for (j=mesh->htab.nxt; j<mesh->htab.max; j++)  mesh->htab.geom[j].nxt = j+1;
+
+  /* double the table when it becomes half full */
+  if ( 2*(hash->nxt+1) > hash->siz ) {
+    siz = 2*hash->siz;
+    _MMG5_ADD_MEM(mesh,siz*sizeof(MMG5_hgeom),"larger htab table",
+                  printf("  Exit program.\n");
+                  exit(EXIT_FAILURE));
+    _MMG5_SAFE_CALLOC(geom,siz,MMG5_hgeom);
+    for (k=0; k<hash->siz; k++) {
+      if ( !hash->geom[k].a )  continue;
+      key = _MMG5_hashSlot(hash->geom[k].a,hash->geom[k].b,siz-1);
+      while ( geom[key].a )  key = (key+1) & (siz-1);
+      geom[key] = hash->geom[k];
     }
-    return;
+    _MMG5_DEL_MEM(mesh,hash->geom,hash->siz*sizeof(MMG5_hgeom));
+    hash->geom = geom;
+    hash->siz  = siz;
+    hash->max  = siz-1;
   }
+
+  ph = &hash->geom[_MMG5_hSeek(hash,ia,ib)];
+  if ( ph->a )  return;
+
   /* insert new edge */
   ph->a   = ia;   ph->b   = ib;
   ph->ref = ref;  ph->tag = tag;
-  ph->nxt = 0;
+  ++hash->nxt;
   return;
 }
 
-/** to store edge on geometry */
-int _MMG5_hNew(MMG5_HGeom *hash,int hsiz,int hmax,int secure) {
-  int   k;
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param hash pointer toward the hash table of geometric edges.
+ * \param hsiz expected number of edges (the table grows if needed).
+ * \param secure if 1, exit if the allocation fails.
+ * \return 1 if success, 0 if fail.
+ *
+ * Allocate the open addressing table to store edges on geometry.
+ *
+ */
+int _MMG5_hNew(MMG5_pMesh mesh,MMG5_HGeom *hash,int hsiz,int secure) {
 
   /* adjust hash table params */
-  hash->geom = (MMG5_hgeom*)calloc(hmax+2,sizeof(MMG5_hgeom));
+  hash->siz  = _MMG5_hashSiz(hsiz);
+  hash->max  = hash->siz - 1;
+  hash->nxt  = 0;
+
+  _MMG5_ADD_MEM(mesh,hash->siz*sizeof(MMG5_hgeom),"htab",
+                hash->siz = 0;
+                if ( !secure )  return(0);
+                else  exit(EXIT_FAILURE));
+
+  hash->geom = (MMG5_hgeom*)calloc(hash->siz,sizeof(MMG5_hgeom));
   if ( !hash->geom ) {
     perror("  ## Memory problem: calloc");
+    mesh->memCur -= (long long)(hash->siz*sizeof(MMG5_hgeom));
+    hash->siz = 0;
     if ( !secure )  return(0);
     else  exit(EXIT_FAILURE);
   }
-  hash->siz  = hsiz;
-  hash->max  = hmax + 1;
-  hash->nxt  = hsiz;
-  for (k=hsiz; k<hash->max; k++)
-    hash->geom[k].nxt = k+1;
   return 1;
 }
 
@@ -831,8 +769,7 @@ int _MMG5_hGeom(MMG5_pMesh mesh) {
   if ( mesh->na ) {
     if ( !mesh->htab.geom ) {
       mesh->namax = MG_MAX(1.5*mesh->na,_MMG5_NAMAX);
-      _MMG5_ADD_MEM(mesh,(3*mesh->namax+2)*sizeof(MMG5_hgeom),"htab",return(0));
-      _MMG5_hNew(&mesh->htab,mesh->na,3*mesh->namax,1);
+      if ( !_MMG5_hNew(mesh,&mesh->htab,mesh->na,0) )  return(0);
     }
     else {
       if ( abs(mesh->info.imprim) > 3 || mesh->info.ddebug ) {
@@ -901,8 +838,7 @@ int _MMG5_hGeom(MMG5_pMesh mesh) {
       _MMG5_DEL_MEM(mesh,mesh->htab.geom,(mesh->htab.max+1)*sizeof(MMG5_hgeom));
 
     mesh->namax = MG_MAX(1.5*mesh->na,_MMG5_NAMAX);
-    _MMG5_ADD_MEM(mesh,(3*mesh->namax+2)*sizeof(MMG5_hgeom),"htab",return(0));
-    _MMG5_hNew(&mesh->htab,mesh->na,3*mesh->namax,1);
+    if ( !_MMG5_hNew(mesh,&mesh->htab,mesh->na,0) )  return(0);
     mesh->na = 0;
 
     /* build hash for edges */
@@ -1080,7 +1016,7 @@ int _MMG5_bdrySet(MMG5_pMesh mesh) {
     return(1);
   }
 
-  if ( ! _MMG5_hashNew(mesh,&hash,0.51*mesh->nt,1.51*mesh->nt) ) return(0);
+  if ( ! _MMG5_hashNew(mesh,&hash,mesh->nt) ) return(0);
   for (k=1; k<=mesh->nt; k++) {
     ptt = &mesh->tria[k];
     _MMG5_hashFace(mesh,&hash,ptt->v[0],ptt->v[1],ptt->v[2],k);
@@ -1177,7 +1113,7 @@ int _MMG5_bdryUpdate(MMG5_pMesh mesh) {
   char     i,tag;
 
   if ( !mesh->nt )  return(1);
-  if ( !_MMG5_hashNew(mesh,&hash,0.51*mesh->nt,1.51*mesh->nt) )  return(0);
+  if ( !_MMG5_hashNew(mesh,&hash,mesh->nt) )  return(0);
   for (k=1; k<=mesh->nt; k++) {
     ptt = &mesh->tria[k];
     _MMG5_hashFace(mesh,&hash,ptt->v[0],ptt->v[1],ptt->v[2],k);
@@ -1248,7 +1184,7 @@ int _MMG5_bdryPerm(MMG5_pMesh mesh) {
   assert(mesh->nt);
 
   /* store triangles temporarily */
-  if ( !_MMG5_hashNew(mesh,&hash,MG_MAX(0.51*mesh->nt,100),MG_MAX(1.51*mesh->nt,300)) )
+  if ( !_MMG5_hashNew(mesh,&hash,mesh->nt) )
     return(0);
   for (k=1; k<=mesh->nt; k++) {
     ptt = &mesh->tria[k];
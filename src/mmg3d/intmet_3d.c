@@ -35,6 +35,129 @@
 
 #include "mmg3d.h"
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param ip1 first extremity of the edge.
+ * \param ip2 second extremity of the edge.
+ * \param ip global index of the new point.
+ * \param s interpolation parameter (between 0 and 1).
+ *
+ * Linear interpolation of the user fields at parameter \a s along the edge
+ * \f$ ip_1-ip_2 \f$.
+ *
+ */
+void _MMG3D_intfield(MMG5_pMesh mesh,int ip1,int ip2,int ip,double s) {
+  MMG5_pSol     psl;
+  double        *m1,*m2,*mm;
+  int           l,j;
+
+  for (l=0; l<mesh->nfield; l++) {
+    psl = mesh->field[l];
+    m1  = &psl->m[psl->size*ip1];
+    m2  = &psl->m[psl->size*ip2];
+    mm  = &psl->m[psl->size*ip];
+    for (j=0; j<psl->size; j++)
+      mm[j] = (1.-s)*m1[j] + s*m2[j];
+  }
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param k index of the tetra.
+ * \param ip global index of the new point.
+ * \param cb barycentric coordinates of \a ip in \a k.
+ *
+ * Linear interpolation of the user fields in a tetra given the barycentric
+ * coordinates of the new point in \a k.
+ *
+ */
+void _MMG3D_intfield4bar(MMG5_pMesh mesh,int k,int ip,double *cb) {
+  MMG5_pTetra   pt;
+  MMG5_pSol     psl;
+  double        *mm;
+  int           l,i,j;
+
+  pt = &mesh->tetra[k];
+  for (l=0; l<mesh->nfield; l++) {
+    psl = mesh->field[l];
+    mm  = &psl->m[psl->size*ip];
+    for (j=0; j<psl->size; j++) {
+      mm[j] = 0.;
+      for (i=0; i<4; i++)
+        mm[j] += cb[i]*psl->m[psl->size*pt->v[i]+j];
+    }
+  }
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param list volumic ball of the point to move.
+ * \param ilist size of the ball.
+ * \param o new position of the point.
+ *
+ * Linear interpolation of the user fields at the new position \a o of the
+ * center of the ball \a list, in the ball before the point is moved. The
+ * tetra of the ball that contains \a o (or the closest one for a boundary
+ * point that leaves its ball) is used.
+ *
+ */
+void _MMG3D_movfield(MMG5_pMesh mesh,int *list,int ilist,double *o) {
+  MMG5_pTetra   pt;
+  MMG5_pSol     psl;
+  double        *c[4],*cc,cb[4],cbmin[4],vol,lmin,best,dd,val;
+  int           l,kmin,k,i,j,ip;
+
+  if ( !mesh->nfield )  return;
+
+  ip   = mesh->tetra[list[0]/4].v[list[0]%4];
+  kmin = 0;
+  best = -DBL_MAX;
+  for (l=0; l<ilist; l++) {
+    k  = list[l]/4;
+    pt = &mesh->tetra[k];
+    for (i=0; i<4; i++)  c[i] = mesh->point[pt->v[i]].c;
+
+    vol = _MMG5_det4pt(c[0],c[1],c[2],c[3]);
+    if ( fabs(vol) < _MMG5_EPSD2 )  continue;
+
+    lmin = DBL_MAX;
+    for (i=0; i<4; i++) {
+      cc    = c[i];
+      c[i]  = o;
+      cb[i] = _MMG5_det4pt(c[0],c[1],c[2],c[3]) / vol;
+      c[i]  = cc;
+      lmin  = MG_MIN(lmin,cb[i]);
+    }
+    if ( lmin > best ) {
+      best = lmin;
+      kmin = k;
+      memcpy(cbmin,cb,4*sizeof(double));
+      if ( lmin >= 0. )  break;
+    }
+  }
+  if ( !kmin )  return;
+
+  /* clamp the coordinates in the tetra */
+  dd = 0.;
+  for (i=0; i<4; i++) {
+    cbmin[i] = MG_MAX(0.,cbmin[i]);
+    dd      += cbmin[i];
+  }
+  if ( dd < _MMG5_EPSD )  return;
+  for (i=0; i<4; i++)  cbmin[i] /= dd;
+
+  pt = &mesh->tetra[kmin];
+  for (l=0; l<mesh->nfield; l++) {
+    psl = mesh->field[l];
+    for (j=0; j<psl->size; j++) {
+      val = 0.;
+      for (i=0; i<4; i++)
+        val += cbmin[i]*psl->m[psl->size*pt->v[i]+j];
+      psl->m[psl->size*ip+j] = val;
+    }
+  }
+}
+
 /**
  * \param mesh pointer toward the mesh structure.
  * \param met pointer toward the metric structure.
@@ -46,6 +169,7 @@
  *
  * Interpolation of anisotropic sizemap at parameter \a s along edge \a i of elt
  * \a k for a special storage of ridges metric (after defsiz call).
+ * The user fields are linearly interpolated at the new point.
  *
  */
 int _MMG5_intmet_ani(MMG5_pMesh mesh,MMG5_pSol met,int k,char i,int ip,
@@ -61,6 +185,7 @@ int _MMG5_intmet_ani(MMG5_pMesh mesh,MMG5_pSol met,int k,char i,int ip,
   m  = &met->m[6*ip];
   ip1 = pt->v[_MMG5_iare[i][0]];
   ip2 = pt->v[_MMG5_iare[i][1]];
+  _MMG3D_intfield(mesh,ip1,ip2,ip,s);
 
   if ( pt->xt ) {
     pxt = &mesh->xtetra[pt->xt];
@@ -96,6 +221,7 @@ int _MMG5_intmet_ani(MMG5_pMesh mesh,MMG5_pSol met,int k,char i,int ip,
  *
  * Interpolation of anisotropic sizemap at parameter \a s along edge \a i of elt
  * \a k for a classic storage of ridges metrics (before defsiz call).
+ * The user fields are linearly interpolated at the new point.
  *
  */
 int _MMG3D_intmet33_ani(MMG5_pMesh mesh,MMG5_pSol met,int k,char i,int ip,
@@ -107,6 +233,7 @@ int _MMG3D_intmet33_ani(MMG5_pMesh mesh,MMG5_pSol met,int k,char i,int ip,
   pt = &mesh->tetra[k];
   ip1 = pt->v[_MMG5_iare[i][0]];
   ip2 = pt->v[_MMG5_iare[i][1]];
+  _MMG3D_intfield(mesh,ip1,ip2,ip,s);
 
   m   = &met->m[6*ip1];
   n   = &met->m[6*ip2];
@@ -126,6 +253,7 @@ int _MMG3D_intmet33_ani(MMG5_pMesh mesh,MMG5_pSol met,int k,char i,int ip,
  *
  * Interpolation of anisotropic sizemap at parameter \a s along edge \a i of elt
  * \a k.
+ * The user fields are linearly interpolated at the new point.
  *
  */
 int _MMG5_intmet_iso(MMG5_pMesh mesh,MMG5_pSol met,int k,char i,int ip,
@@ -137,6 +265,7 @@ int _MMG5_intmet_iso(MMG5_pMesh mesh,MMG5_pSol met,int k,char i,int ip,
   pt = &mesh->tetra[k];
   ip1 = pt->v[_MMG5_iare[i][0]];
   ip2 = pt->v[_MMG5_iare[i][1]];
+  _MMG3D_intfield(mesh,ip1,ip2,ip,s);
 
   m1 = &met->m[met->size*ip1];
   m2 = &met->m[met->size*ip2];
@@ -296,6 +425,7 @@ printf("m1 %e %e %e %e %e %e\n",m1[0],m1[1],m1[2],m1[3],m1[4],m1[5]);
  *
  * Linear interpolation of isotropic sizemap in a tetra given the barycentric
  * coordinates of the new point in \a k.
+ * The user fields are linearly interpolated at the new point.
  *
  */
 int _MMG5_interp4bar_iso(MMG5_pMesh mesh, MMG5_pSol met, int k, int ip,
@@ -303,6 +433,7 @@ int _MMG5_interp4bar_iso(MMG5_pMesh mesh, MMG5_pSol met, int k, int ip,
   MMG5_pTetra pt;
 
   pt = &mesh->tetra[k];
+  _MMG3D_intfield4bar(mesh,k,ip,cb);
 
   met->m[ip] = cb[0]*met->m[pt->v[0]]+cb[1]*met->m[pt->v[1]] +
     cb[2]*met->m[pt->v[2]]+cb[3]*met->m[pt->v[3]];
@@ -359,6 +490,7 @@ int _MMG5_interp4barintern(MMG5_pSol met,int ip,double cb[4],double dm0[6],
  *
  * Linear interpolation of anisotropic sizemap in a tetra given the barycentric
  * coordinates of the new point in \a k.
+ * The user fields are linearly interpolated at the new point.
  *
  */
 int _MMG5_interp4bar_ani(MMG5_pMesh mesh, MMG5_pSol met, int k, int ip,
@@ -369,6 +501,8 @@ int _MMG5_interp4bar_ani(MMG5_pMesh mesh, MMG5_pSol met, int k, int ip,
   int           i;
 
   pt  = &mesh->tetra[k];
+  _MMG3D_intfield4bar(mesh,k,ip,cb);
+
   pp1 = &mesh->point[pt->v[0]];
   if(MG_SIN(pp1->tag) || (MG_NOM & pp1->tag)) {
     for (i=0; i<6; i++) {
@@ -431,6 +565,7 @@ int _MMG5_interp4bar_ani(MMG5_pMesh mesh, MMG5_pSol met, int k, int ip,
  *
  * Linear interpolation of anisotropic sizemap in a tetra given the barycentric
  * coordinates of the new point in \a k.
+ * The user fields are linearly interpolated at the new point.
  *
  */
 int _MMG5_interp4bar33_ani(MMG5_pMesh mesh, MMG5_pSol met, int k, int ip,
@@ -440,6 +575,8 @@ int _MMG5_interp4bar33_ani(MMG5_pMesh mesh, MMG5_pSol met, int k, int ip,
   int           i;
 
   pt  = &mesh->tetra[k];
+  _MMG3D_intfield4bar(mesh,k,ip,cb);
+
   for (i=0; i<6; i++) {
     dm0[i] = met->m[met->size*pt->v[0]+i];
   }
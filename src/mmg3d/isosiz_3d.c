@@ -41,6 +41,9 @@ extern char   ddb;
 #define A16TH     0.0625
 #define A32TH     0.03125
 
+/** Number of points above which the gradation is done by parallel sweeps */
+#define _MMG5_GRADPAR  500000
+
 /**
  * \param mesh pointer toward the mesh structure.
  * \param met pointer toward the sol structure.
@@ -459,12 +462,35 @@ _MMG5_defsizreg(MMG5_pMesh mesh,MMG5_pSol met,int nump,int *lists,
       hnm = MG_MIN(hnm,isqhmin);
       hnm = MG_MAX(hnm,isqhmax);
       hnm = 1.0 / sqrt(hnm);
+#ifdef _OPENMP
+#pragma omp critical (defsizreg_nom)
+#endif
       met->m[ip0] = MG_MIN(met->m[ip0],hnm);
     }
   }
   return(h);
 }
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param ref reference of the triangle.
+ * \return the index of the local parameters that apply to a triangle of
+ * reference \a ref (the last matching one), -1 if none.
+ *
+ */
+static inline int
+_MMG3D_triParIdx(MMG5_pMesh mesh,int ref) {
+  MMG5_pPar par;
+  int       l,ipar;
+
+  ipar = -1;
+  for (l=0; l<mesh->info.npar; l++) {
+    par = &mesh->info.par[l];
+    if ( (par->elt == MMG5_Triangle) && (ref == par->ref ) )  ipar = l;
+  }
+  return(ipar);
+}
+
 /**
  * \param mesh pointer toward the mesh structure.
  * \param met pointer toward the metric structure.
@@ -481,9 +507,9 @@ int _MMG3D_defsiz_iso(MMG5_pMesh mesh,MMG5_pSol met) {
   MMG5_pPoint    p0,p1;
   double         hp,v[3],b0[3],b1[3],b0p0[3],b1b0[3],p1b1[3],hausd,hmin,hmax;
   double         secder0[3],secder1[3],kappa,tau[3],gammasec[3],ntau2,intau,ps,lm;
-  int            lists[MMG3D_LMAX+2],listv[MMG3D_LMAX+2],ilists,ilistv,k,ip0,ip1,l;
-  int            isloc;
-  char           i,j,ia,ised,i0,i1;
+  int            lists[MMG3D_LMAX+2],ilists,k,ip0,ip1,l,ll,ipar,iparl;
+  int            isloc,*adr,*list;
+  char           *loc,i,j,ia,ised,i0,i1;
   MMG5_pPar      par;
 
   if ( abs(mesh->info.imprim) > 5 || mesh->info.ddebug )
@@ -514,66 +540,52 @@ int _MMG3D_defsiz_iso(MMG5_pMesh mesh,MMG5_pSol met) {
       met->m[k] = MG_MIN(mesh->info.hmax,MG_MAX(mesh->info.hmin,met->m[k]));
   }
 
-  /* size at regular surface points */
-  for (k=1; k<=mesh->ne; k++) {
-    pt = &mesh->tetra[k];
-    // Warning: why are we skipped the tetra with negative refs ?
-    if ( !MG_EOK(pt) || pt->ref < 0 || (pt->tag & MG_REQ) )   continue;
-    else if ( !pt->xt )  continue;
+  /* size at regular surface points: each point is treated once for each set
+   * of local parameters of its boundary faces, points are independent */
+  if ( !_MMG3D_surfIncid(mesh,&adr,&list,&loc) ) return(0);
 
-    pxt = &mesh->xtetra[pt->xt];
-    for (i=0; i<4; i++) {
-      if ( !(pxt->ftag[i] & MG_BDY) ) continue;
-      if ( !MG_GET(mesh->xtetra[mesh->tetra[k].xt].ori,i) ) continue;
+#pragma omp parallel for schedule(dynamic,64) \
+  private(p0,pt,pxt,par,hp,hausd,hmin,hmax,lists,ilists,k,l,ll,ipar,iparl,i,i0)
+  for (ip0=1; ip0<=mesh->np; ip0++) {
+    p0 = &mesh->point[ip0];
+    if ( adr[ip0] == adr[ip0+1] ) continue;
+    if ( MG_SIN(p0->tag) || MG_EDG(p0->tag) || (p0->tag & MG_NOM) ) continue;
+
+    for (l=adr[ip0]; l<adr[ip0+1]; l++) {
+      k  = list[l] / 4;
+      i  = list[l] % 4;
+      i0 = loc[l];
+      pt  = &mesh->tetra[k];
+      pxt = &mesh->xtetra[pt->xt];
 
       /* local parameters for triangle */
-      hausd = mesh->info.hausd;
-      hmin  = mesh->info.hmin;
-      hmax  = mesh->info.hmax;
-      isloc = 0;
-      for (l=0; l<mesh->info.npar; l++) {
-        par = &mesh->info.par[l];
-        if ( (par->elt == MMG5_Triangle) && (pxt->ref[i] == par->ref ) ) {
-          hausd = par->hausd;
-          hmin  = par->hmin;
-          hmax  = par->hmax;
-          isloc = 1;
-        }
+      ipar = _MMG3D_triParIdx(mesh,pxt->ref[i]);
+      for (ll=adr[ip0]; ll<l; ll++) {
+        iparl = _MMG3D_triParIdx(mesh,mesh->xtetra[mesh->tetra[list[ll]/4].xt].ref[list[ll]%4]);
+        if ( iparl == ipar ) break;
       }
+      if ( ll < l ) continue;
 
-      for (j=0; j<3; j++) {
-        i0  = _MMG5_idir[i][j];
-        ip0 = pt->v[i0];
-        p0  = &mesh->point[ip0];
-
-        /* local parameters at vertex: useless for now because new points are
-         * created without reference (inside the domain) */
-        /* for (l=0; l<mesh->info.npar; l++) { */
-        /*   par = &mesh->info.par[l]; */
-        /*   if ( (par->elt == MMG5_Vertex) && (p0->ref == par->ref ) ) { */
-        /*     if ( !isloc ) { */
-        /*       hausd = par->hausd; */
-        /*       hmin  = par->hmin; */
-        /*       hmax  = par->hmax; */
-        /*       isloc = 1; */
-        /*     } */
-        /*     else { */
-        /*       hausd = MG_MIN(par->hausd,hausd); */
-        /*       hmin  = MG_MAX(par->hmin,hmin); */
-        /*       hmax  = MG_MIN(par->hmax,hmax); */
-        /*     } */
-        /*   } */
-        /* } */
-
-        if ( MG_SIN(p0->tag) || MG_EDG(p0->tag) || (p0->tag & MG_NOM) ) continue;
-        if ( !_MMG5_boulesurfvolp(mesh,k,i0,i,listv,&ilistv,lists,&ilists,0) )
-          continue;
-
-        hp  = _MMG5_defsizreg(mesh,met,ip0,lists,ilists,hmin,hmax,hausd);
-        met->m[ip0] = MG_MIN(met->m[ip0],hp);
+      if ( ipar < 0 ) {
+        hausd = mesh->info.hausd;
+        hmin  = mesh->info.hmin;
+        hmax  = mesh->info.hmax;
       }
+      else {
+        par   = &mesh->info.par[ipar];
+        hausd = par->hausd;
+        hmin  = par->hmin;
+        hmax  = par->hmax;
+      }
+
+      if ( !_MMG5_boulesurfvolp(mesh,k,i0,i,NULL,NULL,lists,&ilists,0) )
+        continue;
+
+      hp  = _MMG5_defsizreg(mesh,met,ip0,lists,ilists,hmin,hmax,hausd);
+      met->m[ip0] = MG_MIN(met->m[ip0],hp);
     }
   }
+  _MMG3D_freeSurfIncid(mesh,&adr,&list,&loc);
 
   /* Travel all boundary faces to update size prescription for points on ridges/edges */
   for (k=1; k<=mesh->ne; k++) {
@@ -724,74 +736,181 @@ int _MMG3D_defsiz_iso(MMG5_pMesh mesh,MMG5_pSol met) {
 /**
  * \param mesh pointer toward the mesh structure.
  * \param met pointer toward the metric structure.
- * \return 0 if fail, 1 otherwise.
+ * \return the number of updated sizes, -1 if fail.
  *
- * Enforce mesh gradation by truncating size map.
+ * Enforce mesh gradation by propagating the sizes from the smallest to the
+ * largest ones (Dijkstra-like front). The size of a point popped from the heap
+ * is final, so each point is treated once and its ball is computed from its
+ * incident tetra (see \ref _MMG3D_ptStart).
  *
  */
-int _MMG5_gradsiz_iso(MMG5_pMesh mesh,MMG5_pSol met) {
+static int
+_MMG5_gradsizHeap_iso(MMG5_pMesh mesh,MMG5_pSol met) {
   MMG5_pTetra    pt;
   MMG5_pPoint    p0,p1;
-  double    l,hn;
-  int       ip0,ip1,it,maxit,nu,nup,k;
-  char      i,j,ia,i0,i1;
+  _MMG5_Heap     heap;
+  _MMG3D_List    lst;
+  double         l,hn;
+  int            ip0,ip1,k,kel,ilist,nu,isset;
+  char           i,j,iloc;
+
+  if ( !_MMG5_heapNew(mesh,&heap,mesh->np) )  return(-1);
+  if ( !_MMG3D_initList(mesh,&lst,MMG3D_LMAX+2) ) {
+    _MMG5_heapFree(mesh,&heap);
+    return(-1);
+  }
 
-  if ( abs(mesh->info.imprim) > 5 || mesh->info.ddebug )
-    fprintf(stdout,"  ** Grading mesh\n");
+  for (k=1; k<=mesh->np; k++) {
+    if ( !MG_VOK(&mesh->point[k]) || met->m[k] < _MMG5_EPSD )  continue;
+    _MMG5_heapPush(&heap,k,met->m[k]);
+  }
+
+  nu = isset = 0;
+  while ( (ip0 = _MMG5_heapPop(&heap)) ) {
+    p0 = &mesh->point[ip0];
+
+    kel = _MMG3D_ptStart(mesh,ip0,&iloc);
+    if ( !kel && !isset ) {
+      /* out of date incident tetra: refresh them once */
+      _MMG3D_setPointStart(mesh);
+      isset = 1;
+      kel = _MMG3D_ptStart(mesh,ip0,&iloc);
+    }
+    if ( !kel )  continue;
+    ilist = _MMG5_boulevolp(mesh,kel,iloc,&lst);
+    if ( !ilist ) {
+      nu = -1;
+      break;
+    }
+
+    for (k=0; k<ilist; k++) {
+      pt = &mesh->tetra[lst.item[k]/4];
+      if ( pt->tag & MG_REQ )  continue;
+      i  = lst.item[k]%4;
 
-  for (k=1; k<=mesh->np; k++)
-    mesh->point[k].flag = mesh->base;
+      for (j=0; j<3; j++) {
+        ip1 = pt->v[_MMG5_idir[i][j]];
+        /* size of ip1 is already final */
+        if ( !heap.pos[ip1] )  continue;
+
+        p1 = &mesh->point[ip1];
+        l = (p1->c[0]-p0->c[0])*(p1->c[0]-p0->c[0]) + (p1->c[1]-p0->c[1])*(p1->c[1]-p0->c[1])\
+          + (p1->c[2]-p0->c[2])*(p1->c[2]-p0->c[2]);
+        l = sqrt(l);
+
+        hn = met->m[ip0] + mesh->info.hgrad*l;
+        if ( met->m[ip1] > hn ) {
+          met->m[ip1] = hn;
+          _MMG5_heapPush(&heap,ip1,hn);
+          nu++;
+        }
+      }
+    }
+  }
+  _MMG3D_freeList(mesh,&lst);
+  _MMG5_heapFree(mesh,&heap);
+
+  return(nu);
+}
+
+#ifdef _OPENMP
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \param adr addresses of the point balls (see \ref _MMG3D_ballIncid).
+ * \param list point balls.
+ * \return the number of updated sizes.
+ *
+ * Enforce mesh gradation by multithreaded sweeps over the points: each point
+ * pulls the smallest size allowed by its neighbours so that a size is only
+ * written by the thread that owns the point.
+ *
+ */
+static int
+_MMG5_gradsizPar_iso(MMG5_pMesh mesh,MMG5_pSol met,int *adr,int *list) {
+  MMG5_pTetra    pt;
+  MMG5_pPoint    p0,p1;
+  double         l,h0,h1,hmin;
+  int            ip0,ip1,k,it,maxit,nu,nup;
+  char           i,j;
 
   it = nup = 0;
-  maxit = 100;
+  maxit = 500;
   do {
-    mesh->base++;
     nu = 0;
-    for (k=1; k<=mesh->ne; k++) {
-      pt = &mesh->tetra[k];
-      if ( !MG_EOK(pt) || (pt->tag & MG_REQ) )  continue;
+#pragma omp parallel for schedule(dynamic,1024) reduction(+:nu) \
+  private(pt,p0,p1,l,h0,h1,hmin,ip1,k,i,j)
+    for (ip0=1; ip0<=mesh->np; ip0++) {
+      p0 = &mesh->point[ip0];
+      h0 = met->m[ip0];
+      if ( !MG_VOK(p0) || h0 < _MMG5_EPSD )  continue;
+
+      hmin = h0;
+      for (k=adr[ip0]; k<adr[ip0+1]; k++) {
+        pt = &mesh->tetra[list[k]/4];
+        if ( pt->tag & MG_REQ )  continue;
+        i  = list[k]%4;
 
-      for (i=0; i<4; i++) {
         for (j=0; j<3; j++) {
-          ia  = _MMG5_iarf[i][j];
-          i0  = _MMG5_iare[ia][0];
-          i1  = _MMG5_iare[ia][1];
-          ip0 = pt->v[i0];
-          ip1 = pt->v[i1];
-          p0  = &mesh->point[ip0];
-          p1  = &mesh->point[ip1];
-          if ( p0->flag < mesh->base-1 && p1->flag < mesh->base-1 )  continue;
+          ip1 = pt->v[_MMG5_idir[i][j]];
+#pragma omp atomic read
+          h1 = met->m[ip1];
+          if ( h1 < _MMG5_EPSD || h1 >= hmin )  continue;
 
+          p1 = &mesh->point[ip1];
           l = (p1->c[0]-p0->c[0])*(p1->c[0]-p0->c[0]) + (p1->c[1]-p0->c[1])*(p1->c[1]-p0->c[1])\
             + (p1->c[2]-p0->c[2])*(p1->c[2]-p0->c[2]);
           l = sqrt(l);
 
-          if ( met->m[ip0] < met->m[ip1] ) {
-            if ( met->m[ip0] < _MMG5_EPSD )  continue;
-            hn = met->m[ip0] + mesh->info.hgrad*l;
-            if ( met->m[ip1] > hn ) {
-              met->m[ip1] = hn;
-              p1->flag = mesh->base;
-              nu++;
-            }
-          }
-          else {
-            if ( met->m[ip1] < _MMG5_EPSD )  continue;
-            hn = met->m[ip1] + mesh->info.hgrad*l;
-            if ( met->m[ip0] > hn ) {
-              met->m[ip0] = hn;
-              p0->flag = mesh->base;
-              nu++;
-            }
-          }
+          hmin = MG_MIN(hmin,h1 + mesh->info.hgrad*l);
         }
       }
+      if ( hmin < h0 ) {
+#pragma omp atomic write
+        met->m[ip0] = hmin;
+        nu++;
+      }
     }
     nup += nu;
   }
   while( ++it < maxit && nu > 0 );
 
+  return(nup);
+}
+#endif
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param met pointer toward the metric structure.
+ * \return 0 if fail, 1 otherwise.
+ *
+ * Enforce mesh gradation by truncating size map. Large meshes are treated by
+ * multithreaded sweeps if available, the others by front propagation.
+ *
+ */
+int _MMG5_gradsiz_iso(MMG5_pMesh mesh,MMG5_pSol met) {
+  int       nup;
+#ifdef _OPENMP
+  int       *adr,*list;
+#endif
+
+  if ( abs(mesh->info.imprim) > 5 || mesh->info.ddebug )
+    fprintf(stdout,"  ** Grading mesh\n");
+
+#ifdef _OPENMP
+  /* the sweeps read the balls many times: store them once */
+  if ( mesh->np > _MMG5_GRADPAR && omp_get_max_threads() > 1 ) {
+    if ( !_MMG3D_ballIncid(mesh,&adr,&list) )  return(0);
+    nup = _MMG5_gradsizPar_iso(mesh,met,adr,list);
+    _MMG3D_freeBallIncid(mesh,&adr,&list);
+  }
+  else
+#endif
+    nup = _MMG5_gradsizHeap_iso(mesh,met);
+
+  if ( nup < 0 )  return(0);
+
   if ( abs(mesh->info.imprim) > 4 )
-    fprintf(stdout,"     gradation: %7d updated, %d iter.\n",nup,it);
+    fprintf(stdout,"     gradation: %7d updated.\n",nup);
   return(1);
 }
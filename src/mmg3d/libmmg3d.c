@@ -93,8 +93,9 @@ static inline
 int _MMG3D_packMesh(MMG5_pMesh mesh,MMG5_pSol met,MMG5_pSol disp) {
   MMG5_pTetra   pt,ptnew;
   MMG5_pPoint   ppt,pptnew;
+  MMG5_pSol     psl;
   MMG5_hgeom   *ph;
-  int     np,nc,nr, k,ne,nbl,imet,imetnew,i;
+  int     np,nc,nr, k,ne,nbl,imet,imetnew,i,l;
   int     iadr,iadrnew,iadrv,*adjav,*adja,*adjanew,voy;
 
   /* compact vertices */
@@ -179,6 +180,22 @@ int _MMG3D_packMesh(MMG5_pMesh mesh,MMG5_pSol met,MMG5_pSol disp) {
     }
   }
 
+  /* compact user fields */
+  for (l=0; l<mesh->nfield; l++) {
+    psl = mesh->field[l];
+    nbl = 1;
+    for (k=1; k<=mesh->np; k++) {
+      ppt = &mesh->point[k];
+      if ( !MG_VOK(ppt) )  continue;
+      imet    = k   * psl->size;
+      imetnew = nbl * psl->size;
+
+      for (i=0; i<psl->size; i++)
+        psl->m[imetnew + i] = psl->m[imet + i];
+      ++nbl;
+    }
+  }
+
   /*compact vertices*/
   np  = 0;
   nbl = 1;
@@ -199,6 +216,8 @@ int _MMG3D_packMesh(MMG5_pMesh mesh,MMG5_pSol met,MMG5_pSol disp) {
     met->np  = np;
   if ( disp && disp->m )
     disp->np = np;
+  for (l=0; l<mesh->nfield; l++)
+    mesh->field[l]->np = mesh->field[l]->npi = np;
 
   /* rebuild triangles*/
   mesh->nt = 0;
@@ -215,14 +234,12 @@ int _MMG3D_packMesh(MMG5_pMesh mesh,MMG5_pSol met,MMG5_pSol disp) {
   mesh->na = 0;
   /* in the worst case (all edges are marked), we will have around 1 edge per *
    * triangle (we count edges only one time) */
-  mesh->memCur += (long long)((3*mesh->nt+2)*sizeof(MMG5_hgeom));
-  if ( (mesh->memCur) > (mesh->memMax) ) {
-    mesh->memCur -= (long long)((3*mesh->nt+2)*sizeof(MMG5_hgeom));
+  if ( !_MMG5_hNew(mesh,&mesh->htab,mesh->nt,0) ) {
     fprintf(stdout,"  ## Warning:");
     fprintf(stdout," unable to allocate an hash table to store the mesh edges."
       "\n  ## Warning: uncomplete mesh\n");
   }
-  else if ( _MMG5_hNew(&mesh->htab,mesh->nt,3*(mesh->nt),0) ) {
+  else {
     for (k=1; k<=mesh->ne; k++) {
       pt   = &mesh->tetra[k];
       if ( MG_EOK(pt) &&  pt->xt ) {
@@ -281,8 +298,6 @@ int _MMG3D_packMesh(MMG5_pMesh mesh,MMG5_pSol met,MMG5_pSol disp) {
     }
     _MMG5_DEL_MEM(mesh,mesh->htab.geom,(mesh->htab.max+1)*sizeof(MMG5_hgeom));
   }
-  else
-    mesh->memCur -= (long long)((3*mesh->nt+2)*sizeof(MMG5_hgeom));
 
   for(k=1 ; k<=mesh->np ; k++)
     mesh->point[k].tmp = 0;
@@ -295,6 +310,8 @@ int _MMG3D_packMesh(MMG5_pMesh mesh,MMG5_pSol met,MMG5_pSol disp) {
   for(k=mesh->nenil; k<mesh->nemax-1; k++)
     mesh->tetra[k].v[3] = k+1;
 
+  _MMG3D_setPointStart(mesh);
+
   /* to could save the mesh, the adjacency have to be correct */
   if ( mesh->info.ddebug && (!_MMG5_chkmsh(mesh,1,1) ) ) {
     fprintf(stdout,"  ##  Problem. Invalid mesh.\n");
@@ -710,12 +727,6 @@ int MMG3D_mmg3dmov(MMG5_pMesh mesh,MMG5_pSol met, MMG5_pSol disp) {
     mesh->info.lag = 1;
   }
 
-#ifndef USE_SUSCELAS
-  fprintf(stdout,"  ## Error: you need to compile with the USE_SUSCELAS"
-    " CMake's flag set to ON to use the rigidbody movement library.\n");
-  _LIBMMG5_RETURN(mesh,met,MMG5_STRONGFAILURE);
-#endif
-
   if ( !disp ) {
     fprintf(stdout,"  ## Error: in lagrangian mode, a structure of type"
             " \"MMG5_pSol\" is needed to store the displacement field.\n"
@@ -783,13 +794,11 @@ int MMG3D_mmg3dmov(MMG5_pMesh mesh,MMG5_pSol met, MMG5_pSol disp) {
     _MMG5_RETURN_AND_PACK(mesh,met,disp,MMG5_LOWFAILURE);
   }
 
-#ifdef USE_SUSCELAS
   /* Lagrangian mode */
   if ( !_MMG5_mmg3d3(mesh,disp,met) ) {
     disp->npi = disp->np;
     _LIBMMG5_RETURN(mesh,met,MMG5_STRONGFAILURE);
   }
-#endif
   disp->npi = disp->np;
 
   if ( !met->np && !MMG3D_DoSol(mesh,met) ) {
@@ -56,6 +56,11 @@ extern "C" {
  */
 #define MMG3D_LMAX      10240
 
+/**
+ * Point locator on a copy of a tetrahedral mesh (see \ref MMG3D_Init_locator).
+ */
+typedef struct MMG3D_Locator * MMG3D_pLocator;
+
 /**
  * \enum MMG3D_Param
  * \brief Input parameters for mmg library.
@@ -177,6 +182,21 @@ int  MMG3D_Set_outputSolName(MMG5_pMesh mesh,MMG5_pSol sol, char* solout);
  *
  */
 int  MMG3D_Set_solSize(MMG5_pMesh mesh, MMG5_pSol sol, int typEntity, int np, int typSol);
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param sol pointer toward the sol structure of the field.
+ * \param size number of values per vertex of the field.
+ * \return 0 if failed, 1 otherwise.
+ *
+ * Attach a user field (set by \ref MMG3D_Set_solSize or allocated with \a
+ * size values per vertex) to the mesh. The field is linearly interpolated at
+ * the points created by the remeshing and at the points moved by the
+ * smoothing (in the ball of the point before its move), and packed with the
+ * mesh, so it may be read on the output mesh. Its values are freed with the
+ * mesh.
+ *
+ */
+int  MMG3D_Add_field(MMG5_pMesh mesh, MMG5_pSol sol, int size);
 /**
  * \param mesh pointer toward the mesh structure.
  * \param np number of vertices.
@@ -1416,12 +1436,12 @@ void MMG5_searchqua(MMG5_pMesh,MMG5_pSol,double, int *, char);
 int MMG5_searchlen(MMG5_pMesh,MMG5_pSol, double, double, int *,char);
 
 /**
- * \brief Return adjacent elements of a triangle.
+ * \brief Return adjacent vertices of a vertex.
  * \param mesh pointer toward the mesh structure.
  * \param ip vertex index.
  * \param vtab pointer toward an array of size MMG3D_LMAX that will contain
  * the indices of adjacent vertices to the vertex \a k.
- * \return 1 if success.
+ * \return the number of adjacent vertices, 0 if fail.
  *
  * Find the indices of the adjacent vertices of the vertex \a
  * ip.
@@ -1429,6 +1449,62 @@ int MMG5_searchlen(MMG5_pMesh,MMG5_pSol, double, double, int *,char);
  */
 int MMG3D_Get_adjaVertices(MMG5_pMesh mesh, int ip, int vtab[MMG3D_LMAX]);
 
+/* Solution transfer */
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param loc pointer toward the locator to create.
+ * \return 1 if success, 0 if fail.
+ *
+ * Build a point locator on a copy of the tetrahedra of \a mesh. It must be
+ * built before the remeshing to transfer fields from the input mesh toward
+ * the output one. The locator must be freed by \ref MMG3D_Free_locator.
+ *
+ */
+int  MMG3D_Init_locator(MMG5_pMesh mesh, MMG3D_pLocator *loc);
+/**
+ * \param loc pointer toward the locator.
+ * \param np number of points to locate.
+ * \param c coordinates of the points (3 per point).
+ * \param iel array of size \a np filled by the index of the tetra that
+ * contains each point, or by minus the index of the closest boundary tetra if
+ * the point lies outside the mesh.
+ * \param bary array of size \a 4*np filled by the barycentric coordinates of
+ * each point in its tetra (of its projection on the closest boundary face
+ * for an outside point).
+ * \return 1 if success, 0 if fail.
+ *
+ * Locate a batch of points (0-based arrays) in the mesh of the locator. Each
+ * point is searched by a walk from the previous one before falling back on
+ * the bounding box tree, so the batch should be spatially coherent (e.g. the
+ * output mesh vertices). The batch is processed in parallel when openmp is
+ * enabled.
+ *
+ */
+int  MMG3D_locate(MMG3D_pLocator loc, int np, double *c, int *iel, double *bary);
+/**
+ * \param loc pointer toward the locator.
+ * \param np number of located points.
+ * \param iel tetra of the points (from \ref MMG3D_locate).
+ * \param bary barycentric coordinates of the points (from \ref MMG3D_locate).
+ * \param size number of values per point of the field.
+ * \param fold P1 field on the mesh of the locator (\a size values per
+ * vertex, the value of the vertex \a ip starting at fold[size*(ip-1)]).
+ * \param fnew array of size \a size*np filled by the interpolated field.
+ * \return 1 if success, 0 if fail.
+ *
+ * Interpolate a P1 field of the mesh of the locator at located points.
+ *
+ */
+int  MMG3D_Interp_locator(MMG3D_pLocator loc, int np, int *iel, double *bary,
+                          int size, double *fold, double *fnew);
+/**
+ * \param loc pointer toward the locator.
+ *
+ * Free the locator.
+ *
+ */
+void MMG3D_Free_locator(MMG3D_pLocator *loc);
+
 #ifdef __cplusplus
 }
 #endif
@@ -112,6 +112,73 @@ int MMG3D_Get_adjaTet(MMG5_pMesh mesh, int kel, int listet[4]) {
   return(1);
 }
 
+/**
+ * \brief Return adjacent vertices of a vertex.
+ * \param mesh pointer toward the mesh structure.
+ * \param ip vertex index.
+ * \param vtab pointer toward an array of size MMG3D_LMAX that will contain
+ * the indices of adjacent vertices to the vertex \a ip.
+ * \return the number of adjacent vertices, 0 if fail.
+ *
+ * Find the indices of the adjacent vertices of the vertex \a ip. The ball of
+ * \a ip is travelled from the incident tetra stored in the point (see \ref
+ * _MMG3D_setPointStart).
+ *
+ */
+int MMG3D_Get_adjaVertices(MMG5_pMesh mesh, int ip, int vtab[MMG3D_LMAX]) {
+  MMG5_pTetra  pt;
+  _MMG3D_Vset  vset;
+  _MMG3D_List  lst;
+  int          *list,ilist,k,nbpoi;
+  char         i,j,iloc;
+
+  if ( ! mesh->adja ) {
+    if (! MMG3D_hashTetra(mesh, 0))
+      return(0);
+  }
+
+  k = _MMG3D_ptStart(mesh,ip,&iloc);
+  if ( !k ) {
+    _MMG3D_setPointStart(mesh);
+    k = _MMG3D_ptStart(mesh,ip,&iloc);
+    if ( !k )  return(0);
+  }
+
+  if ( !_MMG3D_initList(mesh,&lst,MMG3D_LMAX+2) )  return(0);
+
+  ilist = _MMG5_boulevolp(mesh,k,iloc,&lst);
+  if ( !ilist ) {
+    fprintf(stdout,"  ## Warning: unable to compute adjacent vertices of the"
+            " vertex %d.\n",ip);
+    _MMG3D_freeList(mesh,&lst);
+    return(0);
+  }
+  list = lst.item;
+
+  _MMG3D_initVset(&vset);
+  nbpoi = 0;
+  for (k=0; k<ilist; k++) {
+    pt = &mesh->tetra[list[k]/4];
+    i  = list[k]%4;
+    for (j=0; j<3; j++) {
+      i = _MMG5_inxt3[i];
+      if ( !_MMG3D_addVset(&vset,pt->v[i]) )  continue;
+      if ( nbpoi == MMG3D_LMAX ) {
+        fprintf(stdout,"  ## Warning: unable to compute adjacent vertices of the"
+                " vertex %d:\nthe ball of point contain too many elements.\n",ip);
+        _MMG3D_freeVset(&vset);
+        _MMG3D_freeList(mesh,&lst);
+        return(0);
+      }
+      vtab[nbpoi++] = pt->v[i];
+    }
+  }
+  _MMG3D_freeVset(&vset);
+  _MMG3D_freeList(mesh,&lst);
+
+  return(nbpoi);
+}
+
 /**
  * \param prog pointer toward the program name.
  *
@@ -124,11 +191,9 @@ void MMG3D_usage(char *prog) {
   fprintf(stdout,"-A           enable anisotropy (without metric file).\n");
   fprintf(stdout,"-ls     val  create mesh of isovalue val\n");
 
-#ifdef USE_SUSCELAS
   fprintf(stdout,"-lag [0/1/2] Lagrangian mesh displacement according to mode 0/1/2\n");
-#endif
 #ifndef PATTERN
-  fprintf(stdout,"-bucket val  Specify the size of bucket per dimension \n");
+  fprintf(stdout,"-bucket val  Initial number of bucket cells per dimension\n");
 #endif
 #ifdef USE_SCOTCH
   fprintf(stdout,"-rn [n]      Turn on or off the renumbering using SCOTCH [1/0] \n");
@@ -157,7 +222,7 @@ void MMG3D_defaultValues(MMG5_pMesh mesh) {
   _MMG5_mmgDefaultValues(mesh);
 
 #ifndef PATTERN
-  fprintf(stdout,"Bucket size per dimension (-bucket) : %d\n",
+  fprintf(stdout,"Initial bucket cells per dim (-bucket): %d\n",
           mesh->info.bucket);
 #endif
 #ifdef USE_SCOTCH
@@ -704,7 +769,7 @@ int MMG3D_searchlen(MMG5_pMesh mesh, MMG5_pSol met, double lmin,
   char            ia,i0,i1,ier;
 
   /* Hash all edges in the mesh */
-  if ( !_MMG5_hashNew(mesh,&hash,mesh->np,7*mesh->np) )  return(0);
+  if ( !_MMG5_hashNew(mesh,&hash,mesh->np) )  return(0);
 
   for(k=1; k<=mesh->ne; k++) {
     pt = &mesh->tetra[k];
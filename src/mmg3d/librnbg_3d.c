@@ -197,11 +197,13 @@ void _MMG5_swapTet(MMG5_pTetra tetras/*, int* adja*/, int* perm, int ind1, int i
 int _MMG5_mmg3dRenumbering(int boxVertNbr, MMG5_pMesh mesh, MMG5_pSol sol) {
   MMG5_pPoint ppt;
   MMG5_pTetra ptet;
+  MMG5_pSol   psl;
   SCOTCH_Num  edgeNbr;
   SCOTCH_Num  *vertTab, *edgeTab, *permVrtTab;
   SCOTCH_Graph graf ;
   int    vertNbr, nodeGlbIdx, tetraIdx, ballTetIdx;
-  int    i, j, k;
+  double dd;
+  int    i, j, k, l;
   int    edgeSiz;
   int    *vertOldTab, *permNodTab, nereal, npreal;
   int    *adja,iadr;
@@ -405,8 +407,18 @@ int _MMG5_mmg3dRenumbering(int boxVertNbr, MMG5_pMesh mesh, MMG5_pSol sol) {
 
   /* Permute nodes and sol */
   for (j=1; j<= mesh->np; j++) {
-    while ( permNodTab[j] != j && permNodTab[j] )
+    while ( permNodTab[j] != j && permNodTab[j] ) {
+      /* user fields */
+      for (l=0; l<mesh->nfield; l++) {
+        psl = mesh->field[l];
+        for (i=0; i<psl->size; i++) {
+          dd = psl->m[psl->size*j+i];
+          psl->m[psl->size*j+i] = psl->m[psl->size*permNodTab[j]+i];
+          psl->m[psl->size*permNodTab[j]+i] = dd;
+        }
+      }
       _MMG5_swapNod(mesh->point,sol->m,permNodTab,j,permNodTab[j],sol->size);
+    }
   }
   _MMG5_DEL_MEM(mesh,permNodTab,(mesh->np+1)*sizeof(int));
 
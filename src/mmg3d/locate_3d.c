@@ -0,0 +1,680 @@
+/* =============================================================================
+**  This file is part of the mmg software package for the tetrahedral
+**  mesh modification.
+**  Copyright (c) Bx INP/Inria/UBordeaux/UPMC, 2004- .
+**
+**  mmg is free software: you can redistribute it and/or modify it
+**  under the terms of the GNU Lesser General Public License as published
+**  by the Free Software Foundation, either version 3 of the License, or
+**  (at your option) any later version.
+**
+**  mmg is distributed in the hope that it will be useful, but WITHOUT
+**  ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+**  FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public
+**  License for more details.
+**
+**  You should have received a copy of the GNU Lesser General Public
+**  License and of the GNU General Public License along with mmg (in
+**  files COPYING.LESSER and COPYING). If not, see
+**  <http://www.gnu.org/licenses/>. Please read their terms carefully and
+**  use this copy of the mmg distribution only if you accept them.
+** =============================================================================
+*/
+
+/**
+ * \file mmg3d/locate_3d.c
+ * \brief Point location in a copy of a tetrahedral mesh (solution transfer).
+ * \author Charles Dapogny (UPMC)
+ * \author Cécile Dobrzynski (Bx INP/Inria/UBordeaux)
+ * \author Pascal Frey (UPMC)
+ * \author Algiane Froehly (Inria/UBordeaux)
+ * \version 5
+ * \copyright GNU Lesser General Public License.
+ */
+
+#include "mmg3d.h"
+
+/** Number of points of a batch located by the same thread */
+#define _MMG3D_LOCCHK    128
+/** Size of the stacks used to traverse the tree */
+#define _MMG3D_LOCSTK    128
+
+/**
+ * \param loc pointer toward the locator.
+ * \return 1 if success, 0 if fail.
+ *
+ * Compute the adjacency relations of the tetra of the locator.
+ *
+ */
+static int _MMG3D_locAdja(MMG3D_pLocator loc) {
+  int       *tab,*v,*vn,siz,mask,k,kn,i,in,j,h,a[3],b[3],tmp;
+
+  siz  = _MMG5_hashSiz(4*loc->ne);
+  mask = siz-1;
+  tab  = (int*)calloc(siz,sizeof(int));
+  if ( !tab ) {
+    perror("  ## Memory problem: calloc");
+    return(0);
+  }
+
+  for (k=1; k<=loc->ne; k++) {
+    v = &loc->v[4*k];
+    if ( !v[0] )  continue;
+    for (i=0; i<4; i++) {
+      for (j=0; j<3; j++)  a[j] = v[_MMG5_idir[i][j]];
+      if ( a[0] > a[1] ) { tmp = a[0]; a[0] = a[1]; a[1] = tmp; }
+      if ( a[1] > a[2] ) { tmp = a[1]; a[1] = a[2]; a[2] = tmp; }
+      if ( a[0] > a[1] ) { tmp = a[0]; a[0] = a[1]; a[1] = tmp; }
+
+      h = _MMG5_hashSlot(a[0],a[2],mask);
+      while ( tab[h] ) {
+        kn = tab[h] / 4;
+        in = tab[h] % 4;
+        vn = &loc->v[4*kn];
+        for (j=0; j<3; j++)  b[j] = vn[_MMG5_idir[in][j]];
+        if ( b[0] > b[1] ) { tmp = b[0]; b[0] = b[1]; b[1] = tmp; }
+        if ( b[1] > b[2] ) { tmp = b[1]; b[1] = b[2]; b[2] = tmp; }
+        if ( b[0] > b[1] ) { tmp = b[0]; b[0] = b[1]; b[1] = tmp; }
+        if ( a[0] == b[0] && a[1] == b[1] && a[2] == b[2] )  break;
+        h = (h+1) & mask;
+      }
+      if ( tab[h] ) {
+        loc->adj[4*k+i]    = kn;
+        loc->adj[4*kn+in]  = k;
+      }
+      else
+        tab[h] = 4*k+i;
+    }
+  }
+  free(tab);
+  return(1);
+}
+
+/**
+ * \param loc pointer toward the locator.
+ * \param cen coordinates of the tetra centroids.
+ * \param beg first index of the range of perm.
+ * \param end last index (excluded) of the range of perm.
+ * \param nth position of the element to select.
+ * \param dir direction of the selection.
+ *
+ * Reorder the range [beg,end[ of loc->perm such that the tetra at position
+ * \a nth is the one with the nth centroid along the direction \a dir.
+ *
+ */
+static void _MMG3D_locSelect(MMG3D_pLocator loc,double *cen,int beg,int end,
+                             int nth,int dir) {
+  int     *perm,i,j,tmp;
+  double  piv;
+
+  perm = loc->perm;
+  end--;
+  while ( beg < end ) {
+    piv = cen[3*perm[(beg+end)/2]+dir];
+    i   = beg;
+    j   = end;
+    while ( i <= j ) {
+      while ( cen[3*perm[i]+dir] < piv )  i++;
+      while ( cen[3*perm[j]+dir] > piv )  j--;
+      if ( i <= j ) {
+        tmp = perm[i]; perm[i] = perm[j]; perm[j] = tmp;
+        i++;
+        j--;
+      }
+    }
+    if ( nth <= j )       end = j;
+    else if ( nth >= i )  beg = i;
+    else  break;
+  }
+}
+
+/**
+ * \param loc pointer toward the locator.
+ * \param n number of valid tetra.
+ * \return 1 if success, 0 if fail.
+ *
+ * Build the bounding box tree of the locator: the tetra are recursively
+ * split at the median of their centroids along the largest direction until
+ * the leaves contain at most _MMG3D_LOCLEAF tetra.
+ *
+ */
+static int _MMG3D_locTree(MMG3D_pLocator loc,int n) {
+  _MMG3D_LocNode *pn;
+  double         *cen,*p,cmin[3],cmax[3],dd,diag;
+  int            stack[_MMG3D_LOCSTK],nst,nd,k,i,j,l,dir;
+
+  cen = (double*)malloc(3*(loc->ne+1)*sizeof(double));
+  loc->node = (_MMG3D_LocNode*)malloc((n/2+2)*sizeof(_MMG3D_LocNode));
+  if ( !cen || !loc->node ) {
+    perror("  ## Memory problem: malloc");
+    free(cen);
+    return(0);
+  }
+
+  for (l=0; l<n; l++) {
+    k = loc->perm[l];
+    for (j=0; j<3; j++) {
+      cen[3*k+j] = 0.;
+      for (i=0; i<4; i++)  cen[3*k+j] += loc->c[3*loc->v[4*k+i]+j];
+      cen[3*k+j] *= 0.25;
+    }
+  }
+
+  loc->node[0].start = 0;
+  loc->node[0].cnt   = n;
+  loc->nnode = 1;
+  stack[0]   = 0;
+  nst        = 1;
+
+  while ( nst ) {
+    nd = stack[--nst];
+    pn = &loc->node[nd];
+
+    for (j=0; j<3; j++) {
+      pn->min[j] = cmin[j] =  DBL_MAX;
+      pn->max[j] = cmax[j] = -DBL_MAX;
+    }
+    for (l=pn->start; l<pn->start+pn->cnt; l++) {
+      k = loc->perm[l];
+      for (i=0; i<4; i++) {
+        p = &loc->c[3*loc->v[4*k+i]];
+        for (j=0; j<3; j++) {
+          pn->min[j] = MG_MIN(pn->min[j],p[j]);
+          pn->max[j] = MG_MAX(pn->max[j],p[j]);
+        }
+      }
+      for (j=0; j<3; j++) {
+        cmin[j] = MG_MIN(cmin[j],cen[3*k+j]);
+        cmax[j] = MG_MAX(cmax[j],cen[3*k+j]);
+      }
+    }
+    if ( pn->cnt <= _MMG3D_LOCLEAF )  continue;
+
+    dir = 0;
+    for (j=1; j<3; j++)
+      if ( cmax[j]-cmin[j] > cmax[dir]-cmin[dir] )  dir = j;
+    if ( cmax[dir]-cmin[dir] <= 0. )  continue;
+
+    l = pn->cnt/2;
+    _MMG3D_locSelect(loc,cen,pn->start,pn->start+pn->cnt,pn->start+l,dir);
+
+    loc->node[loc->nnode].start   = pn->start;
+    loc->node[loc->nnode].cnt     = l;
+    loc->node[loc->nnode+1].start = pn->start+l;
+    loc->node[loc->nnode+1].cnt   = pn->cnt-l;
+    pn->start  = loc->nnode;
+    pn->cnt    = 0;
+    stack[nst++] = loc->nnode;
+    stack[nst++] = loc->nnode+1;
+    loc->nnode += 2;
+    assert ( nst < _MMG3D_LOCSTK );
+  }
+  free(cen);
+
+  diag = 0.;
+  for (j=0; j<3; j++) {
+    dd    = loc->node[0].max[j]-loc->node[0].min[j];
+    diag += dd*dd;
+  }
+  loc->tol = _MMG3D_LOCEPS*sqrt(diag);
+
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param loc pointer toward the locator to create.
+ * \return 1 if success, 0 if fail.
+ *
+ * Build a point locator on a copy of the tetrahedra of \a mesh.
+ *
+ */
+int MMG3D_Init_locator(MMG5_pMesh mesh, MMG3D_pLocator *loc) {
+  MMG3D_pLocator pl;
+  MMG5_pTetra    pt;
+  int            k,i,n;
+
+  *loc = NULL;
+  if ( !mesh->np || !mesh->ne ) {
+    fprintf(stdout,"  ## Error: no tetrahedra to build the locator.\n");
+    return(0);
+  }
+
+  _MMG5_SAFE_CALLOC(pl,1,struct MMG3D_Locator);
+  pl->np = mesh->np;
+  pl->ne = mesh->ne;
+  _MMG5_SAFE_MALLOC(pl->c,3*(pl->np+1),double);
+  _MMG5_SAFE_CALLOC(pl->v,4*(pl->ne+1),int);
+  _MMG5_SAFE_CALLOC(pl->adj,4*(pl->ne+1),int);
+  _MMG5_SAFE_MALLOC(pl->perm,pl->ne,int);
+
+  for (k=1; k<=mesh->np; k++)
+    memcpy(&pl->c[3*k],mesh->point[k].c,3*sizeof(double));
+
+  n = 0;
+  for (k=1; k<=mesh->ne; k++) {
+    pt = &mesh->tetra[k];
+    if ( !MG_EOK(pt) )  continue;
+    for (i=0; i<4; i++)  pl->v[4*k+i] = pt->v[i];
+    pl->perm[n++] = k;
+  }
+
+  if ( !n || !_MMG3D_locAdja(pl) || !_MMG3D_locTree(pl,n) ) {
+    MMG3D_Free_locator(&pl);
+    return(0);
+  }
+
+  *loc = pl;
+  return(1);
+}
+
+/**
+ * \param loc pointer toward the locator.
+ *
+ * Free the locator.
+ *
+ */
+void MMG3D_Free_locator(MMG3D_pLocator *loc) {
+  if ( !*loc )  return;
+
+  _MMG5_SAFE_FREE((*loc)->c);
+  _MMG5_SAFE_FREE((*loc)->v);
+  _MMG5_SAFE_FREE((*loc)->adj);
+  _MMG5_SAFE_FREE((*loc)->perm);
+  _MMG5_SAFE_FREE((*loc)->node);
+  _MMG5_SAFE_FREE(*loc);
+}
+
+/**
+ * \param loc pointer toward the locator.
+ * \param k tetra index.
+ * \param p point coordinates.
+ * \param l barycentric coordinates of \a p in \a k.
+ * \return 1 if success, 0 if the tetra is degenerate.
+ *
+ * Compute the barycentric coordinates of \a p in the tetra \a k from the
+ * volumes of the sub-tetra (computed relatively to \a p).
+ *
+ */
+static inline
+int _MMG3D_locBary(MMG3D_pLocator loc,int k,double *p,double l[4]) {
+  double  a[4][3],bc[3],ad[3],vol;
+  int     i,j,*v;
+
+  v = &loc->v[4*k];
+  for (i=0; i<4; i++)
+    for (j=0; j<3; j++)  a[i][j] = loc->c[3*v[i]+j] - p[j];
+
+  /* bc = b x c, ad = a x d */
+  bc[0] = a[1][1]*a[2][2] - a[1][2]*a[2][1];
+  bc[1] = a[1][2]*a[2][0] - a[1][0]*a[2][2];
+  bc[2] = a[1][0]*a[2][1] - a[1][1]*a[2][0];
+  ad[0] = a[0][1]*a[3][2] - a[0][2]*a[3][1];
+  ad[1] = a[0][2]*a[3][0] - a[0][0]*a[3][2];
+  ad[2] = a[0][0]*a[3][1] - a[0][1]*a[3][0];
+
+  l[0] =   bc[0]*a[3][0] + bc[1]*a[3][1] + bc[2]*a[3][2];
+  l[3] = -(bc[0]*a[0][0] + bc[1]*a[0][1] + bc[2]*a[0][2]);
+  l[1] =   ad[0]*a[2][0] + ad[1]*a[2][1] + ad[2]*a[2][2];
+  l[2] = -(ad[0]*a[1][0] + ad[1]*a[1][1] + ad[2]*a[1][2]);
+
+  vol = l[0]+l[1]+l[2]+l[3];
+  if ( fabs(vol) < _MMG5_EPSD2 )  return(0);
+
+  vol = 1./vol;
+  for (i=0; i<4; i++)  l[i] *= vol;
+  return(1);
+}
+
+/**
+ * \param loc pointer toward the locator.
+ * \param p point coordinates.
+ * \param k starting tetra.
+ * \param l barycentric coordinates of \a p in the returned tetra.
+ * \param kb last tetra of the walk if it leaves the mesh (0 otherwise).
+ * \return the tetra containing \a p, 0 if not found.
+ *
+ * Walk toward \a p through the face opposite to the most negative
+ * barycentric coordinate.
+ *
+ */
+static int _MMG3D_locWalk(MMG3D_pLocator loc,double *p,int k,double l[4],int *kb) {
+  int     step,i,j,kn;
+
+  *kb = 0;
+  for (step=0; step<_MMG3D_LOCWALK; step++) {
+    if ( !_MMG3D_locBary(loc,k,p,l) )  return(0);
+
+    i = 0;
+    for (j=1; j<4; j++)
+      if ( l[j] < l[i] )  i = j;
+    if ( l[i] > -_MMG3D_LOCEPS )  return(k);
+
+    kn = loc->adj[4*k+i];
+    if ( !kn ) {
+      *kb = k;
+      return(0);
+    }
+    k = kn;
+  }
+  return(0);
+}
+
+/**
+ * \param pn pointer toward a tree node.
+ * \param p point coordinates.
+ * \return the squared distance between \a p and the box of \a pn.
+ *
+ */
+static inline
+double _MMG3D_locBoxDist(_MMG3D_LocNode *pn,double *p) {
+  double  dd,d;
+  int     j;
+
+  dd = 0.;
+  for (j=0; j<3; j++) {
+    if ( p[j] < pn->min[j] )       d = pn->min[j] - p[j];
+    else if ( p[j] > pn->max[j] )  d = p[j] - pn->max[j];
+    else  continue;
+    dd += d*d;
+  }
+  return(dd);
+}
+
+/**
+ * \param loc pointer toward the locator.
+ * \param p point coordinates.
+ * \param l barycentric coordinates of \a p in the returned tetra.
+ * \return the tetra containing \a p, 0 if not found.
+ *
+ * Search the tetra containing \a p in the leaves of the tree whose box
+ * contains \a p.
+ *
+ */
+static int _MMG3D_locSearch(MMG3D_pLocator loc,double *p,double l[4]) {
+  _MMG3D_LocNode *pn;
+  double         tol2;
+  int            stack[_MMG3D_LOCSTK],nst,k,j,m;
+
+  tol2  = loc->tol*loc->tol;
+  stack[0] = 0;
+  nst   = 1;
+  while ( nst ) {
+    pn = &loc->node[stack[--nst]];
+    if ( _MMG3D_locBoxDist(pn,p) > tol2 )  continue;
+
+    if ( !pn->cnt ) {
+      stack[nst++] = pn->start;
+      stack[nst++] = pn->start+1;
+      continue;
+    }
+    for (m=pn->start; m<pn->start+pn->cnt; m++) {
+      k = loc->perm[m];
+      if ( !_MMG3D_locBary(loc,k,p,l) )  continue;
+      for (j=0; j<4; j++)
+        if ( l[j] < -_MMG3D_LOCEPS )  break;
+      if ( j == 4 )  return(k);
+    }
+  }
+  return(0);
+}
+
+/**
+ * \param p point coordinates.
+ * \param a first vertex of the triangle.
+ * \param b second vertex of the triangle.
+ * \param c third vertex of the triangle.
+ * \param w barycentric coordinates of the projection of \a p on the triangle.
+ * \return the squared distance between \a p and the triangle.
+ *
+ * Compute the closest point from \a p in the triangle \a abc, by testing
+ * the Voronoi regions of its vertices, edges and interior.
+ *
+ */
+static double _MMG3D_locTriaDist(double *p,double *a,double *b,double *c,
+                                 double w[3]) {
+  double  ab[3],ac[3],ap[3],bp[3],cp[3],q[3],d1,d2,d3,d4,d5,d6,va,vb,vc,dd,s,t;
+  int     j;
+
+  for (j=0; j<3; j++) {
+    ab[j] = b[j]-a[j];
+    ac[j] = c[j]-a[j];
+    ap[j] = p[j]-a[j];
+    bp[j] = p[j]-b[j];
+    cp[j] = p[j]-c[j];
+  }
+  d1 = ab[0]*ap[0] + ab[1]*ap[1] + ab[2]*ap[2];
+  d2 = ac[0]*ap[0] + ac[1]*ap[1] + ac[2]*ap[2];
+  d3 = ab[0]*bp[0] + ab[1]*bp[1] + ab[2]*bp[2];
+  d4 = ac[0]*bp[0] + ac[1]*bp[1] + ac[2]*bp[2];
+  d5 = ab[0]*cp[0] + ab[1]*cp[1] + ab[2]*cp[2];
+  d6 = ac[0]*cp[0] + ac[1]*cp[1] + ac[2]*cp[2];
+
+  w[0] = w[1] = w[2] = 0.;
+  vc = d1*d4 - d3*d2;
+  vb = d5*d2 - d1*d6;
+  va = d3*d6 - d5*d4;
+  if ( d1 <= 0. && d2 <= 0. )
+    w[0] = 1.;
+  else if ( d3 >= 0. && d4 <= d3 )
+    w[1] = 1.;
+  else if ( d6 >= 0. && d5 <= d6 )
+    w[2] = 1.;
+  else if ( vc <= 0. && d1 >= 0. && d3 <= 0. ) {
+    t    = d1/(d1-d3);
+    w[0] = 1.-t;
+    w[1] = t;
+  }
+  else if ( vb <= 0. && d2 >= 0. && d6 <= 0. ) {
+    t    = d2/(d2-d6);
+    w[0] = 1.-t;
+    w[2] = t;
+  }
+  else if ( va <= 0. && d4-d3 >= 0. && d5-d6 >= 0. ) {
+    t    = (d4-d3)/((d4-d3)+(d5-d6));
+    w[1] = 1.-t;
+    w[2] = t;
+  }
+  else {
+    dd = va+vb+vc;
+    if ( fabs(dd) < _MMG5_EPSD2 )  w[0] = 1.;
+    else {
+      s    = vb/dd;
+      t    = vc/dd;
+      w[0] = 1.-s-t;
+      w[1] = s;
+      w[2] = t;
+    }
+  }
+
+  dd = 0.;
+  for (j=0; j<3; j++) {
+    q[j] = w[0]*a[j] + w[1]*b[j] + w[2]*c[j] - p[j];
+    dd  += q[j]*q[j];
+  }
+  return(dd);
+}
+
+/**
+ * \param loc pointer toward the locator.
+ * \param p point coordinates.
+ * \param l barycentric coordinates of the projection of \a p on the boundary.
+ * \return the boundary tetra whose boundary face is the closest from \a p.
+ *
+ * Branch and bound search of the boundary face the closest from a point lying
+ * outside the mesh. The bounding boxes of the nodes and of the tetra are
+ * lower bounds of the distance to their faces.
+ *
+ */
+static int _MMG3D_locNearest(MMG3D_pLocator loc,double *p,double l[4]) {
+  _MMG3D_LocNode *pn,box;
+  double         *c,dd,dmin,w[3];
+  int            stack[_MMG3D_LOCSTK],nst,k,kmin,i,j,m,c0,c1,*v;
+  int            ifac,imin;
+
+  kmin = imin = 0;
+  dmin = DBL_MAX;
+  w[0] = w[1] = w[2] = 0.;
+  l[0] = l[1] = l[2] = l[3] = 0.25;
+  stack[0] = 0;
+  nst  = 1;
+  while ( nst ) {
+    pn = &loc->node[stack[--nst]];
+    if ( _MMG3D_locBoxDist(pn,p) >= dmin )  continue;
+
+    if ( !pn->cnt ) {
+      /* visit the closest child first */
+      c0 = pn->start;
+      c1 = pn->start+1;
+      if ( _MMG3D_locBoxDist(&loc->node[c0],p) < _MMG3D_locBoxDist(&loc->node[c1],p) ) {
+        c0 = c1;
+        c1 = pn->start;
+      }
+      stack[nst++] = c0;
+      stack[nst++] = c1;
+      continue;
+    }
+    for (m=pn->start; m<pn->start+pn->cnt; m++) {
+      k = loc->perm[m];
+      for (ifac=0; ifac<4; ifac++)
+        if ( !loc->adj[4*k+ifac] )  break;
+      if ( ifac == 4 )  continue;
+
+      v = &loc->v[4*k];
+      for (j=0; j<3; j++) {
+        box.min[j] =  DBL_MAX;
+        box.max[j] = -DBL_MAX;
+      }
+      for (i=0; i<4; i++) {
+        c = &loc->c[3*v[i]];
+        for (j=0; j<3; j++) {
+          box.min[j] = MG_MIN(box.min[j],c[j]);
+          box.max[j] = MG_MAX(box.max[j],c[j]);
+        }
+      }
+      if ( _MMG3D_locBoxDist(&box,p) >= dmin )  continue;
+
+      for ( ; ifac<4; ifac++) {
+        if ( loc->adj[4*k+ifac] )  continue;
+        dd = _MMG3D_locTriaDist(p,&loc->c[3*v[_MMG5_idir[ifac][0]]],
+                                &loc->c[3*v[_MMG5_idir[ifac][1]]],
+                                &loc->c[3*v[_MMG5_idir[ifac][2]]],w);
+        if ( dd < dmin ) {
+          dmin = dd;
+          kmin = k;
+          imin = ifac;
+          l[imin] = 0.;
+          for (j=0; j<3; j++)  l[_MMG5_idir[imin][j]] = w[j];
+        }
+      }
+    }
+  }
+  if ( !kmin )  return(loc->perm[0]);
+  return(kmin);
+}
+
+/**
+ * \param loc pointer toward the locator.
+ * \param p point coordinates.
+ * \param hint starting tetra of the walk (0 if none).
+ * \param miss set to 1 if the walk from \a hint failed, 0 otherwise.
+ * \param l barycentric coordinates of \a p in the returned tetra.
+ * \return the tetra containing \a p or minus the closest boundary tetra.
+ *
+ * Locate the point \a p: walk from \a hint, then search the tree and, if
+ * \a p lies outside the mesh, project it on the closest boundary face.
+ *
+ */
+static int _MMG3D_locPoint(MMG3D_pLocator loc,double *p,int hint,double l[4],
+                           int *miss) {
+  int     k,kb;
+
+  kb    = 0;
+  *miss = 0;
+  if ( hint ) {
+    k = _MMG3D_locWalk(loc,p,hint,l,&kb);
+    if ( k )  return(k);
+    *miss = !kb;
+  }
+
+  k = _MMG3D_locSearch(loc,p,l);
+  if ( k )  return(k);
+
+  /* point outside the mesh */
+  return(-_MMG3D_locNearest(loc,p,l));
+}
+
+/**
+ * \param loc pointer toward the locator.
+ * \param np number of points to locate.
+ * \param c coordinates of the points (3 per point).
+ * \param iel tetra containing each point (minus the closest boundary tetra
+ * for a point outside the mesh).
+ * \param bary barycentric coordinates of each point (4 per point).
+ * \return 1 if success, 0 if fail.
+ *
+ * Locate a batch of points. The batch is cut in chunks of consecutive points
+ * located by the same thread, each point being searched from the tetra of
+ * the previous one so the results do not depend on the number of threads.
+ * A failed walk disables the walk of the next point, so that incoherent
+ * queries mostly use the tree.
+ *
+ */
+int MMG3D_locate(MMG3D_pLocator loc, int np, double *c, int *iel, double *bary) {
+  int     nc,ic,i,hint,miss;
+
+  if ( !loc ) {
+    fprintf(stdout,"  ## Error: locator not initialized.\n");
+    return(0);
+  }
+
+  nc = (np+_MMG3D_LOCCHK-1)/_MMG3D_LOCCHK;
+
+#pragma omp parallel for schedule(dynamic) private(i,hint,miss)
+  for (ic=0; ic<nc; ic++) {
+    hint = 0;
+    for (i=ic*_MMG3D_LOCCHK; i<MG_MIN(np,(ic+1)*_MMG3D_LOCCHK); i++) {
+      iel[i] = _MMG3D_locPoint(loc,&c[3*i],hint,&bary[4*i],&miss);
+      hint   = miss ? 0 : abs(iel[i]);
+    }
+  }
+  return(1);
+}
+
+/**
+ * \param loc pointer toward the locator.
+ * \param np number of located points.
+ * \param iel tetra of the points.
+ * \param bary barycentric coordinates of the points.
+ * \param size number of values per point of the field.
+ * \param fold P1 field on the mesh of the locator.
+ * \param fnew interpolated field.
+ * \return 1 if success, 0 if fail.
+ *
+ * Interpolate a P1 field of the mesh of the locator at located points.
+ *
+ */
+int MMG3D_Interp_locator(MMG3D_pLocator loc, int np, int *iel, double *bary,
+                         int size, double *fold, double *fnew) {
+  double  *l;
+  int     i,j,m,k,*v;
+
+  if ( !loc ) {
+    fprintf(stdout,"  ## Error: locator not initialized.\n");
+    return(0);
+  }
+
+#pragma omp parallel for private(j,m,k,v,l)
+  for (i=0; i<np; i++) {
+    k = abs(iel[i]);
+    assert ( k && k <= loc->ne );
+    v = &loc->v[4*k];
+    l = &bary[4*i];
+    for (j=0; j<size; j++) {
+      fnew[size*i+j] = 0.;
+      for (m=0; m<4; m++)
+        fnew[size*i+j] += l[m]*fold[size*(v[m]-1)+j];
+    }
+  }
+  return(1);
+}
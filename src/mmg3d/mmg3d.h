@@ -64,6 +64,9 @@ extern "C" {
     }                                                                   \
     sol->npmax = mesh->npmax;                                           \
                                                                         \
+    /* user fields */                                                   \
+    if ( !_MMG3D_reallocField(mesh) ) {law;}                            \
+                                                                        \
     /* We try again to add the point */                                 \
     ip = _MMG3D_newPt(mesh,o,tag);                                       \
     if ( !ip ) {law;}                                                   \
@@ -91,12 +94,14 @@ extern "C" {
     else                                                                \
       gap = (int)(wantedGap*mesh->npmax);                               \
                                                                         \
-    _MMG5_ADD_MEM(mesh,gap*(sizeof(MMG5_Point)+sizeof(int)),            \
+    _MMG5_ADD_MEM(mesh,gap*(sizeof(MMG5_Point)+sizeof(int)+sizeof(char)), \
                   "point and bucket",law);                              \
     _MMG5_SAFE_RECALLOC(mesh->point,mesh->npmax+1,                      \
                         mesh->npmax+gap+1,MMG5_Point,"larger point table"); \
     _MMG5_SAFE_RECALLOC(bucket->link,mesh->npmax+1,                     \
                         mesh->npmax+gap+1,int,"larger bucket table");   \
+    _MMG5_SAFE_RECALLOC(bucket->lev,mesh->npmax+1,                      \
+                        mesh->npmax+gap+1,char,"larger bucket table");  \
     mesh->npmax = mesh->npmax+gap;                                      \
                                                                         \
     mesh->npnil = mesh->np+1;                                           \
@@ -111,6 +116,9 @@ extern "C" {
     }                                                                   \
     sol->npmax = mesh->npmax;                                           \
                                                                         \
+    /* user fields */                                                   \
+    if ( !_MMG3D_reallocField(mesh) ) {law;}                            \
+                                                                        \
     /* We try again to add the point */                                 \
     ip = _MMG3D_newPt(mesh,o,tag);                                       \
     if ( !ip ) {law;}                                                   \
@@ -189,16 +197,114 @@ static const unsigned char _MMG5_isar[6][2] = { {2,3}, {3,1}, {1,2}, {0,3}, {2,0
 static const unsigned char _MMG5_arpt[4][3] = { {0,1,2}, {0,4,3}, {1,3,5}, {2,5,4} };
 
 
+/** Maximal number of levels of the bucket */
+#define _MMG5_BUCKLEV  20
+
+/**
+ * \struct _MMG5_Bcell
+ * \brief Non-empty cell of the bucket.
+ */
 typedef struct {
-  int     size;
-  int    *head;
-  int    *link;
+  unsigned long long key; /*!< level and indices of the cell, 0 if unused */
+  int                head; /*!< first point stored in the cell */
+  int                nsub; /*!< number of points stored in the cell and below */
+} _MMG5_Bcell;
+
+/**
+ * \struct _MMG5_Bucket
+ * \brief Hashed octree used to filter the inserted points.
+ */
+typedef struct {
+  int          size; /*!< initial number of cells per dimension */
+  int          lmax; /*!< finest level */
+  int          hsiz,ncell; /*!< size of the cell table (power of 2), used cells */
+  double       rmax[_MMG5_BUCKLEV]; /*!< max filtering radius at each level */
+  _MMG5_Bcell *cell; /*!< cell table (open addressing) */
+  int         *link; /*!< next point of the same cell */
+  char        *lev; /*!< level+1 of the stored points, 0 if not stored */
 } _MMG5_Bucket;
 typedef _MMG5_Bucket * _MMG5_pBucket;
 
+/** Store the tetra \a k as incident tetra (field \a s) of its vertices */
+#define _MMG3D_SETSTART(mesh,k) do {                      \
+    int _iv;                                              \
+    for (_iv=0; _iv<4; _iv++)                             \
+      (mesh)->point[(mesh)->tetra[k].v[_iv]].s = (k);     \
+  } while(0)
+
+#define _MMG3D_VSETSIZ  256 /**< size of the local table of a _MMG3D_Vset */
+
+/**
+ * \struct _MMG3D_Vset
+ * \brief Set of visited tetra, owned by the caller of a mesh traversal.
+ *
+ * Open-addressing table (linear probing) of tetra indices: small sets are
+ * stored in \a loc, bigger ones are moved on the heap. Unlike the stamping of
+ * the tetra flags with mesh->base, it does not write in the mesh so traversals
+ * may run concurrently.
+ */
+typedef struct {
+  int   *tab;                 /**< table of keys (0 for an empty slot) */
+  int   siz;                  /**< size of tab (power of 2) */
+  int   shf;                  /**< 32 - log2(siz) */
+  int   nel;                  /**< number of keys */
+  int   loc[_MMG3D_VSETSIZ];  /**< local storage of small sets */
+} _MMG3D_Vset;
+
+/**
+ * \struct _MMG3D_List
+ * \brief Growable list of tetra (Delaunay cavity or volumic ball of a point),
+ * owned by its caller.
+ *
+ * Unlike the fixed size lists, a large cavity or ball is enlarged instead of
+ * being rejected. The memory is counted in mesh->memCur.
+ */
+typedef struct {
+  int   *item;                /**< items of the list */
+  int   max;                  /**< capacity of item */
+} _MMG3D_List;
+
+/** Maximal number of tetra in a leaf of the locator tree */
+#define _MMG3D_LOCLEAF   8
+/** Maximal number of steps of a locator walk */
+#define _MMG3D_LOCWALK   8
+/** Tolerance on the barycentric coordinates of a located point */
+#define _MMG3D_LOCEPS    1.e-10
+
+/**
+ * \struct _MMG3D_LocNode
+ * \brief Node of the bounding box tree of the locator.
+ */
+typedef struct {
+  double  min[3],max[3];      /**< bounding box of the node */
+  int     start;              /**< first child (internal node) or first tetra in perm (leaf) */
+  int     cnt;                /**< number of tetra of a leaf, 0 for an internal node */
+} _MMG3D_LocNode;
+
+/**
+ * \struct MMG3D_Locator
+ * \brief Point locator built on a copy of a tetrahedral mesh.
+ *
+ * The locator does not depend on the mesh it is built from, so that the
+ * mesh may be remeshed while the locator is in use. It is read-only once
+ * built and may be queried by several threads. Its memory is not counted in
+ * mesh->memCur.
+ */
+struct MMG3D_Locator {
+  int             np,ne;      /**< number of points and tetra of the copy */
+  int             nnode;      /**< number of nodes of the tree */
+  double          tol;        /**< tolerance on the bounding boxes */
+  double          *c;         /**< point coordinates (3 per point, 1-based) */
+  int             *v;         /**< tetra vertices (4 per tetra, 1-based, 0 if unused) */
+  int             *adj;       /**< neighbour through each face (0 on the boundary) */
+  int             *perm;      /**< tetra sorted by leaf */
+  _MMG3D_LocNode  *node;      /**< bounding box tree */
+};
+
 /* bucket */
-_MMG5_pBucket _MMG5_newBucket(MMG5_pMesh ,int );
-int     _MMG5_addBucket(MMG5_pMesh ,_MMG5_pBucket ,int );
+_MMG5_pBucket _MMG5_newBucket(MMG5_pMesh ,MMG5_pSol ,int );
+void    _MMG5_freeBucket(MMG5_pMesh ,_MMG5_pBucket );
+int     _MMG5_addBucket(MMG5_pMesh ,MMG5_pSol ,_MMG5_pBucket ,int );
 int     _MMG5_delBucket(MMG5_pMesh ,_MMG5_pBucket ,int );
 int     _MMG5_buckin_iso(MMG5_pMesh mesh,MMG5_pSol sol,_MMG5_pBucket bucket,int ip);
 int     _MMG5_buckin_ani(MMG5_pMesh mesh,MMG5_pSol sol,_MMG5_pBucket bucket,int ip);
@@ -218,6 +324,7 @@ int  _MMG3D_newElt(MMG5_pMesh mesh);
 void _MMG3D_delElt(MMG5_pMesh mesh,int iel);
 void _MMG3D_delPt(MMG5_pMesh mesh,int ip);
 int  _MMG5_zaldy(MMG5_pMesh mesh);
+int  _MMG3D_reallocField(MMG5_pMesh mesh);
 void _MMG5_freeXTets(MMG5_pMesh mesh);
 char _MMG5_chkedg(MMG5_pMesh mesh,MMG5_pTria pt,char ori);
 int  _MMG5_chkNumberOfTri(MMG5_pMesh mesh);
@@ -232,11 +339,24 @@ extern int  _MMG5_BezierEdge(MMG5_pMesh mesh,int ip0, int ip1, double b0[3], dou
 extern int  _MMG5_BezierRidge(MMG5_pMesh mesh,int ip0, int ip1, double s, double *o, double *no1, double *no2, double *to);
 extern int  _MMG5_BezierNom(MMG5_pMesh mesh,int ip0,int ip1,double s,double *o,double *no,double *to);
 extern int  _MMG5_norface(MMG5_pMesh mesh ,int k, int iface, double v[3]);
-int  _MMG5_boulernm (MMG5_pMesh mesh, int start, int ip, int *ng, int *nr);
+int  _MMG5_boulernm (MMG5_pMesh mesh,_MMG3D_List *lst,int start,int ip,int *ng,int *nr);
 int  _MMG5_boulenm(MMG5_pMesh mesh, int start, int ip, int iface, double n[3],double t[3]);
-int  _MMG5_boulevolp(MMG5_pMesh mesh, int start, int ip, int * list);
-int  _MMG5_boulesurfvolp(MMG5_pMesh mesh,int start,int ip,int iface,int *listv,
-                         int *ilistv,int *lists,int*ilists, int isnm);
+int  _MMG5_boulevolp(MMG5_pMesh mesh, int start, int ip, _MMG3D_List *lst);
+void _MMG3D_initVset(_MMG3D_Vset *vset);
+int  _MMG3D_addVset(_MMG3D_Vset *vset,int k);
+void _MMG3D_freeVset(_MMG3D_Vset *vset);
+int  _MMG3D_initList(MMG5_pMesh mesh,_MMG3D_List *lst,int max);
+int  _MMG3D_growList(MMG5_pMesh mesh,_MMG3D_List *lst,int n);
+void _MMG3D_freeList(MMG5_pMesh mesh,_MMG3D_List *lst);
+int  _MMG3D_ballIncid(MMG5_pMesh mesh,int **adr,int **list);
+void _MMG3D_freeBallIncid(MMG5_pMesh mesh,int **adr,int **list);
+void _MMG3D_setPointStart(MMG5_pMesh mesh);
+int  _MMG3D_ptStart(MMG5_pMesh mesh,int ip,char *iloc);
+int  _MMG3D_surfIncid(MMG5_pMesh mesh,int **adr,int **list,char **loc);
+void _MMG3D_freeSurfIncid(MMG5_pMesh mesh,int **adr,int **list,char **loc);
+int  _MMG5_boulesurfvolp(MMG5_pMesh mesh,int start,int ip,int iface,
+                         _MMG3D_List *lstv,int *ilistv,int *lists,int*ilists,
+                         int isnm);
 int  _MMG5_bouletrid(MMG5_pMesh,int,int,int,int *,int *,int *,int *,int *,int *);
 int  _MMG5_startedgsurfball(MMG5_pMesh mesh,int nump,int numq,int *list,int ilist);
 int  _MMG5_srcbdy(MMG5_pMesh mesh,int start,int ia);
@@ -247,19 +367,18 @@ char _MMG5_coquilTravel(MMG5_pMesh, int, int, int*, int*, char*, int*);
 void _MMG5_openCoquilTravel(MMG5_pMesh, int, int, int*, int*, char*, int*);
 extern int  _MMG5_settag(MMG5_pMesh,int,int,int,int);
 int  _MMG5_setNmTag(MMG5_pMesh mesh, _MMG5_Hash *hash);
-int  _MMG5_chkcol_int(MMG5_pMesh ,MMG5_pSol met,int,char,char,int *,char typchk);
-int  _MMG5_chkcol_bdy(MMG5_pMesh,MMG5_pSol met,int,char,char,int *,char typchk);
+int  _MMG5_chkcol_int(MMG5_pMesh ,MMG5_pSol met,int,char,char,_MMG3D_List *,char typchk);
+int  _MMG5_chkcol_bdy(MMG5_pMesh,MMG5_pSol met,int,char,char,_MMG3D_List *,char typchk);
 int  _MMG5_chkmanicoll(MMG5_pMesh,int,int,int,int,int,char,char);
 int  _MMG5_chkmani(MMG5_pMesh mesh);
 int  _MMG5_colver(MMG5_pMesh,MMG5_pSol,int *,int,char,char);
 int  _MMG3D_analys(MMG5_pMesh mesh);
 int  _MMG3D_hashTria(MMG5_pMesh mesh, _MMG5_Hash*);
-int  _MMG5_hashPop(_MMG5_Hash *hash,int a,int b);
 int  _MMG5_hPop(MMG5_HGeom *hash,int a,int b,int *ref,char *tag);
 int  _MMG5_hTag(MMG5_HGeom *hash,int a,int b,int ref,char tag);
 int  _MMG5_hGet(MMG5_HGeom *hash,int a,int b,int *ref,char *tag);
 void _MMG5_hEdge(MMG5_pMesh mesh,int a,int b,int ref,char tag);
-int  _MMG5_hNew(MMG5_HGeom *hash,int hsiz,int hmax,int secure);
+int  _MMG5_hNew(MMG5_pMesh mesh,MMG5_HGeom *hash,int hsiz,int secure);
 int  _MMG5_hGeom(MMG5_pMesh mesh);
 int  _MMG5_bdryTria(MMG5_pMesh );
 int  _MMG5_bdryIso(MMG5_pMesh );
@@ -353,8 +472,8 @@ int _MMG5_saveDisp(MMG5_pMesh ,MMG5_pSol );
 
 /* Delaunay functions*/
 int _MMG5_delone(MMG5_pMesh mesh,MMG5_pSol sol,int ip,int *list,int ilist);
-int _MMG5_cavity_iso(MMG5_pMesh mesh,MMG5_pSol sol,int iel,int ip,int *list,int lon);
-int _MMG5_cavity_ani(MMG5_pMesh mesh,MMG5_pSol sol,int iel,int ip,int *list,int lon);
+int _MMG5_cavity_iso(MMG5_pMesh mesh,MMG5_pSol sol,int iel,int ip,_MMG3D_List *cav,int lon);
+int _MMG5_cavity_ani(MMG5_pMesh mesh,MMG5_pSol sol,int iel,int ip,_MMG3D_List *cav,int lon);
 int _MMG5_cenrad_iso(MMG5_pMesh mesh,double *ct,double *c,double *rad);
 int _MMG5_cenrad_ani(MMG5_pMesh mesh,double *ct,double *m,double *c,double *rad);
 
@@ -383,6 +502,9 @@ int    _MMG3D_intmet33_ani(MMG5_pMesh,MMG5_pSol,int,char,int, double);
 int    _MMG5_interp4bar_ani(MMG5_pMesh,MMG5_pSol,int,int,double *);
 int    _MMG5_interp4bar33_ani(MMG5_pMesh,MMG5_pSol,int,int,double *);
 int    _MMG5_interp4bar_iso(MMG5_pMesh,MMG5_pSol,int,int,double *);
+void   _MMG3D_intfield(MMG5_pMesh,int,int,int,double);
+void   _MMG3D_intfield4bar(MMG5_pMesh,int,int,double *);
+void   _MMG3D_movfield(MMG5_pMesh,int*,int,double*);
 int    _MMG3D_defsiz_iso(MMG5_pMesh,MMG5_pSol );
 int    _MMG3D_defsiz_ani(MMG5_pMesh ,MMG5_pSol );
 int    _MMG5_gradsiz_iso(MMG5_pMesh ,MMG5_pSol );
@@ -406,7 +528,7 @@ int    (*_MMG5_movbdyregpt)(MMG5_pMesh, MMG5_pSol, int*, int, int*, int ,int);
 int    (*_MMG5_movbdyrefpt)(MMG5_pMesh, MMG5_pSol, int*, int, int*, int ,int);
 int    (*_MMG5_movbdynompt)(MMG5_pMesh, MMG5_pSol, int*, int, int*, int ,int);
 int    (*_MMG5_movbdyridpt)(MMG5_pMesh, MMG5_pSol, int*, int, int*, int ,int);
-int    (*_MMG5_cavity)(MMG5_pMesh ,MMG5_pSol ,int ,int ,int *,int );
+int    (*_MMG5_cavity)(MMG5_pMesh ,MMG5_pSol ,int ,int ,_MMG3D_List *,int );
 int    (*_MMG5_buckin)(MMG5_pMesh ,MMG5_pSol ,_MMG5_pBucket ,int );
 
 /**
@@ -538,16 +538,20 @@ int _MMG5_swptet(MMG5_pMesh mesh,MMG5_pSol met,double crit,
  *
  * Analyze tetrahedra and move points so as to make mesh more uniform.
  * In delaunay mode, a negative maxitin means that we don't move internal nodes.
+ * The boundary points are reached through the boundary faces and the internal
+ * ones through their incident tetra (see \ref _MMG3D_ptStart).
  *
  */
 int _MMG5_movtet(MMG5_pMesh mesh,MMG5_pSol met,int maxitin) {
   MMG5_pTetra        pt;
   MMG5_pPoint        ppt;
   MMG5_pxTetra       pxt;
+  _MMG3D_List        lstv;
   double        *n;
-  int           i,k,ier,nm,nnm,ns,lists[MMG3D_LMAX+2],listv[MMG3D_LMAX+2],ilists,ilistv,it;
-  int           improve;
+  int           i,k,ip,l,ier,nm,nnm,ns,lists[MMG3D_LMAX+2],ilists,ilistv,it;
+  int           improve,isset;
   unsigned char j,i0,base;
+  char          iloc;
   int           internal,maxit;
 
   if ( maxitin<0 ) {
@@ -566,6 +570,8 @@ int _MMG5_movtet(MMG5_pMesh mesh,MMG5_pSol met,int maxitin) {
   if ( abs(mesh->info.imprim) > 5 || mesh->info.ddebug )
     fprintf(stdout,"  ** OPTIMIZING MESH\n");
 
+  if ( !_MMG3D_initList(mesh,&lstv,MMG3D_LMAX+2) )  return(-1);
+
   base = 1;
   for (k=1; k<=mesh->np; k++)
     mesh->point[k].flag = base;
@@ -590,6 +596,8 @@ int _MMG5_movtet(MMG5_pMesh mesh,MMG5_pSol met,int maxitin) {
           ppt = &mesh->point[pt->v[i0]];
           if ( ppt->flag == base )  continue;
           else if ( MG_SIN(ppt->tag) )  continue;
+          /* internal points are treated below */
+          else if ( !(ppt->tag & MG_BDY) )  continue;
 
           if ( maxit != 1 ) {
             ppt->flag = base;
@@ -600,36 +608,44 @@ int _MMG5_movtet(MMG5_pMesh mesh,MMG5_pSol met,int maxitin) {
             if ( !pt->xt || !(MG_BDY & pxt->ftag[i]) )  continue;
             else if( ppt->tag & MG_NOM ){
               if( mesh->adja[4*(k-1)+1+i] ) continue;
-              ier=_MMG5_boulesurfvolp(mesh,k,i0,i,listv,&ilistv,lists,&ilists,1);
+              ier=_MMG5_boulesurfvolp(mesh,k,i0,i,&lstv,&ilistv,lists,&ilists,1);
               if( !ier )  continue;
               else if ( ier>0 )
-                ier = _MMG5_movbdynompt(mesh,met,listv,ilistv,lists,ilists,improve);
-              else
+                ier = _MMG5_movbdynompt(mesh,met,lstv.item,ilistv,lists,ilists,improve);
+              else {
+                _MMG3D_freeList(mesh,&lstv);
                 return(-1);
+              }
             }
             else if ( ppt->tag & MG_GEO ) {
-              ier=_MMG5_boulesurfvolp(mesh,k,i0,i,listv,&ilistv,lists,&ilists,0);
+              ier=_MMG5_boulesurfvolp(mesh,k,i0,i,&lstv,&ilistv,lists,&ilists,0);
               if ( !ier )  continue;
               else if ( ier>0 )
-                ier = _MMG5_movbdyridpt(mesh,met,listv,ilistv,lists,ilists,improve);
-              else
+                ier = _MMG5_movbdyridpt(mesh,met,lstv.item,ilistv,lists,ilists,improve);
+              else {
+                _MMG3D_freeList(mesh,&lstv);
                 return(-1);
+              }
             }
             else if ( ppt->tag & MG_REF ) {
-              ier=_MMG5_boulesurfvolp(mesh,k,i0,i,listv,&ilistv,lists,&ilists,0);
+              ier=_MMG5_boulesurfvolp(mesh,k,i0,i,&lstv,&ilistv,lists,&ilists,0);
               if ( !ier )
                 continue;
               else if ( ier>0 )
-                ier = _MMG5_movbdyrefpt(mesh,met,listv,ilistv,lists,ilists,improve);
-              else
+                ier = _MMG5_movbdyrefpt(mesh,met,lstv.item,ilistv,lists,ilists,improve);
+              else {
+                _MMG3D_freeList(mesh,&lstv);
                 return(-1);
+              }
             }
             else {
-              ier=_MMG5_boulesurfvolp(mesh,k,i0,i,listv,&ilistv,lists,&ilists,0);
+              ier=_MMG5_boulesurfvolp(mesh,k,i0,i,&lstv,&ilistv,lists,&ilists,0);
               if ( !ier )
                 continue;
-              else if ( ier<0 )
+              else if ( ier<0 ) {
+                _MMG3D_freeList(mesh,&lstv);
                 return(-1);
+              }
 
               n = &(mesh->xpoint[ppt->xp].n1[0]);
               // if ( MG_GET(pxt->ori,i) ) {
@@ -643,15 +659,10 @@ int _MMG5_movtet(MMG5_pMesh mesh,MMG5_pSol met,int maxitin) {
                 if ( !_MMG5_directsurfball(mesh,pt->v[i0],lists,ilists,n) )
                   continue;
               }
-              ier = _MMG5_movbdyregpt(mesh,met,listv,ilistv,lists,ilists,improve);
+              ier = _MMG5_movbdyregpt(mesh,met,lstv.item,ilistv,lists,ilists,improve);
               if ( ier )  ns++;
             }
           }
-          else if ( internal ) {
-            ilistv = _MMG5_boulevolp(mesh,k,i0,listv);
-            if ( !ilistv )  continue;
-            ier = _MMG5_movintpt(mesh,met,listv,ilistv,improve);
-          }
           if ( ier ) {
             nm++;
             if(maxit==1){
@@ -661,6 +672,41 @@ int _MMG5_movtet(MMG5_pMesh mesh,MMG5_pSol met,int maxitin) {
         }
       }
     }
+
+    /* internal points: the ball is reached through the incident tetra */
+    if ( internal ) {
+      isset = 0;
+      for (ip=1; ip<=mesh->np; ip++) {
+        ppt = &mesh->point[ip];
+        if ( !MG_VOK(ppt) || (ppt->tag & MG_BDY) || MG_SIN(ppt->tag) )
+          continue;
+
+        k = _MMG3D_ptStart(mesh,ip,&iloc);
+        if ( !k ) {
+          /* out of date incident tetra: refresh them once per sweep */
+          if ( isset )  continue;
+          if ( mesh->info.ddebug )
+            fprintf(stdout,"%s:%d: Warning: incident tetra of point %d out of"
+                    " date.\n",__FILE__,__LINE__,ip);
+          _MMG3D_setPointStart(mesh);
+          isset = 1;
+          k = _MMG3D_ptStart(mesh,ip,&iloc);
+          if ( !k )  continue;
+        }
+
+        ilistv = _MMG5_boulevolp(mesh,k,iloc,&lstv);
+        if ( !ilistv )  continue;
+
+        /* the point is moved if one of its tetra may be modified */
+        for (l=0; l<ilistv; l++) {
+          pt = &mesh->tetra[lstv.item[l]/4];
+          if ( pt->ref >= 0 && !(pt->tag & MG_REQ) )  break;
+        }
+        if ( l == ilistv )  continue;
+
+        if ( _MMG5_movintpt(mesh,met,lstv.item,ilistv,improve) )  nm++;
+      }
+    }
     nnm += nm;
     if ( mesh->info.ddebug )  fprintf(stdout,"     %8d moved, %d geometry\n",nm,ns);
   }
@@ -669,6 +715,7 @@ int _MMG5_movtet(MMG5_pMesh mesh,MMG5_pSol met,int maxitin) {
   if ( (abs(mesh->info.imprim) > 5 || mesh->info.ddebug) && nnm )
     fprintf(stdout,"     %8d vertices moved, %d iter.\n",nnm,it);
 
+  _MMG3D_freeList(mesh,&lstv);
   return(nnm);
 }
 
@@ -686,11 +733,14 @@ static int _MMG5_coltet(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
   MMG5_pxTetra    pxt;
   MMG5_pPoint     p0,p1;
   MMG5_pPar       par;
+  _MMG3D_List     lst;
   double     ll,ux,uy,uz,hmi2;
-  int        k,nc,list[MMG3D_LMAX+2],ilist,base,nnm,l,isloc;
+  int        k,nc,ilist,base,nnm,l,isloc;
   char       i,j,tag,ip,iq,isnm;
   int        ier;
 
+  if ( !_MMG3D_initList(mesh,&lst,MMG3D_LMAX+2) )  return(-1);
+
   nc = nnm = 0;
 
   /* init point flags */
@@ -763,24 +813,30 @@ static int _MMG5_coltet(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
             if ( mesh->adja[4*(k-1)+1+i] )  continue;
           }
           if ( p0->tag > tag )  continue;
-          ilist = _MMG5_chkcol_bdy(mesh,met,k,i,j,list,typchk);
+          ilist = _MMG5_chkcol_bdy(mesh,met,k,i,j,&lst,typchk);
         }
         /* internal face */
         else {
           isnm = 0;
           if ( p0->tag & MG_BDY )  continue;
-          ilist = _MMG5_chkcol_int(mesh,met,k,i,j,list,typchk);
+          ilist = _MMG5_chkcol_int(mesh,met,k,i,j,&lst,typchk);
         }
 
         if ( ilist > 0 ) {
-          ier = _MMG5_colver(mesh,met,list,ilist,iq,typchk);
-          if ( ier < 0 ) return(-1);
+          ier = _MMG5_colver(mesh,met,lst.item,ilist,iq,typchk);
+          if ( ier < 0 ) {
+            _MMG3D_freeList(mesh,&lst);
+            return(-1);
+          }
           else if ( ier ) {
             _MMG3D_delPt(mesh,ier);
             break;
           }
         }
-        else if (ilist < 0 ) return(-1);
+        else if (ilist < 0 ) {
+          _MMG3D_freeList(mesh,&lst);
+          return(-1);
+        }
       }
       if ( ier ) {
         p1->flag = base;
@@ -793,6 +849,8 @@ static int _MMG5_coltet(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
   if ( nc > 0 && (abs(mesh->info.imprim) > 5 || mesh->info.ddebug) )
     fprintf(stdout,"     %8d vertices removed, %8d non manifold,\n",nc,nnm);
 
+  _MMG3D_freeList(mesh,&lst);
+
   return(nc);
 }
 
@@ -817,7 +875,7 @@ _MMG5_anatetv(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
   char     i,j,ia;
 
   /** 1. analysis */
-  if ( !_MMG5_hashNew(mesh,&hash,mesh->np,7*mesh->np) )  return(-1);
+  if ( !_MMG5_hashNew(mesh,&hash,mesh->np) )  return(-1);
   memlack = ns = nap = 0;
   hma2 = _MMG5_LLONG*_MMG5_LLONG*mesh->info.hmax*mesh->info.hmax;
 
@@ -1040,7 +1098,7 @@ _MMG5_anatets(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
   static double uv[3][2] = { {0.5,0.5}, {0.,0.5}, {0.5,0.} };
 
   /** 1. analysis of boundary elements */
-  if ( !_MMG5_hashNew(mesh,&hash,mesh->np,7*mesh->np) ) return(-1);
+  if ( !_MMG5_hashNew(mesh,&hash,mesh->np) ) return(-1);
   ns = nap = 0;
   npinit=mesh->np;
   for (k=1; k<=mesh->ne; k++) {
@@ -51,13 +51,15 @@ char  ddb;
  * \param mesh pointer toward the mesh structure.
  * \param met pointer toward the metric structure.
  * \param bucket pointer toward the bucket structure.
- * \param ne number of elements.
+ * \param ne number of tetrahedra to process.
  * \param ifilt pointer to store the number of vertices filtered by the bucket.
  * \param ns pointer to store the number of vertices insertions.
  * \param nc pointer to store the number of collapse.
  * \param warn pointer to store a flag that warn the user in case of
  * reallocation difficulty.
  * \param it iteration index.
+ * \param perm tetrahedra to process, in processing order.
+ * \param cav list used to store the Delaunay cavities and the collapse balls.
  * \return -1 if fail and we don't save the mesh, 0 if fail but we try to save
  * the mesh, 1 otherwise.
  *
@@ -67,7 +69,8 @@ char  ddb;
  */
 static inline int
 _MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
-                 int* ifilt,int* ns,int* nc,int* warn,int it) {
+                 int* ifilt,int* ns,int* nc,int* warn,int it,int *perm,
+                 _MMG3D_List *cav) {
   MMG5_pTetra     pt;
   MMG5_pxTetra    pxt;
   MMG5_Tria       ptt;
@@ -81,9 +84,10 @@ _MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
   int        imin,iq;
   int        ii;
   double     lmaxtet,lmintet;
-  int        imaxtet,imintet;
+  int        imaxtet,imintet,l;
 
-  for (k=1; k<=ne; k++) {
+  for (l=0; l<ne; l++) {
+    k  = perm[l];
     pt = &mesh->tetra[k];
     if ( !MG_EOK(pt)  || (pt->tag & MG_REQ) )   continue;
 
@@ -287,7 +291,7 @@ _MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
           goto collapse;
         }
         else {
-          _MMG5_addBucket(mesh,bucket,ip);
+          _MMG5_addBucket(mesh,met,bucket,ip);
           (*ns)++;
           continue;
         }
@@ -330,15 +334,20 @@ _MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
           (*ifilt)++;
           goto collapse;
         } else {
-          lon = _MMG5_cavity(mesh,met,k,ip,list,ilist/2);
+          if ( !_MMG3D_growList(mesh,cav,ilist/2) ) {
+            _MMG3D_delPt(mesh,ip);
+            return(0);
+          }
+          memcpy(cav->item,list,(ilist/2)*sizeof(int));
+          lon = _MMG5_cavity(mesh,met,k,ip,cav,ilist/2);
           if ( lon < 1 ) {
             // MMG_npd++; // decomment to debug
             _MMG3D_delPt(mesh,ip);
             goto collapse;
           } else {
-            ret = _MMG5_delone(mesh,met,ip,list,lon);
+            ret = _MMG5_delone(mesh,met,ip,cav->item,lon);
             if ( ret > 0 ) {
-              _MMG5_addBucket(mesh,bucket,ip);
+              _MMG5_addBucket(mesh,met,bucket,ip);
               (*ns)++;
               continue;
             }
@@ -381,9 +390,9 @@ _MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
         tag |= MG_BDY;
         if ( p0->tag > tag )   continue;
         if ( ( tag & MG_NOM ) && (mesh->adja[4*(k-1)+1+i]) ) continue;
-        ilist = _MMG5_chkcol_bdy(mesh,met,k,i,j,list,2);
+        ilist = _MMG5_chkcol_bdy(mesh,met,k,i,j,cav,2);
         if ( ilist > 0 ) {
-          ier = _MMG5_colver(mesh,met,list,ilist,i2,2);
+          ier = _MMG5_colver(mesh,met,cav->item,ilist,i2,2);
 
           if ( ier < 0 ) return(-1);
           else if(ier) {
@@ -397,9 +406,9 @@ _MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
       /* Case of an internal face */
       else {
         if ( p0->tag & MG_BDY )  continue;
-        ilist = _MMG5_chkcol_int(mesh,met,k,i,j,list,2);
+        ilist = _MMG5_chkcol_int(mesh,met,k,i,j,cav,2);
         if ( ilist > 0 ) {
-          ier = _MMG5_colver(mesh,met,list,ilist,i2,2);
+          ier = _MMG5_colver(mesh,met,cav->item,ilist,i2,2);
           if ( ilist < 0 ) continue;
           if ( ier < 0 ) return(-1);
           else if(ier) {
@@ -535,7 +544,7 @@ _MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
             goto collapse2;//continue;
           } else {
             (*ns)++;
-            //_MMG5_addBucket(mesh,bucket,ip);
+            //_MMG5_addBucket(mesh,met,bucket,ip);
 
             ppt = &mesh->point[ip];
 
@@ -607,7 +616,7 @@ _MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
             goto collapse2;
           }
           else {
-            _MMG5_addBucket(mesh,bucket,ip);
+            _MMG5_addBucket(mesh,met,bucket,ip);
             (*ns)++;
             break;//imax continue;
           }
@@ -647,15 +656,20 @@ _MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
             (*ifilt)++;
             goto collapse2;
           } else {
-            lon = _MMG5_cavity(mesh,met,k,ip,list,ilist/2);
+            if ( !_MMG3D_growList(mesh,cav,ilist/2) ) {
+              _MMG3D_delPt(mesh,ip);
+              return(0);
+            }
+            memcpy(cav->item,list,(ilist/2)*sizeof(int));
+            lon = _MMG5_cavity(mesh,met,k,ip,cav,ilist/2);
             if ( lon < 1 ) {
               // MMG_npd++; // decomment to debug
               _MMG3D_delPt(mesh,ip);
               goto collapse2;
             } else {
-              ret = _MMG5_delone(mesh,met,ip,list,lon);
+              ret = _MMG5_delone(mesh,met,ip,cav->item,lon);
               if ( ret > 0 ) {
-                _MMG5_addBucket(mesh,bucket,ip);
+                _MMG5_addBucket(mesh,met,bucket,ip);
                 (*ns)++;
                 break;//imax continue;
               }
@@ -698,9 +712,9 @@ _MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
         tag |= MG_BDY;
         if ( p0->tag > tag )   continue;
         if ( ( tag & MG_NOM ) && (mesh->adja[4*(k-1)+1+i]) ) continue;
-        ilist = _MMG5_chkcol_bdy(mesh,met,k,i,j,list,2);
+        ilist = _MMG5_chkcol_bdy(mesh,met,k,i,j,cav,2);
         if ( ilist > 0 ) {
-          ier = _MMG5_colver(mesh,met,list,ilist,i2,2);
+          ier = _MMG5_colver(mesh,met,cav->item,ilist,i2,2);
           if ( ier < 0 ) return(-1);
           else if(ier) {
             _MMG3D_delPt(mesh,ier);
@@ -713,9 +727,9 @@ _MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
       /* Case of an internal face */
       else {
         if ( p0->tag & MG_BDY )  continue;
-        ilist = _MMG5_chkcol_int(mesh,met,k,i,j,list,2);
+        ilist = _MMG5_chkcol_int(mesh,met,k,i,j,cav,2);
         if ( ilist > 0 ) {
-          ier = _MMG5_colver(mesh,met,list,ilist,i2,2);
+          ier = _MMG5_colver(mesh,met,cav->item,ilist,i2,2);
           if ( ilist < 0 ) continue;
           if ( ier < 0 ) return(-1);
           else if(ier) {
@@ -733,6 +747,52 @@ _MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
   return(1);
 }
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param perm array of size at least mesh->ne, filled with the tetrahedra to
+ * process.
+ * \return the number of tetrahedra stored in \a perm, -1 if fail.
+ *
+ * Order the valid tetrahedra of the mesh following a biased randomized
+ * insertion order along a Hilbert curve of their barycenters: the points
+ * created by the \a adpsplcol loop are then inserted in a few spread rounds
+ * followed by spatially coherent sweeps, which keeps the Delaunay cavities
+ * small and the walk in the mesh memory local.
+ *
+ */
+static int
+_MMG5_brioTetra(MMG5_pMesh mesh,int *perm) {
+  MMG5_pTetra pt;
+  double      *c;
+  int         k,i,j,n,ier;
+
+  n = 0;
+  for (k=1; k<=mesh->ne; k++) {
+    pt = &mesh->tetra[k];
+    if ( !MG_EOK(pt) || (pt->tag & MG_REQ) )  continue;
+    perm[n++] = k;
+  }
+  if ( n < 2 )  return(n);
+
+  _MMG5_ADD_MEM(mesh,3*n*sizeof(double),"barycenters",return(-1));
+  _MMG5_SAFE_MALLOC(c,3*n,double);
+
+#pragma omp parallel for private(pt,i,j)
+  for (k=0; k<n; k++) {
+    pt = &mesh->tetra[perm[k]];
+    for (j=0; j<3; j++) {
+      c[3*k+j] = 0.;
+      for (i=0; i<4; i++)
+        c[3*k+j] += 0.25*mesh->point[pt->v[i]].c[j];
+    }
+  }
+
+  ier = _MMG5_brioSort(mesh,n,3,c,perm);
+
+  _MMG5_DEL_MEM(mesh,c,3*n*sizeof(double));
+  return(ier ? n : -1);
+}
+
 /**
  * \param mesh pointer toward the mesh structure.
  * \param met pointer toward the metric structure.
@@ -747,7 +807,8 @@ _MMG5_boucle_for(MMG5_pMesh mesh, MMG5_pSol met,_MMG5_pBucket bucket,int ne,
  */
 static int
 _MMG5_adpsplcol(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket, int* warn) {
-  int        nfilt,ifilt,ne,ier;
+  _MMG3D_List cav;
+  int        nfilt,ifilt,ne,ier,*perm,nperm;
   int        ns,nc,it,nnc,nns,nnf,nnm,maxit,nf,nm;
   double     maxgap;
 
@@ -762,8 +823,21 @@ _MMG5_adpsplcol(MMG5_pMesh mesh,MMG5_pSol met,_MMG5_pBucket bucket, int* warn) {
       ns = nc = 0;
       nf = nm = 0;
       ifilt = 0;
-      ne = mesh->ne;
-      ier = _MMG5_boucle_for(mesh,met,bucket,ne,&ifilt,&ns,&nc,warn,it);
+      nperm = mesh->ne+1;
+      _MMG5_ADD_MEM(mesh,nperm*sizeof(int),"tetra order",return(-1));
+      _MMG5_SAFE_MALLOC(perm,nperm,int);
+      ne = _MMG5_brioTetra(mesh,perm);
+      if ( ne < 0 ) {
+        _MMG5_DEL_MEM(mesh,perm,nperm*sizeof(int));
+        return(-1);
+      }
+      if ( !_MMG3D_initList(mesh,&cav,MMG3D_LMAX+2) ) {
+        _MMG5_DEL_MEM(mesh,perm,nperm*sizeof(int));
+        return(-1);
+      }
+      ier = _MMG5_boucle_for(mesh,met,bucket,ne,&ifilt,&ns,&nc,warn,it,perm,&cav);
+      _MMG3D_freeList(mesh,&cav);
+      _MMG5_DEL_MEM(mesh,perm,nperm*sizeof(int));
       if(ier<0) exit(EXIT_FAILURE);
       else if(!ier) return(-1);
     } /* End conditional loop on mesh->info.noinsert */
@@ -998,6 +1072,9 @@ int _MMG5_mmg3d1_delone(MMG5_pMesh mesh,MMG5_pSol met) {
     return(0);
   }
 
+  /* cache of the Bezier patches of the boundary faces (optional) */
+  _MMG5_bezierCacheNew(mesh,mesh->xt);
+
   /**--- stage 1: geometric mesh */
   if ( abs(mesh->info.imprim) > 4 || mesh->info.ddebug )
     fprintf(stdout,"  ** GEOMETRIC MESH\n");
@@ -1044,7 +1121,7 @@ int _MMG5_mmg3d1_delone(MMG5_pMesh mesh,MMG5_pSol met) {
     return(0);
 
   /* CEC : create filter */
-  bucket = _MMG5_newBucket(mesh,mesh->info.bucket); //M_MAX(mesh->mesh->info.bucksiz,BUCKSIZ));
+  bucket = _MMG5_newBucket(mesh,met,mesh->info.bucket); //M_MAX(mesh->mesh->info.bucksiz,BUCKSIZ));
   if ( !bucket )  return(0);
 
   if ( !_MMG5_adptet_delone(mesh,met,bucket) ) {
@@ -1068,9 +1145,9 @@ int _MMG5_mmg3d1_delone(MMG5_pMesh mesh,MMG5_pSol met) {
   }
 
   /*free bucket*/
-  _MMG5_DEL_MEM(mesh,bucket->head,(bucket->size*bucket->size*bucket->size+1)*sizeof(int));
-  _MMG5_DEL_MEM(mesh,bucket->link,(mesh->npmax+1)*sizeof(int));
-  _MMG5_DEL_MEM(mesh,bucket,sizeof(_MMG5_Bucket));
+  _MMG5_freeBucket(mesh,bucket);
+
+  _MMG5_bezierCacheFree(mesh);
 
   return(1);
 }
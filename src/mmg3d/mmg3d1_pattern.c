@@ -267,11 +267,14 @@ static int _MMG5_adpcol(MMG5_pMesh mesh,MMG5_pSol met) {
   MMG5_pTetra     pt;
   MMG5_pxTetra    pxt;
   MMG5_pPoint     p0,p1;
+  _MMG3D_List     lst;
   double     len,lmin;
-  int        k,ip,iq,list[MMG3D_LMAX+2],ilist,nc;
+  int        k,ip,iq,ilist,nc;
   char       imin,tag,j,i,i1,i2,ifa0,ifa1;
   int        ier;
 
+  if ( !_MMG3D_initList(mesh,&lst,MMG3D_LMAX+2) )  return(-1);
+
   nc = 0;
   for (k=1; k<=mesh->ne; k++) {
     pt = &mesh->tetra[k];
@@ -319,24 +322,29 @@ static int _MMG5_adpcol(MMG5_pMesh mesh,MMG5_pSol met) {
       tag |= MG_BDY;
       if ( p0->tag > tag )   continue;
       if ( ( tag & MG_NOM ) && (mesh->adja[4*(k-1)+1+i]) ) continue;
-      ilist = _MMG5_chkcol_bdy(mesh,met,k,i,j,list,2);
+      ilist = _MMG5_chkcol_bdy(mesh,met,k,i,j,&lst,2);
     }
     /* Case of an internal face */
     else {
       if ( p0->tag & MG_BDY )  continue;
-      ilist = _MMG5_chkcol_int(mesh,met,k,i,j,list,2);
+      ilist = _MMG5_chkcol_int(mesh,met,k,i,j,&lst,2);
     }
     if ( ilist > 0 ) {
-      ier = _MMG5_colver(mesh,met,list,ilist,i2,2);
-      if ( ier < 0 )  return(-1);
+      ier = _MMG5_colver(mesh,met,lst.item,ilist,i2,2);
+      if ( ier < 0 )  break;
       else if ( ier ) {
         _MMG3D_delPt(mesh,ier);
         nc++;
       }
     }
-    else if (ilist < 0 )  return(-1);
+    else if (ilist < 0 )  {
+      ier = -1;
+      break;
+    }
   }
+  _MMG3D_freeList(mesh,&lst);
 
+  if ( ier < 0 )  return(-1);
   return(nc);
 }
 
@@ -530,6 +538,9 @@ int _MMG5_mmg3d1_pattern(MMG5_pMesh mesh,MMG5_pSol met) {
     return(0);
   }
 
+  /* cache of the Bezier patches of the boundary faces (optional) */
+  _MMG5_bezierCacheNew(mesh,mesh->xt);
+
   /**--- stage 1: geometric mesh */
   if ( abs(mesh->info.imprim) > 4 || mesh->info.ddebug )
     fprintf(stdout,"  ** GEOMETRIC MESH\n");
@@ -594,5 +605,7 @@ int _MMG5_mmg3d1_pattern(MMG5_pMesh mesh,MMG5_pSol met) {
     return(0);
   }
 
+  _MMG5_bezierCacheFree(mesh);
+
   return(1);
 }
@@ -296,12 +296,60 @@ _MMG5_ismaniball(MMG5_pMesh mesh,MMG5_pSol sol,int k,int indp) {
   return(1);
 }
 
+/** Extract the band of tetras that may be snapped or cut by the 0 level set
+    (a vertex value close to 0 or values of both signs), in increasing order.
+    Tetra flags are reset on the way. */
+static int _MMG3D_bandls(MMG5_pMesh mesh,MMG5_pSol sol,int **band,int *nband) {
+  MMG5_pTetra   pt;
+  double        v,vmin,vmax;
+  int           k,nb;
+  char          *inband,i,isnear;
+
+  _MMG5_ADD_MEM(mesh,(mesh->ne+1)*sizeof(char),"level-set band",return(0));
+  _MMG5_SAFE_CALLOC(inband,mesh->ne+1,char);
+
+#pragma omp parallel for schedule(static) private(pt,v,vmin,vmax,i,isnear)
+  for (k=1; k<=mesh->ne; k++) {
+    pt = &mesh->tetra[k];
+    if ( !MG_EOK(pt) )  continue;
+    if ( !(pt->tag & MG_REQ) )  pt->flag = 0;
+
+    vmin   = vmax = sol->m[pt->v[0]];
+    isnear = 0;
+    for (i=0; i<4; i++) {
+      v      = sol->m[pt->v[i]];
+      vmin   = MG_MIN(vmin,v);
+      vmax   = MG_MAX(vmax,v);
+      isnear = isnear || ( fabs(v) < _MMG5_EPS );
+    }
+    inband[k] = isnear || ( vmin < 0.0 && vmax > 0.0 );
+  }
+
+  nb = 0;
+  for (k=1; k<=mesh->ne; k++)
+    if ( inband[k] )  nb++;
+
+  _MMG5_ADD_MEM(mesh,(nb+1)*sizeof(int),"level-set band",
+                _MMG5_DEL_MEM(mesh,inband,(mesh->ne+1)*sizeof(char));
+                return(0));
+  _MMG5_SAFE_MALLOC(*band,nb+1,int);
+
+  nb = 0;
+  for (k=1; k<=mesh->ne; k++)
+    if ( inband[k] )  (*band)[nb++] = k;
+  *nband = nb;
+
+  _MMG5_DEL_MEM(mesh,inband,(mesh->ne+1)*sizeof(char));
+  return(1);
+}
+
 /** Snap values of the level set function very close to 0 to exactly 0,
     and prevent nonmanifold patterns from being generated */
-static int _MMG5_snpval_ls(MMG5_pMesh mesh,MMG5_pSol sol,double *tmp) {
+static int _MMG5_snpval_ls(MMG5_pMesh mesh,MMG5_pSol sol,double *tmp,
+                           int *band,int nband) {
   MMG5_pTetra   pt;
   MMG5_pPoint   p0;
-  int      k,nc,ns,ip;
+  int      k,l,nc,ns,ip;
   char     i;
 
   /* create tetra adjacency */
@@ -310,14 +358,12 @@ static int _MMG5_snpval_ls(MMG5_pMesh mesh,MMG5_pSol sol,double *tmp) {
     return(0);
   }
 
-  /* Reset point flags */
-  for (k=1; k<=mesh->np; k++)
-    mesh->point[k].flag = 0;
-
   /* Snap values of sol that are close to 0 to 0 exactly */
   ns = nc = 0;
+#pragma omp parallel for schedule(static) private(p0) reduction(+:ns)
   for (k=1; k<=mesh->np; k++) {
     p0 = &mesh->point[k];
+    p0->flag = 0;
     if ( !MG_VOK(p0) ) continue;
     if ( fabs(sol->m[k]) < _MMG5_EPS ) {
       if ( mesh->info.ddebug )  fprintf(stdout,"  Snapping value %d ; previous value : %E\n",k,fabs(sol->m[k]));
@@ -328,8 +374,10 @@ static int _MMG5_snpval_ls(MMG5_pMesh mesh,MMG5_pSol sol,double *tmp) {
     }
   }
 
-  /* Check snapping did not lead to a nonmanifold situation */
-  for (k=1; k<=mesh->ne; k++) {
+  /* Check snapping did not lead to a nonmanifold situation: snapped points
+   * only belong to tetras of the band */
+  for (l=0; l<nband; l++) {
+    k  = band[l];
     pt = &mesh->tetra[k];
     if ( !MG_EOK(pt) ) continue;
     for (i=0; i<4; i++) {
@@ -355,12 +403,13 @@ static int _MMG5_snpval_ls(MMG5_pMesh mesh,MMG5_pSol sol,double *tmp) {
 
 /** Proceed to discretization of the implicit function carried by sol into mesh, once values
     of sol have been snapped/checked */
-static int _MMG5_cuttet_ls(MMG5_pMesh mesh, MMG5_pSol sol/*,double *tmp*/){
+static int _MMG5_cuttet_ls(MMG5_pMesh mesh, MMG5_pSol sol/*,double *tmp*/,
+                           int *band,int nband){
   MMG5_pTetra   pt;
   MMG5_pPoint   p0,p1;
   _MMG5_Hash     hash;
   double   c[3],v0,v1,s;
-  int      vx[6],nb,k,ip0,ip1,np,ns,ne;
+  int      *vx,nb,k,l,ip0,ip1,np,ns;
   char     ia;
   /* Commented because unused */
   /*MMG5_pPoint  p[4];*/
@@ -369,12 +418,14 @@ static int _MMG5_cuttet_ls(MMG5_pMesh mesh, MMG5_pSol sol/*,double *tmp*/){
   /*char    i,ier;*/
 
   /* reset point flags and h */
+#pragma omp parallel for schedule(static)
   for (k=1; k<=mesh->np; k++)
     mesh->point[k].flag = 0;
 
-  /* compute the number nb of intersection points on edges */
+  /* compute the number nb of intersection points on edges of the band */
   nb = 0;
-  for (k=1; k<=mesh->ne; k++) {
+  for (l=0; l<nband; l++) {
+    k  = band[l];
     pt = &mesh->tetra[k];
     for (ia=0; ia<6; ia++) {
       ip0 = pt->v[_MMG5_iare[ia][0]];
@@ -448,8 +499,9 @@ static int _MMG5_cuttet_ls(MMG5_pMesh mesh, MMG5_pSol sol/*,double *tmp*/){
   /* } */
 
   /* Create intersection points at 0 isovalue and set flags to tetras */
-  if ( !_MMG5_hashNew(mesh,&hash,nb,7*nb) ) return(0);
-  for (k=1; k<=mesh->ne; k++) {
+  if ( !_MMG5_hashNew(mesh,&hash,nb) ) return(0);
+  for (l=0; l<nband; l++) {
+    k  = band[l];
     pt = &mesh->tetra[k];
     if ( !MG_EOK(pt) )  continue;
 
@@ -504,41 +556,56 @@ static int _MMG5_cuttet_ls(MMG5_pMesh mesh, MMG5_pSol sol/*,double *tmp*/){
                             ,c,0);
       }
       sol->m[np] = 0.0;
+      _MMG3D_intfield(mesh,ip0,ip1,np,s);
       _MMG5_hashEdge(mesh,&hash,ip0,ip1,np);
     }
   }
 
-  /* Proceed to splitting, according to flags to tets */
-  ne = mesh->ne;
-  ns = 0;
-  for (k=1; k<=ne; k++) {
+  /* Proceed to splitting, according to flags to tets: the split patterns of
+   * the band are computed in parallel (read only access to the hash table),
+   * new elements are then created serially. */
+  _MMG5_ADD_MEM(mesh,6*(nband+1)*sizeof(int),"split patterns",
+                _MMG5_DEL_MEM(mesh,hash.item,(hash.max+1)*sizeof(_MMG5_hedge));
+                return(0));
+  _MMG5_SAFE_CALLOC(vx,6*(nband+1),int);
+
+#pragma omp parallel for schedule(static) private(k,pt,ia)
+  for (l=0; l<nband; l++) {
+    k  = band[l];
     pt = &mesh->tetra[k];
     if ( !MG_EOK(pt) || (pt->tag & MG_REQ) )  continue;
     pt->flag = 0;
-    memset(vx,0,6*sizeof(int));
     for (ia=0; ia<6; ia++) {
-      vx[ia] = _MMG5_hashGet(&hash,pt->v[_MMG5_iare[ia][0]],pt->v[_MMG5_iare[ia][1]]);
-      if ( vx[ia] )  MG_SET(pt->flag,ia);
+      vx[6*l+ia] = _MMG5_hashGet(&hash,pt->v[_MMG5_iare[ia][0]],
+                                 pt->v[_MMG5_iare[ia][1]]);
+      if ( vx[6*l+ia] )  MG_SET(pt->flag,ia);
     }
+  }
+
+  ns = 0;
+  for (l=0; l<nband; l++) {
+    k  = band[l];
+    pt = &mesh->tetra[k];
+    if ( !MG_EOK(pt) || (pt->tag & MG_REQ) )  continue;
     switch (pt->flag) {
     case 1: case 2: case 4: case 8: case 16: case 32: /* 1 edge split */
-      _MMG5_split1(mesh,sol,k,vx,1);
+      _MMG5_split1(mesh,sol,k,&vx[6*l],1);
       ns++;
       break;
 
     case 48: case 24: case 40: case 6: case 34: case 36:
     case 20: case 5: case 17: case 9: case 3: case 10: /* 2 edges (same face) split */
-      _MMG5_split2sf(mesh,sol,k,vx,1);
+      _MMG5_split2sf(mesh,sol,k,&vx[6*l],1);
       ns++;
       break;
 
     case 7: case 25: case 42: case 52: /* 3 edges on conic configuration splitted */
-      _MMG5_split3cone(mesh,sol,k,vx,1);
+      _MMG5_split3cone(mesh,sol,k,&vx[6*l],1);
       ns++;
       break;
 
     case 30: case 45: case 51:
-      _MMG5_split4op(mesh,sol,k,vx,1);
+      _MMG5_split4op(mesh,sol,k,&vx[6*l],1);
       ns++;
       break;
 
@@ -550,6 +617,7 @@ static int _MMG5_cuttet_ls(MMG5_pMesh mesh, MMG5_pSol sol/*,double *tmp*/){
   if ( (mesh->info.ddebug || abs(mesh->info.imprim) > 5) && ns > 0 )
     fprintf(stdout,"     %7d splitted\n",ns);
 
+  _MMG5_DEL_MEM(mesh,vx,6*(nband+1)*sizeof(int));
   _MMG5_DEL_MEM(mesh,hash.item,(hash.max+1)*sizeof(_MMG5_hedge));
   return(ns);
 }
@@ -561,6 +629,7 @@ static int _MMG5_setref_ls(MMG5_pMesh mesh, MMG5_pSol sol) {
   int      k,ip;
   char     nmns,npls,nz,i;
 
+#pragma omp parallel for schedule(static) private(pt,ip,nmns,npls,nz,i)
   for (k=1; k<=mesh->ne; k++) {
     pt = &mesh->tetra[k];
     nmns = npls = nz = 0;
@@ -1329,6 +1398,7 @@ int _MMG5_chkmanicoll(MMG5_pMesh mesh,int k,int iface,int iedg,int ndepmin,int n
 /** Create implicit surface in mesh */
 int _MMG5_mmg3d2(MMG5_pMesh mesh,MMG5_pSol sol) {
   double   *tmp;
+  int      *band,nband;
 
   if ( abs(mesh->info.imprim) > 3 )
     fprintf(stdout,"  ** ISOSURFACE EXTRACTION\n");
@@ -1338,44 +1408,61 @@ int _MMG5_mmg3d2(MMG5_pMesh mesh,MMG5_pSol sol) {
                 exit(EXIT_FAILURE));
   _MMG5_SAFE_CALLOC(tmp,mesh->npmax+1,double);
 
+  /* Band of tetras crossed by the 0 level set (before snapping, it contains
+   * the tetras of the snapped points and those cut after snapping) */
+  if ( !_MMG3D_bandls(mesh,sol,&band,&nband) ) {
+    fprintf(stdout,"  ## Problem with implicit function. Exit program.\n");
+    _MMG5_DEL_MEM(mesh,tmp,(mesh->npmax+1)*sizeof(double));
+    return(0);
+  }
+
   /* Snap values of level set function if need be, then discretize it */
-  if ( !_MMG5_snpval_ls(mesh,sol,tmp) ) {
+  if ( !_MMG5_snpval_ls(mesh,sol,tmp,band,nband) ) {
     fprintf(stdout,"  ## Problem with implicit function. Exit program.\n");
+    _MMG5_DEL_MEM(mesh,tmp,(mesh->npmax+1)*sizeof(double));
+    _MMG5_DEL_MEM(mesh,band,(nband+1)*sizeof(int));
     return(0);
   }
   _MMG5_DEL_MEM(mesh,tmp,(mesh->npmax+1)*sizeof(double));
 
   if ( !MMG3D_hashTetra(mesh,1) ) {
     fprintf(stdout,"  ## Hashing problem. Exit program.\n");
+    _MMG5_DEL_MEM(mesh,band,(nband+1)*sizeof(int));
     return(0);
   }
   if ( !_MMG5_chkNumberOfTri(mesh) ) {
     if ( !_MMG5_bdryTria(mesh) ) {
       fprintf(stdout,"  ## Boundary problem. Exit program.\n");
+      _MMG5_DEL_MEM(mesh,band,(nband+1)*sizeof(int));
       return(0);
     }
     _MMG5_freeXTets(mesh);
   }
   else if ( !_MMG5_bdryPerm(mesh) ) {
     fprintf(stdout,"  ## Boundary orientation problem. Exit program.\n");
+    _MMG5_DEL_MEM(mesh,band,(nband+1)*sizeof(int));
     return(0);
   }
 
   /* build hash table for initial edges */
   if ( !_MMG5_hGeom(mesh) ) {
     fprintf(stdout,"  ## Hashing problem (0). Exit program.\n");
+    _MMG5_DEL_MEM(mesh,band,(nband+1)*sizeof(int));
     return(0);
   }
 
   if ( !_MMG5_bdrySet(mesh) ) {
     fprintf(stdout,"  ## Problem in setting boundary. Exit program.\n");
+    _MMG5_DEL_MEM(mesh,band,(nband+1)*sizeof(int));
     return(0);
   }
 
-  if ( !_MMG5_cuttet_ls(mesh,sol/*,tmp*/) ) {
+  if ( !_MMG5_cuttet_ls(mesh,sol/*,tmp*/,band,nband) ) {
     fprintf(stdout,"  ## Problem in discretizing implicit function. Exit program.\n");
+    _MMG5_DEL_MEM(mesh,band,(nband+1)*sizeof(int));
     return(0);
   }
+  _MMG5_DEL_MEM(mesh,band,(nband+1)*sizeof(int));
 
   _MMG5_DEL_MEM(mesh,mesh->adja,(4*mesh->nemax+5)*sizeof(int));
   _MMG5_DEL_MEM(mesh,mesh->tria,(mesh->nt+1)*sizeof(MMG5_Tria));
@@ -33,10 +33,8 @@
  * \todo Doxygen documentation
  */
 
-#ifdef USE_SUSCELAS
-
 #include "mmg3d.h"
-#include "ls_calls.h"
+
 #define _MMG5_DEGTOL  1.e-1
 
 extern char  ddb;
@@ -151,8 +149,8 @@ inline double _MMG5_caltet_iso_4pt(double *a, double *b, double *c, double *d) {
  */
 static int _MMG5_spllag(MMG5_pMesh mesh,MMG5_pSol disp,MMG5_pSol met,int itdeg, int* warn) {
   MMG5_pTetra     pt;
-  MMG5_pPoint     p0,p1,ppt;
-  double     dd,len,lmax,o[3],hma2;
+  MMG5_pPoint     p0,p1;
+  double     len,lmax,o[3],hma2;
   double    *m1,*m2,*mp;
   int        k,ip,ip1,ip2,list[MMG3D_LMAX+2],ilist,ns,ier,iadr;
   char       imax,i,i1,i2;
@@ -216,7 +214,6 @@ static int _MMG5_spllag(MMG5_pMesh mesh,MMG5_pSol disp,MMG5_pSol met,int itdeg,
       /* reallocation of point table */
       _MMG5_POINT_REALLOC(mesh,met,ip,mesh->gap,*warn=1;break,o,MG_NOTAG);
     }
-    ppt = &mesh->point[ip];
     
     /* Interpolation of metric, if any */
     if ( met->m ) {
@@ -320,10 +317,13 @@ int _MMG5_swptetlag(MMG5_pMesh mesh,MMG5_pSol met,double crit,_MMG5_pBucket buck
 int _MMG5_movtetlag(MMG5_pMesh mesh,MMG5_pSol met,int itdeg) {
   MMG5_pTetra        pt;
   MMG5_pPoint        ppt;
-  int           k,ier,nm,nnm,ns,listv[MMG3D_LMAX+2],ilistv,it;
+  _MMG3D_List        lstv;
+  int           k,ier,nm,nnm,ns,ilistv,it;
   unsigned char i,base;
   int           maxit;
   
+  if ( !_MMG3D_initList(mesh,&lstv,MMG3D_LMAX+2) )  return(-1);
+
   base = 1;
   for (k=1; k<=mesh->np; k++)
     mesh->point[k].flag = base;
@@ -347,10 +347,10 @@ int _MMG5_movtetlag(MMG5_pMesh mesh,MMG5_pSol met,int itdeg) {
 
         ier = 0;
  
-        ilistv = _MMG5_boulevolp(mesh,k,i,listv);
+        ilistv = _MMG5_boulevolp(mesh,k,i,&lstv);
         if ( !ilistv )  continue;
         
-        ier = _MMG5_movintpt_iso(mesh,met,listv,ilistv,0);
+        ier = _MMG5_movintpt_iso(mesh,met,lstv.item,ilistv,0);
           
         if ( ier ) {
           nm++;
@@ -364,6 +364,7 @@ int _MMG5_movtetlag(MMG5_pMesh mesh,MMG5_pSol met,int itdeg) {
   }
   while( ++it < maxit && nm > 0 );
   
+  _MMG3D_freeList(mesh,&lstv);
   return(nnm);
 }
 
@@ -380,11 +381,14 @@ int _MMG5_movtetlag(MMG5_pMesh mesh,MMG5_pSol met,int itdeg) {
 static int _MMG5_coltetlag(MMG5_pMesh mesh,MMG5_pSol met,int itdeg) {
   MMG5_pTetra     pt;
   MMG5_pPoint     p0,p1;
+  _MMG3D_List     lst;
   double     ll,ux,uy,uz,hmi2;
-  int        k,nc,list[MMG3D_LMAX+2],ilist,base,nnm;
-  char       i,j,tag,ip,iq,isnm;
+  int        k,nc,ilist,base,nnm;
+  char       i,j,ip,iq,isnm;
   int        ier;
   
+  if ( !_MMG3D_initList(mesh,&lst,MMG3D_LMAX+2) )  return(-1);
+
   nc = nnm = 0;
   hmi2 = mesh->info.hmin*mesh->info.hmin;
   
@@ -418,17 +422,23 @@ static int _MMG5_coltetlag(MMG5_pMesh mesh,MMG5_pSol met,int itdeg) {
         if ( ll > hmi2 )  continue;
 
         isnm = 0;
-        ilist = _MMG5_chkcol_int(mesh,met,k,i,j,list,2);
+        ilist = _MMG5_chkcol_int(mesh,met,k,i,j,&lst,2);
       
         if ( ilist > 0 ) {
-          ier = _MMG5_colver(mesh,met,list,ilist,iq,2);
-          if ( ier < 0 ) return(-1);
+          ier = _MMG5_colver(mesh,met,lst.item,ilist,iq,2);
+          if ( ier < 0 ) {
+            _MMG3D_freeList(mesh,&lst);
+            return(-1);
+          }
           else if ( ier ) {
             _MMG3D_delPt(mesh,ier);
             break;
           }
         }
-        else if (ilist < 0 ) return(-1);
+        else if (ilist < 0 ) {
+          _MMG3D_freeList(mesh,&lst);
+          return(-1);
+        }
       }
       if ( ier ) {
         p1->flag = base;
@@ -439,6 +449,7 @@ static int _MMG5_coltetlag(MMG5_pMesh mesh,MMG5_pSol met,int itdeg) {
     }
   }
   
+  _MMG3D_freeList(mesh,&lst);
   return(nc);
 }
 
@@ -446,14 +457,17 @@ static int _MMG5_coltetlag(MMG5_pMesh mesh,MMG5_pSol met,int itdeg) {
 int _MMG5_chkmovmesh(MMG5_pMesh mesh,MMG5_pSol disp,short t) {
   MMG5_pTetra  pt;
   MMG5_pPoint  ppt;
-  double       *v,c[4][3],tau,cal;
-  int          k,np;
+  double       *v,c[4][3],tau;
+  int          k,np,ier;
   char         i,j;
   
   /* Pseudo time-step = fraction of disp to perform */
   tau = (double)t / _MMG5_SHORTMAX;
-  
+  ier = 1;
+
+#pragma omp parallel for schedule(static) reduction(min:ier) private(pt,ppt,v,c,np,i,j)
   for (k=1; k<=mesh->ne; k++) {
+    if ( !ier ) continue;
     pt = &mesh->tetra[k];
     if ( !MG_EOK(pt) ) continue;
     
@@ -465,29 +479,148 @@ int _MMG5_chkmovmesh(MMG5_pMesh mesh,MMG5_pSol disp,short t) {
         c[i][j] = ppt->c[j]+tau*v[j];
     }
     
-    if( _MMG5_caltet_iso_4pt(c[0],c[1],c[2],c[3]) < _MMG5_NULKAL) return(0);  //     Other criteria : eg. a rate of degradation, etc... ?
+    if( _MMG5_caltet_iso_4pt(c[0],c[1],c[2],c[3]) < _MMG5_NULKAL) ier = 0;  //     Other criteria : eg. a rate of degradation, etc... ?
   }
 
-  return(1);
+  return(ier);
+}
+
+/**
+ * \param a coefficients of the polynomial \f$ a_0 + a_1 s + a_2 s^2 + a_3 s^3\f$.
+ * \param s evaluation point.
+ * \return the value of the polynomial at \a s.
+ *
+ */
+static inline double _MMG5_cubval(double a[4],double s) {
+  return(a[0] + s*(a[1] + s*(a[2] + s*a[3])));
 }
 
-/** Return the largest fraction t that makes the motion along disp valid */
+/**
+ * \param c coordinates of the tetra vertices.
+ * \param v displacement of the tetra vertices.
+ * \return the largest fraction \f$ s \in [0,1]\f$ such that the tetra stays
+ * valid along the motion \f$ c + \sigma v, \sigma \in [0,s]\f$.
+ *
+ * The volume of the moved tetra is a cubic polynomial in the fraction, we
+ * return (a lower bound of) its first root in \f$]0,1]\f$: the critical points
+ * of the cubic split \f$[0,1]\f$ into monotone intervals and the root is
+ * isolated by bisection on the first interval with a sign change.
+ *
+ */
+static double _MMG5_tmaxtet(double c[4][3],double v[4][3]) {
+  double  e[3][3],d[3][3],a[4],s[4],lo,hi,mid,dd,r;
+  int     ns,i,j,it;
+
+  for (i=0; i<3; i++) {
+    for (j=0; j<3; j++) {
+      e[i][j] = c[i+1][j] - c[0][j];
+      d[i][j] = v[i+1][j] - v[0][j];
+    }
+  }
+
+  /* det(e + s d) = a0 + a1 s + a2 s^2 + a3 s^3 */
+#define _MMG5_TRIPLE(x,y,z) ( x[0]*(y[1]*z[2]-y[2]*z[1])          \
+                              + x[1]*(y[2]*z[0]-y[0]*z[2])        \
+                              + x[2]*(y[0]*z[1]-y[1]*z[0]) )
+  a[0] = _MMG5_TRIPLE(e[0],e[1],e[2]) - _MMG5_EPSD2;
+  a[1] = _MMG5_TRIPLE(d[0],e[1],e[2]) + _MMG5_TRIPLE(e[0],d[1],e[2])
+    + _MMG5_TRIPLE(e[0],e[1],d[2]);
+  a[2] = _MMG5_TRIPLE(e[0],d[1],d[2]) + _MMG5_TRIPLE(d[0],e[1],d[2])
+    + _MMG5_TRIPLE(d[0],d[1],e[2]);
+  a[3] = _MMG5_TRIPLE(d[0],d[1],d[2]);
+#undef _MMG5_TRIPLE
+
+  if ( a[0] <= 0.0 )  return(0.0);
+
+  /* critical points in ]0,1[: roots of a1 + 2 a2 s + 3 a3 s^2 */
+  ns = 0;
+  s[ns++] = 0.0;
+  if ( fabs(a[3]) > _MMG5_EPSD ) {
+    dd = a[2]*a[2] - 3.0*a[1]*a[3];
+    if ( dd > 0.0 ) {
+      dd = sqrt(dd);
+      /* stable form of the two roots */
+      r = ( a[2] > 0.0 ) ? -(a[2]+dd) : -(a[2]-dd);
+      lo = r / (3.0*a[3]);
+      hi = ( fabs(r) > _MMG5_EPSD ) ? a[1] / r : lo;
+      if ( lo > hi ) { mid = lo; lo = hi; hi = mid; }
+      if ( lo > 0.0 && lo < 1.0 )  s[ns++] = lo;
+      if ( hi > 0.0 && hi < 1.0 && hi > lo )  s[ns++] = hi;
+    }
+  }
+  else if ( fabs(a[2]) > _MMG5_EPSD ) {
+    r = -a[1] / (2.0*a[2]);
+    if ( r > 0.0 && r < 1.0 )  s[ns++] = r;
+  }
+  s[ns] = 1.0;
+
+  for (i=0; i<ns; i++) {
+    if ( _MMG5_cubval(a,s[i+1]) > 0.0 )  continue;
+
+    /* the cubic is monotone on [s_i,s_i+1] and changes sign */
+    lo = s[i];
+    hi = s[i+1];
+    for (it=0; it<50 && hi-lo > 1.0/(4.0*_MMG5_SHORTMAX); it++) {
+      mid = 0.5*(lo+hi);
+      if ( _MMG5_cubval(a,mid) > 0.0 )  lo = mid;
+      else hi = mid;
+    }
+    return(lo);
+  }
+
+  return(1.0);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param disp pointer toward the displacement.
+ * \return the largest fraction t (in 1/_MMG5_SHORTMAX) that makes the motion
+ * along disp valid.
+ *
+ * The admissible fraction of each tetra is computed analytically and the
+ * smallest one is kept (one pass over the mesh). The move is then checked
+ * against the quality criterion and, if it fails, the fraction is refined by
+ * dichotomy below the analytic bound.
+ *
+ */
 short _MMG5_dikomv(MMG5_pMesh mesh,MMG5_pSol disp) {
-  int     it,maxit;
-  short   t,tmin,tmax;
-  char    ier;
- 
-  maxit = 200;
-  it = 0;
-  
-  tmin = 0;
-  tmax = _MMG5_SHORTMAX;
-  
-  /* If full displacement can be achieved */
-  if ( _MMG5_chkmovmesh(mesh,disp,tmax) )
+  MMG5_pTetra  pt;
+  MMG5_pPoint  ppt;
+  double       c[4][3],v[4][3],tmv,te;
+  int          k,np,it,maxit;
+  short        t,tmin,tmax;
+  char         i,j,ier;
+
+  tmv = 1.0;
+
+#pragma omp parallel for schedule(static) reduction(min:tmv) \
+  private(pt,ppt,c,v,te,np,i,j)
+  for (k=1; k<=mesh->ne; k++) {
+    pt = &mesh->tetra[k];
+    if ( !MG_EOK(pt) ) continue;
+
+    for (i=0; i<4; i++) {
+      np  = pt->v[i];
+      ppt = &mesh->point[np];
+      for (j=0; j<3; j++) {
+        c[i][j] = ppt->c[j];
+        v[i][j] = disp->m[3*np+j];
+      }
+    }
+    te = _MMG5_tmaxtet(c,v);
+    if ( te < tmv )  tmv = te;
+  }
+
+  tmax = (short)(tmv*_MMG5_SHORTMAX);
+  if ( !tmax || _MMG5_chkmovmesh(mesh,disp,tmax) )
     return(tmax);
 
   /* Else, find the largest displacement by dichotomy */
+  maxit = 200;
+  it    = 0;
+  tmin  = 0;
+  tmax--;
+
   while( tmin != tmax && it < maxit ) {
     t = (tmin+tmax)/2;
   
@@ -573,7 +706,7 @@ int _MMG5_dispmesh(MMG5_pMesh mesh,MMG5_pSol disp,short t,int itdeg) {
 int _MMG5_saveDisp(MMG5_pMesh mesh,MMG5_pSol disp) {
   FILE        *out;
   int         k;
-  char        j,data[256],*ptr;
+  char        data[256],*ptr;
   
   strcpy(data,disp->namein);
   ptr = strstr(data,".sol");
@@ -614,10 +747,6 @@ int _MMG5_mmg3d3(MMG5_pMesh mesh,MMG5_pSol disp,MMG5_pSol met) {
   if ( abs(mesh->info.imprim) > 4 || mesh->info.ddebug )
     fprintf(stdout,"  ** LAGRANGIAN MOTION\n");
   
-  /* Field mark stores information about whether a tetra has been greatly deformed during current step */
-  for (k=1; k<=mesh->ne; k++)
-    mesh->tetra[k].mark = 0;
-
   /* Estimates of the minimum and maximum edge lengths in the mesh */
   avlen = _MMG5_estavglen(mesh);
   mesh->info.hmax = _MMG5_LLONG*avlen;
@@ -628,9 +757,13 @@ int _MMG5_mmg3d3(MMG5_pMesh mesh,MMG5_pSol disp,MMG5_pSol met) {
   for (itmn=0; itmn<maxitmn; itmn++) {
     nnnspl = nnnc = nnns = nnnm = 0;
 
+    /* Field mark stores information about whether a tetra has been greatly deformed during current step */
+    for (k=1; k<=mesh->ne; k++)
+      mesh->tetra[k].mark = 0;
+
     /* Extension of the velocity field */
     if ( !_MMG5_velextLS(mesh,disp) ) {
-      fprintf(stdout,"  ## Problem in func. _MMG5_packLS. Exit program.\n");
+      fprintf(stdout,"  ## Problem in func. _MMG5_velextLS. Exit program.\n");
       return(0);
     }
   
@@ -731,5 +864,3 @@ int _MMG5_mmg3d3(MMG5_pMesh mesh,MMG5_pSol disp,MMG5_pSol met) {
 
   return(1);
 }
-
-#endif
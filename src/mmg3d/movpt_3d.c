@@ -129,7 +129,8 @@ int _MMG5_movintpt_iso(MMG5_pMesh mesh,MMG5_pSol met,int *list,int ilist,int imp
 	  return(0);
   }
 
-  /* update position */
+  /* update position (and the user fields) */
+  _MMG3D_movfield(mesh,list,ilist,ppt0->c);
   p0 = &mesh->point[pt->v[i0]];
   p0->c[0] = ppt0->c[0];
   p0->c[1] = ppt0->c[1];
@@ -518,6 +519,9 @@ int _MMG5_movbdyregpt_iso(MMG5_pMesh mesh, MMG5_pSol met,int *listv,
 	  return(0);
   }
 
+  /* interpolate the user fields at the new position */
+  _MMG3D_movfield(mesh,listv,ilistv,o);
+
   /* When all tests have been carried out, update coordinates and normals */
   p0->c[0] = o[0];
   p0->c[1] = o[1];
@@ -822,6 +826,9 @@ int _MMG5_movbdyrefpt_iso(MMG5_pMesh mesh, MMG5_pSol met, int *listv,
 	  return(0);
   }
 
+  /* interpolate the user fields at the new position */
+  _MMG3D_movfield(mesh,listv,ilistv,o);
+
   /* Update coordinates, normals, for new point */
   p0->c[0] = o[0];
   p0->c[1] = o[1];
@@ -1132,6 +1139,9 @@ int _MMG5_movbdynompt_iso(MMG5_pMesh mesh,MMG5_pSol met, int *listv,
 	  return(0);
   }
 
+  /* interpolate the user fields at the new position */
+  _MMG3D_movfield(mesh,listv,ilistv,o);
+
   /* Update coordinates, normals, for new point */
   p0->c[0] = o[0];
   p0->c[1] = o[1];
@@ -1444,6 +1454,9 @@ int _MMG5_movbdyridpt_iso(MMG5_pMesh mesh, MMG5_pSol met, int *listv,
 	  return(0);
   }
 
+  /* interpolate the user fields at the new position */
+  _MMG3D_movfield(mesh,listv,ilistv,o);
+
   /* Update coordinates, normals, for new point */
   p0->c[0] = o[0];
   p0->c[1] = o[1];
@@ -1473,9 +1486,10 @@ int _MMG5_movbdyridpt_iso(MMG5_pMesh mesh, MMG5_pSol met, int *listv,
 int _MMG3D_movv_ani(MMG5_pMesh mesh,MMG5_pSol sol,int k,int ib) {
   MMG5_pTetra   pt,pt1;
   MMG5_pPoint   ppa,ppb,p1,p2,p3;
-  int           j,iadr,ipb,iter,maxiter,l,lon,iel,i1,i2,i3,list[MMG3D_LMAX+2];
-  double        *mp,coe,qualtet[MMG3D_LMAX+2];
-  double        ax,ay,az,bx,by,bz,nx,ny,nz,dd,len,qual,oldc[3];
+  _MMG3D_List   lst;
+  int           j,iadr,ipb,iter,maxiter,l,lon,iel,i1,i2,i3,*list;
+  double        *mp,coe,*qualtet;
+  double        ax,ay,az,bx,by,bz,nx,ny,nz,dd,len,qual,oldc[3],newc[3];
   assert(k);
   assert(ib<4);
   pt = &mesh->tetra[k];
@@ -1528,9 +1542,16 @@ int _MMG3D_movv_ani(MMG5_pMesh mesh,MMG5_pSol sol,int k,int ib) {
   len *= dd;
   memcpy(oldc,ppa->c,3*sizeof(double));
 
-  lon = _MMG5_boulevolp(mesh,k,ib,&list[0]);
+  if ( !_MMG3D_initList(mesh,&lst,MMG3D_LMAX+2) )  return(0);
+
+  lon = _MMG5_boulevolp(mesh,k,ib,&lst);
   if(mesh->info.imprim < 0 ) if(lon < 4 && lon) printf("lon petit : %d\n",lon);
-  if(!lon) return(0);
+  if(!lon) {
+    _MMG3D_freeList(mesh,&lst);
+    return(0);
+  }
+  list = lst.item;
+  _MMG5_SAFE_MALLOC(qualtet,lon,double);
 
   coe     = 1.;
   iter    = 0;
@@ -1555,9 +1576,19 @@ int _MMG3D_movv_ani(MMG5_pMesh mesh,MMG5_pSol sol,int k,int ib) {
   while ( ++iter <= maxiter );
   if ( iter > maxiter) {
     memcpy(ppa->c,oldc,3*sizeof(double));
+    _MMG5_SAFE_FREE(qualtet);
+    _MMG3D_freeList(mesh,&lst);
     return(0);
   }
 
+  /* interpolate the user fields at the new position, in the old ball */
+  if ( mesh->nfield ) {
+    memcpy(newc,ppa->c,3*sizeof(double));
+    memcpy(ppa->c,oldc,3*sizeof(double));
+    _MMG3D_movfield(mesh,list,lon,newc);
+    memcpy(ppa->c,newc,3*sizeof(double));
+  }
+
   for (l=0; l<lon; l++) {
     iel = list[l] / 4;
     pt1 = &mesh->tetra[iel];
@@ -1565,6 +1596,8 @@ int _MMG3D_movv_ani(MMG5_pMesh mesh,MMG5_pSol sol,int k,int ib) {
     //    if ( pt1->qual < declic )
     //  MMG_kiudel(queue,iel);
   }
+  _MMG5_SAFE_FREE(qualtet);
+  _MMG3D_freeList(mesh,&lst);
   return(1);
 
 }
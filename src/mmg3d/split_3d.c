@@ -255,6 +255,10 @@ nextstep1:
     pt->qual=_MMG5_orcal(mesh,met,k);
     pt1->qual=_MMG5_orcal(mesh,met,iel);
   }
+
+  /* Update the incident tetra of the vertices */
+  _MMG3D_SETSTART(mesh,k);
+  _MMG3D_SETSTART(mesh,iel);
 }
 
 /**
@@ -597,6 +601,9 @@ int _MMG5_split1b(MMG5_pMesh mesh, MMG5_pSol met,int *list, int ret, int ip,
       pt1->qual=_MMG5_orcal(mesh,met,jel);
     }
 
+    _MMG3D_SETSTART(mesh,iel);
+    _MMG3D_SETSTART(mesh,jel);
+
     _MMG5_SAFE_FREE(newtet);
     return(1);
   }
@@ -894,6 +901,12 @@ int _MMG5_split1b(MMG5_pMesh mesh, MMG5_pSol met,int *list, int ret, int ip,
     }
   }
 
+  /* Update the incident tetra of the vertices */
+  for (k=0; k<ilist; k++) {
+    _MMG3D_SETSTART(mesh,list[k]/6);
+    _MMG3D_SETSTART(mesh,abs(newtet[k]));
+  }
+
   _MMG5_SAFE_FREE(newtet);
   return(1);
 }
@@ -1216,6 +1229,9 @@ void _MMG5_split2sf(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6],char metRidTyp
     pt[2]->qual=_MMG5_orcal(mesh,met,newtet[2]);
   }
 
+  /* Update the incident tetra of the vertices */
+  for (i=0; i<3; i++)
+    _MMG3D_SETSTART(mesh,newtet[i]);
 }
 
 /** Split of two OPPOSITE edges */
@@ -1415,6 +1431,9 @@ void _MMG5_split2(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6],char metRidTyp)
     pt[3]->qual=_MMG5_orcal(mesh,met,newtet[3]);
   }
 
+  /* Update the incident tetra of the vertices */
+  for (i=0; i<4; i++)
+    _MMG3D_SETSTART(mesh,newtet[i]);
 }
 
 /** Simulate split of 1 face (3 edges) */
@@ -1673,6 +1692,10 @@ void _MMG5_split3(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6],char metRidTyp)
     pt[2]->qual=_MMG5_orcal(mesh,met,newtet[2]);
     pt[3]->qual=_MMG5_orcal(mesh,met,newtet[3]);
   }
+
+  /* Update the incident tetra of the vertices */
+  for (i=0; i<4; i++)
+    _MMG3D_SETSTART(mesh,newtet[i]);
 }
 
 /** Split 3 edge in cone configuration */
@@ -2023,6 +2046,9 @@ void _MMG5_split3cone(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6],char metRidT
     pt[3]->qual=_MMG5_orcal(mesh,met,newtet[3]);
   }
 
+  /* Update the incident tetra of the vertices */
+  for (i=0; i<4; i++)
+    _MMG3D_SETSTART(mesh,newtet[i]);
 }
 
 void _MMG5_split3op(MMG5_pMesh mesh, MMG5_pSol met, int k, int vx[6],char metRidTyp){
@@ -2585,6 +2611,9 @@ void _MMG5_split3op(MMG5_pMesh mesh, MMG5_pSol met, int k, int vx[6],char metRid
     }
   }
 
+  /* Update the incident tetra of the vertices */
+  for (i=0; i<5; i++)
+    if ( newtet[i] )  _MMG3D_SETSTART(mesh,newtet[i]);
 }
 
 
@@ -2807,6 +2836,9 @@ int _MMG5_split4bar(MMG5_pMesh mesh, MMG5_pSol met, int k,char metRidTyp) {
     pt[3]->qual=_MMG5_orcal(mesh,met,newtet[3]);
   }
 
+  /* Update the incident tetra of the vertices */
+  for (i=0; i<4; i++)
+    _MMG3D_SETSTART(mesh,newtet[i]);
   return(1);
 }
 
@@ -3093,6 +3125,10 @@ void _MMG5_split4sf(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6],char metRidTyp
       pt[i]->qual=_MMG5_orcal(mesh,met,newtet[i]);
     }
   }
+
+  /* Update the incident tetra of the vertices */
+  for (i=0; i<6; i++)
+    _MMG3D_SETSTART(mesh,newtet[i]);
 }
 
 /** Split 4 edges in a configuration when no 3 edges lie on the same face */
@@ -3350,6 +3386,10 @@ void _MMG5_split4op(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6],char metRidTyp
       pt[i]->qual=_MMG5_orcal(mesh,met,newtet[i]);
     }
   }
+
+  /* Update the incident tetra of the vertices */
+  for (i=0; i<6; i++)
+    _MMG3D_SETSTART(mesh,newtet[i]);
 }
 
 /** Split 5 edges */
@@ -3606,6 +3646,10 @@ void _MMG5_split5(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6],char metRidTyp)
       pt[i]->qual=_MMG5_orcal(mesh,met,newtet[i]);
     }
   }
+
+  /* Update the incident tetra of the vertices */
+  for (i=0; i<7; i++)
+    _MMG3D_SETSTART(mesh,newtet[i]);
 }
 
 /** split all faces (6 edges) */
@@ -3970,6 +4014,10 @@ void _MMG5_split6(MMG5_pMesh mesh,MMG5_pSol met,int k,int vx[6],char metRidTyp)
       pt[i]->qual=_MMG5_orcal(mesh,met,newtet[i]);
     }
   }
+
+  /* Update the incident tetra of the vertices */
+  for (i=0; i<8; i++)
+    _MMG3D_SETSTART(mesh,newtet[i]);
 }
 
 
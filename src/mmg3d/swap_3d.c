@@ -350,6 +350,7 @@ int _MMG5_swpbdy(MMG5_pMesh mesh,MMG5_pSol met,int *list,int ret,int it1,
                  _MMG5_pBucket bucket, char typchk) {
   MMG5_pTetra   pt,pt1;
   MMG5_pPoint   p0,p1;
+  _MMG3D_List   lst;
   int           iel,iel1,ilist,np,nq,nm;
   double        c[3];
   char          ia,iface1,j,ipa,im;
@@ -430,7 +431,6 @@ int _MMG5_swpbdy(MMG5_pMesh mesh,MMG5_pSol met,int *list,int ret,int it1,
   else if ( !ier )  return(0);
 
   /* Collapse m on na after taking (new) ball of m */
-  memset(list,0,(MMG3D_LMAX+2)*sizeof(int));
   for (j=0; j<3; j++) {
     im = _MMG5_idir[iface1][j];
     if ( pt1->v[im] == nm )  break;
@@ -440,12 +440,22 @@ int _MMG5_swpbdy(MMG5_pMesh mesh,MMG5_pSol met,int *list,int ret,int it1,
     fprintf(stdout,"%s:%d: Warning pt1->v[im] != nm\n",__FILE__,__LINE__);
     return(0);
   }
-  ilist = _MMG5_boulevolp(mesh,iel1,im,list);
+  if ( !_MMG3D_initList(mesh,&lst,MMG3D_LMAX+2) ) {
+    fprintf(stdout,"  ## Warning: unable to swap boundary edge.\n");
+    return(-1);
+  }
+  ilist = _MMG5_boulevolp(mesh,iel1,im,&lst);
+  if ( !ilist ) {
+    _MMG3D_freeList(mesh,&lst);
+    fprintf(stdout,"  ## Warning: unable to swap boundary edge.\n");
+    return(-1);
+  }
 
-  assert(list[0]/4 == iel1);
+  assert(lst.item[0]/4 == iel1);
   assert(pt1->v[ipa] == na);
 
-  ier = _MMG5_colver(mesh,met,list,ilist,ipa,typchk);
+  ier = _MMG5_colver(mesh,met,lst.item,ilist,ipa,typchk);
+  _MMG3D_freeList(mesh,&lst);
   if ( ier < 0 ) {
     fprintf(stdout,"  ## Warning: unable to swap boundary edge.\n");
     return(-1);
@@ -239,6 +239,7 @@ int _MMG5_swpgen(MMG5_pMesh mesh,MMG5_pSol met,int nconf,int ilist,int *list,
                  _MMG5_pBucket bucket, char typchk) {
   MMG5_pTetra    pt;
   MMG5_pPoint    p0,p1;
+  _MMG3D_List    lst;
   int       iel,na,nb,np,nball,ret,start;
   double    m[3];
   char      ia,ip,iq;
@@ -306,10 +307,19 @@ int _MMG5_swpgen(MMG5_pMesh mesh,MMG5_pSol met,int nconf,int ilist,int *list,
   }
   assert(ip<4);
 
-  memset(list,0,(MMG3D_LMAX+2)*sizeof(int));
-  nball = _MMG5_boulevolp(mesh,start,ip,list);
+  if ( !_MMG3D_initList(mesh,&lst,MMG3D_LMAX+2) ) {
+    fprintf(stdout,"  ## Warning: unable to swap internal edge.\n");
+    return(-1);
+  }
+  nball = _MMG5_boulevolp(mesh,start,ip,&lst);
+  if ( !nball ) {
+    _MMG3D_freeList(mesh,&lst);
+    fprintf(stdout,"  ## Warning: unable to swap internal edge.\n");
+    return(-1);
+  }
 
-  ier = _MMG5_colver(mesh,met,list,nball,iq,typchk);
+  ier = _MMG5_colver(mesh,met,lst.item,nball,iq,typchk);
+  _MMG3D_freeList(mesh,&lst);
   if ( ier < 0 ) {
     fprintf(stdout,"  ## Warning: unable to swap internal edge.\n");
     return(-1);
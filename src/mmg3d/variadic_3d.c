@@ -302,9 +302,9 @@ void _MMG3D_Free_structures_var(va_list argptr)
 {
 
   MMG5_pMesh     *mesh;
-  MMG5_pSol      *sol,*disp;
+  MMG5_pSol      *sol,*disp,psl;
   enum MMG5_arg  typArg;
-  int            meshCount;
+  int            meshCount,k;
 
   meshCount = 0;
   disp = sol = NULL;
@@ -370,6 +370,19 @@ void _MMG3D_Free_structures_var(va_list argptr)
   if ( (*mesh)->xpoint )
     _MMG5_DEL_MEM((*mesh),(*mesh)->xpoint,((*mesh)->xpmax+1)*sizeof(MMG5_xPoint));
 
+  _MMG5_bezierCacheFree(*mesh);
+
+  /* user fields */
+  if ( (*mesh)->field ) {
+    for (k=0; k<(*mesh)->nfield; k++) {
+      psl = (*mesh)->field[k];
+      if ( psl->m )
+        _MMG5_DEL_MEM((*mesh),psl->m,(psl->size*(psl->npmax+1))*sizeof(double));
+    }
+    _MMG5_DEL_MEM((*mesh),(*mesh)->field,(*mesh)->nfield*sizeof(MMG5_pSol));
+    (*mesh)->nfield = 0;
+  }
+
   if ( (*mesh)->htab.geom )
     _MMG5_DEL_MEM((*mesh),(*mesh)->htab.geom,((*mesh)->htab.max+1)*sizeof(MMG5_hgeom));
 
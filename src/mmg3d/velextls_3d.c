@@ -23,318 +23,558 @@
 
 /**
  * \file mmg3d/velextls_3d.c
- * \brief Tools for interfacing mmg with LS, for extension of the displacement field.
+ * \brief Extension of the displacement field by linear elasticity.
  * \author Charles Dapogny (UPMC)
  * \author Cécile Dobrzynski (Bx INP/Inria/UBordeaux)
  * \author Pascal Frey (UPMC)
  * \author Algiane Froehly (Inria/UBordeaux)
  * \version 5
  * \copyright GNU Lesser General Public License.
- * \todo Doxygen documentation
+ *
+ * The displacement prescribed at the nodes of the triangles of reference
+ * _MMG5_DISPREF is extended to a layer of tetrahedra around them by solving
+ * the P1 linear elasticity problem (homogeneous Dirichlet condition on the
+ * boundary of the layer). The system is stored by 3x3 blocks (one block per
+ * pair of neighbouring nodes) and solved by a block-Jacobi preconditioned
+ * conjugate gradient, warm-started from the current displacement.
+ *
  */
-#ifdef USE_SUSCELAS
 
 #include "mmg3d.h"
-#include "ls_calls.h"
-#define _MMG5_DEGTOL    0.75
+
 #define _MMG5_DISPREF   0
+#define _MMG5_NLAY      20      /**< nb of layers of tetra around DISPREF */
 #define _LS_LAMBDA      10.0e5
 #define _LS_MU          8.2e5
+#define _MMG5_ELASTOL   1.e-6   /**< relative residual of the CG */
+#define _MMG5_ELASMAXIT 10000   /**< max nb of CG iterations */
+
+/**
+ * \struct _MMG5_Elas
+ * \brief Linear elasticity system on a layer of tetrahedra.
+ *
+ * Nodes of the layer are numbered from 0 to \a n-1, the blocks of row \a i
+ * are stored in \f$[adr[i],adr[i+1][\f$.
+ */
+typedef struct {
+  int     ne;    /**< nb of tetra of the layer */
+  int     n;     /**< nb of nodes of the layer */
+  int     nnz;   /**< nb of 3x3 blocks of the matrix */
+  int     np;    /**< nb of points of the mesh when the system is built */
+  int     *list; /**< tetra of the layer */
+  int     *perm; /**< perm[ip]: local index + 1 of mesh point ip, 0 if none */
+  int     *ip;   /**< ip[i]: mesh point of local node i */
+  int     *tadr; /**< ball of node i in tlist[tadr[i]..tadr[i+1]-1] */
+  int     *tlist;/**< balls (4*l+iloc, l index in list) */
+  int     *adr;  /**< row addresses */
+  int     *col;  /**< column (local node) of each block */
+  char    *fix;  /**< fix[ip]: 1 for homogeneous, 2 for prescribed Dirichlet */
+  double  *val;  /**< block coefficients (9 per block) */
+  double  *dinv; /**< inverse of the diagonal blocks */
+} _MMG5_Elas;
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param el pointer toward the elasticity system.
+ *
+ * Free the elasticity system.
+ *
+ */
+static void _MMG5_freeElas(MMG5_pMesh mesh,_MMG5_Elas *el) {
 
-/** Create submesh for solving the linear elasticity velocity extension problem.
- invperm stores the permutation [ new pt nb -> old pt nb ] (for unpacking purposes)
- Return: npf = number of vertices in the packed mesh.
+  if ( el->list )
+    _MMG5_DEL_MEM(mesh,el->list,(mesh->ne+1)*sizeof(int));
+  if ( el->perm )
+    _MMG5_DEL_MEM(mesh,el->perm,(el->np+1)*sizeof(int));
+  if ( el->fix )
+    _MMG5_DEL_MEM(mesh,el->fix,(el->np+1)*sizeof(char));
+  if ( el->ip )
+    _MMG5_DEL_MEM(mesh,el->ip,(el->n+1)*sizeof(int));
+  if ( el->tadr )
+    _MMG5_DEL_MEM(mesh,el->tadr,(el->n+1)*sizeof(int));
+  if ( el->tlist )
+    _MMG5_DEL_MEM(mesh,el->tlist,(4*el->ne+1)*sizeof(int));
+  if ( el->adr )
+    _MMG5_DEL_MEM(mesh,el->adr,(el->n+1)*sizeof(int));
+  if ( el->col )
+    _MMG5_DEL_MEM(mesh,el->col,(el->nnz+1)*sizeof(int));
+  if ( el->val )
+    _MMG5_DEL_MEM(mesh,el->val,9*(el->nnz+1)*sizeof(double));
+  if ( el->dinv )
+    _MMG5_DEL_MEM(mesh,el->dinv,9*(el->n+1)*sizeof(double));
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param el pointer toward the elasticity system.
+ * \return 1 if success, 0 if fail.
+ *
+ * Pile the tetra with a face of reference _MMG5_DISPREF and _MMG5_NLAY layers
+ * of tetra around them, number their nodes and set the Dirichlet conditions:
+ * prescribed displacement on the faces of ref _MMG5_DISPREF, null
+ * displacement on the other faces of the boundary of the layer.
+ *
  */
-int* _MMG5_packLS(MMG5_pMesh mesh,MMG5_pSol disp,LSst *lsst,int *npfin) {
+static int _MMG5_elasDomain(MMG5_pMesh mesh,_MMG5_Elas *el) {
   MMG5_pTetra    pt,pt1;
   MMG5_pxTetra   pxt;
-  MMG5_pPoint    p0;
-  double         u[3];
-  int            k,n,ip,iel,jel,nlay,npf,ntf,ilist,ilisto,ilistck,vper[4],*list,*perm,*invperm,*adja;
-  int            refdirh,refdirnh;
-  char           i,j,jface;
-  
-  nlay = 20;
-  refdirh = 0;
-  refdirnh = 1;
-  npf = 0;
-  ntf = 0;
-  u[0] = u[1] = u[2] = 0.0;
-  list = (int*)calloc(mesh->ne+1,sizeof(int));
-  perm = (int*)calloc(mesh->np+1,sizeof(int));
-  ilist = ilisto = ilistck = 0;
-  
-  for (k=1; k<=mesh->ne; k++)
-    mesh->tetra[k].mark = 0;      // A faire fusionner avec celui de mmg3d3.c
-  
+  int            k,l,n,ip,iel,jel,ilist,ilisto,ilistck,*adja;
+  char           *inlist,i,j;
+
+  el->np = mesh->np;
+
+  _MMG5_ADD_MEM(mesh,(mesh->ne+1)*(sizeof(int)+sizeof(char)),"elasticity layer",
+                return(0));
+  _MMG5_SAFE_CALLOC(el->list,mesh->ne+1,int);
+  _MMG5_SAFE_CALLOC(inlist,mesh->ne+1,char);
+
   /* Step 1: pile all the tetras containing a triangle with ref DISPREF */
-  for(k=1; k<=mesh->ne; k++) {
+  ilist = 0;
+  for (k=1; k<=mesh->ne; k++) {
     pt = &mesh->tetra[k];
     if ( !MG_EOK(pt) || !pt->xt ) continue;
     pxt = &mesh->xtetra[pt->xt];
-    
-    for(i=0; i<4; i++) {
+
+    for (i=0; i<4; i++) {
       if ( (pxt->ftag[i] & MG_BDY) && (pxt->ref[i] == _MMG5_DISPREF) ) {
-        ilist++;
-        list[ilist] = k;
-        MG_SET(pt->mark,0);
-        
-        for(j=0; j<4; j++) {
-          ip = pt->v[j];
-          if ( !perm[ip] ) {
-            npf++;
-            perm[ip] = npf;
-          }
-        }
+        el->list[ilist++] = k;
+        inlist[k] = 1;
         break;
       }
     }
   }
-  
-  /* Step 2: create a layer around these tetras */
-  for(n=0; n<nlay; n++) {
+
+  /* Step 2: create layers around these tetras */
+  ilisto = 0;
+  for (n=0; n<_MMG5_NLAY; n++) {
     ilistck = ilisto;
-    ilisto = ilist;
-    
-    for(k=ilistck+1; k<=ilisto; k++) {
-      iel = list[k];
-      pt = &mesh->tetra[iel];
+    ilisto  = ilist;
+
+    for (l=ilistck; l<ilisto; l++) {
+      iel  = el->list[l];
       adja = &mesh->adja[4*(iel-1)+1];
-      
-      for(i=0; i<4; i++) {
+
+      for (i=0; i<4; i++) {
         jel = adja[i] / 4;
-        if ( !jel ) continue;
+        if ( !jel || inlist[jel] ) continue;
         pt1 = &mesh->tetra[jel];
-        if ( MG_EOK(pt1) && (!MG_GET(pt1->mark,0) ) ) {
-          ilist++;
-          assert( ilist <= mesh->ne );
-          MG_SET(pt1->mark,0);
-          list[ilist] = jel;
-          
-          for(j=0; j<4; j++) {
-            ip = pt1->v[j];
-            if ( !perm[ip] ) {
-              npf++;
-              perm[ip] = npf;
-            }
-          }
-        }
+        if ( !MG_EOK(pt1) )  continue;
+        el->list[ilist++] = jel;
+        inlist[jel] = 1;
       }
     }
   }
-    
-  /* Creation of the inverse permutation table */
-  invperm = (int*)calloc(npf+1,sizeof(int));
-  
-  /* Step 3: count of the surface triangles in the new mesh 
-     Code for pt->mark : if MG_GET(pt->mark,0) = in the list
-                         if !MG_GET(pt->mark,0) = not in the list
-                         if MG_GET(pt->mark, i+1) : face i has a boundary triangle which has already been counted */
-  for(k=1; k<=ilist; k++) {
-    iel = list[k];
-    pt = &mesh->tetra[iel];
+  el->ne = ilist;
+
+  /* Step 3: Dirichlet conditions and numbering of the nodes */
+  _MMG5_ADD_MEM(mesh,(el->np+1)*(sizeof(int)+sizeof(char)),"elasticity layer",
+                _MMG5_DEL_MEM(mesh,inlist,(mesh->ne+1)*sizeof(char));
+                return(0));
+  _MMG5_SAFE_CALLOC(el->perm,el->np+1,int);
+  _MMG5_SAFE_CALLOC(el->fix,el->np+1,char);
+
+  el->n = 0;
+  for (l=0; l<ilist; l++) {
+    iel  = el->list[l];
+    pt   = &mesh->tetra[iel];
     adja = &mesh->adja[4*(iel-1)+1];
-    if (pt->xt) pxt = &mesh->xtetra[pt->xt];
-    
-    for(i=0; i<4; i++) {
+    pxt  = pt->xt ? &mesh->xtetra[pt->xt] : NULL;
+
+    for (i=0; i<4; i++) {
+      ip = pt->v[i];
+      if ( !el->perm[ip] )  el->perm[ip] = ++el->n;
+
       jel = adja[i] / 4;
-      jface = adja[i] % 4;
-      
-      /* Face i carries a non homogeneous Dirichlet BC */
-      if ( pt->xt && (pxt->ftag[i] & MG_BDY) && (pxt->ref[i] == _MMG5_DISPREF) ) {
-        /* If this triangle has not been taken into account */
-        if ( MG_GET(pt->mark,i+1) ) continue;
-        
-        ntf++;
-        if ( !jel ) continue;
-        pt1 = &mesh->tetra[jel];
-        MG_SET(pt1->mark,jface+1);
+      if ( pxt && (pxt->ftag[i] & MG_BDY) && (pxt->ref[i] == _MMG5_DISPREF) ) {
+        for (j=0; j<3; j++)
+          el->fix[pt->v[_MMG5_idir[i][j]]] = 2;
+      }
+      else if ( !jel || !inlist[jel] ) {
+        for (j=0; j<3; j++) {
+          ip = pt->v[_MMG5_idir[i][j]];
+          if ( !el->fix[ip] )  el->fix[ip] = 1;
+        }
       }
-      /* iel has no neighbour through face i within the list */
-      else if ( !jel || ( !mesh->tetra[jel].mark ) ) ntf++;
     }
   }
-  
-  /* Step 4: creation of the mesh for elasticity */
-  if ( !LS_mesh(lsst,npf,0,ntf,ilist) ) {
-    fprintf(stdout,"  ## Problem in fn LS_mesh. Exiting.\n");
-    return(0);
+  _MMG5_DEL_MEM(mesh,inlist,(mesh->ne+1)*sizeof(char));
+
+  _MMG5_ADD_MEM(mesh,(el->n+1)*sizeof(int),"elasticity layer",return(0));
+  _MMG5_SAFE_CALLOC(el->ip,el->n+1,int);
+  for (k=1; k<=mesh->np; k++)
+    if ( el->perm[k] )  el->ip[el->perm[k]-1] = k;
+
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param el pointer toward the elasticity system.
+ * \return 1 if success, 0 if fail.
+ *
+ * Build the balls of the nodes of the layer and the sparsity pattern of the
+ * matrix (one block per pair of nodes sharing a tetra).
+ *
+ */
+static int _MMG5_elasGraph(MMG5_pMesh mesh,_MMG5_Elas *el) {
+  MMG5_pTetra    pt;
+  int            *colb,i,j,l,t,c,nc,iel,n;
+  char           a,b;
+
+  n = el->n;
+
+  /* balls of the nodes */
+  _MMG5_ADD_MEM(mesh,(n+1+4*el->ne+1)*sizeof(int),"elasticity graph",return(0));
+  _MMG5_SAFE_CALLOC(el->tadr,n+1,int);
+  _MMG5_SAFE_CALLOC(el->tlist,4*el->ne+1,int);
+
+  for (l=0; l<el->ne; l++) {
+    pt = &mesh->tetra[el->list[l]];
+    for (a=0; a<4; a++)
+      el->tadr[el->perm[pt->v[a]]]++;
   }
+  for (i=0; i<n; i++)
+    el->tadr[i+1] += el->tadr[i];
 
-  /* Set verbosity and debug info */
-  if ( !mesh->info.imprim )
-    LS_setPar(lsst,0,0,0);
-  else
-    LS_setPar(lsst,1,0,0);
-  
-  /* Step 5: fill the LS mesh */
-  /* Add vertices */
-  for(k=1; k<=mesh->np; k++) {
-    ip = perm[k];
-    if ( !ip ) continue;
-    
-    p0 = &mesh->point[k];
-    invperm[ip] = k;
-    if ( !LS_addVer(lsst,ip,p0->c,p0->ref) ) {
-      fprintf(stdout,"  ## Problem in fn LS_addVer. Exiting.\n");
-      return(0);
+  /* tadr[i] is used as cursor then shifted back */
+  for (l=0; l<el->ne; l++) {
+    pt = &mesh->tetra[el->list[l]];
+    for (a=0; a<4; a++) {
+      i = el->perm[pt->v[a]]-1;
+      el->tlist[el->tadr[i]++] = 4*l+a;
     }
   }
-  
-  /* Add tetrahedra */
-  for(k=1; k<=ilist; k++) {
-    iel = list[k];
-    pt = &mesh->tetra[iel];
-    
-    for(i=0; i<4; i++)
-      vper[i] = perm[pt->v[i]];
-    
-    if (!LS_addTet(lsst,k,vper,0) ) {
-      fprintf(stdout,"  ## Problem in fn LS_addTet. Exiting.\n");
-      return(0);
+  for (i=n; i>0; i--)
+    el->tadr[i] = el->tadr[i-1];
+  el->tadr[0] = 0;
+
+  /* neighbours of each node, row i is first stored from 4*tadr[i] */
+  _MMG5_ADD_MEM(mesh,(n+1+16*el->ne+1)*sizeof(int),"elasticity graph",return(0));
+  _MMG5_SAFE_CALLOC(el->adr,n+1,int);
+  _MMG5_SAFE_MALLOC(colb,16*el->ne+1,int);
+
+#pragma omp parallel for schedule(dynamic,64) private(t,l,iel,pt,b,j,c,nc)
+  for (i=0; i<n; i++) {
+    nc = 0;
+    for (t=el->tadr[i]; t<el->tadr[i+1]; t++) {
+      l   = el->tlist[t] / 4;
+      iel = el->list[l];
+      pt  = &mesh->tetra[iel];
+      for (b=0; b<4; b++) {
+        j = el->perm[pt->v[b]]-1;
+        for (c=0; c<nc; c++)
+          if ( colb[4*el->tadr[i]+c] == j )  break;
+        if ( c == nc )  colb[4*el->tadr[i]+nc++] = j;
+      }
     }
+    el->adr[i+1] = nc;
   }
-  
-  /* Add surface triangles */
-  ntf = 0;
-  for(k=1; k<=ilist; k++) {
-    iel = list[k];
-    pt = &mesh->tetra[iel];
-    adja = &mesh->adja[4*(iel-1)+1];
-    if (pt->xt) pxt = &mesh->xtetra[pt->xt];
-    
-    for(i=0; i<4; i++) {
-      jel = adja[i] / 4;
-      jface = adja[i] % 4;
-      
-      /* Face i carries a non homogeneous Dirichlet BC */
-      if ( pt->xt && (pxt->ftag[i] & MG_BDY) && (pxt->ref[i] == _MMG5_DISPREF) ) {
-        /* If this triangle has not been taken into account */
-        if ( MG_GET(pt->mark,i+1) ) continue;
-        ntf++;
-        for (j=0; j<3; j++)
-          vper[j] = perm[pt->v[_MMG5_idir[i][j]]];
-        
-        if ( !LS_addTri(lsst,ntf,vper,refdirnh) ) {
-          fprintf(stdout,"  ## Problem in fn LS_addTri. Exiting.\n");
-          return(0);
-        }
+  for (i=0; i<n; i++)
+    el->adr[i+1] += el->adr[i];
+  el->nnz = el->adr[n];
+
+  _MMG5_ADD_MEM(mesh,(el->nnz+1)*sizeof(int),"elasticity graph",
+                _MMG5_DEL_MEM(mesh,colb,(16*el->ne+1)*sizeof(int));
+                return(0));
+  _MMG5_SAFE_MALLOC(el->col,el->nnz+1,int);
+  for (i=0; i<n; i++)
+    memcpy(&el->col[el->adr[i]],&colb[4*el->tadr[i]],
+           (el->adr[i+1]-el->adr[i])*sizeof(int));
+
+  _MMG5_DEL_MEM(mesh,colb,(16*el->ne+1)*sizeof(int));
+
+  return(1);
+}
+
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param el pointer toward the elasticity system.
+ * \return 1 if success, 0 if fail.
+ *
+ * Assemble the P1 stiffness matrix row by row (a row only depends on the ball
+ * of its node so rows are assembled concurrently) and invert its diagonal
+ * blocks for the preconditioner.
+ *
+ */
+static int _MMG5_elasAssemble(MMG5_pMesh mesh,_MMG5_Elas *el) {
+  MMG5_pTetra    pt;
+  double         *c[4],e1[3],e2[3],e3[3],g[4][3],det,vol,gg,*kb,*d;
+  int            i,j,l,t,pos;
+  char           a,b,r,s;
+
+  _MMG5_ADD_MEM(mesh,9*(el->nnz+1+el->n+1)*sizeof(double),"elasticity matrix",
+                return(0));
+  _MMG5_SAFE_CALLOC(el->val,9*(el->nnz+1),double);
+  _MMG5_SAFE_CALLOC(el->dinv,9*(el->n+1),double);
+
+#pragma omp parallel for schedule(dynamic,64) \
+  private(pt,c,e1,e2,e3,g,det,vol,gg,kb,d,j,l,t,pos,a,b,r,s)
+  for (i=0; i<el->n; i++) {
+    for (t=el->tadr[i]; t<el->tadr[i+1]; t++) {
+      l  = el->tlist[t] / 4;
+      a  = el->tlist[t] % 4;
+      pt = &mesh->tetra[el->list[l]];
+      for (b=0; b<4; b++)
+        c[b] = mesh->point[pt->v[b]].c;
+
+      /* gradients of the P1 basis functions */
+      for (r=0; r<3; r++) {
+        e1[r] = c[1][r] - c[0][r];
+        e2[r] = c[2][r] - c[0][r];
+        e3[r] = c[3][r] - c[0][r];
       }
-      /* iel has no neighbour through face i within list */
-      else if ( !jel || (!mesh->tetra[jel].mark) ) {
-        ntf++;
-        for (j=0; j<3; j++)
-          vper[j] = perm[pt->v[_MMG5_idir[i][j]]];
-        
-        if ( !LS_addTri(lsst,ntf,vper,refdirh) ) {
-          fprintf(stdout,"  ## Problem in fn LS_addTri. Exiting.\n");
-          return(0);
+      g[1][0] = e2[1]*e3[2] - e2[2]*e3[1];
+      g[1][1] = e2[2]*e3[0] - e2[0]*e3[2];
+      g[1][2] = e2[0]*e3[1] - e2[1]*e3[0];
+      g[2][0] = e3[1]*e1[2] - e3[2]*e1[1];
+      g[2][1] = e3[2]*e1[0] - e3[0]*e1[2];
+      g[2][2] = e3[0]*e1[1] - e3[1]*e1[0];
+      g[3][0] = e1[1]*e2[2] - e1[2]*e2[1];
+      g[3][1] = e1[2]*e2[0] - e1[0]*e2[2];
+      g[3][2] = e1[0]*e2[1] - e1[1]*e2[0];
+      det = e1[0]*g[1][0] + e1[1]*g[1][1] + e1[2]*g[1][2];
+      if ( fabs(det) < _MMG5_EPSD )  continue;
+      vol = fabs(det) / 6.0;
+      det = 1.0 / det;
+      for (r=0; r<3; r++) {
+        g[1][r] *= det;
+        g[2][r] *= det;
+        g[3][r] *= det;
+        g[0][r]  = -g[1][r] - g[2][r] - g[3][r];
+      }
+
+      /* K_ab = vol (lambda ga gb^t + mu (gb ga^t + (ga.gb) Id)) */
+      for (b=0; b<4; b++) {
+        j = el->perm[pt->v[b]]-1;
+        for (pos=el->adr[i]; pos<el->adr[i+1]; pos++)
+          if ( el->col[pos] == j )  break;
+        assert ( pos < el->adr[i+1] );
+
+        kb = &el->val[9*pos];
+        gg = g[a][0]*g[b][0] + g[a][1]*g[b][1] + g[a][2]*g[b][2];
+        for (r=0; r<3; r++) {
+          for (s=0; s<3; s++)
+            kb[3*r+s] += vol*(_LS_LAMBDA*g[a][r]*g[b][s] + _LS_MU*g[a][s]*g[b][r]);
+          kb[3*r+r] += vol*_LS_MU*gg;
         }
       }
     }
-  }
 
-  if ( (abs(mesh->info.imprim) > 4 || mesh->info.ddebug) && (ilist+npf+ntf > 0) )
-       printf("Number of packed tetra %d, points %d, triangles %d\n",ilist,npf,ntf);
-  
-  /* Add boundary conditions */
-  if ( !LS_setBC(lsst,Dirichlet,refdirnh,'f',LS_tri,NULL) ) {
-    fprintf(stdout,"  ## Problem in fn LS_set BC. Exiting.\n");
-    return(0);
-  }
-  
-  if ( !LS_setBC(lsst,Dirichlet,refdirh,'v',LS_tri,u) ) {
-    fprintf(stdout,"  ## Problem in fn LS_set BC. Exiting.\n");
-    return(0);
-  }
-  
-  /* Add materials */
-  if ( !LS_setLame(lsst,0,_LS_LAMBDA,_LS_MU) ) {
-    fprintf(stdout,"  ## Problem in fn LS_setLame. Exiting.\n");
-    return(0);
-  }
-  
-  /* Transfer displacement */
-  if ( !LS_CreaSol(lsst) ) {
-    fprintf(stdout,"  ## Problem in fn LS_CreaSol. Exiting.\n");
-    return(0);
-  }
-  
-  for(k=1; k<=mesh->np; k++) {
-    ip = perm[k];
-    if ( !ip ) continue;
-    
-    if ( !LS_addSol(lsst,ip,&disp->m[3*k]) ) {
-      fprintf(stdout,"  ## Problem in fn LS_addSol. Exiting.\n");
-      return(0);
+    /* block-Jacobi preconditioner */
+    for (pos=el->adr[i]; pos<el->adr[i+1]; pos++)
+      if ( el->col[pos] == i )  break;
+    d = &el->dinv[9*i];
+    if ( !_MMG5_invmatg(&el->val[9*pos],d) ) {
+      memset(d,0,9*sizeof(double));
+      for (r=0; r<3; r++)
+        d[4*r] = fabs(el->val[9*pos+4*r]) > _MMG5_EPSD ? 1.0/el->val[9*pos+4*r] : 1.0;
     }
   }
-  
-  *npfin = npf;
-  free(list);
-  free(perm);
-  return(invperm);
+
+  return(1);
 }
 
-/** Transfer solution from the submesh to the global mesh */
-int _MMG5_unpackLS(MMG5_pMesh mesh,MMG5_pSol disp,LSst *lsst,int npf,int *invperm) {
-  double     *u;
-  int        k,ip;
-  char       i;
-  
-  u = LS_getSol(lsst);
-  
-  for(k=1; k<=mesh->np; k++) {
-    for(i=0; i<3; i++)
-      disp->m[3*k+i] = 0.0;
+/**
+ * \param el pointer toward the elasticity system.
+ * \param x input vector.
+ * \param y output vector \f$ y = K x \f$ on the free nodes, 0 elsewhere.
+ *
+ * Product of the stiffness matrix by a vector.
+ *
+ */
+static void _MMG5_elasMatvec(_MMG5_Elas *el,double *x,double *y) {
+  double   *kb,*xj,y0,y1,y2;
+  int      i,pos;
+
+#pragma omp parallel for schedule(static) private(kb,xj,y0,y1,y2,pos)
+  for (i=0; i<el->n; i++) {
+    y0 = y1 = y2 = 0.0;
+    if ( !el->fix[el->ip[i]] ) {
+      for (pos=el->adr[i]; pos<el->adr[i+1]; pos++) {
+        kb = &el->val[9*pos];
+        xj = &x[3*el->col[pos]];
+        y0 += kb[0]*xj[0] + kb[1]*xj[1] + kb[2]*xj[2];
+        y1 += kb[3]*xj[0] + kb[4]*xj[1] + kb[5]*xj[2];
+        y2 += kb[6]*xj[0] + kb[7]*xj[1] + kb[8]*xj[2];
+      }
+    }
+    y[3*i]   = y0;
+    y[3*i+1] = y1;
+    y[3*i+2] = y2;
   }
-  
-  for(k=1; k<=npf; k++) {
-    ip = invperm[k];
-    
-    for(i=0; i<3; i++)
-      disp->m[3*ip+i] = u[3*(k-1)+i];
+}
+
+/**
+ * \param el pointer toward the elasticity system.
+ * \param r input vector.
+ * \param z output vector \f$ z = D^{-1} r \f$.
+ *
+ * Apply the block-Jacobi preconditioner.
+ *
+ */
+static void _MMG5_elasPrec(_MMG5_Elas *el,double *r,double *z) {
+  double   *d,*ri;
+  int      i;
+
+#pragma omp parallel for schedule(static) private(d,ri)
+  for (i=0; i<el->n; i++) {
+    d  = &el->dinv[9*i];
+    ri = &r[3*i];
+    z[3*i]   = d[0]*ri[0] + d[1]*ri[1] + d[2]*ri[2];
+    z[3*i+1] = d[3]*ri[0] + d[4]*ri[1] + d[5]*ri[2];
+    z[3*i+2] = d[6]*ri[0] + d[7]*ri[1] + d[8]*ri[2];
   }
+}
 
-  return(1);
+/**
+ * \param n size of the vectors.
+ * \param x first vector.
+ * \param y second vector.
+ * \return the dot product of \a x and \a y.
+ *
+ */
+static double _MMG5_elasDot(int n,double *x,double *y) {
+  double   dd;
+  int      i;
+
+  dd = 0.0;
+#pragma omp parallel for schedule(static) reduction(+:dd)
+  for (i=0; i<n; i++)
+    dd += x[i]*y[i];
+
+  return(dd);
 }
 
-/** Extension of the displacement at the nodes of triangles tagged _MMG5_DISPREF */
-int _MMG5_velextLS(MMG5_pMesh mesh,MMG5_pSol disp) {
-  LSst        *lsst;
-  int         npf,*invperm;
-  
-  /* Creation of the data structure for the submesh */
-  lsst = LS_init(mesh->dim,mesh->ver,P1,1);
-  invperm = _MMG5_packLS(mesh,disp,lsst,&npf);
-  
-  if ( !npf ) {
-    fprintf(stdout,"  ## Problem in fn MMG5_packLS. Exiting.\n");
-    return(0);
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param disp pointer toward the displacement.
+ * \param el pointer toward the elasticity system.
+ * \return 1 if success, 0 if fail.
+ *
+ * Solve the elasticity system by a preconditioned conjugate gradient: the
+ * unknowns are the displacements of the free nodes, starting from the
+ * current displacement, and the result is stored in \a disp.
+ *
+ */
+static int _MMG5_elasSolve(MMG5_pMesh mesh,MMG5_pSol disp,_MMG5_Elas *el) {
+  double   *x,*r,*z,*p,*q,bnorm,rnorm,rz,rzn,alpha,beta;
+  int      i,k,n,it;
+  char     j,fix;
+
+  n = 3*el->n;
+  _MMG5_ADD_MEM(mesh,5*(n+1)*sizeof(double),"elasticity vectors",return(0));
+  _MMG5_SAFE_CALLOC(x,n+1,double);
+  _MMG5_SAFE_CALLOC(r,n+1,double);
+  _MMG5_SAFE_CALLOC(z,n+1,double);
+  _MMG5_SAFE_CALLOC(p,n+1,double);
+  _MMG5_SAFE_CALLOC(q,n+1,double);
+
+  /* Dirichlet values (in z) and initial guess (in x) */
+  for (i=0; i<el->n; i++) {
+    k   = el->ip[i];
+    fix = el->fix[k];
+    for (j=0; j<3; j++) {
+      x[3*i+j] = ( fix == 1 ) ? 0.0 : disp->m[3*k+j];
+      z[3*i+j] = ( fix == 2 ) ? disp->m[3*k+j] : 0.0;
+    }
   }
-  
-  /* Resolution of the elasticity system on the submesh */
-  if ( !LS_elastic(lsst) ) {
-    fprintf(stdout,"  ## Problem in fn elasti1. Exiting.\n");
-    return(0);
+
+  /* norm of the right-hand side and initial residual r = -K x */
+  _MMG5_elasMatvec(el,z,q);
+  bnorm = sqrt(_MMG5_elasDot(n,q,q));
+  _MMG5_elasMatvec(el,x,r);
+  for (i=0; i<n; i++)
+    r[i] = -r[i];
+
+  it    = 0;
+  rnorm = 0.0;
+  if ( bnorm < _MMG5_EPSD ) {
+    /* no prescribed displacement */
+    for (i=0; i<el->n; i++)
+      if ( !el->fix[el->ip[i]] )
+        x[3*i] = x[3*i+1] = x[3*i+2] = 0.0;
   }
-  
-  /* Update of the displacement */
-  if ( !_MMG5_unpackLS(mesh,disp,lsst,npf,invperm) ) {
-    fprintf(stdout,"  ## Problem in fn _MMG5_unpackLS. Exiting.\n");
-    return(0);
+  else {
+    _MMG5_elasPrec(el,r,z);
+    memcpy(p,z,n*sizeof(double));
+    rz = _MMG5_elasDot(n,r,z);
+
+    for (it=0; it<_MMG5_ELASMAXIT; it++) {
+      rnorm = sqrt(_MMG5_elasDot(n,r,r));
+      if ( rnorm <= _MMG5_ELASTOL*bnorm )  break;
+
+      _MMG5_elasMatvec(el,p,q);
+      alpha = rz / _MMG5_elasDot(n,p,q);
+
+#pragma omp parallel for schedule(static)
+      for (i=0; i<n; i++) {
+        x[i] += alpha*p[i];
+        r[i] -= alpha*q[i];
+      }
+      _MMG5_elasPrec(el,r,z);
+      rzn  = _MMG5_elasDot(n,r,z);
+      beta = rzn / rz;
+      rz   = rzn;
+
+#pragma omp parallel for schedule(static)
+      for (i=0; i<n; i++)
+        p[i] = z[i] + beta*p[i];
+    }
+    rnorm /= bnorm;
   }
-  
-  /* Free memory */
-  free(invperm);
-  
-  
-  if ( !LS_stop(lsst) ) {
-    fprintf(stdout,"  ## Problem in fn LS_stop. Exiting.\n");
-    return(0);
+
+  if ( abs(mesh->info.imprim) > 4 || mesh->info.ddebug )
+    fprintf(stdout,"     elasticity: %d tetra, %d points, %d iterations"
+            " (residual %e)\n",el->ne,el->n,it,rnorm);
+  if ( it == _MMG5_ELASMAXIT )
+    fprintf(stdout,"  ## Warning: elasticity solver did not converge"
+            " (residual %e).\n",rnorm);
+
+  /* Update of the displacement */
+#pragma omp parallel for schedule(static) private(j)
+  for (k=1; k<=mesh->np; k++)
+    for (j=0; j<3; j++)
+      disp->m[3*k+j] = 0.0;
+
+  for (i=0; i<el->n; i++) {
+    k = el->ip[i];
+    for (j=0; j<3; j++)
+      disp->m[3*k+j] = x[3*i+j];
   }
-  
+
+  _MMG5_DEL_MEM(mesh,x,(n+1)*sizeof(double));
+  _MMG5_DEL_MEM(mesh,r,(n+1)*sizeof(double));
+  _MMG5_DEL_MEM(mesh,z,(n+1)*sizeof(double));
+  _MMG5_DEL_MEM(mesh,p,(n+1)*sizeof(double));
+  _MMG5_DEL_MEM(mesh,q,(n+1)*sizeof(double));
+
   return(1);
 }
 
-#endif
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \param disp pointer toward the displacement.
+ * \return 1 if success, 0 if fail.
+ *
+ * Extension of the displacement at the nodes of triangles tagged _MMG5_DISPREF.
+ *
+ */
+int _MMG5_velextLS(MMG5_pMesh mesh,MMG5_pSol disp) {
+  _MMG5_Elas  el;
+  int         ier;
+
+  memset(&el,0,sizeof(_MMG5_Elas));
+
+  ier = _MMG5_elasDomain(mesh,&el);
+  if ( ier && !el.n ) {
+    fprintf(stdout,"  ## Error: no triangle of reference %d to prescribe the"
+            " displacement.\n",_MMG5_DISPREF);
+    ier = 0;
+  }
+  if ( ier )  ier = _MMG5_elasGraph(mesh,&el);
+  if ( ier )  ier = _MMG5_elasAssemble(mesh,&el);
+  if ( ier )  ier = _MMG5_elasSolve(mesh,disp,&el);
+
+  _MMG5_freeElas(mesh,&el);
+  return(ier);
+}
@@ -51,6 +51,7 @@ int _MMG3D_newPt(MMG5_pMesh mesh,double c[3],char tag) {
   ppt->ref = 0;
   ppt->xp = 0;
   ppt->flag = 0;
+  ppt->s = 0;
   /* point on geometry */
   if ( tag & MG_BDY ) {
     mesh->xp++;
@@ -107,17 +108,43 @@ int _MMG3D_newElt(MMG5_pMesh mesh) {
 
 
 void _MMG3D_delElt(MMG5_pMesh mesh,int iel) {
-  MMG5_pTetra   pt;
-  int      iadr;
+  MMG5_pTetra   pt,pt1;
+  MMG5_pPoint   ppt;
+  int      iadr,jel;
+  char     i,j,l;
 
   pt = &mesh->tetra[iel];
   if ( !MG_EOK(pt) ) {
     fprintf(stdout,"  ## INVALID ELEMENT %d.\n",iel);
     exit(EXIT_FAILURE);
   }
+  iadr = 4*(iel-1) + 1;
+
+  /* the vertices whose incident tetra is iel take a neighbour of iel that
+   * still contains them (the new tetra are stored by the kernels) */
+  if ( mesh->adja ) {
+    for (i=0; i<4; i++) {
+      ppt = &mesh->point[pt->v[i]];
+      if ( ppt->s != iel )  continue;
+      ppt->s = 0;
+      for (j=0; j<4 && !ppt->s; j++) {
+        if ( j == i )  continue;
+        jel = mesh->adja[iadr+j] / 4;
+        if ( !jel || jel == iel )  continue;
+        pt1 = &mesh->tetra[jel];
+        if ( !MG_EOK(pt1) )  continue;
+        for (l=0; l<4; l++) {
+          if ( pt1->v[l] == pt->v[i] ) {
+            ppt->s = jel;
+            break;
+          }
+        }
+      }
+    }
+  }
+
   memset(pt,0,sizeof(MMG5_Tetra));
   pt->v[3] = mesh->nenil;
-  iadr = 4*(iel-1) + 1;
   if ( mesh->adja )
     memset(&mesh->adja[iadr],0,4*sizeof(int));
   mesh->nenil = iel;
@@ -255,6 +282,30 @@ int _MMG5_zaldy(MMG5_pMesh mesh) {
   return(1);
 }
 
+/**
+ * \param mesh pointer toward the mesh structure.
+ * \return 1 if success, 0 if fail.
+ *
+ * Resize the user fields to the size of the point table.
+ *
+ */
+int _MMG3D_reallocField(MMG5_pMesh mesh) {
+  MMG5_pSol    psl;
+  int          l;
+
+  for (l=0; l<mesh->nfield; l++) {
+    psl = mesh->field[l];
+    if ( psl->npmax == mesh->npmax )  continue;
+
+    _MMG5_ADD_MEM(mesh,(psl->size*(mesh->npmax-psl->npmax))*sizeof(double),
+                  "larger user field",return(0));
+    _MMG5_SAFE_RECALLOC(psl->m,psl->size*(psl->npmax+1),
+                        psl->size*(mesh->npmax+1),double,"larger user field");
+    psl->npmax = mesh->npmax;
+  }
+  return(1);
+}
+
 /**
  * \param mesh pointer toward the mesh structure.
  *
@@ -65,6 +65,8 @@ int _MMG5_mmgsBezierCP(MMG5_pMesh mesh,MMG5_Tria *pt,_MMG5_pBezier pb,
   p[1] = &mesh->point[ib];
   p[2] = &mesh->point[ic];
 
+  if ( _MMG5_bezierCacheGet(mesh,pt,pb,ori) )  return(1);
+
   memset(pb,0,sizeof(_MMG5_Bezier));
 
   /* first 3 CP = vertices, normals */
@@ -190,6 +192,7 @@ int _MMG5_mmgsBezierCP(MMG5_pMesh mesh,MMG5_Tria *pt,_MMG5_pBezier pb,
     pb->b[9][2] += 0.25 * (pb->b[2*i+3][2] + pb->b[2*i+4][2]);
   }
 
+  _MMG5_bezierCachePut(mesh,pt,pb,ori);
   return(1);
 }
 
@@ -145,14 +145,7 @@ int assignEdge(MMG5_pMesh mesh) {
   if ( !mesh->na ) return(1);
 
   /* adjust hash table params */
-  hash.siz  = mesh->na;
-  hash.max  = 3*mesh->na+1;
-  _MMG5_ADD_MEM(mesh,(hash.max+1)*sizeof(_MMG5_Hash),"hash table",return(0));
-  _MMG5_SAFE_CALLOC(hash.item,hash.max+1,_MMG5_hedge);
-
-  hash.nxt  = mesh->na;
-  for (k=mesh->na; k<hash.max; k++)
-    hash.item[k].nxt = k+1;
+  if ( !_MMG5_hashNew(mesh,&hash,mesh->na) )  return(0);
 
   /* hash mesh edges */
   for (k=1; k<=mesh->na; k++)
@@ -39,55 +39,6 @@
 #define sw 4
 #define sd 8
 
-int swapbin(int sbin)
-{
-  int inv;
-  char *p_in = (char *) &sbin;
-  char *p = (char *)&inv;
-
-
-  p[0] = p_in[3];
-  p[1] = p_in[2];
-  p[2] = p_in[1];
-  p[3] = p_in[0];
-
-  return(inv);
-  /*unsigned char c1, c2, c3, c4;
-
-    c1 = sbin & 255;
-    c2 = (sbin >> 8) & 255;
-    c3 = (sbin >> 16) & 255;
-    c4 = (sbin >> 24) & 255;
-
-    return ((int)c1 << 24) + ((int)c2 << 16) + ((int)c3 << 8) + c4;   */
-
-}
-float swapf(float sbin)
-{
-  float out;
-  char *p_in = (char *) &sbin;
-  char *p_out = (char *) &out;
-  p_out[0] = p_in[3];
-  p_out[1] = p_in[2];
-  p_out[2] = p_in[1];
-  p_out[3] = p_in[0];
-
-  return(out);
-}
-double swapd(double sbin)
-{
-  float out;
-  char *p_in = (char *) &sbin;
-  char *p_out = (char *) &out;
-  int i;
-
-  for(i=0;i<8;i++)
-  {
-    p_out[i] = p_in[7-i];
-  }
-  //printf("CONVERTION DOUBLE\n");
-  return(out);
-}
 /**
  * \param mesh pointer toward the mesh structure.
  * \param filename name of file.
@@ -212,15 +163,15 @@ int MMGS_loadMesh(MMG5_pMesh mesh, char *filename) {
       fprintf(stdout,"BAD FILE ENCODING\n");
     }
     fread(&mesh->ver,sw,1,inm);
-    if(iswp) mesh->ver = swapbin(mesh->ver);
+    if(iswp) mesh->ver = _MMG5_swapbin(mesh->ver);
     while(fread(&binch,sw,1,inm)!=0 && binch!=54 ) {
-      if(iswp) binch=swapbin(binch);
+      if(iswp) binch=_MMG5_swapbin(binch);
       if(binch==54) break;
       if(!bdim && binch==3) {  //Dimension
         fread(&bdim,sw,1,inm);  //NulPos=>20
-        if(iswp) bdim=swapbin(bdim);
+        if(iswp) bdim=_MMG5_swapbin(bdim);
         fread(&bdim,sw,1,inm);
-        if(iswp) bdim=swapbin(bdim);
+        if(iswp) bdim=_MMG5_swapbin(bdim);
         mesh->dim = bdim;
         if(bdim!=3) {
           fprintf(stdout,"BAD SOL DIMENSION : %d\n",mesh->dim);
@@ -230,99 +181,99 @@ int MMGS_loadMesh(MMG5_pMesh mesh, char *filename) {
         continue;
       } else if(!mesh->npi && binch==4) {  //Vertices
         fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=swapbin(bpos);
+        if(iswp) bpos=_MMG5_swapbin(bpos);
         fread(&mesh->npi,sw,1,inm);
-        if(iswp) mesh->npi=swapbin(mesh->npi);
+        if(iswp) mesh->npi=_MMG5_swapbin(mesh->npi);
         posnp = ftell(inm);
         rewind(inm);
         fseek(inm,bpos,SEEK_SET);
         continue;
       } else if(binch==15) {  //RequiredVertices
         fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=swapbin(bpos);
+        if(iswp) bpos=_MMG5_swapbin(bpos);
         fread(&npreq,sw,1,inm);
-        if(iswp) npreq=swapbin(npreq);
+        if(iswp) npreq=_MMG5_swapbin(npreq);
         posnpreq = ftell(inm);
         rewind(inm);
         fseek(inm,bpos,SEEK_SET);
         continue;
       } else if(!mesh->nti && binch==6) {//Triangles
         fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=swapbin(bpos);
+        if(iswp) bpos=_MMG5_swapbin(bpos);
         fread(&mesh->nti,sw,1,inm);
-        if(iswp) mesh->nti=swapbin(mesh->nti);
+        if(iswp) mesh->nti=_MMG5_swapbin(mesh->nti);
         posnt = ftell(inm);
         rewind(inm);
         fseek(inm,bpos,SEEK_SET);
         continue;
       } else if(binch==17) {  //RequiredTriangles
         fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=swapbin(bpos);
+        if(iswp) bpos=_MMG5_swapbin(bpos);
         fread(&ntreq,sw,1,inm);
-        if(iswp) ntreq=swapbin(ntreq);
+        if(iswp) ntreq=_MMG5_swapbin(ntreq);
         posntreq = ftell(inm);
         rewind(inm);
         fseek(inm,bpos,SEEK_SET);
         continue;
       } else if(binch==7) {//Quadrilaterals
         fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=swapbin(bpos);
+        if(iswp) bpos=_MMG5_swapbin(bpos);
         fread(&nq,sw,1,inm);
-        if(iswp) nq=swapbin(nq);
+        if(iswp) nq=_MMG5_swapbin(nq);
         posnq = ftell(inm);
         rewind(inm);
         fseek(inm,bpos,SEEK_SET);
         continue;
       } else if(!ncor && binch==13) { //Corners
         fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=swapbin(bpos);
+        if(iswp) bpos=_MMG5_swapbin(bpos);
         fread(&ncor,sw,1,inm);
-        if(iswp) ncor=swapbin(ncor);
+        if(iswp) ncor=_MMG5_swapbin(ncor);
         posncor = ftell(inm);
         rewind(inm);
         fseek(inm,bpos,SEEK_SET);
         continue;
       } else if(!mesh->na && binch==5) { //Edges
         fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=swapbin(bpos);
+        if(iswp) bpos=_MMG5_swapbin(bpos);
         fread(&mesh->na,sw,1,inm);
-        if(iswp) mesh->na=swapbin(mesh->na);
+        if(iswp) mesh->na=_MMG5_swapbin(mesh->na);
         posned = ftell(inm);
         rewind(inm);
         fseek(inm,bpos,SEEK_SET);
         continue;
       } else if(binch==16) {  //RequiredEdges
         fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=swapbin(bpos);
+        if(iswp) bpos=_MMG5_swapbin(bpos);
         fread(&nedreq,sw,1,inm);
-        if(iswp) nedreq=swapbin(nedreq);
+        if(iswp) nedreq=_MMG5_swapbin(nedreq);
         posnedreq = ftell(inm);
         rewind(inm);
         fseek(inm,bpos,SEEK_SET);
         continue;
       } else if(binch==14) {  //Ridges
         fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=swapbin(bpos);
+        if(iswp) bpos=_MMG5_swapbin(bpos);
         fread(&nri,sw,1,inm);
-        if(iswp) nri=swapbin(nri);
+        if(iswp) nri=_MMG5_swapbin(nri);
         posnr = ftell(inm);
         rewind(inm);
         fseek(inm,bpos,SEEK_SET);
         continue;
       } else if(!ng && binch==60) {  //Normals
         fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=swapbin(bpos);
+        if(iswp) bpos=_MMG5_swapbin(bpos);
         fread(&ng,sw,1,inm);
-        if(iswp) ng=swapbin(ng);
+        if(iswp) ng=_MMG5_swapbin(ng);
         posnormal = ftell(inm);
         rewind(inm);
         fseek(inm,bpos,SEEK_SET);
         continue;
       } else if(binch==20) {  //NormalAtVertices
         fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=swapbin(bpos);
+        if(iswp) bpos=_MMG5_swapbin(bpos);
         fread(&mesh->nc1,sw,1,inm);
-        if(iswp) mesh->nc1=swapbin(mesh->nc1);
+        if(iswp) mesh->nc1=_MMG5_swapbin(mesh->nc1);
         posnc1 = ftell(inm);
         rewind(inm);
         fseek(inm,bpos,SEEK_SET);
@@ -330,7 +281,7 @@ int MMGS_loadMesh(MMG5_pMesh mesh, char *filename) {
       } else {
         //printf("on traite ? %d\n",binch);
         fread(&bpos,sw,1,inm); //NulPos
-        if(iswp) bpos=swapbin(bpos);
+        if(iswp) bpos=_MMG5_swapbin(bpos);
         //printf("on avance... Nulpos %d\n",bpos);
         rewind(inm);
         fseek(inm,bpos,SEEK_SET);
@@ -364,11 +315,11 @@ int MMGS_loadMesh(MMG5_pMesh mesh, char *filename) {
       } else {
         for (i=0 ; i<3 ; i++) {
           fread(&fc,sw,1,inm);
-          if(iswp) fc=swapf(fc);
+          if(iswp) fc=_MMG5_swapf(fc);
           ppt->c[i] = (double) fc;
         }
         fread(&ppt->ref,sw,1,inm);
-        if(iswp) ppt->ref=swapbin(ppt->ref);
+        if(iswp) ppt->ref=_MMG5_swapbin(ppt->ref);
       }
     } else {
       if (!bin)
@@ -376,10 +327,10 @@ int MMGS_loadMesh(MMG5_pMesh mesh, char *filename) {
       else {
         for (i=0 ; i<3 ; i++) {
           fread(&ppt->c[i],sd,1,inm);
-          if(iswp) ppt->c[i]=swapd(ppt->c[i]);
+          if(iswp) ppt->c[i]=_MMG5_swapd(ppt->c[i]);
         }
         fread(&ppt->ref,sw,1,inm);
-        if(iswp) ppt->ref=swapbin(ppt->ref);
+        if(iswp) ppt->ref=_MMG5_swapbin(ppt->ref);
       }
     }
     ppt->tag = MG_NUL;
@@ -395,10 +346,10 @@ int MMGS_loadMesh(MMG5_pMesh mesh, char *filename) {
     else {
       for (i=0 ; i<3 ; i++) {
         fread(&pt1->v[i],sw,1,inm);
-        if(iswp) pt1->v[i]=swapbin(pt1->v[i]);
+        if(iswp) pt1->v[i]=_MMG5_swapbin(pt1->v[i]);
       }
       fread(&pt1->ref,sw,1,inm);
-      if(iswp) pt1->ref=swapbin(pt1->ref);
+      if(iswp) pt1->ref=_MMG5_swapbin(pt1->ref);
     }
     for (i=0; i<3; i++) {
       ppt = &mesh->point[pt1->v[i]];
@@ -421,12 +372,12 @@ int MMGS_loadMesh(MMG5_pMesh mesh, char *filename) {
       else {
         for (i=0 ; i<3 ; i++) {
           fread(&pt1->v[i],sw,1,inm);
-          if(iswp) pt1->v[i]=swapbin(pt1->v[i]);
+          if(iswp) pt1->v[i]=_MMG5_swapbin(pt1->v[i]);
         }
         fread(&pt2->v[2],sw,1,inm);
-        if(iswp) pt2->v[2]=swapbin(pt2->v[2]);
+        if(iswp) pt2->v[2]=_MMG5_swapbin(pt2->v[2]);
         fread(&pt1->ref,sw,1,inm);
-        if(iswp) pt1->ref=swapbin(pt1->ref);
+        if(iswp) pt1->ref=_MMG5_swapbin(pt1->ref);
       }
       pt2->v[0] = pt1->v[0];
       pt2->v[1] = pt1->v[2];
@@ -449,7 +400,7 @@ int MMGS_loadMesh(MMG5_pMesh mesh, char *filename) {
         fscanf(inm,"%d",&i);
       else {
         fread(&i,sw,1,inm);
-        if(iswp) i=swapbin(i);
+        if(iswp) i=_MMG5_swapbin(i);
       }
       if(i>mesh->np) {
         fprintf(stdout,"   Warning Corner number %8d IGNORED\n",i);
@@ -469,7 +420,7 @@ int MMGS_loadMesh(MMG5_pMesh mesh, char *filename) {
         fscanf(inm,"%d",&i);
       else {
         fread(&i,sw,1,inm);
-        if(iswp) i=swapbin(i);
+        if(iswp) i=_MMG5_swapbin(i);
       }
       if(i>mesh->np) {
         fprintf(stdout,"   Warning Required Vertices number %8d IGNORED\n",i);
@@ -490,11 +441,11 @@ int MMGS_loadMesh(MMG5_pMesh mesh, char *filename) {
         fscanf(inm,"%d %d %d",&mesh->edge[k].a,&mesh->edge[k].b,&mesh->edge[k].ref);
       else {
         fread(&mesh->edge[k].a,sw,1,inm);
-        if(iswp) mesh->edge[k].a=swapbin(mesh->edge[k].a);
+        if(iswp) mesh->edge[k].a=_MMG5_swapbin(mesh->edge[k].a);
         fread(&mesh->edge[k].b,sw,1,inm);
-        if(iswp) mesh->edge[k].b=swapbin(mesh->edge[k].b);
+        if(iswp) mesh->edge[k].b=_MMG5_swapbin(mesh->edge[k].b);
         fread(&mesh->edge[k].ref,sw,1,inm);
-        if(iswp) mesh->edge[k].ref=swapbin(mesh->edge[k].ref);
+        if(iswp) mesh->edge[k].ref=_MMG5_swapbin(mesh->edge[k].ref);
       }
       mesh->edge[k].tag |= MG_REF;
       mesh->point[mesh->edge[k].a].tag |= MG_REF;
@@ -509,7 +460,7 @@ int MMGS_loadMesh(MMG5_pMesh mesh, char *filename) {
           fscanf(inm,"%d",&ia);
         else {
           fread(&ia,sw,1,inm);
-          if(iswp) ia=swapbin(ia);
+          if(iswp) ia=_MMG5_swapbin(ia);
         }
         if ( ia > 0 && ia <= mesh->na )  mesh->edge[ia].tag |= MG_GEO;
       }
@@ -522,7 +473,7 @@ int MMGS_loadMesh(MMG5_pMesh mesh, char *filename) {
           fscanf(inm,"%d",&ia);
         else {
           fread(&ia,sw,1,inm);
-          if(iswp) ia=swapbin(ia);
+          if(iswp) ia=_MMG5_swapbin(ia);
         }
         if ( ia > 0 && ia <= mesh->na )   mesh->edge[ia].tag |= MG_REQ;
       }
@@ -552,7 +503,7 @@ int MMGS_loadMesh(MMG5_pMesh mesh, char *filename) {
         } else {
           for (i=0 ; i<3 ; i++) {
             fread(&fc,sw,1,inm);
-            if(iswp) fc=swapf(fc);
+            if(iswp) fc=_MMG5_swapf(fc);
             n[i] = (double) fc;
           }
         }
@@ -563,7 +514,7 @@ int MMGS_loadMesh(MMG5_pMesh mesh, char *filename) {
         else {
           for (i=0 ; i<3 ; i++) {
             fread(&n[i],sd,1,inm);
-            if(iswp) n[i]=swapd(n[i]);
+            if(iswp) n[i]=_MMG5_swapd(n[i]);
           }
         }
       }
@@ -584,9 +535,9 @@ int MMGS_loadMesh(MMG5_pMesh mesh, char *filename) {
         fscanf(inm,"%d %d",&ip,&idn);
       else {
         fread(&ip,sw,1,inm);
-        if(iswp) ip=swapbin(ip);
+        if(iswp) ip=_MMG5_swapbin(ip);
         fread(&idn,sw,1,inm);
-        if(iswp) idn=swapbin(idn);
+        if(iswp) idn=_MMG5_swapbin(idn);
       }
       if ( idn > 0 && ip < mesh->np+1 )
         memcpy(&mesh->point[ip].n,&norm[3*(idn-1)+1],3*sizeof(double));
@@ -1119,15 +1070,15 @@ int MMGS_loadSol(MMG5_pMesh mesh,MMG5_pSol met,char* filename) {
       fprintf(stdout,"BAD FILE ENCODING\n");
     }
     fread(&met->ver,sw,1,inm);
-    if(iswp) met->ver = swapbin(met->ver);
+    if(iswp) met->ver = _MMG5_swapbin(met->ver);
     while(fread(&binch,sw,1,inm)!=EOF && binch!=54 ) {
-      if(iswp) binch=swapbin(binch);
+      if(iswp) binch=_MMG5_swapbin(binch);
       if(binch==54) break;
       if(binch==3) {  //Dimension
         fread(&bdim,sw,1,inm);  //NulPos=>20
-        if(iswp) bdim=swapbin(bdim);
+        if(iswp) bdim=_MMG5_swapbin(bdim);
         fread(&met->dim,sw,1,inm);
-        if(iswp) met->dim=swapbin(met->dim);
+        if(iswp) met->dim=_MMG5_swapbin(met->dim);
         if(met->dim!=3) {
           fprintf(stdout,"BAD SOL DIMENSION : %d\n",met->dim);
           return(-1);
@@ -1135,22 +1086,22 @@ int MMGS_loadSol(MMG5_pMesh mesh,MMG5_pSol met,char* filename) {
         continue;
       } else if(binch==62) {  //SolAtVertices
         fread(&binch,sw,1,inm); //NulPos
-        if(iswp) binch=swapbin(binch);
+        if(iswp) binch=_MMG5_swapbin(binch);
         fread(&met->np,sw,1,inm);
-        if(iswp) met->np=swapbin(met->np);
+        if(iswp) met->np=_MMG5_swapbin(met->np);
         fread(&type,sw,1,inm); //nb sol
-        if(iswp) type=swapbin(type);
+        if(iswp) type=_MMG5_swapbin(type);
         if(type!=1) {
           fprintf(stdout,"SEVERAL SOLUTION => IGNORED : %d\n",type);
           return(-1);
         }
         fread(&met->size,sw,1,inm); //typsol
-        if(iswp) met->size=swapbin(met->size);
+        if(iswp) met->size=_MMG5_swapbin(met->size);
         posnp = ftell(inm);
         break;
       } else {
         fread(&bpos,sw,1,inm); //Pos
-        if(iswp) bpos=swapbin(bpos);
+        if(iswp) bpos=_MMG5_swapbin(bpos);
         rewind(inm);
         fseek(inm,bpos,SEEK_SET);
       }
@@ -1196,7 +1147,7 @@ int MMGS_loadSol(MMG5_pMesh mesh,MMG5_pSol met,char* filename) {
           fscanf(inm,"%f",&fbuf[0]);
         } else {
           fread(&fbuf[0],sw,1,inm);
-          if(iswp) fbuf[0]=swapf(fbuf[0]);
+          if(iswp) fbuf[0]=_MMG5_swapf(fbuf[0]);
         }
         met->m[k] = fbuf[0];
       }
@@ -1207,7 +1158,7 @@ int MMGS_loadSol(MMG5_pMesh mesh,MMG5_pSol met,char* filename) {
           fscanf(inm,"%lf",&dbuf[0]);
         } else {
           fread(&dbuf[0],sd,1,inm);
-          if(iswp) dbuf[0]=swapd(dbuf[0]);
+          if(iswp) dbuf[0]=_MMG5_swapd(dbuf[0]);
         }
         met->m[k] = dbuf[0];
       }
@@ -1224,7 +1175,7 @@ int MMGS_loadSol(MMG5_pMesh mesh,MMG5_pSol met,char* filename) {
         } else {
           for(i=0 ; i<met->size ; i++) {
             fread(&fbuf[i],sw,1,inm);
-            if(iswp) fbuf[i]=swapf(fbuf[i]);
+            if(iswp) fbuf[i]=_MMG5_swapf(fbuf[i]);
           }
         }
         tmpf    = fbuf[2];
@@ -1241,7 +1192,7 @@ int MMGS_loadSol(MMG5_pMesh mesh,MMG5_pSol met,char* filename) {
         } else {
           for(i=0 ; i<met->size ; i++) {
             fread(&dbuf[i],sw,1,inm);
-            if(iswp) dbuf[i]=swapf(dbuf[i]);
+            if(iswp) dbuf[i]=_MMG5_swapf(dbuf[i]);
           }
         }
         tmpd    = dbuf[2];
@@ -460,7 +460,7 @@ static int anaelt(MMG5_pMesh mesh,MMG5_pSol met,char typchk) {
   char          i1,i2;
   static double uv[3][2] = { {0.5,0.5}, {0.,0.5}, {0.5,0.} };
 
-  _MMG5_hashNew(mesh,&hash,mesh->np,3*mesh->np);
+  _MMG5_hashNew(mesh,&hash,mesh->np);
   ns = 0;
   s  = 0.5;
   npinit = mesh->np;
@@ -1157,6 +1157,9 @@ int _MMG5_mmgs1(MMG5_pMesh mesh,MMG5_pSol met) {
   if ( abs(mesh->info.imprim) > 4 )
     fprintf(stdout,"  ** MESH ANALYSIS\n");
 
+  /* cache of the Bezier patches of the triangles (optional) */
+  _MMG5_bezierCacheNew(mesh,mesh->nt);
+
   /*--- stage 1: geometric mesh */
   if ( abs(mesh->info.imprim) > 4 || mesh->info.ddebug )
     fprintf(stdout,"  ** GEOMETRIC MESH\n");
@@ -1201,5 +1204,7 @@ int _MMG5_mmgs1(MMG5_pMesh mesh,MMG5_pSol met) {
     return(0);
   }
 
+  _MMG5_bezierCacheFree(mesh);
+
   return(1);
 }
@@ -295,7 +295,7 @@ int _MMGS_prilen(MMG5_pMesh mesh, MMG5_pSol met, int metRidTyp) {
   amin = amax = bmin = bmax = 0;
 
   /* Hash all edges in the mesh */
-  if ( !_MMG5_hashNew(mesh,&hash,mesh->np,7*mesh->np) )  return(0);
+  if ( !_MMG5_hashNew(mesh,&hash,mesh->np) )  return(0);
 
   for(k=1; k<=mesh->nt; k++) {
     pt = &mesh->tria[k];
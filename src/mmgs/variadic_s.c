@@ -306,6 +306,8 @@ void _MMGS_Free_structures_var(va_list argptr)
   if ( (*mesh)->xpoint )
     _MMG5_DEL_MEM((*mesh),(*mesh)->xpoint,((*mesh)->xpmax+1)*sizeof(MMG5_xPoint));
 
+  _MMG5_bezierCacheFree(*mesh);
+
   if ( (*mesh)->tria )
     _MMG5_DEL_MEM((*mesh),(*mesh)->tria,((*mesh)->nt+1)*sizeof(MMG5_Tria));
 